@@ -134,11 +134,13 @@
 // Please choose the name from boards.h that matches your setup
 #if defined(__AVR_ATmega2560__)
   #define MOTHERBOARD BOARD_RAMPS_14_EFB
-#if defined(ARDUINO_SAM_ARCHIM)
+#elif defined(ARDUINO_SAM_ARCHIM)
   #define MOTHERBOARD BOARD_ARCHIM2
 #elif defined(TARGET_LPC1768)
   #define MOTHERBOARD BOARD_AZTEEG_X5_GT
   //#define MOTHERBOARD BOARD_RAMPS_14_RE_ARM_EFB
+#elif defined(__PLAT_LINUX__)
+  #define MOTHERBOARD BOARD_LINUX_RAMPS
 #endif
 
 // Optional custom name for your RepStrap or other custom machine
@@ -509,7 +511,7 @@
 // Specify here all the endstop connectors that are connected to any endstop or probe.
 // Almost all printers will be using one per axis. Probes will use one or more of the
 // extra connectors. Leave undefined any used for non-endstop and non-probe purposes.
-#if MB(RAMPS_14_EFB)
+#if MB(RAMPS_14_EFB) || MB(LINUX_RAMPS)
   #define USE_XMIN_PLUG
   //#define USE_YMIN_PLUG
   #define USE_ZMIN_PLUG
@@ -560,7 +562,7 @@
   #define Y_MAX_ENDSTOP_INVERTING true // set to true to invert the logic of the endstop.
   #define Z_MAX_ENDSTOP_INVERTING false // set to true to invert the logic of the endstop.
   #define Z_MIN_PROBE_ENDSTOP_INVERTING true // set to true to invert the logic of the probe.
-#if MB(RAMPS_14_EFB)
+#elif MB(RAMPS_14_EFB) || MB(LINUX_RAMPS)
   #define X_MIN_ENDSTOP_INVERTING true // set to true to invert the logic of the endstop.
   #define Y_MIN_ENDSTOP_INVERTING false // set to true to invert the logic of the endstop.
   #define Z_MIN_ENDSTOP_INVERTING false // set to true to invert the logic of the endstop.
@@ -607,7 +609,7 @@
  * Override with M92
  *                                      X, Y, Z, E0 [, E1[, E2[, E3[, E4]]]]
  */
-#if MB(RAMPS_14_EFB)
+#if MB(RAMPS_14_EFB) || MB(LINUX_RAMPS)
   #define DEFAULT_AXIS_STEPS_PER_UNIT   { 80, 80, 2000, 560 }
 #elif MB(ARCHIM2)
   #define DEFAULT_AXIS_STEPS_PER_UNIT   { 80, 80, 400, 150 }
@@ -618,7 +620,7 @@
  * Override with M203
  *                                      X, Y, Z, E0 [, E1[, E2[, E3[, E4]]]]
  */
-#if MB(RAMPS_14_EFB)
+#if MB(RAMPS_14_EFB) || MB(LINUX_RAMPS)
   #define DEFAULT_MAX_FEEDRATE          { 120, 120, 8, 25 }
 #elif MB(ARCHIM2)
   #define DEFAULT_MAX_FEEDRATE          { 100, 100, 40, 25 }
@@ -630,7 +632,7 @@
  * Override with M201
  *                                      X, Y, Z, E0 [, E1[, E2[, E3[, E4]]]]
  */
-#if MB(RAMPS_14_EFB)
+#if MB(RAMPS_14_EFB) || MB(LINUX_RAMPS)
   #define DEFAULT_MAX_ACCELERATION      { 2000, 1800, 25, 10000 }
 #elif MB(ARCHIM2)
   #define DEFAULT_MAX_ACCELERATION      { 2000, 2000, 1000, 10000 }
@@ -661,6 +663,20 @@
 #define DEFAULT_ZJERK                  0.2
 #define DEFAULT_EJERK                  5.0
 
+/**
+ * Junction Deviation
+ *
+ * Limit the speed through a corner by how far (mm) a circle tangent to
+ * both moves stays from the corner, instead of by the Jerk of each axis,
+ * so cornering speed follows the angle of the path.
+ * E Jerk still limits the change in extrusion speed at a junction.
+ * Override with M205 J
+ */
+//#define JUNCTION_DEVIATION
+#if ENABLED(JUNCTION_DEVIATION)
+  #define JUNCTION_DEVIATION_MM 0.02  // (mm) Distance from real junction edge
+#endif
+
 /**
  * Realtime Jerk Control
  *
@@ -787,7 +803,7 @@
  *      O-- FRONT --+
  *    (0,0)
  */
-#if MB(RAMPS_14_EFB)
+#if MB(RAMPS_14_EFB) || MB(LINUX_RAMPS)
   #define X_PROBE_OFFSET_FROM_EXTRUDER 0  // X offset: -left  +right  [of the nozzle]
   #define Y_PROBE_OFFSET_FROM_EXTRUDER 0  // Y offset: -front +behind [the nozzle]
   #define Z_PROBE_OFFSET_FROM_EXTRUDER 0   // Z offset: -below +above  [the nozzle]
@@ -864,7 +880,7 @@
 // @section machine
 
 // Invert the stepper direction. Change (or reverse the motor connector) if an axis goes the wrong way.
-#if MB(RAMPS_14_EFB)
+#if MB(RAMPS_14_EFB) || MB(LINUX_RAMPS)
   #define INVERT_X_DIR false
   #define INVERT_Y_DIR false
   #define INVERT_Z_DIR true
@@ -897,7 +913,7 @@
 
 // Direction of endstops when homing; 1=MAX, -1=MIN
 // :[-1,1]
-#if MB(RAMPS_14_EFB)
+#if MB(RAMPS_14_EFB) || MB(LINUX_RAMPS)
   #define X_HOME_DIR -1
   #define Y_HOME_DIR 1
   #define Z_HOME_DIR -1
@@ -910,7 +926,7 @@
 // @section machine
 
 // The size of the print bed
-#if MB(RAMPS_14_EFB)
+#if MB(RAMPS_14_EFB) || MB(LINUX_RAMPS)
   #define X_BED_SIZE 200
   #define Y_BED_SIZE 180
 
@@ -1194,7 +1210,7 @@
 #endif
 
 // Homing speeds (mm/m)
-#if MB(RAMPS_14_EFB)
+#if MB(RAMPS_14_EFB) || MB(LINUX_RAMPS)
   #define HOMING_FEEDRATE_XY (50*60)
   #define HOMING_FEEDRATE_Z  (5*60)
 #elif MB(ARCHIM2)
@@ -1276,6 +1292,7 @@
 #define EEPROM_SETTINGS // Enable for M500 and M501 commands
 //#define DISABLE_M503    // Saves ~2700 bytes of PROGMEM. Disable for release!
 #define EEPROM_CHITCHAT   // Give feedback on EEPROM commands. Disable to save PROGMEM.
+//#define EEPROM_JOURNAL    // Flash-emulated EEPROM: log only changed settings, erasing flash far less often.
 
 //
 // Host Keepalive
@@ -1424,7 +1441,9 @@
  *
  * View the current statistics with M78.
  */
-#define PRINTCOUNTER
+#if !MB(LINUX_RAMPS) // Stored with the EEPROM byte functions, which the Linux HAL lacks
+  #define PRINTCOUNTER
+#endif
 
 //=============================================================================
 //============================= LCD and SD support ============================
@@ -1633,7 +1652,9 @@
 //
 // Note: Usually sold with a white PCB.
 //
-#define REPRAP_DISCOUNT_SMART_CONTROLLER
+#if !MB(LINUX_RAMPS)
+  #define REPRAP_DISCOUNT_SMART_CONTROLLER
+#endif
 
 //
 // GADGETS3D G3D LCD/SD Controller
@@ -1646,8 +1667,11 @@
 //
 // RepRapDiscount FULL GRAPHIC Smart Controller
 // http://reprap.org/wiki/RepRapDiscount_Full_Graphic_Smart_Controller
+// The Linux HAL simulates it only with U8glib-HAL (see HAL_LINUX/README.md)
 //
-#define REPRAP_DISCOUNT_FULL_GRAPHIC_SMART_CONTROLLER
+#if !MB(LINUX_RAMPS)
+  #define REPRAP_DISCOUNT_FULL_GRAPHIC_SMART_CONTROLLER
+#endif
 
 //
 // MakerLab Mini Panel with graphic
@@ -86,6 +86,14 @@
     typedef uint8_t ring_buffer_pos_t;
   #endif
 
+  // Over 256 bytes the TX buffer needs 16-bit indexes. Only the ISR changes
+  // the tail, so a torn read of it while waiting for room is harmless.
+  #if TX_BUFFER_SIZE > 256
+    typedef uint16_t tx_buffer_pos_t;
+  #else
+    typedef uint8_t tx_buffer_pos_t;
+  #endif
+
   #if ENABLED(SERIAL_STATS_DROPPED_RX)
     extern uint8_t rx_dropped_bytes;
   #endif
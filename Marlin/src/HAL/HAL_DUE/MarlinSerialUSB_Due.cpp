@@ -41,6 +41,7 @@ extern "C" {
   int udi_cdc_getc(void);
   bool udi_cdc_is_tx_ready(void);
   int udi_cdc_putc(int value);
+  uint32_t udi_cdc_get_free_tx_buffer(void);
 };
 
 // Pending character
@@ -123,6 +124,13 @@ void MarlinSerialUSB::write(const uint8_t c) {
   udi_cdc_putc(c);
 }
 
+// Free space in the CDC TX buffer, up to 255. Output is dropped without a host, so there's always room.
+uint8_t MarlinSerialUSB::availableForWrite(void) {
+  if (!usb_task_cdc_isenabled() || !usb_task_cdc_dtr_active()) return 255;
+  const uint32_t free = udi_cdc_get_free_tx_buffer();
+  return free > 255 ? 255 : free;
+}
+
 /**
 * Imports from print.h
 */
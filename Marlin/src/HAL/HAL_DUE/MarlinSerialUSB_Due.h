@@ -50,6 +50,7 @@ public:
   static void flush(void);
   static bool available(void);
   static void write(const uint8_t c);
+  static uint8_t availableForWrite(void);
 
   #if ENABLED(SERIAL_STATS_DROPPED_RX)
   FORCE_INLINE static uint32_t dropped() { return 0; }
@@ -67,7 +67,7 @@
   #if TX_BUFFER_SIZE > 0
     struct ring_buffer_t {
       unsigned char buffer[TX_BUFFER_SIZE];
-      volatile uint8_t head, tail;
+      volatile tx_buffer_pos_t head, tail;
     };
   #endif
 
@@ -289,7 +289,8 @@
         else
       #endif
         { // Send the next byte
-          const uint8_t t = tx_buffer.tail, c = tx_buffer.buffer[t];
+          const tx_buffer_pos_t t = tx_buffer.tail;
+          const uint8_t c = tx_buffer.buffer[t];
           tx_buffer.tail = (t + 1) & (TX_BUFFER_SIZE - 1);
           HWUART->UART_THR = c;
         }
@@ -445,11 +446,13 @@
 
   #if TX_BUFFER_SIZE > 0
 
+    // Free space in the TX buffer, up to 255
     uint8_t MarlinSerial::availableForWrite(void) {
       CRITICAL_SECTION_START;
-      const uint8_t h = tx_buffer.head, t = tx_buffer.tail;
+      const tx_buffer_pos_t h = tx_buffer.head, t = tx_buffer.tail;
       CRITICAL_SECTION_END;
-      return (uint8_t)(TX_BUFFER_SIZE + h - t) & (TX_BUFFER_SIZE - 1);
+      const tx_buffer_pos_t free = (TX_BUFFER_SIZE - 1) - ((TX_BUFFER_SIZE + h - t) & (TX_BUFFER_SIZE - 1));
+      return free > 255 ? 255 : free;
     }
 
     void MarlinSerial::write(const uint8_t c) {
@@ -480,7 +483,7 @@
         CRITICAL_SECTION_END;
         return;
       }
-      const uint8_t i = (tx_buffer.head + 1) & (TX_BUFFER_SIZE - 1);
+      const tx_buffer_pos_t i = (tx_buffer.head + 1) & (TX_BUFFER_SIZE - 1);
 
       // If the output buffer is full, there's nothing for it other than to
       // wait for the interrupt handler to empty it a bit
@@ -44,7 +44,7 @@
 // using a ring buffer (I think), in which rx_buffer_head is the index of the
 // location to which to write the next incoming character and rx_buffer_tail
 // is the index of the location from which to read.
-// 256 is the max limit due to uint8_t head and tail. Use only powers of 2. (...,16,32,64,128,256)
+// Use only powers of 2. (...,16,32,64,128,256,...)
 #ifndef RX_BUFFER_SIZE
   #define RX_BUFFER_SIZE 128
 #endif
@@ -56,8 +56,8 @@
 //  #error "SERIAL_XON_XOFF requires RX_BUFFER_SIZE >= 1024 for reliable transfers without drops."
 //#elif RX_BUFFER_SIZE && (RX_BUFFER_SIZE < 2 || !IS_POWER_OF_2(RX_BUFFER_SIZE))
 //  #error "RX_BUFFER_SIZE must be a power of 2 greater than 1."
-//#elif TX_BUFFER_SIZE && (TX_BUFFER_SIZE < 2 || TX_BUFFER_SIZE > 256 || !IS_POWER_OF_2(TX_BUFFER_SIZE))
-//  #error "TX_BUFFER_SIZE must be 0, a power of 2 greater than 1, and no greater than 256."
+//#elif TX_BUFFER_SIZE && (TX_BUFFER_SIZE < 2 || !IS_POWER_OF_2(TX_BUFFER_SIZE))
+//  #error "TX_BUFFER_SIZE must be 0 or a power of 2 greater than 1."
 //#endif
 
 #if RX_BUFFER_SIZE > 256
@@ -66,6 +66,12 @@
   typedef uint8_t ring_buffer_pos_t;
 #endif
 
+#if TX_BUFFER_SIZE > 256
+  typedef uint16_t tx_buffer_pos_t;
+#else
+  typedef uint8_t tx_buffer_pos_t;
+#endif
+
 #if ENABLED(SERIAL_STATS_DROPPED_RX)
   extern uint8_t rx_dropped_bytes;
 #endif
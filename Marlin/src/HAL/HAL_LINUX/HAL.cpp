@@ -0,0 +1,83 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "../../inc/MarlinConfig.h"
+
+#include <pthread.h>
+#include <signal.h>
+
+HalSerial usb_serial;
+
+// return free heap space
+int freeMemory() {
+  return 0;
+}
+
+// --------------------------------------------------------------------------
+// Interrupts
+// --------------------------------------------------------------------------
+
+// Non-zero if the timer signals are currently held off
+uint32_t HAL_isr_mask(void) {
+  sigset_t current;
+  pthread_sigmask(SIG_SETMASK, NULL, &current);
+  return sigismember(&current, SIGRTMIN + STEP_TIMER_NUM);
+}
+
+void cli(void) { pthread_sigmask(SIG_BLOCK, &Timer::isr_signals, NULL); }
+void sei(void) { pthread_sigmask(SIG_UNBLOCK, &Timer::isr_signals, NULL); }
+
+// --------------------------------------------------------------------------
+// ADC
+// --------------------------------------------------------------------------
+
+// The simulated sensors write their raw readings directly to the analog pins
+static uint8_t active_ch = 0;
+
+void HAL_adc_init(void) {}
+
+void HAL_adc_enable_channel(int ch) {}
+
+void HAL_adc_start_conversion(const uint8_t ch) {
+  active_ch = ch;
+}
+
+bool HAL_adc_finished(void) {
+  return true;
+}
+
+uint16_t HAL_adc_get_result(void) {
+  const pin_t pin = analogInputToDigitalPin(active_ch);
+  return Gpio::get(pin) & 0x3FF;  // 10-bit, like AVR
+}
+
+void (*HAL_idle_hook)(void); // = NULL
+
+void HAL_idletask(void) {
+  if (HAL_idle_hook) HAL_idle_hook();
+  // Let the I/O and simulation threads run while loop() spins
+  sched_yield();
+}
+
+#endif // __PLAT_LINUX__
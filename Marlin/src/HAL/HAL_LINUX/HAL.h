@@ -0,0 +1,121 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * HAL_LINUX/HAL.h
+ * Hardware Abstraction Layer for running Marlin as a Linux process
+ *
+ * Timers are POSIX timers delivering signals to the firmware thread,
+ * the serial port is a pseudo-terminal, EEPROM is a file and the SD card
+ * is a FAT image file. See README.md for usage.
+ */
+
+#ifndef _HAL_LINUX_H_
+#define _HAL_LINUX_H_
+
+#define CPU_32_BIT
+
+// --------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdarg.h>
+
+#undef min
+#undef max
+
+#include <algorithm>
+
+//arduino: Print.h
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+//arduino: binary.h (weird defines)
+#define B01 1
+#define B10 2
+
+#include <Arduino.h>
+#include <pinmapping.h>
+
+#include "../math_32bit.h"
+#include "../HAL_SPI.h"
+#include "fastio.h"
+#include "watchdog.h"
+#include "serial.h"
+#include "HAL_timers.h"
+
+// --------------------------------------------------------------------------
+// Defines
+// --------------------------------------------------------------------------
+
+#ifndef F_CPU
+  #define F_CPU 100000000
+#endif
+
+extern HalSerial usb_serial;
+
+#if SERIAL_PORT != -1
+  #error "SERIAL_PORT must be -1 for the Linux HAL (pty or stdio)."
+#endif
+#define MYSERIAL0 usb_serial
+#define NUM_SERIAL 1
+
+// Interrupts are the timer signals, see hardware/Timer.h
+uint32_t HAL_isr_mask(void);
+#define CRITICAL_SECTION_START  uint32_t primask = HAL_isr_mask(); cli();
+#define CRITICAL_SECTION_END    if (!primask) sei();
+
+//Utility functions
+int freeMemory(void);
+
+// EEPROM, read from the file the settings are stored in, or the EEPROM journal
+void eeprom_read_block(void *__dst, const void *__src, size_t __n);
+#define JOURNAL_BANK_SIZE 0x4000  // The banks of hardware/FlashMemory.h
+
+// SPI: Extended functions which take a channel number (hardware SPI only)
+/** Write single byte to specified SPI channel */
+void spiSend(uint32_t chan, byte b);
+/** Write buffer to specified SPI channel */
+void spiSend(uint32_t chan, const uint8_t* buf, size_t n);
+/** Read single byte from specified SPI channel */
+uint8_t spiRec(uint32_t chan);
+
+// ADC
+#define HAL_ANALOG_SELECT(pin) HAL_adc_enable_channel(pin)
+#define HAL_START_ADC(pin)     HAL_adc_start_conversion(pin)
+#define HAL_READ_ADC           HAL_adc_get_result()
+
+void HAL_adc_init(void);
+void HAL_adc_enable_channel(int pin);
+void HAL_adc_start_conversion(const uint8_t adc_pin);
+uint16_t HAL_adc_get_result(void);
+
+// Enable hooks into idle and setup for HAL
+#define HAL_IDLETASK 1
+void HAL_idletask(void);
+
+// Called from HAL_idletask when set, e.g. to empty the planner buffer in a benchmark
+extern void (*HAL_idle_hook)(void);
+
+#endif // _HAL_LINUX_H_
@@ -0,0 +1,81 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Software emulation of the SPI bus for the Linux HAL.
+ *
+ * Only the SD card is attached. Bytes are clocked through the SDCard model
+ * whenever SDSS is driven low; with the card deselected MISO floats high.
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "../../inc/MarlinConfig.h"
+#include "hardware/SDCard.h"
+
+SDCard sd_card;
+
+static bool sd_selected = false;
+
+static uint8_t spiTransfer(const uint8_t b) {
+  const bool selected = Gpio::get(SDSS) == LOW;
+  if (selected != sd_selected) sd_card.select(sd_selected = selected);
+  return selected ? sd_card.transfer(b) : 0xFF;
+}
+
+void spiBegin() {
+  #if !PIN_EXISTS(SS)
+    #error "SS_PIN not defined!"
+  #endif
+  OUT_WRITE(SS_PIN, HIGH);
+}
+
+void spiInit(uint8_t spiRate) { UNUSED(spiRate); }
+
+void spiSend(uint8_t b) { spiTransfer(b); }
+
+uint8_t spiRec() { return spiTransfer(0xFF); }
+
+void spiRead(uint8_t* buf, uint16_t nbyte) {
+  for (uint16_t i = 0; i < nbyte; i++) buf[i] = spiTransfer(0xFF);
+}
+
+void spiSendBlock(uint8_t token, const uint8_t* buf) {
+  spiTransfer(token);
+  for (uint16_t i = 0; i < 512; i++) spiTransfer(buf[i]);
+}
+
+void spiBeginTransaction(uint32_t spiClock, uint8_t bitOrder, uint8_t dataMode) {
+  UNUSED(spiClock); UNUSED(bitOrder); UNUSED(dataMode);
+}
+
+// Extended functions which take a channel number (hardware SPI only)
+void spiSend(uint32_t chan, byte b) { UNUSED(chan); spiSend(b); }
+
+void spiSend(uint32_t chan, const uint8_t* buf, size_t n) {
+  UNUSED(chan);
+  for (size_t i = 0; i < n; i++) spiSend(buf[i]);
+}
+
+uint8_t spiRec(uint32_t chan) { UNUSED(chan); return spiRec(); }
+
+#endif // __PLAT_LINUX__
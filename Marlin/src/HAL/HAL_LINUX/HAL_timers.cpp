@@ -0,0 +1,46 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "../../inc/MarlinConfig.h"
+
+extern "C" void TIMER0_IRQHandler(void);
+extern "C" void TIMER1_IRQHandler(void);
+
+Timer timers[2];
+
+// The stepper ISR may preempt the temperature ISR, but not the reverse
+void HAL_timer_init(void) {
+  sigemptyset(&Timer::isr_signals);
+  sigaddset(&Timer::isr_signals, SIGRTMIN + STEP_TIMER_NUM);
+  sigaddset(&Timer::isr_signals, SIGRTMIN + TEMP_TIMER_NUM);
+
+  timers[STEP_TIMER_NUM].init(SIGRTMIN + STEP_TIMER_NUM, HAL_STEPPER_TIMER_RATE, TIMER0_IRQHandler, false);
+  timers[TEMP_TIMER_NUM].init(SIGRTMIN + TEMP_TIMER_NUM, HAL_TEMP_TIMER_RATE, TIMER1_IRQHandler, true);
+}
+
+void HAL_timer_start(const uint8_t timer_num, const uint32_t frequency) {
+  timers[timer_num].start(frequency);
+}
+
+#endif // __PLAT_LINUX__
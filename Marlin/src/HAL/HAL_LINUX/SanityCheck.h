@@ -0,0 +1,47 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Test Linux HAL specific configuration values for errors at compile-time.
+ */
+
+#if HAS_SERVOS
+  #error "Servos are not supported by the Linux HAL."
+#endif
+
+#if ENABLED(EMERGENCY_PARSER)
+  #error "EMERGENCY_PARSER is not yet implemented for the Linux HAL. Disable EMERGENCY_PARSER to continue."
+#endif
+
+#if ENABLED(ENDSTOP_INTERRUPTS_FEATURE)
+  #error "ENDSTOP_INTERRUPTS_FEATURE is not supported by the Linux HAL. Endstops are polled."
+#endif
+
+#if ENABLED(DOGLCD)
+  #if DISABLED(U8GLIB_ST7920) || ENABLED(REPRAPWORLD_GRAPHICAL_LCD) || ENABLED(LIGHTWEIGHT_UI)
+    #error "The Linux HAL only simulates the ST7920 of the REPRAP_DISCOUNT_FULL_GRAPHIC_SMART_CONTROLLER, without LIGHTWEIGHT_UI."
+  #elif !defined(U8G_HAL_LINKS)
+    #error "A display on the Linux HAL needs U8glib-HAL and U8G_HAL_LINKS. See HAL_LINUX/README.md."
+  #endif
+#elif ENABLED(ULTRA_LCD)
+  #error "The Linux HAL has no character display support. Disable the LCD controller to continue."
+#endif
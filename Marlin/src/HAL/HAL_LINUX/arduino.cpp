@@ -0,0 +1,105 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "../../inc/MarlinConfig.h"
+#include "hardware/Clock.h"
+
+// Time functions
+void _delay_ms(const int delay_ms) {
+  delay(delay_ms);
+}
+
+uint32_t millis() {
+  return (uint32_t)Clock::millis();
+}
+
+uint32_t micros() {
+  return (uint32_t)Clock::micros();
+}
+
+// Short delays spin so step pulse timing isn't at the mercy of the scheduler
+void delayMicroseconds(unsigned long us) {
+  if (us > 1000) return Clock::delayNanos(us * 1000ULL);
+  const uint64_t end = Clock::nanos() + us * 1000ULL;
+  while (Clock::nanos() < end) { /* nada */ }
+}
+
+extern "C" void delay(const int msec) {
+  Clock::delayNanos(msec * 1000000ULL);
+}
+
+// IO functions
+// As defined by Arduino INPUT(0x0), OUTPUT(0x1), INPUT_PULLUP(0x2)
+void pinMode(const pin_t pin, const uint8_t mode) {
+  if (!Gpio::valid_pin(pin)) return;
+  Gpio::setMode(pin, mode);
+}
+
+void digitalWrite(pin_t pin, uint8_t pin_status) {
+  if (!Gpio::valid_pin(pin)) return;
+  Gpio::set(pin, pin_status ? HIGH : LOW);
+}
+
+bool digitalRead(pin_t pin) {
+  if (!Gpio::valid_pin(pin)) return false;
+  return Gpio::get(pin) != 0;
+}
+
+void analogWrite(pin_t pin, int pwm_value) {  // 1 - 254: pwm_value, 0: LOW, 255: HIGH
+  if (!Gpio::valid_pin(pin)) return;
+  Gpio::set(pin, pwm_value);
+}
+
+uint16_t analogRead(pin_t adc_pin) {
+  HAL_adc_start_conversion(DIGITAL_PIN_TO_ANALOG_PIN(adc_pin));
+  return HAL_adc_get_result();
+}
+
+void attachInterrupt(uint32_t pin, void (*callback)(void), uint32_t mode) {}
+void detachInterrupt(uint32_t pin) {}
+
+char *dtostrf (double __val, signed char __width, unsigned char __prec, char *__s) {
+  char format_string[20];
+  snprintf(format_string, 20, "%%%d.%df", __width, __prec);
+  sprintf(__s, format_string, __val);
+  return __s;
+}
+
+int32_t random(int32_t max) {
+  return rand() % max;
+}
+
+int32_t random(int32_t min, int32_t max) {
+  return min + rand() % (max - min);
+}
+
+void randomSeed(uint32_t value) {
+  srand(value);
+}
+
+int map(uint16_t x, uint16_t in_min, uint16_t in_max, uint16_t out_min, uint16_t out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,107 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "benchmark.h"
+
+#if HAS_ABL_BENCHMARK
+
+#include "../../../feature/bedlevel/abl/abl.h"
+
+// The bilinear height from the grid points in double precision, for reference
+static double abl_exact_z(const float x, const float y) {
+  const double u = (x - bilinear_start[X_AXIS]) / double(bilinear_grid_spacing[X_AXIS]),
+               v = (y - bilinear_start[Y_AXIS]) / double(bilinear_grid_spacing[Y_AXIS]);
+  const int gx = constrain(int(floor(u)), 0, GRID_MAX_POINTS_X - 2), gy = constrain(int(floor(v)), 0, GRID_MAX_POINTS_Y - 2);
+  double fu = u - gx, fv = v - gy;
+  #if DISABLED(EXTRAPOLATE_BEYOND_GRID)
+    fu = constrain(fu, 0, 1);
+    fv = constrain(fv, 0, 1);
+  #endif
+  const double zl = z_values[gx][gy] + (z_values[gx][gy + 1] - z_values[gx][gy]) * fv,
+               zr = z_values[gx + 1][gy] + (z_values[gx + 1][gy + 1] - z_values[gx + 1][gy]) * fv;
+  return zl + (zr - zl) * fu;
+}
+
+/**
+ * Level the segments of random lines over a random grid, one point at a
+ * time with bilinear_z_offset() and in batches with bilinear_z_offsets(),
+ * and report the time per point and the largest difference from exact
+ * bilinear interpolation. The lines reach a little beyond the grid.
+ */
+void benchmark_abl(const uint32_t count) {
+  constexpr uint8_t batch = 16;
+  uint32_t seed = 1;
+  bilinear_start[X_AXIS] = X_MIN_POS + 10;
+  bilinear_start[Y_AXIS] = Y_MIN_POS + 10;
+  bilinear_grid_spacing[X_AXIS] = (X_MAX_POS - X_MIN_POS - 20) / (GRID_MAX_POINTS_X - 1);
+  bilinear_grid_spacing[Y_AXIS] = (Y_MAX_POS - Y_MIN_POS - 20) / (GRID_MAX_POINTS_Y - 1);
+  for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
+    for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
+      z_values[x][y] = (benchmark_random(seed) - 0.5) * 0.8;
+  refresh_bed_level();
+
+  float (* const z)[batch] = (float(*)[batch])malloc(count * sizeof(*z));
+  float (* const lines)[2][XYZ] = (float(*)[2][XYZ])malloc(count * sizeof(*lines));
+  for (uint32_t i = 0; i < count; i++) {
+    // Start anywhere on the bed, segments of 0.2-5mm in any direction
+    const float mm = 0.2 + benchmark_random(seed) * 4.8, angle = benchmark_random(seed) * RADIANS(360);
+    lines[i][0][X_AXIS] = X_MIN_POS + benchmark_random(seed) * (X_MAX_POS - X_MIN_POS);
+    lines[i][0][Y_AXIS] = Y_MIN_POS + benchmark_random(seed) * (Y_MAX_POS - Y_MIN_POS);
+    lines[i][1][X_AXIS] = mm * cos(angle);
+    lines[i][1][Y_AXIS] = mm * sin(angle);
+    lines[i][0][Z_AXIS] = lines[i][1][Z_AXIS] = 0;
+  }
+
+  for (uint8_t batched = 0; batched < 2; batched++) {
+    const uint64_t start = Clock::nanos();
+    for (uint32_t i = 0; i < count; i++) {
+      if (batched)
+        bilinear_z_offsets(lines[i][0], lines[i][1], batch, z[i]);
+      else {
+        float raw[XYZ];
+        COPY(raw, lines[i][0]);
+        for (uint8_t k = 0; k < batch; k++) {
+          raw[X_AXIS] += lines[i][1][X_AXIS];
+          raw[Y_AXIS] += lines[i][1][Y_AXIS];
+          z[i][k] = bilinear_z_offset(raw);
+        }
+      }
+    }
+    const float seconds = (Clock::nanos() - start) * 1e-9;
+
+    double max_error = 0;
+    for (uint32_t i = 0; i < count; i++)
+      for (uint8_t k = 0; k < batch; k++)
+        NOLESS(max_error, fabs(z[i][k] - abl_exact_z(lines[i][0][X_AXIS] + (k + 1) * lines[i][1][X_AXIS], lines[i][0][Y_AXIS] + (k + 1) * lines[i][1][Y_AXIS])));
+
+    fprintf(stderr, "abl: %-8s %u lines of %u segments on a %ux%u grid, %.1f ns/segment, max error %.6fmm\n",
+      batched ? "batched" : "single", count, batch, GRID_MAX_POINTS_X, GRID_MAX_POINTS_Y, seconds * 1e9 / (count * batch), max_error);
+  }
+  free(z);
+  free(lines);
+  exit(0);
+}
+
+#endif // HAS_ABL_BENCHMARK
+#endif // __PLAT_LINUX__
@@ -0,0 +1,150 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "benchmark.h"
+
+#if HAS_ARC_BENCHMARK
+
+#include "../../../module/planner.h"
+#include "../../../module/motion.h"
+#include "../../../module/segment_producer.h"
+#include "../../../gcode/gcode.h"
+
+void plan_arc(const float (&cart)[XYZE], const float (&offset)[2], const uint8_t clockwise);
+
+static float arc_center[2], arc_radius, arc_last[2], arc_max_error, arc_error_sum, arc_min_mm;
+static long arc_steps[2];
+static uint32_t arc_segments, arc_short;
+
+// The distance from the arc to the farthest point of a chord
+static float chord_error(const float p0[2], const float p1[2]) {
+  const float dx = p1[0] - p0[0], dy = p1[1] - p0[1], len2 = sq(dx) + sq(dy);
+  float t = len2 ? ((arc_center[0] - p0[0]) * dx + (arc_center[1] - p0[1]) * dy) / len2 : 0;
+  t = constrain(t, 0, 1);
+  const float inner = arc_radius - HYPOT(p0[0] + t * dx - arc_center[0], p0[1] + t * dy - arc_center[1]);
+  return max(inner, max(fabs(HYPOT(p0[0] - arc_center[0], p0[1] - arc_center[1]) - arc_radius),
+                        fabs(HYPOT(p1[0] - arc_center[0], p1[1] - arc_center[1]) - arc_radius)));
+}
+
+// Take the queued segments from the planner, measuring each one
+static void arc_drain() {
+  while (planner.has_blocks_queued()) {
+    const block_t &block = planner.block_buffer[planner.block_buffer_tail];
+    float p[2];
+    for (uint8_t a = X_AXIS; a <= Y_AXIS; a++) {
+      arc_steps[a] += TEST(block.direction_bits, a) ? -long(block.steps[a]) : long(block.steps[a]);
+      p[a] = arc_steps[a] * planner.steps_to_mm[a];
+    }
+    const float error = chord_error(arc_last, p);
+    NOLESS(arc_max_error, error);
+    arc_error_sum += error;
+    // The length of arc the chord cuts off, against the minimum (less a step)
+    if (2 * arc_radius * asin(min(block.millimeters / (2 * arc_radius), 1.0f)) < arc_min_mm - 0.001) arc_short++;
+    arc_segments++;
+    COPY(arc_last, p);
+    planner.discard_current_block();
+  }
+}
+
+/**
+ * Run a corpus of random arcs through plan_arc(), with MM_PER_ARC_SEGMENT
+ * and (with ARC_CHORD_TOLERANCE) with the chord tolerance, without and with
+ * the minimum segment time, and report the segment count, the path error
+ * and the segments shorter than the minimum segment time allows. X and Y get 1000 steps/mm, so step positions are
+ * within 0.001mm of the segment ends. The stepper ISR is masked and the
+ * planner is emptied from idle().
+ */
+void benchmark_arcs(const uint32_t count) {
+  cli();
+  #ifdef ARC_CHORD_TOLERANCE
+    const float tolerance = gcode.arc_chord_tolerance;
+    const uint16_t min_time = gcode.arc_min_segment_time;
+    const uint8_t passes = 3;
+  #else
+    constexpr uint8_t passes = 1;
+  #endif
+  planner.axis_steps_per_mm[X_AXIS] = planner.axis_steps_per_mm[Y_AXIS] = 1000;
+  planner.refresh_positioning();
+  const float bed_center[] = { (X_MIN_POS + X_MAX_POS) * 0.5, (Y_MIN_POS + Y_MAX_POS) * 0.5 },
+              max_radius = min(X_MAX_POS - X_MIN_POS, Y_MAX_POS - Y_MIN_POS) * 0.4;
+  HAL_idle_hook = arc_drain;
+
+  for (uint8_t pass = 0; pass < passes; pass++) {
+    #ifdef ARC_CHORD_TOLERANCE
+      gcode.arc_chord_tolerance = pass ? tolerance : 0;
+      gcode.arc_min_segment_time = pass == 1 ? 0 : min_time;
+    #endif
+    uint32_t seed = 1;
+    arc_max_error = arc_error_sum = 0;
+    arc_segments = arc_short = 0;
+    uint64_t ns = 0;
+    for (uint32_t i = 0; i < count; i++) {
+      // Radius 0.5mm up to the bed, 10-360 degrees, 10-200mm/s
+      arc_radius = 0.5 * pow(max_radius / 0.5, benchmark_random(seed));
+      const float start = benchmark_random(seed) * RADIANS(360),
+                  sweep = RADIANS(10 + benchmark_random(seed) * 350);
+      const bool clockwise = benchmark_random(seed) < 0.5;
+      feedrate_mm_s = min(10 + benchmark_random(seed) * 190, PLANNER_XY_FEEDRATE());
+      #ifdef ARC_CHORD_TOLERANCE
+        arc_min_mm = feedrate_mm_s * min_time * 0.001;
+      #else
+        arc_min_mm = 0;
+      #endif
+
+      COPY(arc_center, bed_center);
+      current_position[X_AXIS] = arc_center[X_AXIS] + arc_radius * cos(start);
+      current_position[Y_AXIS] = arc_center[Y_AXIS] + arc_radius * sin(start);
+      current_position[Z_AXIS] = current_position[E_AXIS] = 0;
+      SYNC_PLAN_POSITION_KINEMATIC();
+      COPY(destination, current_position);
+      destination[X_AXIS] = arc_center[X_AXIS] + arc_radius * cos(start + (clockwise ? -sweep : sweep));
+      destination[Y_AXIS] = arc_center[Y_AXIS] + arc_radius * sin(start + (clockwise ? -sweep : sweep));
+      for (uint8_t a = X_AXIS; a <= Y_AXIS; a++) {
+        arc_steps[a] = LROUND(current_position[a] * planner.axis_steps_per_mm[a]);
+        arc_last[a] = current_position[a];
+      }
+      const float offset[2] = { arc_center[X_AXIS] - current_position[X_AXIS], arc_center[Y_AXIS] - current_position[Y_AXIS] };
+
+      const uint64_t begin = Clock::nanos();
+      plan_arc(destination, offset, clockwise);
+      segment_feed.finish();
+      ns += Clock::nanos() - begin;
+      arc_drain();
+    }
+
+    #ifdef ARC_CHORD_TOLERANCE
+      if (pass)
+        fprintf(stderr, "arcs: ARC_CHORD_TOLERANCE %.4fmm, ARC_MIN_SEGMENT_TIME %ums:", gcode.arc_chord_tolerance, gcode.arc_min_segment_time);
+      else
+    #endif
+        fprintf(stderr, "arcs: MM_PER_ARC_SEGMENT %.2fmm:", float(MM_PER_ARC_SEGMENT));
+    fprintf(stderr, " %u arcs, %u segments, %.1f segments/arc, %.0f ns/segment, max error %.4fmm, mean %.4fmm, %u segments under the minimum time\n",
+      count, arc_segments, float(arc_segments) / count, float(ns) / arc_segments, arc_max_error, arc_error_sum / arc_segments, arc_short);
+  }
+  HAL_idle_hook = NULL;
+  exit(0);
+}
+
+#endif // HAS_ARC_BENCHMARK
+#endif // __PLAT_LINUX__
@@ -0,0 +1,93 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _HAL_LINUX_BENCHMARK_H_
+#define _HAL_LINUX_BENCHMARK_H_
+
+/**
+ * Benchmarks for the --benchmark-* options (see README.md)
+ *
+ * Each one runs after setup() in place of the main loop, reports on stderr
+ * and exits, with status 1 if the firmware failed one of its checks.
+ */
+
+#include "../../../inc/MarlinConfig.h"
+#include "../hardware/Clock.h"
+#include "../hardware/Heater.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HAS_JUNCTION_BENCHMARK (!IS_KINEMATIC && !IS_CORE)
+#define HAS_ARC_BENCHMARK (ENABLED(ARC_SUPPORT) && !IS_KINEMATIC && !IS_CORE)
+#define HAS_ABL_BENCHMARK (ENABLED(AUTO_BED_LEVELING_BILINEAR) && DISABLED(ABL_BILINEAR_SUBDIVISION))
+#define HAS_UBL_BENCHMARK (ENABLED(AUTO_BED_LEVELING_UBL) && !UBL_SEGMENTED)
+
+// From main.cpp
+extern volatile uint32_t host_rate;  // Bytes per second the host takes, or 0 for as fast as it can
+extern volatile uint64_t host_received;  // Bytes the host has taken from usb_serial
+Heater simulated_hotend(const pin_t heater, const pin_t adc);
+
+// The next of a sequence of random numbers in [0, 1), the same on every host
+inline float benchmark_random(uint32_t &seed) {
+  seed = seed * 1103515245UL + 12345;
+  return (seed >> 8) * (1.0f / 16777216);
+}
+
+void benchmark_planner(const uint32_t count);
+void benchmark_stepper(const uint32_t count);
+void benchmark_gcode(const char * const filename);
+void benchmark_dispatch(const char * const filename);
+void benchmark_serial(const uint32_t count);
+#if ENABLED(PIDTEMP)
+  void benchmark_hotend(const uint32_t count);
+#endif
+#if HAS_JUNCTION_BENCHMARK
+  void benchmark_junction(const uint32_t count);
+#endif
+#if HAS_ARC_BENCHMARK
+  void benchmark_arcs(const uint32_t count);
+#endif
+#if HAS_ABL_BENCHMARK
+  void benchmark_abl(const uint32_t count);
+#endif
+#if HAS_UBL_BENCHMARK
+  void benchmark_ubl(const uint32_t count);
+#endif
+#if ENABLED(DELTA)
+  void benchmark_delta(const uint32_t count);
+#endif
+#if ENABLED(SDSUPPORT)
+  void benchmark_sd(char * const filename);
+  #if ENABLED(POWER_LOSS_RECOVERY)
+    void benchmark_recovery(char * const filename);
+  #endif
+#endif
+#if ENABLED(EEPROM_JOURNAL)
+  void benchmark_eeprom(const uint32_t count);
+#endif
+#if ENABLED(DOGLCD)
+  void benchmark_lcd(const uint32_t seconds);
+#endif
+
+#endif // _HAL_LINUX_BENCHMARK_H_
@@ -0,0 +1,184 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "benchmark.h"
+
+#if ENABLED(DELTA)
+
+#include "../../../module/delta.h"
+#include "../../../module/planner.h"
+#include "../../../module/motion.h"
+#include "../../../module/segment_producer.h"
+
+struct DeltaMove { float start[XYZ], target[XYZ], mm_s; };
+
+// The carriage heights in double precision, for reference
+static double exact_carriage(const uint8_t tower, const double x, const double y, const double z) {
+  return z + sqrt(delta_diagonal_rod_2_tower[tower] - sq(delta_tower[tower][X_AXIS] - x) - sq(delta_tower[tower][Y_AXIS] - y));
+}
+
+enum DeltaKinematics : uint8_t { DELTA_KIN_IK, DELTA_KIN_STEPPED, DELTA_KIN_BATCHED };
+
+/**
+ * Segment a move the way prepare_kinematic_move_to does, with DELTA_IK for
+ * every segment, with the kinematics stepped along the line one segment at
+ * a time or a batch at a time, and return the segment count. With errors,
+ * find the largest difference from the exact carriage heights at the
+ * segment ends (IK) and halfway between them (path).
+ */
+static uint32_t delta_segment_move(const DeltaMove &m, const DeltaKinematics kinematics, float *checksum, double *ik_error=NULL, double *path_error=NULL) {
+  float diff[XYZ];
+  LOOP_XYZ(i) diff[i] = m.target[i] - m.start[i];
+  const float cartesian_mm = SQRT(sq(diff[X_AXIS]) + sq(diff[Y_AXIS]) + sq(diff[Z_AXIS]));
+  uint16_t segments = delta_segments_per_second * cartesian_mm / m.mm_s;
+  #ifdef DELTA_SEGMENT_TOLERANCE
+    if (kinematics != DELTA_KIN_IK) NOMORE(segments, delta_segments_for_tolerance(m.start, m.target, HYPOT(diff[X_AXIS], diff[Y_AXIS])));
+  #endif
+  NOLESS(segments, 1);
+  const float inv_segments = 1.0 / float(segments);
+  float segment[XYZ], raw[XYZ], carriage[ABC][DELTA_SEGMENT_BATCH];
+  LOOP_XYZ(i) { segment[i] = diff[i] * inv_segments; raw[i] = m.start[i]; }
+
+  double last[ABC];
+  if (ik_error) LOOP_XYZ(t) last[t] = exact_carriage(t, raw[X_AXIS], raw[Y_AXIS], raw[Z_AXIS]);
+  if (kinematics != DELTA_KIN_IK) delta_segments_init(raw, segment);
+  uint8_t batch_index = 0, batch_size = 0;
+  for (uint16_t s = 1; s <= segments; s++) {
+    if (s < segments) {
+      if (kinematics == DELTA_KIN_BATCHED && batch_index == batch_size) {
+        batch_size = min(uint16_t(segments - s), uint16_t(DELTA_SEGMENT_BATCH));
+        batch_index = 0;
+        delta_segments_next(batch_size, raw[Z_AXIS], segment[Z_AXIS], carriage);
+      }
+      LOOP_XYZ(i) raw[i] += segment[i];
+      switch (kinematics) {
+        case DELTA_KIN_IK: DELTA_IK(raw); break;
+        case DELTA_KIN_STEPPED: delta_segments_next(raw[Z_AXIS]); break;
+        case DELTA_KIN_BATCHED: LOOP_XYZ(t) delta[t] = carriage[t][batch_index]; batch_index++; break;
+      }
+    }
+    else
+      inverse_kinematics(m.target);
+    *checksum += delta[A_AXIS] + delta[B_AXIS] + delta[C_AXIS];
+    if (ik_error) {
+      const double f = double(s) / segments, h = (double(s) - 0.5) / segments;
+      LOOP_XYZ(t) {
+        const double exact = exact_carriage(t, m.start[X_AXIS] + f * diff[X_AXIS], m.start[Y_AXIS] + f * diff[Y_AXIS], m.start[Z_AXIS] + f * diff[Z_AXIS]),
+                     middle = exact_carriage(t, m.start[X_AXIS] + h * diff[X_AXIS], m.start[Y_AXIS] + h * diff[Y_AXIS], m.start[Z_AXIS] + h * diff[Z_AXIS]);
+        NOLESS(*ik_error, fabs(delta[t] - exact));
+        NOLESS(*path_error, fabs((last[t] + exact) * 0.5 - middle));
+        last[t] = exact;
+      }
+    }
+  }
+  return segments;
+}
+
+static uint32_t delta_queued;
+
+// Take the queued segments from the planner
+static void delta_drain() {
+  while (planner.has_blocks_queued()) {
+    delta_queued++;
+    planner.discard_current_block();
+  }
+}
+
+// Within the printable radius, with every rod at least 15 degrees above horizontal
+static bool delta_benchmark_reachable(const float p[XYZ]) {
+  if (HYPOT2(p[X_AXIS], p[Y_AXIS]) > sq(DELTA_PRINTABLE_RADIUS)) return false;
+  LOOP_XYZ(t) if (delta_diagonal_rod_2_tower[t] * sq(cos(RADIANS(15))) < HYPOT2(delta_tower[t][X_AXIS] - p[X_AXIS], delta_tower[t][Y_AXIS] - p[Y_AXIS])) return false;
+  return true;
+}
+
+/**
+ * Compare DELTA_IK at every segment with the stepped kinematics (and
+ * DELTA_SEGMENT_TOLERANCE, if enabled) on random moves at 20-200mm/s.
+ */
+void benchmark_delta(const uint32_t count) {
+  DeltaMove * const moves = (DeltaMove*)malloc(count * sizeof(DeltaMove));
+  uint32_t seed = 1;
+  float p[XYZ] = { 0 };
+  for (uint32_t i = 0; i < count; i++) {
+    COPY(moves[i].start, p);
+    do { p[X_AXIS] = (benchmark_random(seed) * 2 - 1) * DELTA_PRINTABLE_RADIUS; p[Y_AXIS] = (benchmark_random(seed) * 2 - 1) * DELTA_PRINTABLE_RADIUS; }
+    while (!delta_benchmark_reachable(p));
+    p[Z_AXIS] = benchmark_random(seed) * 50;
+    COPY(moves[i].target, p);
+    moves[i].mm_s = 20 + benchmark_random(seed) * 180;
+  }
+
+  static const char * const names[] = { "DELTA_IK", "stepped", "batched" };
+  for (uint8_t k = DELTA_KIN_IK; k <= DELTA_KIN_BATCHED; k++) {
+    const DeltaKinematics kinematics = (DeltaKinematics)k;
+    float checksum = 0;
+    uint64_t segments = 0;
+    const uint64_t start = Clock::nanos();
+    for (uint32_t i = 0; i < count; i++) segments += delta_segment_move(moves[i], kinematics, &checksum);
+    const float seconds = (Clock::nanos() - start) * 1e-9;
+
+    double ik_error = 0, path_error = 0;
+    for (uint32_t i = 0; i < count; i++) delta_segment_move(moves[i], kinematics, &checksum, &ik_error, &path_error);
+
+    fprintf(stderr, "delta: %-9s %u moves, %lu segments in %.3fs, %.0f ns/segment, %.0f segments/s, max error %.4fmm (IK) %.4fmm (path)\n",
+      names[k], count, (unsigned long)segments, seconds, seconds * 1e9 / segments, segments / seconds,
+      ik_error, path_error);
+    UNUSED(checksum);
+  }
+
+  // The same moves through prepare_move_to_destination() into the planner,
+  // with the stepper ISR masked and the planner emptied from idle()
+  cli();
+  #if HAS_SOFTWARE_ENDSTOPS
+    soft_endstops_enabled = false; // Not homed
+  #endif
+  HAL_idle_hook = delta_drain;
+  COPY(current_position, moves[0].start);
+  current_position[E_AXIS] = 0;
+  SYNC_PLAN_POSITION_KINEMATIC();
+  delta_drain();
+  delta_queued = 0;
+  const uint64_t start = Clock::nanos();
+  for (uint32_t i = 0; i < count; i++) {
+    COPY(destination, moves[i].target);
+    destination[E_AXIS] = 0;
+    feedrate_mm_s = moves[i].mm_s;
+    prepare_move_to_destination();
+  }
+  segment_feed.finish();
+  const float seconds = (Clock::nanos() - start) * 1e-9;
+  delta_drain();
+  HAL_idle_hook = NULL;
+  fprintf(stderr, "delta: planner   %u moves, %u segments in %.3fs, %.0f segments/s (HOTENDS %d)\n",
+    count, delta_queued, seconds, delta_queued / seconds, HOTENDS);
+
+  #ifdef DELTA_SEGMENT_TOLERANCE
+    fprintf(stderr, "delta: DELTA_SEGMENT_TOLERANCE %.4fmm\n", float(DELTA_SEGMENT_TOLERANCE));
+  #endif
+  free(moves);
+  exit(0);
+}
+
+#endif // DELTA
+#endif // __PLAT_LINUX__
@@ -0,0 +1,99 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "benchmark.h"
+
+#if ENABLED(EEPROM_JOURNAL)
+
+#include "../../../module/configuration_store.h"
+#include "../../../module/planner.h"
+#include "../../persistent_store_journal.h"
+#include "../hardware/FlashMemory.h"
+#if ENABLED(AUTO_BED_LEVELING_UBL)
+  #include "../../../feature/bedlevel/ubl/ubl.h"
+#endif
+
+extern FlashMemory flash_memory;
+
+// Typical STM32F1 flash timings: 20ms to erase a page, 52.5us to program a half-word
+#define FLASH_ERASE_MS        20.0f
+#define FLASH_PROGRAM_MS_BYTE 0.02625f
+
+/**
+ * Save the settings COUNT times through the EEPROM journal, changing one
+ * setting each time (and one mesh point in slot 0 with UBL), and report
+ * the flash erased and programmed per save, and the time that takes on an
+ * STM32F1, against erasing and rewriting the whole settings image. Then
+ * cut the power at random points of COUNT saves, and check that each load
+ * after the reset finds either the old or the new settings.
+ */
+void benchmark_eeprom(const uint32_t count) {
+  const float steps = planner.axis_steps_per_mm[X_AXIS];
+  flash_memory.clearCounts();
+  for (uint32_t i = 0; i < count; i++) {
+    planner.axis_steps_per_mm[X_AXIS] = steps + (i + 1) * 0.01f;
+    settings.save();
+    #if ENABLED(AUTO_BED_LEVELING_UBL)
+      if (settings.calc_num_meshes()) {
+        ubl.z_values[i % GRID_MAX_POINTS_X][(i / GRID_MAX_POINTS_X) % GRID_MAX_POINTS_Y] += 0.01f;
+        settings.store_mesh(0);
+      }
+    #endif
+  }
+  const float erases = flash_memory.erases[0] + flash_memory.erases[1],
+              programmed = flash_memory.bytes_programmed,
+              flash_ms = (erases * FLASH_ERASE_MS + programmed * FLASH_PROGRAM_MS_BYTE) / count,
+              image_ms = 2 * FLASH_ERASE_MS + settings.datasize() * FLASH_PROGRAM_MS_BYTE;
+  fprintf(stderr, "eeprom: %u saves, %.0f bytes programmed and %.3f erases per save (banks %u/%u), %.2fms of STM32F1 flash time per save\n",
+    count, programmed / count, erases / count, flash_memory.erases[0], flash_memory.erases[1], flash_ms);
+  fprintf(stderr, "eeprom: whole image, %u bytes programmed and 2 erases per save, %.2fms\n", settings.datasize(), image_ms);
+
+  uint32_t seed = 1, interrupted = 0, found_old = 0, found_new = 0, lost = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    const float before = planner.axis_steps_per_mm[X_AXIS], after = before + 0.01f;
+    planner.axis_steps_per_mm[X_AXIS] = after;
+    // Mostly within the few records of a save, sometimes into a compaction
+    seed = seed * 1103515245UL + 12345;
+    flash_memory.cutPowerAfter((seed >> 8) % (i & 3 ? 48 : 2048));
+    settings.save();
+    if (flash_memory.powerLost()) interrupted++;
+    flash_memory.restorePower();
+    HAL::PersistentStore::journal_unmount();
+    settings.load();
+    const float loaded = planner.axis_steps_per_mm[X_AXIS];
+    if (loaded == after) found_new++;
+    else if (loaded == before) found_old++;
+    else {
+      lost++;
+      planner.axis_steps_per_mm[X_AXIS] = after;
+      settings.save();
+    }
+  }
+  fprintf(stderr, "eeprom: %u saves with power cuts (%u interrupted), loaded %u new, %u old, %u lost\n",
+    count, interrupted, found_new, found_old, lost);
+  exit(0);
+}
+
+#endif // EEPROM_JOURNAL
+#endif // __PLAT_LINUX__
@@ -0,0 +1,158 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "benchmark.h"
+
+#include "../../../gcode/gcode.h"
+#include "../../../gcode/queue.h"
+
+/**
+ * Measure how fast commands get from the serial port through the command
+ * queue and the parser, for G-code as sent by a host: text lines with line
+ * numbers and checksums, or binary frames. Moves are not run, but G0/G1
+ * parameters are fetched into the destination as the G1 handler does.
+ */
+void benchmark_gcode(const char * const filename) {
+  FILE * const file = fopen(filename, "rb");
+  if (!file) {
+    fprintf(stderr, "gcode: unable to open %s\n", filename);
+    exit(1);
+  }
+  fseek(file, 0, SEEK_END);
+  const size_t size = ftell(file);
+  uint8_t * const data = (uint8_t*)malloc(size);
+  fseek(file, 0, SEEK_SET);
+  if (fread(data, 1, size, file) != size) exit(1);
+  fclose(file);
+
+  uint32_t commands = 0, tokenized = 0;
+  size_t pos = 0;
+  const uint64_t start = Clock::nanos();
+  while (pos < size || usb_serial.available() || commands_in_queue) {
+    while (pos < size && usb_serial.receive_buffer.write(data[pos])) pos++;
+    get_available_commands();
+    for (; commands_in_queue; commands++) {
+      char * const command = command_queue[cmd_queue_index_r];
+      #if ENABLED(BINARY_GCODE_TRANSPORT)
+        if (command_queue_binary[cmd_queue_index_r]) {
+          parser.parse_binary((uint8_t*)command);
+          command_queue_binary[cmd_queue_index_r] = false;
+        }
+        else
+      #endif
+      #if ENABLED(SERIAL_LINE_TOKENS)
+        if (command_queue_tokens[cmd_queue_index_r].letter) {
+          parser.parse_tokens(command, command_queue_tokens[cmd_queue_index_r]);
+          command_queue_tokens[cmd_queue_index_r].letter = 0;
+          tokenized++;
+        }
+        else
+      #endif
+          parser.parse(command);
+      if (parser.command_letter == 'G' && parser.codenum <= 1) gcode.get_destination_from_command();
+      ok_to_send();
+      commands_in_queue--;
+      if (++cmd_queue_index_r >= BUFSIZE) cmd_queue_index_r = 0;
+    }
+  }
+  const float seconds = (Clock::nanos() - start) * 1e-9;
+  fprintf(stderr, "gcode: %u commands, %u bytes in %.3fs, %.0f commands/s, last line %ld, %u tokenized on input\n",
+    commands, (unsigned)size, seconds, commands / seconds, gcode_LastN, tokenized);
+  free(data);
+  exit(0);
+}
+
+/**
+ * Measure how fast parsed commands are matched to their handlers, for the
+ * commands in a G-code file. Each pass parses every line and looks up its
+ * handler, then looks up the same codes again without parsing. Handlers
+ * are not run.
+ */
+void benchmark_dispatch(const char * const filename) {
+  FILE * const file = fopen(filename, "r");
+  if (!file) {
+    fprintf(stderr, "dispatch: unable to open %s\n", filename);
+    exit(1);
+  }
+  struct Code { char letter; int codenum; uint8_t subcode; };
+  char line[MAX_CMD_SIZE + 1];
+  char (*lines)[MAX_CMD_SIZE] = NULL;
+  Code *codes = NULL;
+  uint32_t count = 0, unknown = 0;
+  while (fgets(line, sizeof(line), file)) {
+    char * const comment = strchr(line, ';');
+    if (comment) *comment = '\0';
+    size_t len = strlen(line);
+    while (len && (line[len - 1] == '\n' || line[len - 1] == '\r' || line[len - 1] == ' ')) line[--len] = '\0';
+    if (!len || len >= MAX_CMD_SIZE) continue;
+    lines = (char(*)[MAX_CMD_SIZE])realloc(lines, (count + 1) * MAX_CMD_SIZE);
+    codes = (Code*)realloc(codes, (count + 1) * sizeof(Code));
+    strcpy(lines[count], line);
+    parser.parse(line);
+    codes[count].letter = parser.command_letter;
+    codes[count].codenum = parser.codenum;
+    #if USE_GCODE_SUBCODES
+      codes[count].subcode = parser.subcode;
+    #endif
+    if (parser.command_letter != 'T' && !gcode.find_handler()) unknown++;
+    count++;
+  }
+  fclose(file);
+  if (!count) {
+    fprintf(stderr, "dispatch: no commands in %s\n", filename);
+    exit(1);
+  }
+
+  // Repeat the file for about a million commands
+  const uint32_t passes = max(1U, 1000000U / count);
+  uint64_t start = Clock::nanos();
+  for (uint32_t p = 0; p < passes; p++)
+    for (uint32_t i = 0; i < count; i++) {
+      strcpy(line, lines[i]);
+      parser.parse(line);
+      gcode.find_handler();
+    }
+  const float parse_seconds = (Clock::nanos() - start) * 1e-9;
+
+  start = Clock::nanos();
+  for (uint32_t p = 0; p < passes; p++)
+    for (uint32_t i = 0; i < count; i++) {
+      parser.command_letter = codes[i].letter;
+      parser.codenum = codes[i].codenum;
+      #if USE_GCODE_SUBCODES
+        parser.subcode = codes[i].subcode;
+      #endif
+      gcode.find_handler();
+    }
+  const float lookup_seconds = (Clock::nanos() - start) * 1e-9;
+
+  const float total = float(count) * passes;
+  fprintf(stderr, "dispatch: %u commands (%u without a handler) x %u, parse and dispatch %.0f commands/s, dispatch %.0f commands/s\n",
+    count, unknown, passes, total / parse_seconds, total / lookup_seconds);
+  free(lines);
+  free(codes);
+  exit(0);
+}
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,134 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "benchmark.h"
+
+#if ENABLED(PIDTEMP)
+
+#include "../../../module/planner.h"
+#include "../../../module/temperature.h"
+
+/**
+ * Hold the simulated hotend at 210C through COUNT random stretches of
+ * printing and travel, in simulated time, with the hotend controller as
+ * configured: PID, or MPCTEMP with and without the extrusion feed-forward.
+ * Moves go through the planner and are used up at their nominal speed,
+ * and the controller runs every PID_dT. Reports how far the sensor
+ * temperature sagged below and rose above the target while printing.
+ */
+void benchmark_hotend(const uint32_t count) {
+  cli();
+  #if ENABLED(PREVENT_COLD_EXTRUSION)
+    thermalManager.allow_cold_extrude = true;
+  #endif
+  const float target = 210, dt = PID_dT,
+              filament_area = M_PI * sq(1.75) * 0.25; // As simulated_hotend()
+  #if ENABLED(MPCTEMP)
+    const char * const names[] = { "MPC", "MPC without feed-forward" };
+    const float filament_heat = thermalManager.mpc[0].filament_heat_capacity;
+  #else
+    const char * const names[] = { "PID" };
+  #endif
+
+  for (uint8_t pass = 0; pass < COUNT(names); pass++) {
+    #if ENABLED(MPCTEMP)
+      thermalManager.mpc[0].filament_heat_capacity = pass ? 0 : filament_heat;
+    #endif
+    thermalManager.updatePID();
+    thermalManager.target_temperature[0] = target;
+    Heater hotend = simulated_hotend(-1, -1);
+    planner.set_position_mm(0, 0, 0, 0);
+
+    uint32_t seed = 1;
+
+    float block_left = 0, e_rate = 0,   // Of the block being used up
+          x = 0, e = 0,                 // The end of the last move queued
+          phase_left = 0, flow = 0,     // Of the stretch being queued
+          seconds = 0, reached = 0, printing = 0,
+          lowest = target, highest = target, heatup_highest = 0, square_sum = 0;
+    uint32_t stretches = 0, samples = 0;
+
+    for (;;) {
+      // A minute after reaching the target, queue the moves: 20mm at
+      // 80mm/s extruding 4-24mm3/s for 5-20s, then 2-8s of travel
+      const bool started = reached && seconds > reached + 60;
+      if (started) {
+        while (!planner.is_full() && (phase_left > 0 || stretches < count * 2)) {
+          if (phase_left <= 0) {
+            const bool print = !(stretches & 1);
+            flow = print ? 4 + benchmark_random(seed) * 20 : 0;
+            phase_left = print ? 5 + benchmark_random(seed) * 15 : 2 + benchmark_random(seed) * 6;
+            stretches++;
+          }
+          const float fr_mm_s = flow ? 80 : 150, length = 20;
+          x = x ? 0 : length;
+          e += flow * length / fr_mm_s / filament_area;
+          planner.buffer_line(x, 0, 0, e, fr_mm_s, 0);
+          phase_left -= length / fr_mm_s;
+        }
+        if (!planner.has_blocks_queued()) break;
+      }
+
+      // Use up the queued moves for one cycle
+      float extruded = 0;
+      for (float left = dt; left > 0 && planner.has_blocks_queued();) {
+        const block_t &block = planner.block_buffer[planner.block_buffer_tail];
+        if (block_left <= 0) {
+          block_left = block.millimeters / block.nominal_speed;
+          e_rate = TEST(block.direction_bits, E_AXIS) ? 0 : block.steps[E_AXIS] * planner.steps_to_mm[E_AXIS] / block_left;
+        }
+        const float used = min(left, block_left);
+        extruded += e_rate * used;
+        block_left -= used;
+        left -= used;
+        if (block_left <= 0) planner.discard_current_block();
+      }
+
+      thermalManager.current_temperature[0] = hotend.sensed;
+      const uint8_t amount = (int)thermalManager.get_pid_output(0) >> 1;
+      hotend.step(dt, amount / 128.0f, extruded);
+      seconds += dt;
+
+      if (!started) {
+        NOLESS(heatup_highest, hotend.sensed);
+        if (!reached && hotend.sensed >= target - 0.5f) reached = seconds;
+      }
+      else {
+        NOMORE(lowest, hotend.sensed);
+        NOLESS(highest, hotend.sensed);
+        square_sum += sq(hotend.sensed - target);
+        samples++;
+        if (extruded) printing += dt;
+      }
+    }
+
+    fprintf(stderr, "hotend: %s: %u stretches, %.0fs printing, sag %.2fC, rise %.2fC, rms %.2fC, heat-up %.0fs, overshoot %.2fC\n",
+      names[pass], count, printing, target - lowest, highest - target, samples ? SQRT(square_sum / samples) : 0,
+      reached, heatup_highest - target);
+  }
+  exit(0);
+}
+
+#endif // PIDTEMP
+#endif // __PLAT_LINUX__
@@ -0,0 +1,148 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "benchmark.h"
+
+#if HAS_JUNCTION_BENCHMARK
+
+#include "../../../module/planner.h"
+#include "../../../module/temperature.h"
+
+static float junction_exit[XYZ], junction_seconds, junction_max_jump[XYZ], junction_jump_sum;
+static uint32_t junction_blocks;
+
+// The trapezoid of each block as the stepper would run it, and the velocity jump at its entry
+static void junction_take_block() {
+  const block_t &block = planner.block_buffer[planner.block_buffer_tail];
+  const float mm_per_step = block.millimeters / block.step_event_count,
+              v_in = block.initial_rate * mm_per_step, v_out = block.final_rate * mm_per_step,
+              accel = block.acceleration;
+  float v_peak = SQRT((2 * accel * block.millimeters + sq(v_in) + sq(v_out)) * 0.5);
+  NOMORE(v_peak, block.nominal_speed);
+  const float ramps = (sq(v_peak) - sq(v_in) + sq(v_peak) - sq(v_out)) / (2 * accel);
+  junction_seconds += (v_peak - v_in + v_peak - v_out) / accel + max(block.millimeters - ramps, 0.0f) / v_peak;
+
+  float jump = 0;
+  LOOP_XYZ(a) {
+    const float unit = (TEST(block.direction_bits, a) ? -1.0f : 1.0f) * block.steps[a] * planner.steps_to_mm[a] / block.millimeters,
+                a_jump = FABS(v_in * unit - junction_exit[a]);
+    NOLESS(junction_max_jump[a], a_jump);
+    NOLESS(jump, a_jump);
+    junction_exit[a] = v_out * unit;
+  }
+  junction_jump_sum += jump;
+  junction_blocks++;
+  planner.discard_current_block();
+}
+
+/**
+ * Plan random toolpaths, curves cut into short chords and zigzags of long
+ * moves with sharp corners, and report the print time of the planned
+ * trapezoids and the largest speed change of an axis at a junction (the
+ * acceleration the steppers can't ramp). With JUNCTION_DEVIATION this runs
+ * at several deviations; compare with a build without it for the jerk
+ * model. The stepper ISR is masked and the oldest block is taken whenever
+ * the buffer is full, as the stepper would. The paths extrude with the
+ * hotend cold, so cold extrusion is allowed while they're planned.
+ */
+void benchmark_junction(const uint32_t count) {
+  cli();
+  #if ENABLED(PREVENT_COLD_EXTRUSION)
+    const bool allow_cold_extrude = thermalManager.allow_cold_extrude;
+    thermalManager.allow_cold_extrude = true;
+  #endif
+  #if ENABLED(JUNCTION_DEVIATION)
+    const float deviations[] = { 0.01, planner.junction_deviation_mm, 0.05 };
+  #else
+    const float deviations[] = { 0 };
+  #endif
+  const float center[] = { (X_MIN_POS + X_MAX_POS) * 0.5, (Y_MIN_POS + Y_MAX_POS) * 0.5 },
+              reach = min(X_MAX_POS - X_MIN_POS, Y_MAX_POS - Y_MIN_POS) * 0.4;
+
+  for (uint8_t pass = 0; pass < COUNT(deviations); pass++) {
+    #if ENABLED(JUNCTION_DEVIATION)
+      planner.junction_deviation_mm = deviations[pass];
+    #endif
+    uint32_t seed = 1;
+    ZERO(junction_exit);
+    ZERO(junction_max_jump);
+    junction_seconds = junction_jump_sum = 0;
+    junction_blocks = 0;
+    float p[XYZE] = { center[X_AXIS], center[Y_AXIS], 0, 0 };
+    planner.set_position_mm(p[X_AXIS], p[Y_AXIS], p[Z_AXIS], p[E_AXIS]);
+    float length = 0;
+    const uint64_t begin = Clock::nanos();
+    for (uint32_t i = 0; i < count; i++) {
+      const float fr_mm_s = min(20 + benchmark_random(seed) * 130, PLANNER_XY_FEEDRATE());
+      const bool curve = benchmark_random(seed) < 0.5;
+      // A curve of radius 2-40mm in 0.2-2mm chords, or 5-20 moves of 1-30mm
+      const float radius = 2 + benchmark_random(seed) * 38, chord = 0.2 + benchmark_random(seed) * 1.8;
+      const uint16_t moves = curve ? radius * RADIANS(90 + benchmark_random(seed) * 270) / chord : 5 + benchmark_random(seed) * 15;
+      float heading = benchmark_random(seed) * RADIANS(360);
+      for (uint16_t m = 0; m < moves; m++) {
+        const float step = curve ? chord : 1 + benchmark_random(seed) * 29;
+        if (curve)
+          heading += chord / radius;
+        else {
+          const float turn = RADIANS(30 + benchmark_random(seed) * 150);
+          heading += benchmark_random(seed) < 0.5 ? -turn : turn;
+        }
+        float dx = step * cos(heading), dy = step * sin(heading);
+        // Turn back toward the center at the edge of the bed
+        if (HYPOT(p[X_AXIS] + dx - center[X_AXIS], p[Y_AXIS] + dy - center[Y_AXIS]) > reach) {
+          heading = atan2(center[Y_AXIS] - p[Y_AXIS], center[X_AXIS] - p[X_AXIS]);
+          dx = step * cos(heading);
+          dy = step * sin(heading);
+        }
+        p[X_AXIS] += dx;
+        p[Y_AXIS] += dy;
+        p[E_AXIS] += step * 0.05;
+        length += step;
+        while (planner.is_full()) junction_take_block();
+        planner.buffer_line(p[X_AXIS], p[Y_AXIS], p[Z_AXIS], p[E_AXIS], fr_mm_s, 0);
+      }
+    }
+    while (planner.has_blocks_queued()) junction_take_block();
+    const float host = (Clock::nanos() - begin) * 1e-9;
+
+    #if ENABLED(JUNCTION_DEVIATION)
+      fprintf(stderr, "junction: JUNCTION_DEVIATION %.3fmm:", planner.junction_deviation_mm);
+    #else
+      fprintf(stderr, "junction: jerk X%.1f Y%.1f mm/s:", planner.max_jerk[X_AXIS], planner.max_jerk[Y_AXIS]);
+    #endif
+    fprintf(stderr, " %u paths, %u blocks, %.0fmm, print time %.1fs, mean %.1fmm/s, max junction jump X%.1f Y%.1f mm/s, mean %.2fmm/s, %.0f ns/block\n",
+      count, junction_blocks, length, junction_seconds, length / junction_seconds,
+      junction_max_jump[X_AXIS], junction_max_jump[Y_AXIS], junction_jump_sum / junction_blocks, host * 1e9 / junction_blocks);
+  }
+  #if ENABLED(JUNCTION_DEVIATION)
+    planner.junction_deviation_mm = deviations[1];
+  #endif
+  #if ENABLED(PREVENT_COLD_EXTRUSION)
+    thermalManager.allow_cold_extrude = allow_cold_extrude;
+  #endif
+  exit(0);
+}
+
+#endif // HAS_JUNCTION_BENCHMARK
+#endif // __PLAT_LINUX__
@@ -0,0 +1,128 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "benchmark.h"
+
+#if ENABLED(DOGLCD)
+
+#include "../../../Marlin.h"
+#include "../../../lcd/ultralcd.h"
+#include "../../../module/motion.h"
+#include "../../../module/printcounter.h"
+#include "../../../module/temperature.h"
+#include "../hardware/ST7920.h"
+
+extern ST7920 lcd_st7920;
+extern bool drawing_screen;
+extern millis_t next_lcd_update_ms;
+#if ENABLED(DOGM_DIRTY_STRIPES)
+  extern bool lcd_frame_retained;
+#endif
+
+// Draw a whole frame of the current screen now
+static void lcd_draw_frame() {
+  lcdDrawUpdate = LCDVIEW_REDRAW_NOW;
+  next_lcd_update_ms = millis();
+  do lcd_update(); while (drawing_screen);
+}
+
+// Run the firmware for a time on the Info Screen and report the bytes the display was sent
+static void lcd_run(const char * const name, const uint32_t seconds, const bool moving) {
+  uint32_t seed = 1;
+  lcd_st7920.clearCounts();
+  const uint64_t start = Clock::nanos(), end = start + seconds * 1000000000ULL;
+  for (uint64_t next_move = start; Clock::nanos() < end;) {
+    if (moving && Clock::nanos() >= next_move) {
+      // A new position every 100ms, and a layer change every 10s
+      next_move += 100000000ULL;
+      seed = seed * 1103515245UL + 12345;
+      current_position[X_AXIS] = 20 + ((seed >> 8) % 16000) * 0.01f;
+      current_position[Y_AXIS] = 20 + ((seed >> 16) % 16000) * 0.01f;
+      if (!((next_move - start) % 10000000000ULL)) current_position[Z_AXIS] += 0.2f;
+    }
+    idle();
+    Clock::delayNanos(1000000);
+  }
+  const uint32_t frame = ST7920::height * (4 + ST7920::width / 8); // Extended mode, address, one row of data
+  fprintf(stderr, "lcd: %s, %u bytes/s (%u commands, %u data), %.1f full frames/s\n",
+    name, lcd_st7920.bytes() / seconds, lcd_st7920.commands / seconds, lcd_st7920.data_bytes / seconds,
+    (float)lcd_st7920.bytes() / seconds / frame);
+}
+
+/**
+ * Show the Info Screen on the simulated ST7920 for SECONDS while printing,
+ * with the hotend and bed heating, the fan running, the print job timer
+ * counting and the head moving, then for SECONDS with the printer idle,
+ * and report the bytes the display was sent per second in each. Then, at
+ * each blink for SECONDS, draw a frame and compare the display with a
+ * full redraw of the same values.
+ */
+void benchmark_lcd(const uint32_t seconds) {
+  lcd_draw_frame();
+
+  thermalManager.setTargetHotend(200, 0);
+  #if HAS_HEATED_BED
+    thermalManager.setTargetBed(60);
+  #endif
+  #if FAN_COUNT > 0
+    fanSpeeds[0] = 128;
+  #endif
+  print_job_timer.start();
+  lcd_run("printing", seconds, true);
+
+  print_job_timer.stop();
+  thermalManager.setTargetHotend(0, 0);
+  #if HAS_HEATED_BED
+    thermalManager.setTargetBed(0);
+  #endif
+  #if FAN_COUNT > 0
+    fanSpeeds[0] = 0;
+  #endif
+  lcd_run("idle", seconds, false);
+
+  print_job_timer.start();
+  uint32_t checks = 0, differing = 0;
+  for (bool blink = lcd_blink(); checks < seconds;) {
+    idle();
+    if (lcd_blink() == blink || drawing_screen) continue;
+    blink = !blink;
+    current_position[X_AXIS] += 1.0f;
+    current_position[Z_AXIS] += 0.2f;
+    lcd_draw_frame();
+    uint8_t shown[ST7920::height][ST7920::width / 8];
+    for (uint8_t y = 0; y < ST7920::height; y++) memcpy(shown[y], lcd_st7920.row(y), sizeof(shown[y]));
+    #if ENABLED(DOGM_DIRTY_STRIPES)
+      lcd_frame_retained = false;
+    #endif
+    lcd_draw_frame();
+    for (uint8_t y = 0; y < ST7920::height; y++) if (memcmp(shown[y], lcd_st7920.row(y), sizeof(shown[y]))) differing++;
+    checks++;
+  }
+  print_job_timer.stop();
+  fprintf(stderr, "lcd: %u frames compared with a full redraw, %u rows differ\n", checks, differing);
+  exit(0);
+}
+
+#endif // DOGLCD
+#endif // __PLAT_LINUX__
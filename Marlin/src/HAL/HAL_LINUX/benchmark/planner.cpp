@@ -0,0 +1,50 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "benchmark.h"
+
+#include "../../../module/planner.h"
+
+/**
+ * Measure how fast the planner accepts blocks. Short segments with changing
+ * directions are buffered with the stepper ISR masked, and the oldest block
+ * is released whenever the buffer is full, so the buffer stays full and only
+ * planning is timed.
+ */
+void benchmark_planner(const uint32_t count) {
+  cli();
+  const float center = (X_MIN_POS + X_MAX_POS) * 0.5, radius = 10.0;
+  const uint64_t start = Clock::nanos();
+  for (uint32_t i = 0; i < count; i++) {
+    while (planner.is_full()) planner.discard_current_block();
+    const float a = i * 0.05, r = radius + (i & 1) * 0.2;
+    planner.buffer_line(center + r * cos(a), center + r * sin(a), 0, 0, MMM_TO_MMS(6000), 0);
+  }
+  const float seconds = (Clock::nanos() - start) * 1e-9;
+  fprintf(stderr, "planner: BLOCK_BUFFER_SIZE %d, %u blocks in %.3fs, %.0f blocks/s\n",
+    BLOCK_BUFFER_SIZE, count, seconds, count / seconds);
+  exit(0);
+}
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,171 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "benchmark.h"
+
+#if ENABLED(SDSUPPORT)
+
+#include "../../../sd/cardreader.h"
+#include "../hardware/SDCard.h"
+#if ENABLED(POWER_LOSS_RECOVERY)
+  #include "../../../Marlin.h"
+  #include "../../../feature/power_loss_recovery.h"
+  #include "../../../gcode/parser.h"
+  #include "../../../module/motion.h"
+  #include "../../../module/temperature.h"
+#endif
+
+extern SDCard sd_card;
+
+/**
+ * Measure how fast commands are read from a file on the SD card image,
+ * the way they're fetched while printing, and count the commands the
+ * card receives. The checksum covers the command text, so runs can be
+ * compared for correctness.
+ */
+void benchmark_sd(char * const filename) {
+  if (!card.cardOK) card.initsd();
+  card.openFile(filename, true);
+  if (!card.isFileOpen()) {
+    fprintf(stderr, "sd: unable to open %s\n", filename);
+    exit(1);
+  }
+  char command[MAX_CMD_SIZE];
+  uint32_t commands = 0, checksum = 2166136261UL;
+  uint8_t len;
+  sd_card.clearCounts();
+  const uint64_t start = Clock::nanos();
+  for (;;) {
+    const int16_t term = card.getCommand(command, len);
+    if (len) commands++;
+    for (uint8_t i = 0; i < len; i++) checksum = (checksum ^ (uint8_t)command[i]) * 16777619UL;
+    if (term == -2) { fprintf(stderr, "sd: read error\n"); exit(1); }
+    if (term == -1) break;
+  }
+  const float seconds = (Clock::nanos() - start) * 1e-9;
+  const uint32_t bytes = card.getIndex();
+  fprintf(stderr, "sd: %u commands, %u bytes in %.3fs, %.0f commands/s, %.0f KB/s, checksum %08x\n",
+    commands, bytes, seconds, commands / seconds, bytes / seconds / 1024, checksum);
+
+  // CMD17 READ_SINGLE_BLOCK, CMD18 READ_MULTIPLE_BLOCK, CMD12 STOP_TRANSMISSION
+  const uint32_t block_commands = sd_card.commands[17] + sd_card.commands[18] + sd_card.commands[12];
+  fprintf(stderr, "sd: %u blocks read with %u commands (CMD17 %u, CMD18 %u, CMD12 %u), %.1f commands/MB\n",
+    sd_card.blocks_read, block_commands, sd_card.commands[17], sd_card.commands[18], sd_card.commands[12],
+    block_commands / (bytes / 1048576.0f));
+  exit(0);
+}
+
+#if ENABLED(POWER_LOSS_RECOVERY)
+
+  /**
+   * Journal the commands of a file on the SD card image as a print would,
+   * following only the axis words of G0, G1 and G92 and the targets of
+   * M104/M109 and M106/M107, and count the blocks written to the card.
+   * At random commands, cut the power: recover from the journal, check that
+   * the print resumes from the last command written to the card, with its
+   * position, and go on from there.
+   */
+  void benchmark_recovery(char * const filename) {
+    if (!card.cardOK) card.initsd();
+    card.openFile(filename, true);
+    if (!card.isFileOpen()) {
+      fprintf(stderr, "recovery: unable to open %s\n", filename);
+      exit(1);
+    }
+    card.startFileprint();
+    start_job_recovery();
+
+    char command[MAX_CMD_SIZE];
+    uint8_t len;
+    uint32_t commands = 0, writes = 0, since_write = 0, max_since_write = 0, cuts = 0, lost = 0, wrong = 0, seed = 1;
+    uint64_t lost_total = 0;
+    uint32_t written_sdpos = 0;
+    float written_position[XYZE] = { 0 };
+    ZERO(current_position);
+    sd_card.clearCounts();
+    for (;;) {
+      const int16_t term = card.getCommand(command, len);
+      if (term == -2) { fprintf(stderr, "recovery: read error\n"); exit(1); }
+      if (len) {
+        commands++;
+        parser.parse(command);
+        if (parser.command_letter == 'G' && (parser.codenum <= 1 || parser.codenum == 92)) {
+          LOOP_XYZE(i) if (parser.seenval(axis_codes[i])) current_position[i] = parser.value_float();
+          if (parser.seenval('F')) feedrate_mm_s = parser.value_float() / 60;
+        }
+        else if (parser.command_letter == 'M' && (parser.codenum == 104 || parser.codenum == 109) && parser.seenval('S'))
+          thermalManager.target_temperature[0] = parser.value_int();
+        else if (parser.command_letter == 'M' && parser.codenum == 106)
+          fanSpeeds[0] = parser.intval('S', 255);
+        else if (parser.command_letter == 'M' && parser.codenum == 107)
+          fanSpeeds[0] = 0;
+
+        save_job_recovery_info(card.getIndex());
+
+        // CMD24 WRITE_BLOCK
+        if (sd_card.commands[24] != writes) {
+          writes = sd_card.commands[24];
+          written_sdpos = card.getIndex();
+          COPY(written_position, current_position);
+          since_write = 0;
+        }
+        else {
+          since_write++;
+          NOLESS(max_since_write, since_write);
+        }
+
+        seed = seed * 1103515245UL + 12345;
+        if ((seed >> 8) % 1000 == 0) {
+          // The entries not written are lost, so resume from the last written
+          cuts++;
+          lost_total += since_write;
+          do_print_job_recovery();
+          if (!job_recovery_info.valid) { lost++; break; }
+          if (job_recovery_info.entry.sdpos != written_sdpos || memcmp(job_recovery_info.entry.current_position, written_position, sizeof(written_position)))
+            wrong++;
+          COPY(current_position, job_recovery_info.entry.current_position);
+          card.startFileprint();
+          since_write = 0;
+          writes = sd_card.commands[24];
+        }
+      }
+      if (term == -1) break;
+    }
+
+    fprintf(stderr, "recovery: %u commands, %u blocks written, %.1f commands per block, at most %u commands not written\n",
+      commands, sd_card.commands[24], (float)commands / sd_card.commands[24], max_since_write);
+    fprintf(stderr, "recovery: %u power cuts, %.1f commands to print again per cut, %u resumed elsewhere, %u not recovered\n",
+      cuts, cuts ? (float)lost_total / cuts : 0.0f, wrong, lost);
+
+    // A finished print leaves nothing to recover
+    card.printingHasFinished();
+    do_print_job_recovery();
+    fprintf(stderr, "recovery: %s after the print finished\n", job_recovery_info.valid ? "FOUND A JOB" : "nothing to recover");
+    exit(0);
+  }
+
+#endif // POWER_LOSS_RECOVERY
+
+#endif // SDSUPPORT
+#endif // __PLAT_LINUX__
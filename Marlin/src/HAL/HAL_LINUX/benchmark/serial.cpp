@@ -0,0 +1,115 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "benchmark.h"
+
+#include "../../../module/motion.h"
+#include "../../../module/temperature.h"
+#include "../../../module/configuration_store.h"
+
+static float serial_values[100];
+
+static void print_round() {
+  for (uint8_t i = 0; i < COUNT(serial_values); i++) { MYSERIAL0.print(serial_values[i], 2); SERIAL_CHAR(' '); }
+}
+
+static void fixed_round() {
+  for (uint8_t i = 0; i < COUNT(serial_values); i++) { serialprint_fixed(serial_values[i], 2); SERIAL_CHAR(' '); }
+}
+
+static void report_round() {
+  report_current_position();
+  #if DISABLED(DISABLE_M503)
+    settings.report();
+  #endif
+}
+
+// The bytes/s of COUNT rounds, timed with no host attached and counted with one
+static float serial_rate(void (*round)(), const uint32_t count) {
+  usb_serial.host_connected = false;
+  const uint64_t start = Clock::nanos();
+  for (uint32_t n = 0; n < count; n++) round();
+  const float seconds = (Clock::nanos() - start) * 1e-9;
+
+  usb_serial.host_connected = true;
+  const uint64_t received = host_received;
+  round();
+  usb_serial.flushTX();
+  Clock::delayNanos(10000000);  // For the serial thread to count the last bytes it took
+  return (host_received - received) * count / seconds;
+}
+
+/**
+ * Format COUNT rounds of 100 random floats with print() and with
+ * serialprint_fixed(), then COUNT rounds of the M114 and M503 reports, with
+ * no host attached so only the formatting is timed. Reports the bytes per
+ * second formatted, counting the bytes of one more round as the host gets
+ * them. Then, with a host reading at BAUDRATE and the TX buffer kept full by
+ * M503 reports, asks for temperature auto-reports every second for COUNT
+ * seconds, and reports how many went out and the longest time the main loop
+ * spent sending one.
+ */
+void benchmark_serial(const uint32_t count) {
+  uint32_t seed = 1;
+  for (uint8_t i = 0; i < COUNT(serial_values); i++) serial_values[i] = (benchmark_random(seed) * 2 - 1) * 500;
+
+  const float print_rate = serial_rate(print_round, count),
+              fixed_rate = serial_rate(fixed_round, count),
+              report_rate = serial_rate(report_round, count);
+  fprintf(stderr, "serial: print(float) %.0f bytes/s, serialprint_fixed %.0f bytes/s, reports %.0f bytes/s\n",
+    print_rate, fixed_rate, report_rate);
+
+  #if ENABLED(AUTO_REPORT_TEMPERATURES)
+    usb_serial.host_connected = true;
+    host_rate = BAUDRATE / 10;
+    thermalManager.set_auto_report_interval(1);
+    const uint64_t end = Clock::nanos() + count * 1000000000ULL;
+    uint32_t sent = 0;
+    uint64_t longest = 0;
+    while (Clock::nanos() < end) {
+      // Keep the TX buffer backed up, as after a long report
+      while (usb_serial.transmit_buffer.free() > 256) {
+        #if DISABLED(DISABLE_M503)
+          settings.report();
+        #else
+          report_current_position();
+        #endif
+      }
+      // A report that went out schedules the next one
+      const millis_t next_report_ms = thermalManager.next_temp_report_ms;
+      const uint64_t start = Clock::nanos();
+      thermalManager.auto_report_temperatures();
+      if (thermalManager.next_temp_report_ms != next_report_ms) {
+        sent++;
+        NOLESS(longest, Clock::nanos() - start);
+      }
+    }
+    fprintf(stderr, "serial: auto-reports at %u baud with the TX buffer full, %u sent in %u seconds, longest %.2fms\n",
+      BAUDRATE, sent, count, longest * 1e-6);
+  #endif
+
+  exit(0);
+}
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,214 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "benchmark.h"
+
+#include "../../../module/planner.h"
+#include "../../../module/motion.h"
+#include "../../../module/stepper.h"
+#include "../../../module/endstops.h"
+#include "../../../module/temperature.h"
+
+// The axis with a step at every step event of a block
+static uint8_t lead_axis(const block_t &block) {
+  uint8_t lead = 0;
+  LOOP_XYZE(a) if (block.steps[a] > block.steps[lead]) lead = a;
+  return lead;
+}
+
+/**
+ * Run the stepper ISR by hand on random moves and check the step timeline
+ * it emits against the planned blocks. Every block must get all its steps
+ * on every axis, and the step rate over each ISR interval must stay within
+ * 5% of the block's trapezoid in time: rising from the initial rate at the
+ * acceleration up to the nominal rate, and falling from the rate reached to
+ * the final rate, by the step events the block planned for each. With
+ * BEZIER_JERK_CONTROL the rate only has to stay between the ends of each
+ * ramp. A slow last ISR of a block that steps fewer events than the one
+ * before it is a short last burst, counted apart. With the interrupt off
+ * HAL_timer_restrain leaves the intervals as the ISR set them, so the host's
+ * speed doesn't change the timeline; the ISRs that took the host longer
+ * than their interval are only counted.
+ *
+ * Moves run once with the configured steps/mm and once with 16 times as many
+ * on X and Y (256 instead of 16 microsteps). The planner buffer is filled,
+ * its blocks are copied, and the ISR runs until they're all done; the ISR's
+ * timer intervals are the timeline. Exits with 1 if any check fails.
+ */
+void benchmark_stepper(const uint32_t count) {
+  cli();
+  endstops.enable(false);
+  #if ENABLED(PREVENT_COLD_EXTRUSION)
+    thermalManager.allow_cold_extrude = true;
+  #endif
+  const float center[] = { (X_MIN_POS + X_MAX_POS) * 0.5, (Y_MIN_POS + Y_MAX_POS) * 0.5 },
+              range[] = { (X_MAX_POS - X_MIN_POS) * 0.4, (Y_MAX_POS - Y_MIN_POS) * 0.4 };
+
+  bool failed = false;
+  for (uint8_t pass = 0; pass < 2; pass++) {
+    if (pass) {
+      planner.axis_steps_per_mm[X_AXIS] *= 16;
+      planner.axis_steps_per_mm[Y_AXIS] *= 16;
+      planner.refresh_positioning();
+    }
+    planner.set_position_mm(center[X_AXIS], center[Y_AXIS], 0, 0);
+    current_position[X_AXIS] = center[X_AXIS];
+    current_position[Y_AXIS] = center[Y_AXIS];
+
+    uint32_t seed = 1;
+    uint64_t isrs = 0, events = 0, isr_ns = 0, ticks = 0;
+    uint32_t blocks = 0, bad_blocks = 0, checked = 0, off_rate = 0, short_bursts = 0, overrun = 0;
+    float max_rate = 0, max_over = 0, max_under = 0, e = 0;
+    block_t batch[BLOCK_BUFFER_SIZE];
+
+    for (uint32_t i = 0; i < count;) {
+      // Fill the buffer with moves of 5mm or more, at 20mm/s up to the XY limit
+      while (i < count && !planner.is_full()) {
+        float x, y;
+        do {
+          x = center[X_AXIS] + (benchmark_random(seed) * 2 - 1) * range[X_AXIS];
+          y = center[Y_AXIS] + (benchmark_random(seed) * 2 - 1) * range[Y_AXIS];
+        } while (HYPOT(x - current_position[X_AXIS], y - current_position[Y_AXIS]) < 5);
+        e += HYPOT(x - current_position[X_AXIS], y - current_position[Y_AXIS]) * 0.05;
+        planner.buffer_line(x, y, 0, e, 20 + benchmark_random(seed) * (PLANNER_XY_FEEDRATE() - 20), 0);
+        current_position[X_AXIS] = x;
+        current_position[Y_AXIS] = y;
+        i++;
+      }
+      DISABLE_STEPPER_DRIVER_INTERRUPT();
+
+      const uint8_t queued = planner.movesplanned();
+      for (uint8_t b = 0; b < queued; b++) batch[b] = planner.block_buffer[BLOCK_MOD(planner.block_buffer_tail + b)];
+
+      long last[NUM_AXIS];
+      LOOP_XYZE(a) last[a] = stepper.position((AxisEnum)a);
+      uint32_t completed = 0, burst = 0, elapsed = 0, block_ticks = 0, set_ticks = 0, decel_ticks = 0;
+      float peak = 0;
+      int32_t steps[NUM_AXIS] = { 0 };
+      for (uint8_t b = 0; b < queued;) {
+        const block_t &block = batch[b];
+        const uint8_t tail = planner.block_buffer_tail;
+
+        timers[STEP_TIMER_NUM].restart();
+        const uint64_t start = Clock::nanos();
+        Stepper::isr();
+        const uint64_t ns = Clock::nanos() - start;
+        isr_ns += ns;
+        isrs++;
+
+        int32_t moved[NUM_AXIS];
+        LOOP_XYZE(a) {
+          const long pos = stepper.position((AxisEnum)a);
+          moved[a] = labs(pos - last[a]);
+          steps[a] += moved[a];
+          last[a] = pos;
+        }
+        const uint32_t stepped = moved[lead_axis(block)];
+        if (stepped) {
+          if (!completed) {
+            block_ticks = decel_ticks = 0;
+            peak = block.initial_rate;
+          }
+          else {
+            // The ideal rate over the interval since the previous ISR with steps, which set it
+            const float accel = float(block.acceleration_steps_per_s2) / (HAL_STEPPER_TIMER_RATE),
+                        nominal = block.nominal_rate;
+            float low, high;
+            if (completed <= (uint32_t)block.accelerate_until) {
+              #if ENABLED(BEZIER_JERK_CONTROL)
+                low = block.initial_rate;
+                high = nominal;
+              #else
+                low = min(block.initial_rate + accel * set_ticks, nominal);
+                high = min(block.initial_rate + accel * block_ticks, nominal);
+              #endif
+              peak = high;
+            }
+            else if (completed > (uint32_t)block.decelerate_after) {
+              if (!decel_ticks) decel_ticks = set_ticks;
+              #if ENABLED(BEZIER_JERK_CONTROL)
+                low = block.final_rate;
+                high = peak;
+              #else
+                low = max(peak - accel * (block_ticks - decel_ticks), float(block.final_rate));
+                high = max(peak - accel * (set_ticks - decel_ticks), float(block.final_rate));
+              #endif
+            }
+            else
+              low = high = nominal;
+            NOMORE(low, float(MAX_STEP_FREQUENCY));
+            NOMORE(high, float(MAX_STEP_FREQUENCY));
+
+            const float rate = float(stepped) * HAL_STEPPER_TIMER_RATE / elapsed,
+                        error = rate > high ? rate / high - 1 : rate < low ? rate / low - 1 : 0;
+            // The step loop cuts the last burst of a block short, in an interval set for a full burst
+            if (error < -0.05 && planner.block_buffer_tail != tail && stepped < burst)
+              short_bursts++;
+            else {
+              NOLESS(max_rate, rate);
+              NOLESS(max_over, error);
+              NOMORE(max_under, error);
+              if (FABS(error) > 0.05) off_rate++;
+              checked++;
+            }
+          }
+          completed += stepped;
+          burst = stepped;
+          elapsed = 0;
+          set_ticks = block_ticks;
+        }
+        const uint32_t interval = HAL_timer_get_compare(STEP_TIMER_NUM);
+        if (ns > Clock::ticksToNanos(interval, HAL_STEPPER_TIMER_RATE)) overrun++;
+        elapsed += interval;
+        block_ticks += interval;
+        ticks += interval;
+
+        if (planner.block_buffer_tail != tail) {
+          bool ok = completed == block.step_event_count;
+          LOOP_XYZE(a) { ok &= steps[a] == block.steps[a]; steps[a] = 0; }
+          if (!ok) bad_blocks++;
+          events += completed;
+          completed = 0;
+          blocks++;
+          b++;
+        }
+      }
+    }
+
+    #ifdef STEP_PATTERN_BUFFER
+      #define STEPPER_MODE "STEP_PATTERN_BUFFER " STRINGIFY(STEP_PATTERN_BUFFER)
+    #else
+      #define STEPPER_MODE "step loop"
+    #endif
+    fprintf(stderr, "stepper: %s, X %.0f steps/mm, %u blocks, %lu step events in %.1fs, %lu ISRs, %.2f ISRs/event, %.0f ns/ISR, %.0f ns/event\n",
+      STEPPER_MODE, planner.axis_steps_per_mm[X_AXIS], blocks, (unsigned long)events, float(ticks) / HAL_STEPPER_TIMER_RATE,
+      (unsigned long)isrs, float(isrs) / events, float(isr_ns) / isrs, float(isr_ns) / events);
+    fprintf(stderr, "stepper: %u blocks with missing steps, max rate %.0f steps/s, rate vs trapezoid %+.1f%% .. %+.1f%%, %u of %u ISRs off by over 5%%, %u short last bursts, %u ISRs longer than their interval\n",
+      bad_blocks, max_rate, max_under * 100, max_over * 100, off_rate, checked, short_bursts, overrun);
+    if (bad_blocks || off_rate) failed = true;
+  }
+  exit(failed ? 1 : 0);
+}
+
+#endif // __PLAT_LINUX__
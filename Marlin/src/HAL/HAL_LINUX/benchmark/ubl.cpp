@@ -0,0 +1,135 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "benchmark.h"
+
+#if HAS_UBL_BENCHMARK
+
+#include "../../../feature/bedlevel/ubl/ubl.h"
+#include "../../../module/planner.h"
+#include "../../../module/motion.h"
+#include "../../../module/segment_producer.h"
+
+static long ubl_steps[XYZ];
+static float ubl_max_error;
+static uint32_t ubl_segments;
+
+// The correction from the mesh points in double precision, for reference
+static double ubl_exact_z(const float x, const float y) {
+  const double u = (x - (MESH_MIN_X)) / double(MESH_X_DIST), v = (y - (MESH_MIN_Y)) / double(MESH_Y_DIST);
+  const int cx = constrain(int(floor(u)), 0, GRID_MAX_POINTS_X - 1), cy = constrain(int(floor(v)), 0, GRID_MAX_POINTS_Y - 1),
+            nx = min(cx, GRID_MAX_POINTS_X - 2) + 1, ny = min(cy, GRID_MAX_POINTS_Y - 2) + 1;
+  const double fu = u - cx, fv = v - cy,
+               z1 = ubl.z_values[cx][cy] + (ubl.z_values[nx][cy] - ubl.z_values[cx][cy]) * fu,
+               z2 = ubl.z_values[cx][ny] + (ubl.z_values[nx][ny] - ubl.z_values[cx][ny]) * fu;
+  return z1 + (z2 - z1) * fv;
+}
+
+// Take the queued segments from the planner, checking the Z of each end
+static void ubl_drain() {
+  while (planner.has_blocks_queued()) {
+    const block_t &block = planner.block_buffer[planner.block_buffer_tail];
+    float p[XYZ];
+    LOOP_XYZ(a) {
+      ubl_steps[a] += TEST(block.direction_bits, a) ? -long(block.steps[a]) : long(block.steps[a]);
+      p[a] = ubl_steps[a] * planner.steps_to_mm[a];
+    }
+    // The planner splits the first move of an empty buffer in two, in a straight line
+    const uint8_t next = BLOCK_MOD(planner.block_buffer_tail + 1);
+    if (next == planner.block_buffer_head || !TEST(planner.block_buffer[next].flag, BLOCK_BIT_CONTINUED)) {
+      NOLESS(ubl_max_error, fabs(p[Z_AXIS] - ubl_exact_z(p[X_AXIS], p[Y_AXIS])));
+      ubl_segments++;
+    }
+    planner.discard_current_block();
+  }
+}
+
+/**
+ * Query get_z_correction() at random points of a random mesh, then cut
+ * COUNT random lines at Z 0 with line_to_destination_cartesian(), and
+ * report the time per query and per segment, and the largest difference
+ * of a correction or a segment end from exact bilinear interpolation.
+ * The axes get 1000 steps/mm and the planner is emptied from idle().
+ */
+void benchmark_ubl(const uint32_t count) {
+  cli();
+  uint32_t seed = 1;
+  for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
+    for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
+      ubl.z_values[x][y] = (benchmark_random(seed) - 0.5) * 0.8;
+
+  constexpr uint32_t queries = 1000000;
+  float sum = 0, max_error = 0;
+  uint64_t start = Clock::nanos();
+  for (uint32_t i = 0; i < queries; i++) {
+    const float x = MESH_MIN_X + benchmark_random(seed) * (MESH_MAX_X - (MESH_MIN_X)), y = MESH_MIN_Y + benchmark_random(seed) * (MESH_MAX_Y - (MESH_MIN_Y));
+    sum += ubl.get_z_correction(x, y);
+  }
+  const float query_ns = float(Clock::nanos() - start) / queries;
+  for (uint32_t i = 0; i < 10000; i++) {
+    const float x = MESH_MIN_X + benchmark_random(seed) * (MESH_MAX_X - (MESH_MIN_X)), y = MESH_MIN_Y + benchmark_random(seed) * (MESH_MAX_Y - (MESH_MIN_Y));
+    NOLESS(max_error, fabs(ubl.get_z_correction(x, y) - ubl_exact_z(x, y)));
+  }
+  fprintf(stderr, "ubl: get_z_correction on a %ux%u mesh, %.1f ns/query, max error %.6fmm (%g)\n",
+    GRID_MAX_POINTS_X, GRID_MAX_POINTS_Y, query_ns, max_error, sum);
+
+  LOOP_XYZ(a) planner.axis_steps_per_mm[a] = 1000;
+  planner.refresh_positioning();
+  HAL_idle_hook = ubl_drain;
+  uint64_t ns = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    // Lines of 1-200mm in any direction, within the mesh
+    float p[2][2];
+    for (uint8_t e = 0; e < 2; e++) {
+      p[e][X_AXIS] = MESH_MIN_X + benchmark_random(seed) * (MESH_MAX_X - (MESH_MIN_X));
+      p[e][Y_AXIS] = MESH_MIN_Y + benchmark_random(seed) * (MESH_MAX_Y - (MESH_MIN_Y));
+    }
+    const float mm = 1 + benchmark_random(seed) * 199, d = HYPOT(p[1][X_AXIS] - p[0][X_AXIS], p[1][Y_AXIS] - p[0][Y_AXIS]);
+    if (d > mm) for (uint8_t a = X_AXIS; a <= Y_AXIS; a++) p[1][a] = p[0][a] + (p[1][a] - p[0][a]) * mm / d;
+
+    current_position[X_AXIS] = p[0][X_AXIS];
+    current_position[Y_AXIS] = p[0][Y_AXIS];
+    current_position[Z_AXIS] = ubl_exact_z(p[0][X_AXIS], p[0][Y_AXIS]);
+    current_position[E_AXIS] = 0;
+    SYNC_PLAN_POSITION_KINEMATIC();
+    LOOP_XYZ(a) ubl_steps[a] = LROUND(current_position[a] * planner.axis_steps_per_mm[a]);
+    current_position[Z_AXIS] = 0;
+    COPY(destination, current_position);
+    destination[X_AXIS] = p[1][X_AXIS];
+    destination[Y_AXIS] = p[1][Y_AXIS];
+
+    const uint64_t begin = Clock::nanos();
+    ubl.line_to_destination_cartesian(MMM_TO_MMS(6000), active_extruder);
+    segment_feed.finish();
+    ns += Clock::nanos() - begin;
+    ubl_drain();
+  }
+  HAL_idle_hook = NULL;
+  fprintf(stderr, "ubl: %u lines, %u segments, %.1f segments/line, %.0f ns/segment, max error %.4fmm\n",
+    count, ubl_segments, float(ubl_segments) / count, float(ns) / ubl_segments, ubl_max_error);
+  exit(0);
+}
+
+#endif // HAS_UBL_BENCHMARK
+#endif // __PLAT_LINUX__
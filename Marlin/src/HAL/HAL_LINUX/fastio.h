@@ -0,0 +1,111 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Fast I/O interfaces for the Linux HAL
+ *
+ * Pins are entries in the simulated Gpio map, so every write is seen by
+ * the attached simulated hardware.
+ */
+
+#ifndef _FASTIO_LINUX_H
+#define _FASTIO_LINUX_H
+
+#include <Arduino.h>
+#include "hardware/Gpio.h"
+
+#define USEABLE_HARDWARE_PWM(pin) false
+
+#define SET_DIR_INPUT(IO)     Gpio::setMode(IO, INPUT)
+#define SET_DIR_OUTPUT(IO)    Gpio::setMode(IO, OUTPUT)
+
+#define SET_MODE(IO, mode)    Gpio::setMode(IO, mode)
+
+#define WRITE_PIN_SET(IO)     Gpio::set(IO, HIGH)
+#define WRITE_PIN_CLR(IO)     Gpio::set(IO, LOW)
+
+#define READ_PIN(IO)          Gpio::get(IO)
+#define WRITE_PIN(IO, v)      Gpio::set(IO, (v) ? HIGH : LOW)
+
+/// Read a pin
+#define _READ(IO) READ_PIN(IO)
+
+/// Write to a pin
+#define _WRITE_VAR(IO, v) digitalWrite(IO, v)
+
+#define _WRITE(IO, v) WRITE_PIN(IO, v)
+
+/// toggle a pin
+#define _TOGGLE(IO) _WRITE(IO, !READ(IO))
+
+/// set pin as input
+#define _SET_INPUT(IO) SET_DIR_INPUT(IO)
+
+/// set pin as output
+#define _SET_OUTPUT(IO) SET_DIR_OUTPUT(IO)
+
+/// set pin as input with pullup mode
+#define _PULLUP(IO, v) (pinMode(IO, (v!=LOW ? INPUT_PULLUP : INPUT)))
+
+/// set pin as input with pulldown mode
+#define _PULLDOWN(IO, v) (pinMode(IO, (v!=LOW ? INPUT_PULLDOWN : INPUT)))
+
+/// check if pin is an input
+#define _GET_INPUT(IO)        (Gpio::getMode(IO) != OUTPUT)
+
+/// check if pin is an output
+#define _GET_OUTPUT(IO)       (Gpio::getMode(IO) == OUTPUT)
+
+/// check if pin is a timer
+#define _GET_TIMER(IO)        false
+
+/// Read a pin wrapper
+#define READ(IO)  _READ(IO)
+
+/// Write to a pin wrapper
+#define WRITE_VAR(IO, v)  _WRITE_VAR(IO, v)
+#define WRITE(IO, v)  _WRITE(IO, v)
+
+/// toggle a pin wrapper
+#define TOGGLE(IO)  _TOGGLE(IO)
+
+/// set pin as input wrapper
+#define SET_INPUT(IO)  _SET_INPUT(IO)
+/// set pin as input with pullup wrapper
+#define SET_INPUT_PULLUP(IO) do{ _SET_INPUT(IO); _PULLUP(IO, HIGH); }while(0)
+/// set pin as input with pulldown wrapper
+#define SET_INPUT_PULLDOWN(IO) do{ _SET_INPUT(IO); _PULLDOWN(IO, HIGH); }while(0)
+/// set pin as output wrapper  -  reads the pin and sets the output to that value
+#define SET_OUTPUT(IO)  do{ _WRITE(IO, _READ(IO)); _SET_OUTPUT(IO); }while(0)
+
+/// check if pin is an input wrapper
+#define GET_INPUT(IO)  _GET_INPUT(IO)
+/// check if pin is an output wrapper
+#define GET_OUTPUT(IO)  _GET_OUTPUT(IO)
+
+/// check if pin is a timer (wrapper)
+#define GET_TIMER(IO)  _GET_TIMER(IO)
+
+// Shorthand
+#define OUT_WRITE(IO, v) { SET_OUTPUT(IO); WRITE(IO, v); }
+
+#endif // _FASTIO_LINUX_H
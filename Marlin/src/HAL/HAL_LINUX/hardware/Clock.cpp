@@ -0,0 +1,41 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "Clock.h"
+
+uint64_t Clock::frequency = 100000000;
+uint32_t Clock::speedup = 1;
+
+// Captured on first use so it is valid during static initialization
+uint64_t Clock::origin() {
+  static uint64_t startup_nanos = 0;
+  if (!startup_nanos) {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    startup_nanos = to_nanos(now);
+  }
+  return startup_nanos;
+}
+
+#endif // __PLAT_LINUX__
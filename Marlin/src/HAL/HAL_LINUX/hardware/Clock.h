@@ -0,0 +1,79 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _HAL_LINUX_CLOCK_H_
+#define _HAL_LINUX_CLOCK_H_
+
+/**
+ * Clock
+ *
+ * Monotonic host time source shared by millis(), micros(), the simulated
+ * timer peripherals and the simulated hardware models. All times are counted
+ * from the moment the firmware process started, and run 'speedup' times
+ * faster than the host's, to test slow processes like heating in less time.
+ */
+
+#include <stdint.h>
+#include <time.h>
+
+class Clock {
+public:
+  static uint64_t nanos() {
+    const uint64_t start = origin();  // Before reading the clock, or the first call goes negative
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (to_nanos(now) - start) * speedup;
+  }
+
+  static uint64_t micros() { return nanos() / 1000; }
+  static uint64_t millis() { return nanos() / 1000000; }
+
+  // Convert between nanoseconds and ticks of a clock running at 'frequency' Hz
+  static uint64_t nanosToTicks(const uint64_t ns, const uint64_t frequency) { return (ns * frequency) / 1000000000ULL; }
+  static uint64_t ticksToNanos(const uint64_t tick, const uint64_t frequency) { return (tick * 1000000000ULL) / frequency; }
+
+  // Absolute CLOCK_MONOTONIC time for a process-relative nanosecond count
+  static timespec absolute(const uint64_t ns) {
+    const uint64_t abs_ns = ns / speedup + origin();
+    timespec ts;
+    ts.tv_sec = abs_ns / 1000000000ULL;
+    ts.tv_nsec = abs_ns % 1000000000ULL;
+    return ts;
+  }
+
+  // Sleep until a process-relative time, resuming after signal delivery
+  static void sleepUntil(const uint64_t ns) {
+    const timespec ts = absolute(ns);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL)) { /* interrupted by a timer ISR */ }
+  }
+
+  static void delayNanos(const uint64_t ns) { sleepUntil(nanos() + ns); }
+
+  static uint64_t frequency;  // Simulated CPU frequency, used for cycle conversions
+  static uint32_t speedup;    // Simulated time per host time, set before anything reads the clock
+
+private:
+  static uint64_t to_nanos(const timespec &ts) { return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec; }
+  static uint64_t origin();
+};
+
+#endif // _HAL_LINUX_CLOCK_H_
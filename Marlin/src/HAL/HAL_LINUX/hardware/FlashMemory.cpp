@@ -0,0 +1,88 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "FlashMemory.h"
+
+#include <string.h>
+
+bool FlashMemory::open(const char * const filename) {
+  file = fopen(filename, "r+b");
+  if (file == NULL) file = fopen(filename, "w+b");
+  if (file == NULL) return false;
+
+  // Pad a new or short file with erased banks
+  fseek(file, 0, SEEK_END);
+  for (long file_size = ftell(file); file_size < (long)(2 * bank_size); file_size++)
+    fputc(0xFF, file);
+  fflush(file);
+  return true;
+}
+
+bool FlashMemory::erase(const uint8_t bank) {
+  if (file == NULL || bank > 1) return true;
+  if (power_left == 0) return false;
+  uint8_t erased[256];
+  memset(erased, 0xFF, sizeof(erased));
+  fseek(file, (long)bank * bank_size, SEEK_SET);
+  for (uint32_t i = 0; i < bank_size; i += sizeof(erased))
+    if (fwrite(erased, 1, sizeof(erased), file) != sizeof(erased)) return true;
+  fflush(file);
+  erases[bank]++;
+  return false;
+}
+
+bool FlashMemory::program(const uint8_t bank, const uint32_t offset, const uint8_t *data, const uint16_t size) {
+  if (file == NULL || bank > 1 || offset + size > bank_size) return true;
+  bool error = false;
+  for (uint16_t done = 0; done < size && power_left != 0;) {
+    uint8_t cells[256];
+    const uint16_t left = size - done;
+    uint16_t n = left < sizeof(cells) ? left : sizeof(cells);
+    if (power_left > 0 && n > power_left) n = power_left;
+    read(bank, offset + done, cells, n);
+    for (uint16_t i = 0; i < n; i++) {
+      // Programming clears bits, it can't set them
+      if ((cells[i] & data[done + i]) != data[done + i]) error = true;
+      cells[i] &= data[done + i];
+    }
+    fseek(file, (long)bank * bank_size + offset + done, SEEK_SET);
+    if (fwrite(cells, 1, n, file) != n) error = true;
+    if (power_left > 0) power_left -= n;
+    bytes_programmed += n;
+    done += n;
+  }
+  fflush(file);
+  return error;
+}
+
+void FlashMemory::read(const uint8_t bank, const uint32_t offset, uint8_t *data, const uint16_t size) {
+  memset(data, 0xFF, size);
+  if (file == NULL || bank > 1 || offset + size > bank_size) return;
+  if (!fseek(file, (long)bank * bank_size + offset, SEEK_SET)) {
+    const size_t bytes_read = fread(data, 1, size, file);
+    (void)bytes_read;
+  }
+}
+
+#endif // __PLAT_LINUX__
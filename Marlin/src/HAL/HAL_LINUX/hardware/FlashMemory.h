@@ -0,0 +1,65 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _HAL_LINUX_FLASHMEMORY_H_
+#define _HAL_LINUX_FLASHMEMORY_H_
+
+/**
+ * FlashMemory
+ *
+ * NOR flash with two erasable banks, backed by a file, for the EEPROM
+ * journal. Like the real part, erasing sets a whole bank to 0xFF and
+ * programming can only clear bits. The erases and the bytes programmed
+ * are counted for benchmarks, and power can be cut after a number of
+ * bytes, to test saves interrupted by a reset.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+class FlashMemory {
+public:
+  static constexpr uint32_t bank_size = 0x4000;  // A 16K sector, as on STM32F4
+
+  FlashMemory() : file(NULL), power_left(-1) { clearCounts(); }
+
+  bool open(const char * const filename);
+
+  bool erase(const uint8_t bank);
+  bool program(const uint8_t bank, const uint32_t offset, const uint8_t *data, const uint16_t size);
+  void read(const uint8_t bank, const uint32_t offset, uint8_t *data, const uint16_t size);
+
+  // Lose power once 'bytes' more bytes have been programmed (-1 for never).
+  // Nothing more is erased or programmed until power is restored.
+  void cutPowerAfter(const int32_t bytes) { power_left = bytes; }
+  void restorePower() { power_left = -1; }
+  bool powerLost() const { return power_left == 0; }
+
+  uint32_t erases[2], bytes_programmed;
+  void clearCounts() { erases[0] = erases[1] = bytes_programmed = 0; }
+
+private:
+  FILE *file;
+  int32_t power_left;
+};
+
+#endif // _HAL_LINUX_FLASHMEMORY_H_
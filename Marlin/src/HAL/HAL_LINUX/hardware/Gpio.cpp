@@ -0,0 +1,46 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "Gpio.h"
+#include "Clock.h"
+
+pin_data Gpio::pin_map[Gpio::pin_count] = {};
+
+void Gpio::set(const pin_t pin, const uint16_t value) {
+  if (!valid_pin(pin)) return;
+  const uint16_t old_value = pin_map[pin].value;
+  pin_map[pin].value = value;
+  if (pin_map[pin].cb) {
+    const GpioEvent::Type type = old_value == value ? GpioEvent::SET_VALUE : value > old_value ? GpioEvent::RISE : GpioEvent::FALL;
+    pin_map[pin].cb->interrupt(GpioEvent(Clock::nanos(), pin, type));
+  }
+}
+
+void Gpio::setMode(const pin_t pin, const uint8_t mode) {
+  if (!valid_pin(pin)) return;
+  pin_map[pin].mode = mode;
+  if (pin_map[pin].cb) pin_map[pin].cb->interrupt(GpioEvent(Clock::nanos(), pin, GpioEvent::SET_MODE));
+}
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,88 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _HAL_LINUX_GPIO_H_
+#define _HAL_LINUX_GPIO_H_
+
+/**
+ * Gpio
+ *
+ * Simulated pin state for the Linux HAL. Every write is timestamped and
+ * forwarded to the Peripheral attached to the pin (if any) so simulated
+ * hardware such as steppers, endstops and heaters can follow the firmware.
+ */
+
+#include <stdint.h>
+
+typedef int16_t pin_t;
+
+struct GpioEvent {
+  enum Type : uint8_t { NOP, FALL, RISE, SET_VALUE, SET_MODE };
+  uint64_t timestamp;
+  pin_t pin_id;
+  Type event;
+
+  GpioEvent(const uint64_t t, const pin_t p, const Type e) : timestamp(t), pin_id(p), event(e) {}
+};
+
+class Peripheral {
+public:
+  virtual void interrupt(const GpioEvent &ev) = 0;
+  virtual ~Peripheral() {}
+};
+
+struct pin_data {
+  uint8_t mode;       // INPUT, OUTPUT, INPUT_PULLUP, INPUT_PULLDOWN
+  uint16_t value;     // Logic level, or raw ADC reading for analog pins
+  Peripheral *cb;     // Simulated hardware attached to this pin
+};
+
+class Gpio {
+public:
+  static const pin_t pin_count = 128;
+  static pin_data pin_map[pin_count];
+
+  static bool valid_pin(const pin_t pin) { return pin >= 0 && pin < pin_count; }
+
+  static void set(const pin_t pin, const uint16_t value);
+
+  static uint16_t get(const pin_t pin) {
+    return valid_pin(pin) ? pin_map[pin].value : 0;
+  }
+
+  static void setMode(const pin_t pin, const uint8_t mode);
+
+  static uint8_t getMode(const pin_t pin) {
+    return valid_pin(pin) ? pin_map[pin].mode : 0;
+  }
+
+  // Change a pin from the simulation side without notifying peripherals
+  static void drive(const pin_t pin, const uint16_t value) {
+    if (valid_pin(pin)) pin_map[pin].value = value;
+  }
+
+  static void attachPeripheral(const pin_t pin, Peripheral * const dest) {
+    if (valid_pin(pin)) pin_map[pin].cb = dest;
+  }
+};
+
+#endif // _HAL_LINUX_GPIO_H_
@@ -0,0 +1,58 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "Heater.h"
+#include "Clock.h"
+
+Heater::Heater(const pin_t heater, const pin_t adc, const sensor_t adc_for_temp,
+               const float power, const float capacity, const float loss,
+               const float filament/*=0.0*/, const float lag/*=0.0*/, const float ambient/*=25.0*/)
+  : temperature(ambient), sensed(ambient), heater_pin(heater), adc_pin(adc), sensor(adc_for_temp),
+    heater_power(power), heat_capacity(capacity), ambient_loss(loss), filament_heat(filament),
+    sensor_lag(lag), ambient_temp(ambient), fed(0.0), last(Clock::nanos()) {
+  Gpio::drive(adc_pin, sensor(sensed));
+}
+
+void Heater::step(const float dt, const float duty, const float extruded) {
+  const float above = temperature - ambient_temp;
+  temperature += ((heater_power * duty - ambient_loss * above) * dt - filament_heat * extruded * above) / heat_capacity;
+  sensed = sensor_lag > dt ? sensed + (temperature - sensed) * dt / sensor_lag : temperature;
+}
+
+void Heater::update(const float extruded/*=0.0*/) {
+  fed += extruded;
+  const uint64_t now = Clock::nanos();
+  const float dt = (now - last) * 1e-9f;
+  if (dt < 0.0001f) return;
+  last = now;
+
+  // Soft PWM runs far slower than the sampling rate, so the pin level
+  // at each sample is a good estimate of the duty over the interval.
+  step(dt, Gpio::get(heater_pin) ? 1.0f : 0.0f, fed);
+  fed = 0.0;
+
+  Gpio::drive(adc_pin, sensor(sensed));
+}
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,71 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _HAL_LINUX_HEATER_H_
+#define _HAL_LINUX_HEATER_H_
+
+/**
+ * Heater
+ *
+ * Lumped first-order thermal model of a heater block:
+ *
+ *   C * dT/dt = P * duty - (h + H * e_rate) * (T - T_ambient)
+ *
+ * where e_rate is the rate filament is pushed through it, if any. The sensor
+ * follows the block with a first-order lag. The duty cycle is sampled from the
+ * heater output pin and the sensor temperature is reported to the firmware as
+ * a raw reading on the sensor's analog channel.
+ */
+
+#include "Gpio.h"
+
+class Heater {
+public:
+  typedef uint16_t (*sensor_t)(const float celsius);  // Temperature to 10-bit ADC reading
+
+  Heater(const pin_t heater, const pin_t adc, const sensor_t adc_for_temp,
+         const float power, const float capacity, const float loss,
+         const float filament=0.0, const float lag=0.0, const float ambient=25.0);
+
+  // Follow the heater pin, with 'extruded' mm of filament fed since the last update
+  void update(const float extruded=0.0);
+
+  // Advance the model by dt seconds at a given duty, without the pins
+  void step(const float dt, const float duty, const float extruded);
+
+  float temperature,    // Block
+        sensed;         // Sensor
+
+private:
+  pin_t heater_pin, adc_pin;
+  sensor_t sensor;
+  float heater_power,   // W at 100% duty
+        heat_capacity,  // J/K
+        ambient_loss,   // W/K
+        filament_heat,  // J/K per mm of filament
+        sensor_lag,     // s
+        ambient_temp;   // °C
+  float fed;            // mm of filament not yet accounted for
+  uint64_t last;
+};
+
+#endif // _HAL_LINUX_HEATER_H_
@@ -0,0 +1,51 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "LinearAxis.h"
+
+LinearAxis::LinearAxis(const pin_t enable, const pin_t dir, const pin_t step, const pin_t end_min, const pin_t end_max,
+                       const int32_t min_pos, const int32_t max_pos, const int32_t start_pos,
+                       const bool enable_on, const bool positive_dir, const bool min_hit, const bool max_hit)
+  : position(start_pos), steps(0),
+    enable_pin(enable), dir_pin(dir), step_pin(step), min_pin(end_min), max_pin(end_max),
+    min_position(min_pos), max_position(max_pos),
+    enable_level(enable_on), positive_level(positive_dir), min_hit_level(min_hit), max_hit_level(max_hit) {
+  Gpio::attachPeripheral(step_pin, this);
+  update_endstops();
+}
+
+void LinearAxis::update_endstops() {
+  Gpio::drive(min_pin, position <= min_position ? min_hit_level : !min_hit_level);
+  Gpio::drive(max_pin, position >= max_position ? max_hit_level : !max_hit_level);
+}
+
+void LinearAxis::interrupt(const GpioEvent &ev) {
+  if (ev.event != GpioEvent::RISE || ev.pin_id != step_pin) return;
+  if (enable_pin >= 0 && (bool)Gpio::get(enable_pin) != enable_level) return;
+  position += (bool)Gpio::get(dir_pin) == positive_level ? 1 : -1;
+  steps++;
+  update_endstops();
+}
+
+#endif // __PLAT_LINUX__
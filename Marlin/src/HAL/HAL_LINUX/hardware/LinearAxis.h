@@ -0,0 +1,55 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _HAL_LINUX_LINEAR_AXIS_H_
+#define _HAL_LINUX_LINEAR_AXIS_H_
+
+/**
+ * LinearAxis
+ *
+ * A stepper-driven axis that counts step pulses and drives its min and max
+ * endstop pins. Steps arrive through the Gpio write hook, so no pulse is
+ * missed regardless of the step rate.
+ */
+
+#include "Gpio.h"
+
+class LinearAxis : public Peripheral {
+public:
+  LinearAxis(const pin_t enable, const pin_t dir, const pin_t step, const pin_t end_min, const pin_t end_max,
+             const int32_t min_pos, const int32_t max_pos, const int32_t start_pos,
+             const bool enable_on, const bool positive_dir, const bool min_hit, const bool max_hit);
+
+  void interrupt(const GpioEvent &ev);
+
+  int32_t position;   // In steps
+  uint32_t steps;     // Total pulses seen, for throughput measurements
+
+private:
+  void update_endstops();
+
+  pin_t enable_pin, dir_pin, step_pin, min_pin, max_pin;
+  int32_t min_position, max_position;
+  bool enable_level, positive_level, min_hit_level, max_hit_level;
+};
+
+#endif // _HAL_LINUX_LINEAR_AXIS_H_
@@ -0,0 +1,250 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "SDCard.h"
+
+#include <string.h>
+
+// SPI mode tokens and R1 bits (see sd/SdInfo.h)
+#define R1_READY            0x00
+#define R1_IDLE             0x01
+#define R1_ILLEGAL_COMMAND  0x04
+#define R1_ADDRESS_ERROR    0x20
+#define DATA_START_BLOCK    0xFE
+#define WRITE_MULTIPLE      0xFC
+#define STOP_TRAN           0xFD
+#define DATA_ACCEPTED       0x05
+#define DATA_WRITE_ERROR    0x0D
+
+bool SDCard::open(const char * const filename) {
+  image = fopen(filename, "r+b");
+  if (!image) return false;
+  fseek(image, 0, SEEK_END);
+  block_count = ftell(image) / 512;
+  reset();
+  return true;
+}
+
+void SDCard::reset() {
+  state = IDLE;
+  idle = true;
+  app_cmd = multi_write = false;
+  cmd_len = 0;
+  out_len = out_pos = 0;
+  data_len = 0;
+}
+
+void SDCard::select(const bool selected) {
+  // A card keeps its state across chip select changes; a pending multiple
+  // block read resumes where it left off once the card is selected again.
+  if (!selected && state == COMMAND) { state = IDLE; cmd_len = 0; }
+}
+
+bool SDCard::readBlock(const uint32_t block, uint8_t * const dst) {
+  if (block >= block_count) return false;
+  fseek(image, (long)block * 512, SEEK_SET);
+  return fread(dst, 1, 512, image) == 512;
+}
+
+bool SDCard::writeBlock(const uint32_t block, const uint8_t * const src) {
+  if (block >= block_count) return false;
+  fseek(image, (long)block * 512, SEEK_SET);
+  const bool ok = fwrite(src, 1, 512, image) == 512;
+  fflush(image);
+  return ok;
+}
+
+// CRC-CCITT, as checked by Sd2Card when SD_CHECK_AND_RETRY is enabled
+uint16_t SDCard::crc16(const uint8_t * const data, const uint16_t len) {
+  uint16_t crc = 0;
+  for (uint16_t i = 0; i < len; i++) {
+    crc = (uint8_t)(crc >> 8) | (crc << 8);
+    crc ^= data[i];
+    crc ^= (uint8_t)(crc & 0xFF) >> 4;
+    crc ^= crc << 12;
+    crc ^= (crc & 0xFF) << 5;
+  }
+  return crc;
+}
+
+void SDCard::queueBlock(const uint8_t * const data, const uint16_t len) {
+  queue(DATA_START_BLOCK);
+  for (uint16_t i = 0; i < len; i++) queue(data[i]);
+  const uint16_t crc = crc16(data, len);
+  queue(crc >> 8);
+  queue(crc & 0xFF);
+}
+
+void SDCard::command(const uint8_t cmd, const uint32_t arg) {
+  out_len = out_pos = 0;
+  queue(0xFF);  // Ncr: one byte before the response
+  commands[cmd]++;
+
+  const bool acmd = app_cmd;
+  app_cmd = false;
+  if (state == READ_MULTIPLE) state = IDLE;  // Any command ends a multiple block read
+
+  if (acmd) switch (cmd) {
+    case 41:  // ACMD41: SD_SEND_OP_COND
+      idle = false;
+      queue(R1_READY);
+      return;
+    case 23:  // ACMD23: SET_WR_BLK_ERASE_COUNT
+      queue(idle ? R1_IDLE : R1_READY);
+      return;
+  }
+
+  const uint8_t r1 = idle ? R1_IDLE : R1_READY;
+  switch (cmd) {
+    case 0:   // GO_IDLE_STATE
+      idle = true;
+      queue(R1_IDLE);
+      break;
+
+    case 8:   // SEND_IF_COND: R7 echoes the check pattern
+      queue(r1);
+      queue(0x00); queue(0x00); queue((arg >> 8) & 0x0F); queue(arg & 0xFF);
+      break;
+
+    case 9: { // SEND_CSD: version 2.0 (SDHC)
+      const uint32_t c_size = block_count / 1024 - 1;
+      const uint8_t csd[16] = {
+        0x40, 0x0E, 0x00, 0x32, 0x5B, 0x59, 0x00,
+        (uint8_t)((c_size >> 16) & 0x3F), (uint8_t)(c_size >> 8), (uint8_t)c_size,
+        0x7F, 0x80, 0x0A, 0x40, 0x00, 0x01
+      };
+      queue(r1);
+      queueBlock(csd, sizeof(csd));
+    } break;
+
+    case 10: { // SEND_CID
+      const uint8_t cid[16] = { 0x00, 'M', 'L', 'L', 'I', 'N', 'U', 'X', 0x10, 0, 0, 0, 1, 0x01, 0x20, 0x01 };
+      queue(r1);
+      queueBlock(cid, sizeof(cid));
+    } break;
+
+    case 12:  // STOP_TRANSMISSION: the host discards a stuff byte first
+      queue(0xFF);
+      queue(R1_READY);
+      break;
+
+    case 13:  // SEND_STATUS: R2
+      queue(r1);
+      queue(0x00);
+      break;
+
+    case 17: { // READ_SINGLE_BLOCK
+      uint8_t block[512];
+      if (!readBlock(arg, block)) { queue(R1_ADDRESS_ERROR); break; }
+      queue(R1_READY);
+      queueBlock(block, 512);
+      blocks_read++;
+    } break;
+
+    case 18:  // READ_MULTIPLE_BLOCK: blocks are queued on demand by transfer()
+      if (arg >= block_count) { queue(R1_ADDRESS_ERROR); break; }
+      queue(R1_READY);
+      block_addr = arg;
+      state = READ_MULTIPLE;
+      break;
+
+    case 24:  // WRITE_BLOCK
+    case 25:  // WRITE_MULTIPLE_BLOCK
+      if (arg >= block_count) { queue(R1_ADDRESS_ERROR); break; }
+      queue(R1_READY);
+      block_addr = arg;
+      multi_write = cmd == 25;
+      state = WRITE_WAIT_TOKEN;
+      break;
+
+    case 32: case 33: case 38:  // Erase range, accepted and ignored
+    case 59:  // CRC_ON_OFF
+      queue(r1);
+      break;
+
+    case 55:  // APP_CMD
+      app_cmd = true;
+      queue(r1);
+      break;
+
+    case 58:  // READ_OCR: powered up, CCS (SDHC) set
+      queue(r1);
+      queue(0xC0); queue(0xFF); queue(0x80); queue(0x00);
+      break;
+
+    default:
+      queue(r1 | R1_ILLEGAL_COMMAND);
+      break;
+  }
+}
+
+uint8_t SDCard::transfer(const uint8_t mosi) {
+  if (!present()) return 0xFF;
+
+  switch (state) {
+    case WRITE_WAIT_TOKEN:
+      if (out_pos < out_len) break;  // Still clocking out the command response
+      if (mosi == DATA_START_BLOCK || mosi == WRITE_MULTIPLE) { state = WRITE_DATA; data_len = 0; }
+      else if (mosi == STOP_TRAN && multi_write) { state = IDLE; multi_write = false; }
+      return 0xFF;
+
+    case WRITE_DATA:
+      data_buf[data_len++] = mosi;
+      if (data_len == sizeof(data_buf)) {
+        out_len = out_pos = 0;
+        queue(writeBlock(block_addr, data_buf) ? DATA_ACCEPTED : DATA_WRITE_ERROR);
+        if (multi_write) { block_addr++; state = WRITE_WAIT_TOKEN; }
+        else state = IDLE;
+      }
+      return 0xFF;
+
+    default:
+      // Command frames start with 01xxxxxx
+      if (state != COMMAND && (mosi & 0xC0) == 0x40) { state = COMMAND; cmd_len = 0; }
+      if (state == COMMAND) {
+        cmd_buf[cmd_len++] = mosi;
+        if (cmd_len == 6) {
+          state = IDLE;
+          command(cmd_buf[0] & 0x3F, ((uint32_t)cmd_buf[1] << 24) | ((uint32_t)cmd_buf[2] << 16) | ((uint32_t)cmd_buf[3] << 8) | cmd_buf[4]);
+        }
+        return 0xFF;
+      }
+      break;
+  }
+
+  if (out_pos < out_len) return out_buf[out_pos++];
+
+  if (state == READ_MULTIPLE) {
+    uint8_t block[512];
+    out_len = out_pos = 0;
+    queue(0xFF);  // Nac: the card is never ready on the first byte of a block
+    if (readBlock(block_addr++, block)) { queueBlock(block, 512); blocks_read++; }
+    else { queue(0x09); state = IDLE; }  // Data error token: out of range
+    return out_buf[out_pos++];
+  }
+
+  return 0xFF;
+}
+
+#endif // __PLAT_LINUX__
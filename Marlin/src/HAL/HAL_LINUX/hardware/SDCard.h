@@ -0,0 +1,79 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _HAL_LINUX_SDCARD_H_
+#define _HAL_LINUX_SDCARD_H_
+
+/**
+ * SDCard
+ *
+ * An SDHC card in SPI mode, backed by a raw image file (e.g., created with
+ * 'mkfs.vfat -C sdcard.img 65536'). It sits behind the HAL SPI functions so
+ * the unmodified Sd2Card / SdVolume / CardReader stack runs against it.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+class SDCard {
+public:
+  SDCard() : image(NULL), block_count(0) { reset(); clearCounts(); }
+
+  bool open(const char * const filename);
+  bool present() const { return image != NULL; }
+
+  void select(const bool selected);
+  uint8_t transfer(const uint8_t mosi);
+
+  // Commands received and blocks sent, by command index, for benchmarks
+  uint32_t commands[64], blocks_read;
+  void clearCounts() { memset(commands, 0, sizeof(commands)); blocks_read = 0; }
+
+private:
+  enum State : uint8_t { IDLE, COMMAND, WRITE_WAIT_TOKEN, WRITE_DATA, READ_MULTIPLE };
+
+  void reset();
+  void command(const uint8_t cmd, const uint32_t arg);
+  void queue(const uint8_t b) { if (out_len < sizeof(out_buf)) out_buf[out_len++] = b; }
+  void queueBlock(const uint8_t * const data, const uint16_t len);
+  bool readBlock(const uint32_t block, uint8_t * const dst);
+  bool writeBlock(const uint32_t block, const uint8_t * const src);
+
+  static uint16_t crc16(const uint8_t * const data, const uint16_t len);
+
+  FILE *image;
+  uint32_t block_count;
+
+  State state;
+  bool idle, app_cmd, multi_write;
+  uint8_t cmd_buf[6], cmd_len;
+  uint32_t block_addr;
+
+  uint8_t out_buf[2 + 1 + 512 + 2 + 8];  // Ncr + R1 + token + data + crc + slack
+  uint16_t out_len, out_pos;
+
+  uint8_t data_buf[512 + 2];
+  uint16_t data_len;
+};
+
+#endif // _HAL_LINUX_SDCARD_H_
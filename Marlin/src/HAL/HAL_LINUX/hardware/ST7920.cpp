@@ -0,0 +1,56 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "ST7920.h"
+
+#include <string.h>
+
+void ST7920::reset() {
+  memset(gdram, 0, sizeof(gdram));
+  gdram_y = gdram_x = 0;
+  extended = vertical_set = false;
+}
+
+void ST7920::write(const bool data, const uint8_t value) {
+  if (data) {
+    data_bytes++;
+    if (!extended) return;  // Text mode isn't modelled
+    gdram[gdram_y & 31][gdram_x & (sizeof(gdram[0]) - 1)] = value;
+    gdram_x++;
+    return;
+  }
+
+  commands++;
+  if ((value & 0xE0) == 0x20) {               // Function set
+    extended = value & 0x04;
+    vertical_set = false;
+  }
+  else if (extended && (value & 0x80)) {      // Set GDRAM address, vertical then horizontal
+    if (!vertical_set) gdram_y = value & 0x3F;
+    else gdram_x = (value & 0x0F) * 2;        // In 16-bit words
+    vertical_set = !vertical_set;
+  }
+}
+
+#endif // __PLAT_LINUX__
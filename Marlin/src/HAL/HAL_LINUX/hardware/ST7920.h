@@ -0,0 +1,59 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _HAL_LINUX_ST7920_H_
+#define _HAL_LINUX_ST7920_H_
+
+/**
+ * ST7920
+ *
+ * The graphics RAM of a 128x64 ST7920 display, as driven by the u8g ST7920
+ * devices: commands and data bytes come from the com function, and only the
+ * extended instruction set's GDRAM addressing is modelled. The bytes the
+ * display is sent are counted for benchmarks.
+ */
+
+#include <stdint.h>
+
+class ST7920 {
+public:
+  static constexpr uint8_t width = 128, height = 64;
+
+  ST7920() { reset(); clearCounts(); }
+
+  void reset();
+  void write(const bool data, const uint8_t value);
+
+  // One row of the screen, width / 8 bytes with the leftmost pixel in the top bit
+  const uint8_t* row(const uint8_t y) const { return y < 32 ? gdram[y] : &gdram[y - 32][width / 8]; }
+
+  uint32_t commands, data_bytes;
+  uint32_t bytes() const { return commands + data_bytes; }
+  void clearCounts() { commands = data_bytes = 0; }
+
+private:
+  uint8_t gdram[32][2 * width / 8];   // The lower half of the screen follows the upper half in each row
+  uint8_t gdram_y, gdram_x;           // Address of the next byte
+  bool extended, vertical_set;        // Extended instructions, waiting for the horizontal address
+};
+
+#endif // _HAL_LINUX_ST7920_H_
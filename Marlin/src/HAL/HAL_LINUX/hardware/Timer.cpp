@@ -0,0 +1,122 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "Timer.h"
+#include "Clock.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+sigset_t Timer::isr_signals;
+
+void Timer::init(const uint8_t timer_signal, const uint32_t timer_rate, const isr_t timer_isr, const bool preemptible) {
+  rate = timer_rate;
+  isr = timer_isr;
+  compare = UINT32_MAX;
+  active = in_isr = false;
+  base_ns = Clock::nanos();
+
+  // A handler that isn't preemptible masks every timer signal while it runs
+  struct sigaction sa = {};
+  sa.sa_flags = SA_SIGINFO | SA_RESTART;
+  sa.sa_sigaction = Timer::handler;
+  sigemptyset(&sa.sa_mask);
+  if (!preemptible) sa.sa_mask = isr_signals;
+  if (sigaction(timer_signal, &sa, NULL) == -1) { perror("sigaction"); exit(1); }
+
+  sigevent sev = {};
+  sev.sigev_notify = SIGEV_SIGNAL;
+  sev.sigev_signo = timer_signal;
+  sev.sigev_value.sival_ptr = this;
+  if (timer_create(CLOCK_MONOTONIC, &sev, &timerid) == -1) { perror("timer_create"); exit(1); }
+}
+
+void Timer::start(const uint32_t frequency) {
+  base_ns = Clock::nanos();
+  setCompare(rate / frequency);
+}
+
+void Timer::enable() {
+  if (active) return;
+  // Don't replay every period that elapsed while the interrupt was off
+  const uint64_t now = Clock::nanos();
+  if (now > base_ns + Clock::ticksToNanos(compare, rate)) base_ns = now;
+  active = true;
+  arm();
+}
+
+void Timer::disable() {
+  active = false;
+  const itimerspec stop = {};
+  timer_settime(timerid, 0, &stop, NULL);
+}
+
+void Timer::setCompare(const uint32_t value) {
+  compare = value;
+  if (in_isr) return;  // The handler re-arms once the ISR returns
+  sigset_t old_mask;
+  pthread_sigmask(SIG_BLOCK, &isr_signals, &old_mask);
+  arm();
+  pthread_sigmask(SIG_SETMASK, &old_mask, NULL);
+}
+
+uint32_t Timer::getCount() const {
+  return (uint32_t)Clock::nanosToTicks(Clock::nanos() - base_ns, rate);
+}
+
+void Timer::restart() {
+  base_ns = Clock::nanos();
+  arm();
+}
+
+void Timer::arm() {
+  if (!active) return;
+  itimerspec spec = {};
+  spec.it_value = Clock::absolute(base_ns + Clock::ticksToNanos(compare, rate));
+  if (!spec.it_value.tv_sec && !spec.it_value.tv_nsec) spec.it_value.tv_nsec = 1;
+  timer_settime(timerid, TIMER_ABSTIME, &spec, NULL);
+}
+
+void Timer::fire() {
+  if (!active) return;
+
+  // The counter wraps to zero at the scheduled match, not at delivery time,
+  // so host latency doesn't accumulate into the step timeline. After a long
+  // stall (debugger, swapping) resynchronize instead of bursting.
+  const uint64_t now = Clock::nanos();
+  base_ns += Clock::ticksToNanos(compare, rate);
+  if (now > base_ns + 100000000ULL) base_ns = now;
+
+  in_isr = true;
+  isr();
+  in_isr = false;
+  arm();
+}
+
+void Timer::handler(int, siginfo_t *info, void*) {
+  static_cast<Timer*>(info->si_value.sival_ptr)->fire();
+}
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,77 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _HAL_LINUX_TIMER_H_
+#define _HAL_LINUX_TIMER_H_
+
+/**
+ * Timer
+ *
+ * A compare-match timer built on a POSIX per-process timer. Expiry is
+ * delivered as a realtime signal to the firmware thread, so the attached
+ * handler preempts loop() exactly like a hardware interrupt would, and is
+ * held off by cli() / CRITICAL_SECTION_START.
+ *
+ * Like the 32-bit HALs, the counter restarts from zero at every compare
+ * match and the handler is expected to set the next compare value.
+ */
+
+#include <stdint.h>
+#include <signal.h>
+#include <time.h>
+
+class Timer {
+public:
+  typedef void (*isr_t)(void);
+
+  void init(const uint8_t timer_signal, const uint32_t timer_rate, const isr_t timer_isr, const bool preemptible);
+  void start(const uint32_t frequency);
+
+  void enable();
+  void disable();
+  bool enabled() const { return active; }
+
+  void setCompare(const uint32_t value);
+  uint32_t getCompare() const { return compare; }
+  uint32_t getCount() const;
+
+  // Restart the counter from zero, as a compare match does
+  void restart();
+
+  // Signal set used by cli() / sei() to hold off all timer handlers
+  static sigset_t isr_signals;
+
+private:
+  static void handler(int sig, siginfo_t *info, void *context);
+  void fire();
+  void arm();
+
+  timer_t timerid;
+  uint32_t rate;
+  volatile uint64_t base_ns;  // Time of the last compare match (counter == 0)
+  volatile uint32_t compare;
+  volatile bool active;
+  volatile bool in_isr;
+  isr_t isr;
+};
+
+#endif // _HAL_LINUX_TIMER_H_
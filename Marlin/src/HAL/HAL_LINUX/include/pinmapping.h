@@ -0,0 +1,52 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _PINMAPPING_H_
+#define _PINMAPPING_H_
+
+#include <stdint.h>
+
+#include "../hardware/Gpio.h"
+
+// Arduino Mega numbering, so RAMPS-style pin definitions can be reused
+constexpr uint8_t NUM_DIGITAL_PINS = Gpio::pin_count;
+#define NUM_ANALOG_INPUTS 16
+#define NUM_ANALOG_FIRST 54
+
+// Test whether the pin is one of the simulated pins
+constexpr bool VALID_PIN(const pin_t p) { return p >= 0 && p < NUM_DIGITAL_PINS; }
+
+// Get the digital pin for an analog index
+constexpr pin_t analogInputToDigitalPin(const int8_t p) {
+  return (p < NUM_ANALOG_INPUTS) ? p + NUM_ANALOG_FIRST : -1;
+}
+
+// Get the analog index for a digital pin
+constexpr int8_t DIGITAL_PIN_TO_ANALOG_PIN(const pin_t p) {
+  return (p >= NUM_ANALOG_FIRST && p < NUM_ANALOG_FIRST + NUM_ANALOG_INPUTS) ? p - NUM_ANALOG_FIRST : -1;
+}
+
+#define GET_PIN_MAP_PIN(index) index
+#define GET_PIN_MAP_INDEX(pin) pin
+#define PARSED_PIN_INDEX(code, dval) parser.intval(code, dval)
+
+#endif // _PINMAPPING_H_
@@ -0,0 +1,191 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _HAL_SERIAL_H_
+#define _HAL_SERIAL_H_
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <sched.h>
+
+/**
+ * Generic RingBuffer
+ * T type of the buffer array
+ * S size of the buffer (must be power of 2)
+ */
+template <typename T, uint32_t S> class RingBuffer {
+public:
+  RingBuffer() { index_read = index_write = 0; }
+  uint32_t available() volatile { return buffer_mask & (index_write - index_read); }
+  uint32_t free() volatile      { return buffer_size - 1 - available(); }
+  bool empty() volatile         { return index_read == index_write; }
+  bool full() volatile          { return index_read == (buffer_mask & (index_write + 1)); }
+  void clear() volatile         { index_read = index_write; }
+  bool peek(T *value) volatile {
+    if (value == 0 || empty()) return false;
+    *value = buffer[index_read];
+    return true;
+  }
+  int read() volatile {
+    if (empty()) return -1;
+    const T val = buffer[index_read];
+    index_read = buffer_mask & (index_read + 1);
+    return val;
+  }
+  bool write(T value) volatile {
+    const uint32_t next_head = buffer_mask & (index_write + 1);
+    if (next_head == index_read) return false;
+    buffer[index_write] = value;
+    index_write = next_head;
+    return true;
+  }
+
+private:
+  static const uint32_t buffer_size = S;
+  static const uint32_t buffer_mask = buffer_size - 1;
+  volatile T buffer[buffer_size];
+  volatile uint32_t index_write;
+  volatile uint32_t index_read;
+};
+
+/**
+ * Serial port backed by a pseudo-terminal (or stdin/stdout). The HAL's I/O
+ * thread moves bytes between the host side and these buffers.
+ */
+class HalSerial {
+public:
+  HalSerial() { host_connected = true; }
+
+  void begin(int32_t) {}
+
+  int peek() {
+    uint8_t value;
+    return receive_buffer.peek(&value) ? value : -1;
+  }
+
+  int read() { return receive_buffer.read(); }
+
+  size_t write(char c) {
+    if (!host_connected) return 0;
+    while (!transmit_buffer.write((uint8_t)c)) sched_yield();  // Block like a full hardware TX buffer
+    return 1;
+  }
+
+  operator bool() { return host_connected; }
+
+  uint16_t available() { return (uint16_t)receive_buffer.available(); }
+
+  void flush() { receive_buffer.clear(); }
+
+  uint8_t availableForWrite(void) {
+    return transmit_buffer.free() > 255 ? 255 : (uint8_t)transmit_buffer.free();
+  }
+
+  void flushTX(void) {
+    if (host_connected)
+      while (transmit_buffer.available()) sched_yield();
+  }
+
+  void printf(const char *format, ...) {
+    char buffer[256];
+    va_list vArgs;
+    va_start(vArgs, format);
+    int length = vsnprintf((char *) buffer, 256, (char const *) format, vArgs);
+    va_end(vArgs);
+    if (length > 0 && length < 256)
+      for (int i = 0; i < length; ++i) write(buffer[i]);
+  }
+
+  #define DEC 10
+  #define HEX 16
+  #define OCT 8
+  #define BIN 2
+
+  void print_bin(uint32_t value, uint8_t num_digits) {
+    uint32_t mask = 1 << (num_digits -1);
+    for (uint8_t i = 0; i < num_digits; i++) {
+      if (!(i % 4) && i)    write(' ');
+      if (!(i % 16)  && i)  write(' ');
+      if (value & mask)     write('1');
+      else                  write('0');
+      value <<= 1;
+    }
+  }
+
+  void print(const char value[]) { printf("%s" , value); }
+  void print(char value, int nbase = 0) {
+    if (nbase == BIN) print_bin(value, 8);
+    else if (nbase == OCT) printf("%3o", value);
+    else if (nbase == HEX) printf("%2X", value);
+    else if (nbase == DEC ) printf("%d", value);
+    else printf("%c" , value);
+  }
+  void print(unsigned char value, int nbase = 0) {
+    if (nbase == BIN) print_bin(value, 8);
+    else if (nbase == OCT) printf("%3o", value);
+    else if (nbase == HEX) printf("%2X", value);
+    else printf("%u" , value);
+  }
+  void print(int value, int nbase = 0) {
+    if (nbase == BIN) print_bin(value, 16);
+    else if (nbase == OCT) printf("%6o", value);
+    else if (nbase == HEX) printf("%4X", value);
+    else printf("%d", value);
+  }
+  void print(unsigned int value, int nbase = 0) {
+    if (nbase == BIN) print_bin(value, 16);
+    else if (nbase == OCT) printf("%6o", value);
+    else if (nbase == HEX) printf("%4X", value);
+    else printf("%u" , value);
+  }
+  void print(long value, int nbase = 0) {
+    if (nbase == BIN) print_bin(value, 32);
+    else if (nbase == OCT) printf("%11lo", value);
+    else if (nbase == HEX) printf("%8lX", value);
+    else printf("%ld" , value);
+  }
+  void print(unsigned long value, int nbase = 0) {
+    if (nbase == BIN) print_bin(value, 32);
+    else if (nbase == OCT) printf("%11lo", value);
+    else if (nbase == HEX) printf("%8lX", value);
+    else printf("%lu" , value);
+  }
+  void print(float value, int round = 2)  { printf("%.*f", round, value); }
+  void print(double value, int round = 2) { printf("%.*f", round, value); }
+
+  void println(const char value[]) { printf("%s\n" , value); }
+  void println(char value, int nbase = 0) { print(value, nbase); println(); }
+  void println(unsigned char value, int nbase = 0) { print(value, nbase); println(); }
+  void println(int value, int nbase = 0) { print(value, nbase); println(); }
+  void println(unsigned int value, int nbase = 0) { print(value, nbase); println(); }
+  void println(long value, int nbase = 0) { print(value, nbase); println(); }
+  void println(unsigned long value, int nbase = 0) { print(value, nbase); println(); }
+  void println(float value, int round = 2) { print(value, round); println(); }
+  void println(double value, int round = 2) { print(value, round); println(); }
+  void println(void) { print('\n'); }
+
+  volatile RingBuffer<uint8_t, 1024> receive_buffer;
+  volatile RingBuffer<uint8_t, 4096> transmit_buffer;
+  volatile bool host_connected;
+};
+
+#endif // _HAL_SERIAL_H_
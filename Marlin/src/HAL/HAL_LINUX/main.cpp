@@ -0,0 +1,406 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Linux HAL process entry point
+ *
+ * The firmware runs unmodified on the main thread; the timer ISRs are
+ * signals delivered to it (see hardware/Timer.h). Two helper threads,
+ * which never receive the timer signals, do the rest:
+ *
+ *  - serial: moves bytes between usb_serial and a pseudo-terminal (or stdio)
+ *  - simulation: heater and axis models that close the loop on the pins
+ *
+ * The --benchmark-* options run one of the benchmarks in benchmark/ after
+ * setup(), in place of the main loop.
+ *
+ * Usage: Marlin [--stdio] [--eeprom FILE] [--sdcard IMAGE] [--speedup N] [--benchmark-planner COUNT]
+ *               [--benchmark-sd FILE] [--benchmark-gcode FILE] [--benchmark-delta COUNT]
+ *               [--benchmark-dispatch FILE] [--benchmark-stepper COUNT] [--benchmark-arcs COUNT]
+ *               [--benchmark-abl COUNT] [--benchmark-junction COUNT] [--benchmark-hotend COUNT]
+ *               [--benchmark-ubl COUNT] [--benchmark-eeprom COUNT] [--benchmark-recovery FILE]
+ *               [--benchmark-lcd SECONDS] [--benchmark-serial COUNT]
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "../../inc/MarlinConfig.h"
+#include "../../module/thermistor/thermistors.h"
+#if ENABLED(DOGLCD)
+  #include "../../lcd/ultralcd.h"
+#endif
+
+#include "benchmark/benchmark.h"
+#include "hardware/Clock.h"
+#include "hardware/Heater.h"
+#include "hardware/LinearAxis.h"
+#include "hardware/SDCard.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+extern void setup();
+extern void loop();
+
+extern SDCard sd_card;
+#if ENABLED(EEPROM_SETTINGS)
+  extern const char *eeprom_filename;
+#endif
+
+static int serial_in = -1, serial_out = -1;
+volatile uint32_t host_rate;
+volatile uint64_t host_received;
+
+// Serial I/O thread
+
+static void* serial_thread(void*) {
+  uint8_t buffer[256];
+  uint64_t paced_ns = 0;  // Time up to which a paced host has been sent its bytes
+  for (;;) {
+    bool idle = true;
+
+    const ssize_t received = read(serial_in, buffer, sizeof(buffer));
+    for (ssize_t i = 0; i < received; i++) {
+      while (!usb_serial.receive_buffer.write(buffer[i])) sched_yield();
+      idle = false;
+    }
+
+    // A paced host takes bytes like a UART, one every byte_ns
+    size_t limit = sizeof(buffer);
+    const uint32_t rate = host_rate;
+    const uint64_t byte_ns = rate ? 1000000000ULL / rate : 0;
+    if (rate) {
+      const uint64_t now = Clock::nanos();
+      if (now - paced_ns > byte_ns * sizeof(buffer)) paced_ns = now - byte_ns * sizeof(buffer);
+      limit = (now - paced_ns) / byte_ns;
+    }
+
+    size_t pending = 0;
+    for (int c; pending < limit && (c = usb_serial.transmit_buffer.read()) >= 0;) buffer[pending++] = c;
+    paced_ns += pending * byte_ns;
+    host_received += pending;
+    // Without a terminal attached to the pty the output is dropped, like a USB CDC port
+    if (pending) {
+      const ssize_t sent = write(serial_out, buffer, pending);
+      UNUSED(sent);
+      idle = false;
+    }
+
+    if (idle) Clock::delayNanos(1000000);
+  }
+  return NULL;
+}
+
+// Simulated printer
+
+#if THERMISTORHEATER_0 > 0 || (HOTENDS > 1 && THERMISTORHEATER_1 > 0) || (HAS_HEATED_BED && THERMISTORBED > 0)
+  /**
+   * Convert a temperature to the 10-bit ADC reading the firmware expects,
+   * inverting the configured thermistor table where there is one.
+   */
+  static uint16_t adc_for_table(const short (*table)[2], const uint8_t len, const float celsius) {
+    for (uint8_t i = 1; i < len; i++) {
+      const short raw0 = table[i - 1][0], t0 = table[i - 1][1],
+                  raw1 = table[i][0],     t1 = table[i][1];
+      if ((celsius <= t0) == (celsius >= t1)) {
+        const float raw = t0 == t1 ? raw0 : raw0 + (celsius - t0) * (raw1 - raw0) / (t1 - t0);
+        return constrain(raw / OVERSAMPLENR, 0, 1023);
+      }
+    }
+    return (celsius > table[0][1]) == (table[0][1] > table[len - 1][1]) ? table[0][0] / OVERSAMPLENR : table[len - 1][0] / OVERSAMPLENR;
+  }
+#endif
+
+#if THERMISTORHEATER_0 <= 0 || (HOTENDS > 1 && THERMISTORHEATER_1 <= 0) || (HAS_HEATED_BED && THERMISTORBED <= 0)
+  // 100k NTC, beta 3950, 4.7k pullup
+  static uint16_t adc_for_beta(const float celsius) {
+    const float r = 100000.0 * exp(3950.0 * (1.0 / (celsius + 273.15) - 1.0 / 298.15));
+    return 1023.0 * r / (r + 4700.0);
+  }
+#endif
+
+static uint16_t hotend_sensor(const float celsius) {
+  #if THERMISTORHEATER_0 > 0
+    return adc_for_table(HEATER_0_TEMPTABLE, HEATER_0_TEMPTABLE_LEN, celsius);
+  #else
+    return adc_for_beta(celsius);
+  #endif
+}
+
+#if HOTENDS > 1
+  static uint16_t hotend1_sensor(const float celsius) {
+    #if THERMISTORHEATER_1 > 0
+      return adc_for_table(HEATER_1_TEMPTABLE, HEATER_1_TEMPTABLE_LEN, celsius);
+    #else
+      return adc_for_beta(celsius);
+    #endif
+  }
+#endif
+
+#if HAS_HEATED_BED
+  static uint16_t bed_sensor(const float celsius) {
+    #if THERMISTORBED > 0
+      return adc_for_table(BEDTEMPTABLE, BEDTEMPTABLE_LEN, celsius);
+    #else
+      return adc_for_beta(celsius);
+    #endif
+  }
+#endif
+
+// A 40W cartridge in an aluminium block fed 1.75mm filament, with a
+// thermistor that trails the block by 2s
+Heater simulated_hotend(const pin_t heater, const pin_t adc) {
+  return Heater(heater, adc, hotend_sensor, 40.0, 10.0, 0.1, 0.0056, 2.0);
+}
+
+static void* simulation_thread(void*) {
+  constexpr float steps_per_mm[] = DEFAULT_AXIS_STEPS_PER_UNIT;
+
+  // The hotend, and a 200W bed
+  Heater hotend = simulated_hotend(HEATER_0_PIN, analogInputToDigitalPin(TEMP_0_PIN));
+  #if HOTENDS > 1
+    // A second hotend, heated but never fed
+    Heater hotend1(HEATER_1_PIN, analogInputToDigitalPin(TEMP_1_PIN), hotend1_sensor, 40.0, 10.0, 0.1, 0.0056, 2.0);
+  #endif
+  #if HAS_HEATED_BED
+    Heater bed(HEATER_BED_PIN, analogInputToDigitalPin(TEMP_BED_PIN), bed_sensor, 200.0, 600.0, 1.5);
+  #endif
+
+  #define SIMULATED_AXIS(A, I, MIN_PIN, MAX_PIN) \
+    LinearAxis A##_axis(A##_ENABLE_PIN, A##_DIR_PIN, A##_STEP_PIN, MIN_PIN, MAX_PIN, \
+      A##_MIN_POS * steps_per_mm[I], A##_MAX_POS * steps_per_mm[I], (A##_MIN_POS + A##_MAX_POS) / 2 * steps_per_mm[I], \
+      A##_ENABLE_ON, !INVERT_##A##_DIR, !A##_MIN_ENDSTOP_INVERTING, !A##_MAX_ENDSTOP_INVERTING)
+
+  SIMULATED_AXIS(X, X_AXIS, X_MIN_PIN, X_MAX_PIN);
+  SIMULATED_AXIS(Y, Y_AXIS, Y_MIN_PIN, Y_MAX_PIN);
+  SIMULATED_AXIS(Z, Z_AXIS, Z_MIN_PIN, Z_MAX_PIN);
+
+  LinearAxis E_axis(E0_ENABLE_PIN, E0_DIR_PIN, E0_STEP_PIN, -1, -1, INT32_MIN, INT32_MAX, 0,
+                    E_ENABLE_ON, !INVERT_E0_DIR, false, false);
+  int32_t e_furthest = 0;
+
+  for (;;) {
+    // Filament takes heat from the hotend the first time it's pushed through
+    const int32_t e_position = E_axis.position;
+    float extruded = 0;
+    if (e_position > e_furthest) {
+      extruded = (e_position - e_furthest) / steps_per_mm[E_AXIS];
+      e_furthest = e_position;
+    }
+    hotend.update(extruded);
+    #if HOTENDS > 1
+      hotend1.update();
+    #endif
+    #if HAS_HEATED_BED
+      bed.update();
+    #endif
+    Clock::delayNanos(100000);
+  }
+  return NULL;
+}
+
+static bool open_pty() {
+  const int fd = posix_openpt(O_RDWR | O_NOCTTY);
+  if (fd < 0 || grantpt(fd) || unlockpt(fd)) return false;
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  fprintf(stderr, "Marlin: serial port is %s\n", ptsname(fd));
+  serial_in = serial_out = fd;
+  return true;
+}
+
+static void usage(const char * const name) {
+  fprintf(stderr, "Usage: %s [--stdio] [--eeprom FILE] [--sdcard IMAGE] [--speedup N] [--benchmark-planner COUNT] [--benchmark-sd FILE] [--benchmark-gcode FILE] [--benchmark-delta COUNT] [--benchmark-dispatch FILE] [--benchmark-stepper COUNT] [--benchmark-arcs COUNT] [--benchmark-abl COUNT] [--benchmark-junction COUNT] [--benchmark-hotend COUNT] [--benchmark-ubl COUNT] [--benchmark-eeprom COUNT] [--benchmark-recovery FILE] [--benchmark-lcd SECONDS] [--benchmark-serial COUNT]\n", name);
+  exit(1);
+}
+
+int main(int argc, char **argv) {
+  bool use_stdio = false;
+  const char *sdcard_image = NULL;
+  uint32_t benchmark_blocks = 0, benchmark_stepper_moves = 0, benchmark_serial_count = 0;
+  const char *benchmark_gcode_file = NULL, *benchmark_dispatch_file = NULL;
+  #if ENABLED(PIDTEMP)
+    uint32_t benchmark_hotend_stretches = 0;
+  #endif
+  #if HAS_JUNCTION_BENCHMARK
+    uint32_t benchmark_junction_paths = 0;
+  #endif
+  #if HAS_ARC_BENCHMARK
+    uint32_t benchmark_arc_count = 0;
+  #endif
+  #if HAS_ABL_BENCHMARK
+    uint32_t benchmark_abl_lines = 0;
+  #endif
+  #if HAS_UBL_BENCHMARK
+    uint32_t benchmark_ubl_lines = 0;
+  #endif
+  #if ENABLED(DELTA)
+    uint32_t benchmark_moves = 0;
+  #endif
+  #if ENABLED(SDSUPPORT)
+    char *benchmark_file = NULL;
+  #endif
+  #if ENABLED(POWER_LOSS_RECOVERY)
+    char *benchmark_recovery_file = NULL;
+  #endif
+  #if ENABLED(EEPROM_JOURNAL)
+    uint32_t benchmark_eeprom_saves = 0;
+  #endif
+  #if ENABLED(DOGLCD)
+    uint32_t benchmark_lcd_seconds = 0;
+  #endif
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--stdio")) use_stdio = true;
+    else if (!strcmp(argv[i], "--eeprom") && i + 1 < argc) {
+      #if ENABLED(EEPROM_SETTINGS)
+        eeprom_filename = argv[i + 1];
+      #endif
+      i++;
+    }
+    else if (!strcmp(argv[i], "--sdcard") && i + 1 < argc) sdcard_image = argv[++i];
+    else if (!strcmp(argv[i], "--speedup") && i + 1 < argc) {
+      Clock::speedup = atol(argv[++i]);
+      NOLESS(Clock::speedup, 1U);
+    }
+    else if (!strcmp(argv[i], "--benchmark-planner") && i + 1 < argc) benchmark_blocks = atol(argv[++i]);
+    else if (!strcmp(argv[i], "--benchmark-stepper") && i + 1 < argc) benchmark_stepper_moves = atol(argv[++i]);
+    else if (!strcmp(argv[i], "--benchmark-gcode") && i + 1 < argc) benchmark_gcode_file = argv[++i];
+    else if (!strcmp(argv[i], "--benchmark-dispatch") && i + 1 < argc) benchmark_dispatch_file = argv[++i];
+    else if (!strcmp(argv[i], "--benchmark-serial") && i + 1 < argc) benchmark_serial_count = atol(argv[++i]);
+    #if ENABLED(PIDTEMP)
+      else if (!strcmp(argv[i], "--benchmark-hotend") && i + 1 < argc) benchmark_hotend_stretches = atol(argv[++i]);
+    #endif
+    #if HAS_JUNCTION_BENCHMARK
+      else if (!strcmp(argv[i], "--benchmark-junction") && i + 1 < argc) benchmark_junction_paths = atol(argv[++i]);
+    #endif
+    #if HAS_ARC_BENCHMARK
+      else if (!strcmp(argv[i], "--benchmark-arcs") && i + 1 < argc) benchmark_arc_count = atol(argv[++i]);
+    #endif
+    #if HAS_ABL_BENCHMARK
+      else if (!strcmp(argv[i], "--benchmark-abl") && i + 1 < argc) benchmark_abl_lines = atol(argv[++i]);
+    #endif
+    #if HAS_UBL_BENCHMARK
+      else if (!strcmp(argv[i], "--benchmark-ubl") && i + 1 < argc) benchmark_ubl_lines = atol(argv[++i]);
+    #endif
+    #if ENABLED(DELTA)
+      else if (!strcmp(argv[i], "--benchmark-delta") && i + 1 < argc) benchmark_moves = atol(argv[++i]);
+    #endif
+    #if ENABLED(SDSUPPORT)
+      else if (!strcmp(argv[i], "--benchmark-sd") && i + 1 < argc) benchmark_file = argv[++i];
+    #endif
+    #if ENABLED(POWER_LOSS_RECOVERY)
+      else if (!strcmp(argv[i], "--benchmark-recovery") && i + 1 < argc) benchmark_recovery_file = argv[++i];
+    #endif
+    #if ENABLED(EEPROM_JOURNAL)
+      else if (!strcmp(argv[i], "--benchmark-eeprom") && i + 1 < argc) benchmark_eeprom_saves = atol(argv[++i]);
+    #endif
+    #if ENABLED(DOGLCD)
+      else if (!strcmp(argv[i], "--benchmark-lcd") && i + 1 < argc) benchmark_lcd_seconds = atol(argv[++i]);
+    #endif
+    else usage(argv[0]);
+  }
+
+  if (use_stdio) {
+    serial_in = STDIN_FILENO;
+    serial_out = STDOUT_FILENO;
+    fcntl(serial_in, F_SETFL, fcntl(serial_in, F_GETFL) | O_NONBLOCK);
+  }
+  else if (!open_pty()) {
+    perror("Marlin: unable to open a pseudo-terminal");
+    return 1;
+  }
+
+  if (sdcard_image && !sd_card.open(sdcard_image)) {
+    fprintf(stderr, "Marlin: unable to open SD card image %s\n", sdcard_image);
+    return 1;
+  }
+
+  // Helper threads inherit the signal mask, so keep the timer ISRs off them
+  HAL_timer_init();
+  pthread_sigmask(SIG_BLOCK, &Timer::isr_signals, NULL);
+
+  pthread_t serial_id, simulation_id;
+  pthread_create(&serial_id, NULL, serial_thread, NULL);
+  pthread_create(&simulation_id, NULL, simulation_thread, NULL);
+
+  pthread_sigmask(SIG_UNBLOCK, &Timer::isr_signals, NULL);
+
+  #if ENABLED(DOGLCD)
+    // Released buttons read high through their pullups
+    #if BUTTON_EXISTS(EN1)
+      Gpio::drive(BTN_EN1, HIGH);
+    #endif
+    #if BUTTON_EXISTS(EN2)
+      Gpio::drive(BTN_EN2, HIGH);
+    #endif
+    #if BUTTON_EXISTS(ENC)
+      Gpio::drive(BTN_ENC, HIGH);
+    #endif
+    #if HAS_KILL
+      Gpio::drive(KILL_PIN, HIGH);
+    #endif
+  #endif
+
+  setup();
+  if (benchmark_blocks) benchmark_planner(benchmark_blocks);
+  if (benchmark_stepper_moves) benchmark_stepper(benchmark_stepper_moves);
+  if (benchmark_gcode_file) benchmark_gcode(benchmark_gcode_file);
+  if (benchmark_dispatch_file) benchmark_dispatch(benchmark_dispatch_file);
+  if (benchmark_serial_count) benchmark_serial(benchmark_serial_count);
+  #if ENABLED(PIDTEMP)
+    if (benchmark_hotend_stretches) benchmark_hotend(benchmark_hotend_stretches);
+  #endif
+  #if HAS_JUNCTION_BENCHMARK
+    if (benchmark_junction_paths) benchmark_junction(benchmark_junction_paths);
+  #endif
+  #if HAS_ARC_BENCHMARK
+    if (benchmark_arc_count) benchmark_arcs(benchmark_arc_count);
+  #endif
+  #if HAS_ABL_BENCHMARK
+    if (benchmark_abl_lines) benchmark_abl(benchmark_abl_lines);
+  #endif
+  #if HAS_UBL_BENCHMARK
+    if (benchmark_ubl_lines) benchmark_ubl(benchmark_ubl_lines);
+  #endif
+  #if ENABLED(DELTA)
+    if (benchmark_moves) benchmark_delta(benchmark_moves);
+  #endif
+  #if ENABLED(SDSUPPORT)
+    if (benchmark_file) benchmark_sd(benchmark_file);
+  #endif
+  #if ENABLED(POWER_LOSS_RECOVERY)
+    if (benchmark_recovery_file) benchmark_recovery(benchmark_recovery_file);
+  #endif
+  #if ENABLED(EEPROM_JOURNAL)
+    if (benchmark_eeprom_saves) benchmark_eeprom(benchmark_eeprom_saves);
+  #endif
+  #if ENABLED(DOGLCD)
+    if (benchmark_lcd_seconds) benchmark_lcd(benchmark_lcd_seconds);
+  #endif
+  for (;;) loop();
+}
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,150 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(EEPROM_SETTINGS)
+
+#include "../persistent_store_api.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// EEPROM is emulated with a plain file, set with --eeprom (see main.cpp)
+const char *eeprom_filename = "eeprom.dat";
+
+#if ENABLED(EEPROM_JOURNAL)
+
+// The file holds the two flash banks of the EEPROM journal instead
+#include "../persistent_store_journal.h"
+#include "hardware/FlashMemory.h"
+
+FlashMemory flash_memory;
+
+namespace HAL {
+namespace JournalFlash {
+
+static void flash_open() {
+  static bool opened = false;
+  if (!opened) opened = flash_memory.open(eeprom_filename);
+}
+
+static_assert(FlashMemory::bank_size == JOURNAL_BANK_SIZE, "JOURNAL_BANK_SIZE must match the simulated flash.");
+
+uint32_t bank_size() { return JOURNAL_BANK_SIZE; }
+
+bool erase(const uint8_t bank) {
+  flash_open();
+  return flash_memory.erase(bank);
+}
+
+bool program(const uint8_t bank, const uint32_t offset, const uint8_t *data, const uint16_t size) {
+  flash_open();
+  return flash_memory.program(bank, offset, data, size);
+}
+
+void read(const uint8_t bank, const uint32_t offset, uint8_t *data, const uint16_t size) {
+  flash_open();
+  flash_memory.read(bank, offset, data, size);
+}
+
+} // JournalFlash
+} // HAL
+
+// Direct reads, e.g. for the G29 EEPROM dump, come from the journal's image
+void eeprom_read_block(void *__dst, const void *__src, size_t __n) {
+  int pos = (int)(intptr_t)__src;
+  uint16_t crc = 0;
+  HAL::PersistentStore::access_start();
+  if (HAL::PersistentStore::read_data(pos, (uint8_t*)__dst, __n, &crc)) memset(__dst, 0xFF, __n);
+  HAL::PersistentStore::access_finish();
+}
+
+#else // !EEPROM_JOURNAL
+
+namespace HAL {
+namespace PersistentStore {
+
+static FILE *eeprom_file = NULL;
+
+bool access_start() {
+  eeprom_file = fopen(eeprom_filename, "r+b");
+  if (eeprom_file == NULL) eeprom_file = fopen(eeprom_filename, "w+b");
+  if (eeprom_file == NULL) return false;
+
+  // Pad a new or short file with the erased value
+  fseek(eeprom_file, 0, SEEK_END);
+  for (long file_size = ftell(eeprom_file); file_size <= E2END; file_size++)
+    fputc(0xFF, eeprom_file);
+  fflush(eeprom_file);
+  return true;
+}
+
+bool access_finish() {
+  if (eeprom_file == NULL) return false;
+  fclose(eeprom_file);
+  eeprom_file = NULL;
+  return true;
+}
+
+bool write_data(int &pos, const uint8_t *value, uint16_t size, uint16_t *crc) {
+  if (pos < 0 || pos + size > E2END + 1 || fseek(eeprom_file, pos, SEEK_SET)) return true;
+  const size_t bytes_written = fwrite(value, 1, size, eeprom_file);
+  crc16(crc, value, size);
+  pos += size;
+  return bytes_written != size;  // return true for any error
+}
+
+bool read_data(int &pos, uint8_t* value, uint16_t size, uint16_t *crc, const bool writing/*=true*/) {
+  if (pos < 0 || pos + size > E2END + 1 || fseek(eeprom_file, pos, SEEK_SET)) return true;
+  while (size--) {
+    const int c = fgetc(eeprom_file);
+    if (c == EOF) return true;
+    const uint8_t v = c;
+    if (writing) *value = v;
+    crc16(crc, &v, 1);
+    pos++;
+    value++;
+  }
+  return false;
+}
+
+} // PersistentStore
+} // HAL
+
+// Direct reads, e.g. for the G29 EEPROM dump. Bytes past the file read as erased.
+void eeprom_read_block(void *__dst, const void *__src, size_t __n) {
+  memset(__dst, 0xFF, __n);
+  FILE * const file = fopen(eeprom_filename, "rb");
+  if (file == NULL) return;
+  if (!fseek(file, (long)__src, SEEK_SET)) {
+    const size_t bytes_read = fread(__dst, 1, __n, file);
+    UNUSED(bytes_read);
+  }
+  fclose(file);
+}
+
+#endif // !EEPROM_JOURNAL
+#endif // EEPROM_SETTINGS
+#endif // __PLAT_LINUX__
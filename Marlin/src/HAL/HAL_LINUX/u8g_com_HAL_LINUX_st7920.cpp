@@ -0,0 +1,71 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * u8g com function for the ST7920 devices on the Linux HAL, which writes
+ * into a simulated display (hardware/ST7920.h) instead of pins, so the
+ * pages the LCD code sends can be checked and counted.
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(DOGLCD)
+
+#include <U8glib.h>
+#include "hardware/ST7920.h"
+
+ST7920 lcd_st7920;
+
+uint8_t u8g_com_HAL_LINUX_st7920_fn(u8g_t *u8g, uint8_t msg, uint8_t arg_val, void *arg_ptr) {
+  switch (msg) {
+    case U8G_COM_MSG_INIT:
+      lcd_st7920.reset();
+      u8g->pin_list[U8G_PI_A0_STATE] = 0;   // Command mode
+      break;
+
+    case U8G_COM_MSG_ADDRESS:               // Command (arg_val = 0) or data (arg_val = 1) mode
+      u8g->pin_list[U8G_PI_A0_STATE] = arg_val;
+      break;
+
+    case U8G_COM_MSG_WRITE_BYTE:
+      lcd_st7920.write(u8g->pin_list[U8G_PI_A0_STATE], arg_val);
+      break;
+
+    case U8G_COM_MSG_WRITE_SEQ:
+    case U8G_COM_MSG_WRITE_SEQ_P: {         // Program memory is ordinary memory here
+      const uint8_t *ptr = (const uint8_t*)arg_ptr;
+      while (arg_val--) lcd_st7920.write(u8g->pin_list[U8G_PI_A0_STATE], *ptr++);
+    } break;
+
+    case U8G_COM_MSG_STOP:
+    case U8G_COM_MSG_RESET:
+    case U8G_COM_MSG_CHIP_SELECT:
+      break;
+  }
+  return 1;
+}
+
+#endif // DOGLCD
+
+#endif // __PLAT_LINUX__
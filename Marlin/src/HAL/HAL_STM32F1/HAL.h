@@ -210,6 +210,11 @@ unsigned char eeprom_read_byte(unsigned char *pos);
 void eeprom_read_block (void *__dst, const void *__src, size_t __n);
 void eeprom_update_block (const void *__src, void *__dst, size_t __n);
 
+#if ENABLED(EEPROM_JOURNAL)
+  #include <EEPROM.h>
+  #define JOURNAL_BANK_SIZE EEPROM_PAGE_SIZE  // Each bank is one of the two EEPROM pages, 1K or 2K
+#endif
+
 // ADC
 
 #define HAL_ANALOG_SELECT(pin) pinMode(pin, INPUT_ANALOG);
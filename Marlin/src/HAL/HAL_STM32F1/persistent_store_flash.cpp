@@ -39,6 +39,43 @@
 #include <flash_stm32.h>
 #include <EEPROM.h>
 
+#if ENABLED(EEPROM_JOURNAL)
+
+// Flash driver for the EEPROM journal, with the two EEPROM pages as its banks
+#include "../persistent_store_journal.h"
+
+namespace HAL {
+namespace JournalFlash {
+
+static uint32_t bank_base(const uint8_t bank) { return bank ? EEPROM_PAGE1_BASE : EEPROM_PAGE0_BASE; }
+
+uint32_t bank_size() { return JOURNAL_BANK_SIZE; }
+
+bool erase(const uint8_t bank) {
+  FLASH_Unlock();
+  const FLASH_Status status = FLASH_ErasePage(bank_base(bank));
+  FLASH_Lock();
+  return status != FLASH_COMPLETE;
+}
+
+bool program(const uint8_t bank, const uint32_t offset, const uint8_t *data, const uint16_t size) {
+  FLASH_Status status = FLASH_COMPLETE;
+  FLASH_Unlock();
+  for (uint16_t i = 0; i < size && status == FLASH_COMPLETE; i += 2)
+    status = FLASH_ProgramHalfWord(bank_base(bank) + offset + i, data[i] | (data[i + 1] << 8));
+  FLASH_Lock();
+  return status != FLASH_COMPLETE;
+}
+
+void read(const uint8_t bank, const uint32_t offset, uint8_t *data, const uint16_t size) {
+  memcpy(data, (const uint8_t*)(bank_base(bank) + offset), size);
+}
+
+} // JournalFlash
+} // HAL
+
+#else // !EEPROM_JOURNAL
+
 namespace HAL {
 namespace PersistentStore {
 
@@ -106,5 +143,6 @@ void read_data(int &pos, uint8_t* value, uint16_t size, uint16_t *crc, const boo
 } // PersistentStore
 } // HAL
 
+#endif // !EEPROM_JOURNAL
 #endif // EEPROM_SETTINGS && EEPROM FLASH
 #endif // __STM32F1__
@@ -0,0 +1,287 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Description: log-structured EEPROM emulation for flash, on top of the
+ * HAL's JournalFlash driver. Not platform dependent.
+ *
+ * Bank layout:
+ *
+ *   journal_bank_t    magic, sequence, crc
+ *   journal_record_t  key (EEPROM address), size, crc, then size bytes
+ *   ...
+ *   journal_record_t  JOURNAL_KEY_COMMIT, closing the records of one save
+ *   ...               erased (0xFF) up to the end of the bank
+ *
+ * The header is written last when a bank is compacted, so a bank with a
+ * valid header holds a complete image. Records after the last commit are
+ * ignored when the bank is replayed.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(EEPROM_SETTINGS) && ENABLED(EEPROM_JOURNAL)
+
+#include "persistent_store_api.h"
+#include "persistent_store_journal.h"
+
+#ifndef E2END
+  #define E2END 0xFFF // Flash emulation with no EEPROM size of its own
+#endif
+
+#define JOURNAL_IMAGE_SIZE  (E2END + 1)
+#define JOURNAL_WORDS       (JOURNAL_IMAGE_SIZE / 4)
+#define JOURNAL_MAGIC       0x4A4C524DUL  // "MRLJ"
+#define JOURNAL_KEY_COMMIT  0xFFFE
+#define JOURNAL_KEY_ERASED  0xFFFF
+#define JOURNAL_MAX_GAP     2             // Unchanged words included in a record, rather than paying for another header
+
+static_assert(!(JOURNAL_IMAGE_SIZE & 3), "The EEPROM journal needs an EEPROM size that is a multiple of 4.");
+
+namespace HAL {
+namespace PersistentStore {
+
+typedef struct {
+  uint32_t magic;
+  uint16_t sequence,  // The valid bank with the newest sequence is the active one
+           crc;       // Of magic and sequence
+} journal_bank_t;
+
+typedef struct {
+  uint16_t key,       // EEPROM address of the data, or JOURNAL_KEY_COMMIT
+           size,      // Bytes of data following the record
+           crc,       // Of key, size and the data
+           reserved;  // Left erased
+} journal_record_t;
+
+static_assert(sizeof(journal_bank_t) == 8 && sizeof(journal_record_t) == 8, "JOURNAL_BANK_NEEDS counts 8 bytes per header.");
+
+static uint8_t image[JOURNAL_IMAGE_SIZE],   // The EEPROM contents
+               dirty[JOURNAL_WORDS / 8];    // Words changed since the last commit, one bit each
+static bool mounted, any_dirty;
+static uint8_t bank;                        // Active bank
+static uint16_t sequence;                   // Sequence of the active bank
+static uint32_t head;                       // First free byte of the active bank
+
+static inline uint32_t padded(const uint16_t size) { return (size + 3UL) & ~3UL; }
+
+static uint16_t record_crc(const uint8_t b, const uint32_t offset, const journal_record_t &record) {
+  uint16_t crc = 0;
+  crc16(&crc, &record, 2 * sizeof(uint16_t));
+  uint8_t chunk[32];
+  for (uint16_t done = 0; done < record.size;) {
+    const uint16_t n = record.size - done < (int)sizeof(chunk) ? record.size - done : sizeof(chunk);
+    JournalFlash::read(b, offset + sizeof(record) + done, chunk, n);
+    crc16(&crc, chunk, n);
+    done += n;
+  }
+  return crc;
+}
+
+static bool read_bank_header(const uint8_t b, uint16_t &seq) {
+  journal_bank_t header;
+  JournalFlash::read(b, 0, (uint8_t*)&header, sizeof(header));
+  uint16_t crc = 0;
+  crc16(&crc, &header, offsetof(journal_bank_t, crc));
+  seq = header.sequence;
+  return header.magic == JOURNAL_MAGIC && header.crc == crc;
+}
+
+/**
+ * Replay the committed records of the active bank into the image, and find
+ * where the next save goes. A torn record or uncommitted records at the end
+ * leave bytes that can't be programmed again, so the next save compacts.
+ */
+static void replay() {
+  const uint32_t bank_size = JournalFlash::bank_size();
+  uint32_t offset = sizeof(journal_bank_t), committed = offset;
+  bool erased = false;
+  for (;;) {
+    journal_record_t record;
+    if (offset + sizeof(record) > bank_size) break;
+    JournalFlash::read(bank, offset, (uint8_t*)&record, sizeof(record));
+    if (record.key == JOURNAL_KEY_ERASED && record.size == 0xFFFF && record.crc == 0xFFFF && record.reserved == 0xFFFF) {
+      erased = true;
+      break;
+    }
+    const uint32_t next = offset + sizeof(record) + padded(record.size);
+    if (next > bank_size) break;
+    if (record.key != JOURNAL_KEY_COMMIT && (uint32_t)record.key + record.size > JOURNAL_IMAGE_SIZE) break;
+    if (record.crc != record_crc(bank, offset, record)) break;
+    offset = next;
+    if (record.key == JOURNAL_KEY_COMMIT) committed = offset;
+  }
+
+  for (uint32_t o = sizeof(journal_bank_t); o < committed;) {
+    journal_record_t record;
+    JournalFlash::read(bank, o, (uint8_t*)&record, sizeof(record));
+    if (record.key != JOURNAL_KEY_COMMIT) JournalFlash::read(bank, o + sizeof(record), &image[record.key], record.size);
+    o += sizeof(record) + padded(record.size);
+  }
+
+  head = (erased && offset == committed) ? committed : bank_size;
+}
+
+static void mount() {
+  memset(image, 0xFF, sizeof(image));
+  memset(dirty, 0, sizeof(dirty));
+  any_dirty = false;
+  mounted = true;
+
+  uint16_t seq0, seq1;
+  const bool valid0 = read_bank_header(0, seq0), valid1 = read_bank_header(1, seq1);
+  if (!valid0 && !valid1) {
+    // Blank or foreign flash. The first save compacts into bank 0.
+    bank = 1;
+    sequence = 0;
+    head = JournalFlash::bank_size();
+    return;
+  }
+  bank = valid1 && (!valid0 || (int16_t)(seq1 - seq0) > 0);
+  sequence = bank ? seq1 : seq0;
+  replay();
+}
+
+void journal_unmount() { mounted = false; }
+
+static bool append(const uint8_t b, uint32_t &offset, const uint16_t key, const uint8_t *data, const uint16_t size) {
+  journal_record_t record = { key, size, 0, 0xFFFF };
+  crc16(&record.crc, &record, 2 * sizeof(uint16_t));
+  crc16(&record.crc, data, size);
+  if (JournalFlash::program(b, offset, (uint8_t*)&record, sizeof(record))) return true;
+  if (size && JournalFlash::program(b, offset + sizeof(record), data, size)) return true;
+  offset += sizeof(record) + size;
+  return false;
+}
+
+// A word goes into the log if it changed, or when compacting, if it isn't erased
+static inline bool selected(const uint16_t word, const bool compacting) {
+  if (!compacting) return TEST(dirty[word >> 3], word & 7);
+  const uint8_t * const p = &image[word << 2];
+  return (p[0] & p[1] & p[2] & p[3]) != 0xFF;
+}
+
+// Find the next run of selected words from 'word'. Return false when there are none.
+static bool next_run(uint16_t &word, uint16_t &count, const bool compacting) {
+  while (word < JOURNAL_WORDS && !selected(word, compacting)) word++;
+  if (word >= JOURNAL_WORDS) return false;
+  uint16_t end = word + 1;
+  for (uint16_t w = end, gap = 0; w < JOURNAL_WORDS && gap <= JOURNAL_MAX_GAP; w++) {
+    if (selected(w, compacting)) { end = w + 1; gap = 0; }
+    else gap++;
+  }
+  count = end - word;
+  return true;
+}
+
+/**
+ * Write the whole image into the other bank and switch to it. The old bank
+ * stays valid until the new header is written, and is erased only by the
+ * next compaction, so the banks take turns.
+ */
+static bool compact() {
+  const uint8_t target = !bank;
+  const uint32_t bank_size = JournalFlash::bank_size();
+  if (JournalFlash::erase(target)) return true;
+
+  uint32_t offset = sizeof(journal_bank_t);
+  uint16_t count;
+  for (uint16_t word = 0; next_run(word, count, true); word += count) {
+    if (offset + 2 * sizeof(journal_record_t) + count * 4UL > bank_size) return true; // The image doesn't fit
+    if (append(target, offset, word * 4, &image[word * 4], count * 4)) return true;
+  }
+  if (append(target, offset, JOURNAL_KEY_COMMIT, NULL, 0)) return true;
+
+  journal_bank_t header = { JOURNAL_MAGIC, (uint16_t)(sequence + 1), 0 };
+  crc16(&header.crc, &header, offsetof(journal_bank_t, crc));
+  if (JournalFlash::program(target, 0, (uint8_t*)&header, sizeof(header))) return true;
+
+  bank = target;
+  sequence++;
+  head = offset;
+  return false;
+}
+
+// Append the changed words and a commit record, compacting when the bank is full
+static bool commit() {
+  uint32_t needed = sizeof(journal_record_t);
+  uint16_t count;
+  for (uint16_t word = 0; next_run(word, count, false); word += count)
+    needed += sizeof(journal_record_t) + count * 4UL;
+
+  bool error = true;
+  if (head + needed <= JournalFlash::bank_size()) {
+    uint32_t offset = head;
+    error = false;
+    for (uint16_t word = 0; !error && next_run(word, count, false); word += count)
+      error = append(bank, offset, word * 4, &image[word * 4], count * 4);
+    if (!error) error = append(bank, offset, JOURNAL_KEY_COMMIT, NULL, 0);
+    head = error ? JournalFlash::bank_size() : offset;
+  }
+  if (error) error = compact();
+
+  if (!error) {
+    memset(dirty, 0, sizeof(dirty));
+    any_dirty = false;
+  }
+  return error;
+}
+
+bool access_start() {
+  if (!mounted) mount();
+  return true;
+}
+
+bool access_finish() {
+  return !any_dirty || !commit();
+}
+
+bool write_data(int &pos, const uint8_t *value, uint16_t size, uint16_t *crc) {
+  if (!mounted) mount();
+  if (pos < 0 || pos + size > JOURNAL_IMAGE_SIZE) return true;
+  crc16(crc, value, size);
+  while (size--) {
+    // Only bytes that have changed go into the log
+    if (image[pos] != *value) {
+      image[pos] = *value;
+      SBI(dirty[pos >> 5], (pos >> 2) & 7);
+      any_dirty = true;
+    }
+    pos++;
+    value++;
+  }
+  return false;
+}
+
+bool read_data(int &pos, uint8_t* value, uint16_t size, uint16_t *crc, const bool writing/*=true*/) {
+  if (!mounted) mount();
+  if (pos < 0 || pos + size > JOURNAL_IMAGE_SIZE) return true;
+  crc16(crc, &image[pos], size);
+  if (writing) memcpy(value, &image[pos], size);
+  pos += size;
+  return false;
+}
+
+} // PersistentStore
+} // HAL
+
+#endif // EEPROM_SETTINGS && EEPROM_JOURNAL
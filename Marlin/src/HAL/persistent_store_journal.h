@@ -0,0 +1,69 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _PERSISTENT_STORE_JOURNAL_H_
+#define _PERSISTENT_STORE_JOURNAL_H_
+
+/**
+ * EEPROM journal
+ *
+ * Implements HAL::PersistentStore for EEPROM emulated in flash. The EEPROM
+ * image lives in RAM, and the bytes changed between access_start() and
+ * access_finish() are appended to a log in one of two flash banks, as
+ * records keyed by their EEPROM address, followed by a commit record. Only
+ * when the active bank is full is the image compacted into the other bank,
+ * so a bank is erased once per many saves instead of on every M500, and a
+ * save interrupted by a reset leaves the previous settings in place.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+// The bytes of a bank holding SIZE bytes of data in RECORDS records: the bank header, a header per record and the commit
+#define JOURNAL_BANK_NEEDS(SIZE, RECORDS) (8UL + 8UL * ((RECORDS) + 1) + (((SIZE) + 3UL) & ~3UL) + 4UL * (RECORDS))
+
+namespace HAL {
+
+/**
+ * Flash driver, provided by the HAL: two banks of bank_size() bytes that
+ * erase to 0xFF. Offsets and sizes given to program() are multiples of 4.
+ * erase() and program() return true for any error, like write_data().
+ * The HAL also defines JOURNAL_BANK_SIZE, the bank size at compile time.
+ */
+namespace JournalFlash {
+
+uint32_t bank_size();
+bool erase(const uint8_t bank);
+bool program(const uint8_t bank, const uint32_t offset, const uint8_t *data, const uint16_t size);
+void read(const uint8_t bank, const uint32_t offset, uint8_t *data, const uint16_t size);
+
+} // JournalFlash
+
+namespace PersistentStore {
+
+// Drop the RAM image, so the next access reads the flash again, as after a reset
+void journal_unmount();
+
+} // PersistentStore
+} // HAL
+
+#endif // _PERSISTENT_STORE_JOURNAL_H_
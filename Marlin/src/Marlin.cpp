@@ -36,6 +36,7 @@
 #include "module/stepper.h"
 #include "module/endstops.h"
 #include "module/probe.h"
+#include "module/segment_producer.h"
 #include "module/temperature.h"
 #include "sd/cardreader.h"
 #include "module/configuration_store.h"
@@ -154,6 +155,14 @@
   #include "feature/controllerfan.h"
 #endif
 
+#if ENABLED(STEP_TIMELINE)
+  #include "feature/step_timeline.h"
+#endif
+
+#if ENABLED(CODE_PROFILER)
+  #include "feature/profiler.h"
+#endif
+
 bool Running = true;
 
 /**
@@ -273,6 +282,7 @@ bool pin_is_protected(const pin_t pin) {
 }
 
 void quickstop_stepper() {
+  segment_feed.abort();
   stepper.quick_stop();
   stepper.synchronize();
   set_current_from_steppers_for_axis(ALL_AXES);
@@ -520,6 +530,10 @@ void idle(
     bool no_stepper_sleep/*=false*/
   #endif
 ) {
+  #if ENABLED(CODE_PROFILER)
+    PROFILE_ZONE(PROFILE_IDLE);
+  #endif
+
   #if ENABLED(MAX7219_DEBUG)
     Max7219_idle_tasks();
   #endif  // MAX7219_DEBUG
@@ -661,6 +675,10 @@ void setup() {
     Max7219_init();
   #endif
 
+  #if ENABLED(CODE_PROFILER)
+    profiler.reset();
+  #endif
+
   #if ENABLED(DISABLE_JTAG)
     // Disable JTAG on AT90USB chips to free up pins for IO
     MCUCR = 0x80;
@@ -931,7 +949,17 @@ void loop() {
     #endif // SDSUPPORT && ULTIPANEL
 
     if (commands_in_queue < BUFSIZE) get_available_commands();
-    advance_command_queue();
+
+    // Commands wait while a move is still being cut into segments
+    if (segment_feed.busy())
+      segment_feed.run();
+    else
+      advance_command_queue();
+
+    #if ENABLED(STEP_TIMELINE)
+      step_timeline.stream(); // Between commands, so not within a line
+    #endif
+
     endstops.report_state();
     idle();
   }
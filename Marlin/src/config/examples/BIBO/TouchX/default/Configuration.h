@@ -615,6 +615,20 @@ const bool Z_MIN_PROBE_ENDSTOP_INVERTING = true; // set to true to invert the lo
 #define DEFAULT_ZJERK                  0.65
 #define DEFAULT_EJERK                  5.0
 
+/**
+ * Junction Deviation
+ *
+ * Limit the speed through a corner by how far (mm) a circle tangent to
+ * both moves stays from the corner, instead of by the Jerk of each axis,
+ * so cornering speed follows the angle of the path.
+ * E Jerk still limits the change in extrusion speed at a junction.
+ * Override with M205 J
+ */
+//#define JUNCTION_DEVIATION
+#if ENABLED(JUNCTION_DEVIATION)
+  #define JUNCTION_DEVIATION_MM 0.02  // (mm) Distance from real junction edge
+#endif
+
 /**
  * Realtime Jerk Control
  *
@@ -1194,6 +1208,7 @@ const bool Z_MIN_PROBE_ENDSTOP_INVERTING = true; // set to true to invert the lo
 #define EEPROM_SETTINGS // Enable for M500 and M501 commands
 //#define DISABLE_M503    // Saves ~2700 bytes of PROGMEM. Disable for release!
 #define EEPROM_CHITCHAT   // Give feedback on EEPROM commands. Disable to save PROGMEM.
+//#define EEPROM_JOURNAL    // Flash-emulated EEPROM: log only changed settings, erasing flash far less often.
 
 //
 // Host Keepalive
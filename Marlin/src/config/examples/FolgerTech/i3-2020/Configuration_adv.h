@@ -116,8 +116,41 @@
     #define DEFAULT_Kc (100) //heating power=Kc*(e_speed)
     #define LPQ_MAX_LEN 50
   #endif
+
+  /**
+   * Model predictive hotend temperature control. Replaces the PID with a
+   * thermal model of the heater block and its sensor,
+   *
+   *   C * dT/dt = P * duty - (A + H * e_rate) * (T - T_ambient)
+   *
+   * and sets the heater power that brings the modeled block to the target.
+   * The heat taken by the filament, H * e_rate, is supplied ahead of time
+   * from the extrusion rate of the moves queued in the planner.
+   *
+   * Identify C, A and the sensor lag with M306 T and save them with M500.
+   */
+  //#define MPCTEMP
+  #if ENABLED(MPCTEMP)
+    #define MPC_HEATER_POWER 40.0                 // (W) Heater cartridge power at full duty (M306 P)
+    #define MPC_BLOCK_HEAT_CAPACITY 16.7          // (J/K) Heat capacity of the heater block (M306 C)
+    #define MPC_SENSOR_RESPONSIVENESS 0.22        // (1/s) How fast the sensor follows the block (M306 R)
+    #define MPC_AMBIENT_XFER_COEFF 0.068          // (W/K) Heat lost to the surroundings (M306 A)
+    #define MPC_FILAMENT_HEAT_CAPACITY 0.0056     // (J/K/mm) Heat taken by 1mm of filament: 0.0056 for 1.75mm PLA, 0.0143 for 2.85mm (M306 H)
+    #define MPC_SMOOTHING_FACTOR 0.5              // (0..1) Share of the difference from a new reading taken into the model
+    #define MPC_MIN_AMBIENT_CHANGE 1.0            // (K/s) Least rate the ambient temperature follows unmodeled losses like a part fan
+    #define MPC_LOOKAHEAD_TIME 1.0                // (s) Queued moves to average the extrusion rate over
+    #define MPC_TUNING_TEMP 200                   // (Degrees Celsius) M306 T heats the hotend to this temperature
+  #endif
 #endif
 
+/**
+ * PID autotune from a step response. M303 F heats once at full power, fits
+ * a first-order-plus-dead-time model to the rise and derives the PID
+ * constants from it, instead of timing several relay cycles. M303 F R
+ * refines the model with a single relay cycle around the target.
+ */
+//#define PID_AUTOTUNE_FIT
+
 /**
  * Automatic Temperature:
  * The hotend target temperature is calculated by all the buffered lines of gcode.
@@ -558,10 +591,10 @@
   /**
    * Continue after Power-Loss (Creality3D)
    *
-   * Store the current state to the SD Card at the start of each layer
-   * during SD printing. If the recovery file is found at boot time, present
-   * an option on the LCD screen to continue the print from the last-known
-   * point in the file.
+   * Journal the state after each command during SD printing, to a file on
+   * the SD Card written a block at a time. If an unfinished print is found
+   * at boot time, present an option on the LCD screen to continue the print
+   * from the last-known point in the file.
    */
   //#define POWER_LOSS_RECOVERY
 
@@ -664,6 +697,10 @@
   // The normal delay is 10µs. Use the lowest value that still gives a reliable display.
   //#define DOGM_SPI_DELAY_US 5
 
+  // Redraw and send only the stripes of the Info Screen whose values have changed.
+  // Cuts most of the display traffic while printing, for a little PROGMEM.
+  //#define DOGM_DIRTY_STRIPES
+
   // Swap the CW/CCW indicators in the graphics overlay
   //#define OVERLAY_GFX_REVERSE
 
@@ -788,6 +825,8 @@
 #define ARC_SUPPORT               // Disable this feature to save ~3226 bytes
 #if ENABLED(ARC_SUPPORT)
   #define MM_PER_ARC_SEGMENT  1   // Length of each arc segment
+  //#define ARC_CHORD_TOLERANCE 0.01 // (mm) Instead, use the longest segments that stay this close to the arc. Set with M214 P
+  #define ARC_MIN_SEGMENT_TIME  5   // (ms) With ARC_CHORD_TOLERANCE, segments last at least this long. Set with M214 S
   #define N_ARC_CORRECTION   25   // Number of intertpolated segments between corrections
   //#define ARC_P_CIRCLES         // Enable the 'P' parameter to specify complete circles
   //#define CNC_WORKSPACE_PLANES  // Allow G2/G3 to operate in XY, ZX, or YZ planes
@@ -811,6 +850,29 @@
 // 0 is OK for AVR, 0 is OK for A4989 drivers, 2 is needed for DRV8825 drivers
 #define MINIMUM_STEPPER_PULSE 2 // (µs)   DRV8825 on 32bit CPUs
 
+// Compute the step events of a move ahead into a buffer of this many
+// entries (a power of 2), so the stepper ISR only has to emit them.
+// The Bresenham and speed calculations then run in one pass per buffer
+// instead of once per ISR, and above the double stepping rate bursts of
+// any size keep the ISR to half that rate, for higher step rates.
+// 32-bit only.
+// Not compatible with LIN_ADVANCE or MIXING_EXTRUDER.
+//#define STEP_PATTERN_BUFFER 32
+
+// Record every step event into a ring buffer while M576 S1 is active and
+// stream it to the host in binary frames, to check the real step timing
+// against the planner settings. See buildroot/share/scripts/step_timeline.py
+//#define STEP_TIMELINE
+#if ENABLED(STEP_TIMELINE)
+  #define STEP_TIMELINE_SIZE 256 // Records (4 bytes each). A power of 2, up to 256.
+#endif
+
+// Time idle(), manage_heater(), lcd_update(), get_available_commands() and
+// the stepper and temperature ISRs with the CPU cycle counter, and report
+// each with M577, to see what holds up the planner under load. Adds a few
+// clock reads to every call and takes ~400 bytes of RAM.
+//#define CODE_PROFILER
+
 // @section temperature
 
 // Control heater 0 and heater 1 in parallel.
@@ -842,7 +904,8 @@
 // For ADVANCED_OK (M105) you need 32 bytes.
 // For debug-echo: 128 bytes for the optimal speed.
 // Other output doesn't need to be that speedy.
-// :[0, 2, 4, 8, 16, 32, 64, 128, 256]
+// Over 256 bytes, large reports and auto-reports can be queued whole.
+// :[0, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024]
 #define TX_BUFFER_SIZE 0
 
 // Host Receive Buffer Size
@@ -882,6 +945,24 @@
 // Some clients will have this feature soon. This could make the NO_TIMEOUTS unnecessary.
 //#define ADVANCED_OK
 
+// Tokenize host lines once as they're read, so the parser only copies the
+// offsets it finds. Costs about 36 bytes of SRAM per BUFSIZE command (144
+// with BUFSIZE 4), so it's best left to 32-bit boards.
+//#define SERIAL_LINE_TOKENS
+
+// Accept binary G-code frames from the host alongside text: packed commands
+// with pre-parsed fixed-point parameters, a line number and a CRC-16, which
+// skip text parsing and checksums. See buildroot/share/scripts/binary_gcode.py.
+//#define BINARY_GCODE_TRANSPORT
+
+// Acknowledge host lines cumulatively instead of with an "ok" for each one,
+// once the host sends 'M575 S1'. "ok N<line> R<bytes> B<slots>" says every
+// line up to N has run and that the host may have up to R bytes sent after
+// line N, so it can stream without waiting for each "ok". Unnumbered lines
+// don't move N on; their bytes are added to R once they've run. AVR, Due
+// UARTs and Linux only. See buildroot/share/scripts/credit_stream.py.
+//#define SERIAL_CREDIT_FLOW
+
 // @section extras
 
 /**
@@ -1448,6 +1529,14 @@
  */
 #define AUTO_REPORT_TEMPERATURES
 
+/**
+ * Hold back auto-reports (M155, M27 S) while the TX buffer is too full to take
+ * them, instead of waiting on the host. Reports falling due in the meantime are
+ * sent as one, with the latest values. Requires TX_BUFFER_SIZE >= 256 on AVR.
+ * AVR, Due and Linux only.
+ */
+//#define AUTO_REPORT_COALESCE
+
 /**
  * Include capabilities in M115 output
  */
@@ -1488,9 +1577,10 @@
 #define PROPORTIONAL_FONT_RATIO 1.5
 
 /**
- * Spend 28 bytes of SRAM to optimize the GCode parser
+ * Reject commands that have parameters their handler doesn't accept,
+ * with "Unknown parameter" instead of running them.
  */
-#define FASTER_GCODE_PARSER
+//#define STRICT_GCODE_PARAMETERS
 
 /**
  * User-defined menu items that execute custom GCode
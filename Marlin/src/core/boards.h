@@ -216,6 +216,11 @@
 //
 #define BOARD_THE_BORG         1860   // THE-BORG (Power outputs: Hotend0, Hotend1, Bed, Fan)
 
+//
+// Linux Native Debug board
+//
+#define BOARD_LINUX_RAMPS      2000   // Linux process with a simulated RAMPS (Power outputs: Hotend, Fan, Bed)
+
 
 #define MB(board) (MOTHERBOARD==BOARD_##board)
 
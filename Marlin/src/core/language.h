@@ -121,6 +121,7 @@
 #define MSG_ERR_LINE_NO                     "Line Number is not Last Line Number+1, Last Line: "
 #define MSG_ERR_CHECKSUM_MISMATCH           "checksum mismatch, Last Line: "
 #define MSG_ERR_NO_CHECKSUM                 "No Checksum with line number, Last Line: "
+#define MSG_ERR_BINARY_FRAME                "Bad binary frame, Last Line: "
 #define MSG_FILE_PRINTED                    "Done printing file"
 #define MSG_BEGIN_FILE_LIST                 "Begin file list"
 #define MSG_END_FILE_LIST                   "End file list"
@@ -138,6 +139,8 @@
 #define MSG_Z_MOVE_COMP                     "Z_move_comp"
 #define MSG_RESEND                          "Resend: "
 #define MSG_UNKNOWN_COMMAND                 "Unknown command: \""
+#define MSG_UNKNOWN_PARAMETER               "Unknown parameter "
+#define MSG_UNKNOWN_PARAMETER_IN            " in \""
 #define MSG_ACTIVE_EXTRUDER                 "Active Extruder: "
 #define MSG_X_MIN                           "x_min: "
 #define MSG_X_MAX                           "x_max: "
@@ -226,6 +229,11 @@
 #define MSG_KU                              " Ku: "
 #define MSG_TU                              " Tu: "
 #define MSG_CLASSIC_PID                     " Classic PID "
+#define MSG_PID_FIT_TOO_CLOSE               MSG_PID_AUTOTUNE_FAILED " Start further below the target"
+#define MSG_PID_FIT_FAILED                  MSG_PID_AUTOTUNE_FAILED " No usable step response"
+#define MSG_PID_GAIN                        " gain: "
+#define MSG_PID_TIME_CONSTANT               " time constant: "
+#define MSG_PID_DEAD_TIME                   " dead time: "
 #define MSG_KP                              " Kp: "
 #define MSG_KI                              " Ki: "
 #define MSG_KD                              " Kd: "
@@ -238,6 +246,18 @@
 #define MSG_PID_DEBUG_ITERM                 " iTerm "
 #define MSG_PID_DEBUG_DTERM                 " dTerm "
 #define MSG_PID_DEBUG_CTERM                 " cTerm "
+#define MSG_MPC_AUTOTUNE                    "MPC Autotune"
+#define MSG_MPC_AUTOTUNE_START              MSG_MPC_AUTOTUNE " start"
+#define MSG_MPC_AUTOTUNE_FAILED             MSG_MPC_AUTOTUNE " failed!"
+#define MSG_MPC_TOO_HOT                     MSG_MPC_AUTOTUNE_FAILED " Let the hotend cool first"
+#define MSG_MPC_TEMP_TOO_HIGH               MSG_MPC_AUTOTUNE_FAILED " Temperature too high"
+#define MSG_MPC_TIMEOUT                     MSG_MPC_AUTOTUNE_FAILED " timeout"
+#define MSG_MPC_BAD_MEASUREMENT             MSG_MPC_AUTOTUNE_FAILED " No usable heating and cooling rates"
+#define MSG_MPC_AUTOTUNE_FINISHED           MSG_MPC_AUTOTUNE " finished! Save with M500 or put the constants below into Configuration_adv.h"
+#define MSG_MPC_DEBUG                       " MPC_DEBUG "
+#define MSG_MPC_DEBUG_BLOCK                 " Block "
+#define MSG_MPC_DEBUG_AMBIENT               " Ambient "
+#define MSG_MPC_DEBUG_E_RATE                " eRate "
 #define MSG_INVALID_EXTRUDER_NUM            " - Invalid extruder number !"
 
 #define MSG_HEATER_BED                      "bed"
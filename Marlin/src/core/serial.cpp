@@ -27,6 +27,44 @@ uint8_t marlin_debug_flags = DEBUG_NONE;
 const char errormagic[] PROGMEM = "Error:";
 const char echomagic[] PROGMEM = "echo:";
 
+static const uint32_t fixed_scale[] PROGMEM = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+
+// n /= 10, returning the remainder. 16-bit division is much faster on 8-bit MCUs.
+static inline uint8_t divmod10(uint32_t &n) {
+  if (n <= 0xFFFF) {
+    const uint16_t w = n, q = w / 10;
+    n = q;
+    return w - q * 10;
+  }
+  const uint32_t q = n / 10;
+  const uint8_t r = n - q * 10;
+  n = q;
+  return r;
+}
+
+/**
+ * Format a float with a number of decimals into the end of buf, rounding
+ * like the serial port's print(). Return the start of the string, or NULL
+ * if the scaled value doesn't fit in 32 bits (including inf and nan).
+ */
+#define FIXED_BUFSIZE 16 // "-4294967295." + NUL, with room to spare
+
+static const char* fixed_str(char (&buf)[FIXED_BUFSIZE], const float value, const uint8_t digits) {
+  if (digits >= COUNT(fixed_scale)) return NULL;
+  const float scaled = FABS(value) * pgm_read_dword(&fixed_scale[digits]) + 0.5f;
+  if (!(scaled < 4294967040.0f)) return NULL;
+  uint32_t n = scaled;
+  char *p = &buf[FIXED_BUFSIZE - 1];
+  *p = '\0';
+  if (digits) {
+    for (uint8_t i = digits; i--;) *--p = '0' + divmod10(n);
+    *--p = '.';
+  }
+  do { *--p = '0' + divmod10(n); } while (n);
+  if (value < 0) *--p = '-';
+  return p;
+}
+
 #if NUM_SERIAL > 1
   void serialprintPGM_P(const int8_t p, const char * str) {
     while (char ch = pgm_read_byte(str++)) SERIAL_CHAR_P(p, ch);
@@ -36,12 +74,19 @@ const char echomagic[] PROGMEM = "echo:";
   void serial_echopair_PGM_P(const int8_t p, const char* s_P, char v)          { serialprintPGM_P(p, s_P); SERIAL_CHAR_P(p, v); }
   void serial_echopair_PGM_P(const int8_t p, const char* s_P, int v)           { serialprintPGM_P(p, s_P); SERIAL_ECHO_P(p, v); }
   void serial_echopair_PGM_P(const int8_t p, const char* s_P, long v)          { serialprintPGM_P(p, s_P); SERIAL_ECHO_P(p, v); }
-  void serial_echopair_PGM_P(const int8_t p, const char* s_P, float v)         { serialprintPGM_P(p, s_P); SERIAL_ECHO_P(p, v); }
-  void serial_echopair_PGM_P(const int8_t p, const char* s_P, double v)        { serialprintPGM_P(p, s_P); SERIAL_ECHO_P(p, v); }
+  void serial_echopair_PGM_P(const int8_t p, const char* s_P, float v)         { serialprintPGM_P(p, s_P); serialprint_fixed_P(p, v, 2); }
+  void serial_echopair_PGM_P(const int8_t p, const char* s_P, double v)        { serialprintPGM_P(p, s_P); serialprint_fixed_P(p, v, 2); }
   void serial_echopair_PGM_P(const int8_t p, const char* s_P, unsigned int v)  { serialprintPGM_P(p, s_P); SERIAL_ECHO_P(p, v); }
   void serial_echopair_PGM_P(const int8_t p, const char* s_P, unsigned long v) { serialprintPGM_P(p, s_P); SERIAL_ECHO_P(p, v); }
 
   void serial_spaces_P(const int8_t p, uint8_t count) { count *= (PROPORTIONAL_FONT_RATIO); while (count--) SERIAL_CHAR_P(p, ' '); }
+
+  void serialprint_fixed_P(const int8_t p, const float value, const uint8_t digits) {
+    char buf[FIXED_BUFSIZE];
+    const char *str = fixed_str(buf, value, digits);
+    if (str) while (*str) SERIAL_CHAR_P(p, *str++);
+    else SERIAL_PRINT_P(p, value, digits);
+  }
 #endif
 
 void serialprintPGM(const char * str) {
@@ -52,13 +97,20 @@ void serial_echopair_PGM(const char* s_P, const char *v)   { serialprintPGM(s_P)
 void serial_echopair_PGM(const char* s_P, char v)          { serialprintPGM(s_P); SERIAL_CHAR(v); }
 void serial_echopair_PGM(const char* s_P, int v)           { serialprintPGM(s_P); SERIAL_ECHO(v); }
 void serial_echopair_PGM(const char* s_P, long v)          { serialprintPGM(s_P); SERIAL_ECHO(v); }
-void serial_echopair_PGM(const char* s_P, float v)         { serialprintPGM(s_P); SERIAL_ECHO(v); }
-void serial_echopair_PGM(const char* s_P, double v)        { serialprintPGM(s_P); SERIAL_ECHO(v); }
+void serial_echopair_PGM(const char* s_P, float v)         { serialprintPGM(s_P); serialprint_fixed(v, 2); }
+void serial_echopair_PGM(const char* s_P, double v)        { serialprintPGM(s_P); serialprint_fixed(v, 2); }
 void serial_echopair_PGM(const char* s_P, unsigned int v)  { serialprintPGM(s_P); SERIAL_ECHO(v); }
 void serial_echopair_PGM(const char* s_P, unsigned long v) { serialprintPGM(s_P); SERIAL_ECHO(v); }
 
 void serial_spaces(uint8_t count) { count *= (PROPORTIONAL_FONT_RATIO); while (count--) SERIAL_CHAR(' '); }
 
+void serialprint_fixed(const float value, const uint8_t digits) {
+  char buf[FIXED_BUFSIZE];
+  const char *str = fixed_str(buf, value, digits);
+  if (str) while (*str) SERIAL_CHAR(*str++);
+  else SERIAL_PRINT(value, digits);
+}
+
 #if ENABLED(DEBUG_LEVELING_FEATURE)
 
   void print_xyz(const char* prefix, const char* suffix, const float x, const float y, const float z) {
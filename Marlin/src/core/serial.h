@@ -75,7 +75,7 @@ extern const char errormagic[] PROGMEM;
 #if NUM_SERIAL > 1
   #define SERIAL_CHAR_P(p,x)          (WITHIN(p, 0, NUM_SERIAL-1) ? (p == 0 ? MYSERIAL0.write(x) : MYSERIAL1.write(x)) : SERIAL_CHAR(x))
   #define SERIAL_PROTOCOL_P(p,x)      (WITHIN(p, 0, NUM_SERIAL-1) ? (p == 0 ? MYSERIAL0.print(x) : MYSERIAL1.print(x)) : SERIAL_PROTOCOL(x))
-  #define SERIAL_PROTOCOL_F_P(p,x,y)  (WITHIN(p, 0, NUM_SERIAL-1) ? (p == 0 ? MYSERIAL0.print(x,y) : MYSERIAL1.print(x,y)) : SERIAL_PROTOCOL_F(x,y))
+  #define SERIAL_PROTOCOL_F_P(p,x,y)  serialprint_fixed_P(p,x,y)
   #define SERIAL_PROTOCOLLN_P(p,x)    (WITHIN(p, 0, NUM_SERIAL-1) ? (p == 0 ? MYSERIAL0.println(x) : MYSERIAL1.println(x)) : SERIAL_PROTOCOLLN(x))
   #define SERIAL_PRINT_P(p,x,b)       (WITHIN(p, 0, NUM_SERIAL-1) ? (p == 0 ? MYSERIAL0.print(x,b) : MYSERIAL1.print(x,b)) : SERIAL_PRINT(x,b))
   #define SERIAL_PRINTLN_P(p,x,b)     (WITHIN(p, 0, NUM_SERIAL-1) ? (p == 0 ? MYSERIAL0.println(x,b) : MYSERIAL1.println(x,b)) : SERIAL_PRINTLN(x,b))
@@ -83,7 +83,7 @@ extern const char errormagic[] PROGMEM;
 
   #define SERIAL_CHAR(x)              (MYSERIAL0.write(x), MYSERIAL1.write(x))
   #define SERIAL_PROTOCOL(x)          (MYSERIAL0.print(x), MYSERIAL1.print(x))
-  #define SERIAL_PROTOCOL_F(x,y)      (MYSERIAL0.print(x,y), MYSERIAL1.print(x,y))
+  #define SERIAL_PROTOCOL_F(x,y)      serialprint_fixed(x,y)
   #define SERIAL_PROTOCOLLN(x)        (MYSERIAL0.println(x), MYSERIAL1.println(x))
   #define SERIAL_PRINT(x,b)           (MYSERIAL0.print(x,b), MYSERIAL1.print(x,b))
   #define SERIAL_PRINTLN(x,b)         (MYSERIAL0.println(x,b), MYSERIAL1.println(x,b))
@@ -143,6 +143,7 @@ extern const char errormagic[] PROGMEM;
   #define SERIAL_PROTOCOL_SP_P(p,C) serial_spaces_P(p,C)
 
   void serialprintPGM_P(const int8_t p, const char* str);
+  void serialprint_fixed_P(const int8_t p, const float value, const uint8_t digits);
 #else
   #define SERIAL_CHAR_P(p,x)          SERIAL_CHAR(x)
   #define SERIAL_PROTOCOL_P(p,x)      SERIAL_PROTOCOL(x)
@@ -154,7 +155,7 @@ extern const char errormagic[] PROGMEM;
 
   #define SERIAL_CHAR(x)              MYSERIAL0.write(x)
   #define SERIAL_PROTOCOL(x)          MYSERIAL0.print(x)
-  #define SERIAL_PROTOCOL_F(x,y)      MYSERIAL0.print(x,y)
+  #define SERIAL_PROTOCOL_F(x,y)      serialprint_fixed(x,y)
   #define SERIAL_PROTOCOLLN(x)        MYSERIAL0.println(x)
   #define SERIAL_PRINT(x,b)           MYSERIAL0.print(x,b)
   #define SERIAL_PRINTLN(x,b)         MYSERIAL0.println(x,b)
@@ -204,6 +205,17 @@ extern const char errormagic[] PROGMEM;
   #define SERIAL_PROTOCOL_SP_P(p,C) SERIAL_PROTOCOL_SP(C)
 
   #define serialprintPGM_P(p,s)     serialprintPGM(s)
+  #define serialprint_fixed_P(p,v,d) serialprint_fixed(v,d)
+#endif
+
+#if ENABLED(AUTO_REPORT_COALESCE)
+  // The TX buffers can take n bytes without waiting on the host. availableForWrite() reports up to 255.
+  #define _TX_ROOM(S,n) (S.availableForWrite() >= ((n) < 255 ? (n) : 255))
+  #if NUM_SERIAL > 1
+    #define SERIAL_TX_ROOM(n) (_TX_ROOM(MYSERIAL0,n) && _TX_ROOM(MYSERIAL1,n))
+  #else
+    #define SERIAL_TX_ROOM(n) _TX_ROOM(MYSERIAL0,n)
+  #endif
 #endif
 
 #define SERIAL_EOL() SERIAL_CHAR('\n')
@@ -257,6 +269,13 @@ void serial_spaces(uint8_t count);
 //
 void serialprintPGM(const char* str);
 
+//
+// Print a float with the given number of decimals, converting it to an
+// integer once and formatting the digits with integer math. Values out of
+// range for that get the serial port's own float printing.
+//
+void serialprint_fixed(const float value, const uint8_t digits);
+
 #if ENABLED(DEBUG_LEVELING_FEATURE)
   void print_xyz(const char* prefix, const char* suffix, const float x, const float y, const float z);
   void print_xyz(const char* prefix, const char* suffix, const float xyz[]);
@@ -35,7 +35,7 @@ void safe_delay(millis_t ms) {
   thermalManager.manage_heater(); // This keeps us safe if too many small safe_delay() calls are made
 }
 
-#if ENABLED(EEPROM_SETTINGS)
+#if ENABLED(EEPROM_SETTINGS) || ENABLED(BINARY_GCODE_TRANSPORT) || ENABLED(STEP_TIMELINE) || ENABLED(POWER_LOSS_RECOVERY)
 
   void crc16(uint16_t *crc, const void * const data, uint16_t cnt) {
     uint8_t *ptr = (uint8_t *)data;
@@ -46,7 +46,7 @@ void safe_delay(millis_t ms) {
     }
   }
 
-#endif // EEPROM_SETTINGS
+#endif // EEPROM_SETTINGS || BINARY_GCODE_TRANSPORT || STEP_TIMELINE || POWER_LOSS_RECOVERY
 
 #if ENABLED(ULTRA_LCD)
 
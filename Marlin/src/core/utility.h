@@ -29,7 +29,7 @@ constexpr char axis_codes[XYZE] = { 'X', 'Y', 'Z', 'E' };
 
 void safe_delay(millis_t ms);
 
-#if ENABLED(EEPROM_SETTINGS)
+#if ENABLED(EEPROM_SETTINGS) || ENABLED(BINARY_GCODE_TRANSPORT) || ENABLED(STEP_TIMELINE) || ENABLED(POWER_LOSS_RECOVERY)
   void crc16(uint16_t *crc, const void * const data, uint16_t cnt);
 #endif
 
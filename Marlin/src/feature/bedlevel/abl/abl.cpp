@@ -238,15 +238,6 @@ void print_bilinear_leveling_grid() {
   }
 #endif // ABL_BILINEAR_SUBDIVISION
 
-// Refresh after other values have been updated
-void refresh_bed_level() {
-  bilinear_grid_factor[X_AXIS] = RECIPROCAL(bilinear_grid_spacing[X_AXIS]);
-  bilinear_grid_factor[Y_AXIS] = RECIPROCAL(bilinear_grid_spacing[Y_AXIS]);
-  #if ENABLED(ABL_BILINEAR_SUBDIVISION)
-    bed_level_virt_interpolate();
-  #endif
-}
-
 #if ENABLED(ABL_BILINEAR_SUBDIVISION)
   #define ABL_BG_SPACING(A) bilinear_grid_spacing_virt[A]
   #define ABL_BG_FACTOR(A)  bilinear_grid_factor_virt[A]
@@ -261,103 +252,97 @@ void refresh_bed_level() {
   #define ABL_BG_GRID(X,Y)  z_values[X][Y]
 #endif
 
-// Get the Z adjustment for non-linear bed leveling
-float bilinear_z_offset(const float raw[XYZ]) {
-
-  static float z1, d2, z3, d4, L, D, ratio_x, ratio_y,
-               last_x = -999.999, last_y = -999.999;
+// Each grid cell stored as the coefficients of its bilinear patch
+static bilinear_cell_t bilinear_cells[ABL_BG_POINTS_X - 1][ABL_BG_POINTS_Y - 1];
 
-  // Whole units for the grid line indices. Constrained within bounds.
-  static int8_t gridx, gridy, nextx, nexty,
-                last_gridx = -99, last_gridy = -99;
-
-  // XY relative to the probed area
-  const float rx = raw[X_AXIS] - bilinear_start[X_AXIS],
-              ry = raw[Y_AXIS] - bilinear_start[Y_AXIS];
+// Refresh after other values have been updated
+void refresh_bed_level() {
+  bilinear_grid_factor[X_AXIS] = RECIPROCAL(bilinear_grid_spacing[X_AXIS]);
+  bilinear_grid_factor[Y_AXIS] = RECIPROCAL(bilinear_grid_spacing[Y_AXIS]);
+  #if ENABLED(ABL_BILINEAR_SUBDIVISION)
+    bed_level_virt_interpolate();
+  #endif
+  for (uint8_t x = 0; x < ABL_BG_POINTS_X - 1; x++)
+    for (uint8_t y = 0; y < ABL_BG_POINTS_Y - 1; y++)
+      bilinear_cells[x][y].set(ABL_BG_GRID(x, y), ABL_BG_GRID(x, y + 1), ABL_BG_GRID(x + 1, y), ABL_BG_GRID(x + 1, y + 1));
+}
 
+/**
+ * Get the cell of a position given in grid units (the XY relative
+ * to the probed area times the grid factor), and make the position
+ * relative to the cell.
+ *
+ * Beyond the grid the outer cells are used. Unless extrapolating,
+ * the ratios are kept within the cell there, keeping the height of
+ * the grid edge. Returns false in that case.
+ */
+static bool bilinear_cell(float &u, float &v, int8_t &gx, int8_t &gy) {
+  gx = constrain(FLOOR(u), 0, ABL_BG_POINTS_X - 2);
+  gy = constrain(FLOOR(v), 0, ABL_BG_POINTS_Y - 2);
+  u -= gx;  // Subtract whole to get the ratio within the grid box
+  v -= gy;
   #if ENABLED(EXTRAPOLATE_BEYOND_GRID)
-    // Keep using the last grid box
-    #define FAR_EDGE_OR_BOX 2
+    return true;
   #else
-    // Just use the grid far edge
-    #define FAR_EDGE_OR_BOX 1
+    // Beyond the grid maintain height at grid edges
+    if (WITHIN(u, 0, 1) && WITHIN(v, 0, 1)) return true;
+    u = constrain(u, 0, 1);
+    v = constrain(v, 0, 1);
+    return false;
   #endif
+}
 
-  if (last_x != rx) {
-    last_x = rx;
-    ratio_x = rx * ABL_BG_FACTOR(X_AXIS);
-    const float gx = constrain(FLOOR(ratio_x), 0, ABL_BG_POINTS_X - FAR_EDGE_OR_BOX);
-    ratio_x -= gx;      // Subtract whole to get the ratio within the grid box
-
-    #if DISABLED(EXTRAPOLATE_BEYOND_GRID)
-      // Beyond the grid maintain height at grid edges
-      NOLESS(ratio_x, 0); // Never < 0.0. (> 1.0 is ok when nextx==gridx.)
-    #endif
-
-    gridx = gx;
-    nextx = min(gridx + 1, ABL_BG_POINTS_X - 1);
-  }
-
-  if (last_y != ry || last_gridx != gridx) {
-
-    if (last_y != ry) {
-      last_y = ry;
-      ratio_y = ry * ABL_BG_FACTOR(Y_AXIS);
-      const float gy = constrain(FLOOR(ratio_y), 0, ABL_BG_POINTS_Y - FAR_EDGE_OR_BOX);
-      ratio_y -= gy;
-
-      #if DISABLED(EXTRAPOLATE_BEYOND_GRID)
-        // Beyond the grid maintain height at grid edges
-        NOLESS(ratio_y, 0); // Never < 0.0. (> 1.0 is ok when nexty==gridy.)
-      #endif
+// Get the Z adjustment for non-linear bed leveling
+float bilinear_z_offset(const float raw[XYZ]) {
+  // XY relative to the probed area, in grid units
+  float u = (raw[X_AXIS] - bilinear_start[X_AXIS]) * ABL_BG_FACTOR(X_AXIS),
+        v = (raw[Y_AXIS] - bilinear_start[Y_AXIS]) * ABL_BG_FACTOR(Y_AXIS);
+  int8_t gx, gy;
+  bilinear_cell(u, v, gx, gy);
+  return bilinear_cells[gx][gy].z(u, v);
+}
 
-      gridy = gy;
-      nexty = min(gridy + 1, ABL_BG_POINTS_Y - 1);
+/**
+ * Get the Z adjustments for a batch of points along a line: count
+ * points spaced by step, the first one a step after start.
+ *
+ * Inside a cell the height along a line is a quadratic in the point
+ * index, so it is stepped by finite differences and the cell is only
+ * looked up again when the line leaves it.
+ */
+void bilinear_z_offsets(const float start[XYZ], const float step[XYZ], const uint8_t count, float z[]) {
+  const float du = step[X_AXIS] * ABL_BG_FACTOR(X_AXIS),
+              dv = step[Y_AXIS] * ABL_BG_FACTOR(Y_AXIS);
+  float pu = (start[X_AXIS] - bilinear_start[X_AXIS]) * ABL_BG_FACTOR(X_AXIS),
+        pv = (start[Y_AXIS] - bilinear_start[Y_AXIS]) * ABL_BG_FACTOR(Y_AXIS);
+
+  int8_t last_gx = -1, last_gy = -1;
+  float zi = 0, d1 = 0, d2 = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    pu += du;
+    pv += dv;
+    float u = pu, v = pv;
+    int8_t gx, gy;
+    const bool inside = bilinear_cell(u, v, gx, gy);
+    if (inside && gx == last_gx && gy == last_gy) {
+      zi += d1;   // Next point in the same cell
+      d1 += d2;
     }
-
-    if (last_gridx != gridx || last_gridy != gridy) {
-      last_gridx = gridx;
-      last_gridy = gridy;
-      // Z at the box corners
-      z1 = ABL_BG_GRID(gridx, gridy);       // left-front
-      d2 = ABL_BG_GRID(gridx, nexty) - z1;  // left-back (delta)
-      z3 = ABL_BG_GRID(nextx, gridy);       // right-front
-      d4 = ABL_BG_GRID(nextx, nexty) - z3;  // right-back (delta)
+    else {
+      const bilinear_cell_t &cell = bilinear_cells[gx][gy];
+      zi = cell.z(u, v);
+      if (inside) {
+        // Differences to the following point
+        d2 = 2 * cell.dxy * du * dv;
+        d1 = cell.dx * du + cell.dy * dv + cell.dxy * (u * dv + v * du + du * dv);
+        last_gx = gx;
+        last_gy = gy;
+      }
+      else
+        last_gx = -1; // Clamped at the grid edge
     }
-
-    // Bilinear interpolate. Needed since ry or gridx has changed.
-                L = z1 + d2 * ratio_y;   // Linear interp. LF -> LB
-    const float R = z3 + d4 * ratio_y;   // Linear interp. RF -> RB
-
-    D = R - L;
-  }
-
-  const float offset = L + ratio_x * D;   // the offset almost always changes
-
-  /*
-  static float last_offset = 0;
-  if (FABS(last_offset - offset) > 0.2) {
-    SERIAL_ECHOPGM("Sudden Shift at ");
-    SERIAL_ECHOPAIR("x=", rx);
-    SERIAL_ECHOPAIR(" / ", bilinear_grid_spacing[X_AXIS]);
-    SERIAL_ECHOLNPAIR(" -> gridx=", gridx);
-    SERIAL_ECHOPAIR(" y=", ry);
-    SERIAL_ECHOPAIR(" / ", bilinear_grid_spacing[Y_AXIS]);
-    SERIAL_ECHOLNPAIR(" -> gridy=", gridy);
-    SERIAL_ECHOPAIR(" ratio_x=", ratio_x);
-    SERIAL_ECHOLNPAIR(" ratio_y=", ratio_y);
-    SERIAL_ECHOPAIR(" z1=", z1);
-    SERIAL_ECHOPAIR(" z2=", z2);
-    SERIAL_ECHOPAIR(" z3=", z3);
-    SERIAL_ECHOLNPAIR(" z4=", z4);
-    SERIAL_ECHOPAIR(" L=", L);
-    SERIAL_ECHOPAIR(" R=", R);
-    SERIAL_ECHOLNPAIR(" offset=", offset);
+    z[i] = zi;
   }
-  last_offset = offset;
-  //*/
-
-  return offset;
 }
 
 #if IS_CARTESIAN && DISABLED(SEGMENT_LEVELED_MOVES)
@@ -367,8 +352,11 @@ float bilinear_z_offset(const float raw[XYZ]) {
   /**
    * Prepare a bilinear-leveled linear move on Cartesian,
    * splitting the move where it crosses grid borders.
+   *
+   * The grid lines are walked in the order the move crosses them,
+   * taking whichever of the next X and Y lines comes first.
    */
-  void bilinear_line_to_destination(const float fr_mm_s, uint16_t x_splits, uint16_t y_splits) {
+  void bilinear_line_to_destination(const float fr_mm_s) {
     // Get current and destination cells for this line
     int cx1 = CELL_INDEX(X, current_position[X_AXIS]),
         cy1 = CELL_INDEX(Y, current_position[Y_AXIS]),
@@ -379,54 +367,36 @@ float bilinear_z_offset(const float raw[XYZ]) {
     cx2 = constrain(cx2, 0, ABL_BG_POINTS_X - 2);
     cy2 = constrain(cy2, 0, ABL_BG_POINTS_Y - 2);
 
-    // Start and end in the same cell? No split needed.
-    if (cx1 == cx2 && cy1 == cy2) {
-      buffer_line_to_destination(fr_mm_s);
-      set_current_from_destination();
-      return;
-    }
+    if (cx1 != cx2 || cy1 != cy2) {
+      float start[XYZE], end[XYZE];
+      COPY(start, current_position);
+      COPY(end, destination);
 
-    #define LINE_SEGMENT_END(A) (current_position[A ##_AXIS] + (destination[A ##_AXIS] - current_position[A ##_AXIS]) * normalized_dist)
+      // Direction through the cells and the next grid line each way
+      const int8_t sx = cx2 > cx1 ? 1 : -1, sy = cy2 > cy1 ? 1 : -1;
+      int gx = cx1 + (sx > 0), gy = cy1 + (sy > 0);
 
-    float normalized_dist, end[XYZE];
-    const int8_t gcx = max(cx1, cx2), gcy = max(cy1, cy2);
+      while (cx1 != cx2 || cy1 != cy2) {
+        // Fraction of the move to each grid line, or beyond the end if it stays in the column/row
+        float tx = 2, ty = 2;
+        if (cx1 != cx2) tx = (bilinear_start[X_AXIS] + ABL_BG_SPACING(X_AXIS) * gx - start[X_AXIS]) / (end[X_AXIS] - start[X_AXIS]);
+        if (cy1 != cy2) ty = (bilinear_start[Y_AXIS] + ABL_BG_SPACING(Y_AXIS) * gy - start[Y_AXIS]) / (end[Y_AXIS] - start[Y_AXIS]);
 
-    // Crosses on the X and not already split on this X?
-    // The x_splits flags are insurance against rounding errors.
-    if (cx2 != cx1 && TEST(x_splits, gcx)) {
-      // Split on the X grid line
-      CBI(x_splits, gcx);
-      COPY(end, destination);
-      destination[X_AXIS] = bilinear_start[X_AXIS] + ABL_BG_SPACING(X_AXIS) * gcx;
-      normalized_dist = (destination[X_AXIS] - current_position[X_AXIS]) / (end[X_AXIS] - current_position[X_AXIS]);
-      destination[Y_AXIS] = LINE_SEGMENT_END(Y);
-    }
-    // Crosses on the Y and not already split on this Y?
-    else if (cy2 != cy1 && TEST(y_splits, gcy)) {
-      // Split on the Y grid line
-      CBI(y_splits, gcy);
-      COPY(end, destination);
-      destination[Y_AXIS] = bilinear_start[Y_AXIS] + ABL_BG_SPACING(Y_AXIS) * gcy;
-      normalized_dist = (destination[Y_AXIS] - current_position[Y_AXIS]) / (end[Y_AXIS] - current_position[Y_AXIS]);
-      destination[X_AXIS] = LINE_SEGMENT_END(X);
-    }
-    else {
-      // Must already have been split on these border(s)
-      // This should be a rare case.
-      buffer_line_to_destination(fr_mm_s);
-      set_current_from_destination();
-      return;
-    }
+        // Split at the nearer line, or at both where the move goes through a grid point
+        const float t = constrain(min(tx, ty), 0, 1);
+        LOOP_XYZE(i) destination[i] = start[i] + (end[i] - start[i]) * t;
+        if (tx <= ty) { destination[X_AXIS] = bilinear_start[X_AXIS] + ABL_BG_SPACING(X_AXIS) * gx; cx1 += sx; gx += sx; }
+        if (ty <= tx) { destination[Y_AXIS] = bilinear_start[Y_AXIS] + ABL_BG_SPACING(Y_AXIS) * gy; cy1 += sy; gy += sy; }
 
-    destination[Z_AXIS] = LINE_SEGMENT_END(Z);
-    destination[E_AXIS] = LINE_SEGMENT_END(E);
+        buffer_line_to_destination(fr_mm_s);
+        set_current_from_destination();
+      }
 
-    // Do the split and look for more borders
-    bilinear_line_to_destination(fr_mm_s, x_splits, y_splits);
+      COPY(destination, end);
+    }
 
-    // Restore destination from stack
-    COPY(destination, end);
-    bilinear_line_to_destination(fr_mm_s, x_splits, y_splits);
+    buffer_line_to_destination(fr_mm_s);
+    set_current_from_destination();
   }
 
 #endif // IS_CARTESIAN && !SEGMENT_LEVELED_MOVES
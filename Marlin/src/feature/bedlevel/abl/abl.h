@@ -33,6 +33,7 @@
   extern float bilinear_grid_factor[2],
                z_values[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
   float bilinear_z_offset(const float raw[XYZ]);
+  void bilinear_z_offsets(const float start[XYZ], const float step[XYZ], const uint8_t count, float z[]);
 
   void extrapolate_unprobed_bed_level();
   void print_bilinear_leveling_grid();
@@ -43,7 +44,7 @@
   #endif
 
   #if IS_CARTESIAN && DISABLED(SEGMENT_LEVELED_MOVES)
-    void bilinear_line_to_destination(const float fr_mm_s, uint16_t x_splits=0xFFFF, uint16_t y_splits=0xFFFF);
+    void bilinear_line_to_destination(const float fr_mm_s);
   #endif
 
 #endif // AUTO_BED_LEVELING_BILINEAR
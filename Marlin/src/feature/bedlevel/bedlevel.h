@@ -30,6 +30,26 @@ typedef struct {
   float distance; // When populated, the distance from the search location
 } mesh_index_pair;
 
+#if ENABLED(AUTO_BED_LEVELING_BILINEAR) || ENABLED(AUTO_BED_LEVELING_UBL)
+  /**
+   * A grid cell as the coefficients of its bilinear patch, so that the
+   * height at the ratios (u, v) into the cell is z0 + dx u + (dy + dxy u) v.
+   */
+  struct bilinear_cell_t {
+    float z0, dx, dy, dxy;
+
+    // From the heights at the left-front, left-back, right-front and right-back corners
+    FORCE_INLINE void set(const float &z1, const float &z2, const float &z3, const float &z4) {
+      z0 = z1;
+      dx = z3 - z1;
+      dy = z2 - z1;
+      dxy = z4 - z3 - z2 + z1;
+    }
+
+    FORCE_INLINE float z(const float &u, const float &v) const { return z0 + dx * u + (dy + dxy * u) * v; }
+  };
+#endif
+
 #if ENABLED(G26_MESH_VALIDATION)
   extern bool g26_debug_flag;
 #else
@@ -62,6 +62,8 @@ extern uint8_t ubl_cnt;
 
 #define MESH_X_DIST (float(MESH_MAX_X - (MESH_MIN_X)) / float(GRID_MAX_POINTS_X - 1))
 #define MESH_Y_DIST (float(MESH_MAX_Y - (MESH_MIN_Y)) / float(GRID_MAX_POINTS_Y - 1))
+#define MESH_X_FACTOR (float(GRID_MAX_POINTS_X - 1) / float(MESH_MAX_X - (MESH_MIN_X))) // Cells per mm
+#define MESH_Y_FACTOR (float(GRID_MAX_POINTS_Y - 1) / float(MESH_MAX_Y - (MESH_MIN_Y)))
 
 class unified_bed_leveling {
   private:
@@ -169,14 +171,14 @@ class unified_bed_leveling {
     FORCE_INLINE static void set_z(const int8_t px, const int8_t py, const float &z) { z_values[px][py] = z; }
 
     static int8_t get_cell_index_x(const float &x) {
-      const int8_t cx = (x - (MESH_MIN_X)) * (1.0 / (MESH_X_DIST));
+      const int8_t cx = (x - (MESH_MIN_X)) * (MESH_X_FACTOR);
       return constrain(cx, 0, (GRID_MAX_POINTS_X) - 1);   // -1 is appropriate if we want all movement to the X_MAX
     }                                                     // position. But with this defined this way, it is possible
                                                           // to extrapolate off of this point even further out. Probably
                                                           // that is OK because something else should be keeping that from
                                                           // happening and should not be worried about at this level.
     static int8_t get_cell_index_y(const float &y) {
-      const int8_t cy = (y - (MESH_MIN_Y)) * (1.0 / (MESH_Y_DIST));
+      const int8_t cy = (y - (MESH_MIN_Y)) * (MESH_Y_FACTOR);
       return constrain(cy, 0, (GRID_MAX_POINTS_Y) - 1);   // -1 is appropriate if we want all movement to the Y_MAX
     }                                                     // position. But with this defined this way, it is possible
                                                           // to extrapolate off of this point even further out. Probably
@@ -184,108 +186,34 @@ class unified_bed_leveling {
                                                           // happening and should not be worried about at this level.
 
     static int8_t find_closest_x_index(const float &x) {
-      const int8_t px = (x - (MESH_MIN_X) + (MESH_X_DIST) * 0.5) * (1.0 / (MESH_X_DIST));
+      const int8_t px = (x - (MESH_MIN_X) + (MESH_X_DIST) * 0.5) * (MESH_X_FACTOR);
       return WITHIN(px, 0, GRID_MAX_POINTS_X - 1) ? px : -1;
     }
 
     static int8_t find_closest_y_index(const float &y) {
-      const int8_t py = (y - (MESH_MIN_Y) + (MESH_Y_DIST) * 0.5) * (1.0 / (MESH_Y_DIST));
+      const int8_t py = (y - (MESH_MIN_Y) + (MESH_Y_DIST) * 0.5) * (MESH_Y_FACTOR);
       return WITHIN(py, 0, GRID_MAX_POINTS_Y - 1) ? py : -1;
     }
 
     /**
-     *                           z2   --|
-     *                 z0        |      |
-     *                  |        |      + (z2-z1)
-     *   z1             |        |      |
-     * ---+-------------+--------+--  --|
-     *   a1            a0        a2
-     *    |<---delta_a---------->|
-     *
-     *  calc_z0 is the basis for all the Mesh Based correction. It is used to
-     *  find the expected Z Height at a position between two known Z-Height locations.
-     *
-     *  It is fairly expensive with its 4 floating point additions and 2 floating point
-     *  multiplications.
+     * The patch of cell (cx, cy). Beyond the last mesh line the cell has
+     * no far side, so the heights of the last line carry on.
      */
-    FORCE_INLINE static float calc_z0(const float &a0, const float &a1, const float &z1, const float &a2, const float &z2) {
-      return z1 + (z2 - z1) * (a0 - a1) / (a2 - a1);
+    FORCE_INLINE static void get_cell(bilinear_cell_t &cell, const int8_t cx, const int8_t cy) {
+      const int8_t nx = min(cx, GRID_MAX_POINTS_X - 2) + 1,
+                   ny = min(cy, GRID_MAX_POINTS_Y - 2) + 1;
+      cell.set(z_values[cx][cy], z_values[cx][ny], z_values[nx][cy], z_values[nx][ny]);
     }
 
-    /**
-     * z_correction_for_x_on_horizontal_mesh_line is an optimization for
-     * the case where the printer is making a vertical line that only crosses horizontal mesh lines.
-     */
-    inline static float z_correction_for_x_on_horizontal_mesh_line(const float &rx0, const int x1_i, const int yi) {
-      if (!WITHIN(x1_i, 0, GRID_MAX_POINTS_X - 1) || !WITHIN(yi, 0, GRID_MAX_POINTS_Y - 1)) {
-        #if ENABLED(DEBUG_LEVELING_FEATURE)
-          if (DEBUGGING(LEVELING)) {
-            serialprintPGM( !WITHIN(x1_i, 0, GRID_MAX_POINTS_X - 1) ? PSTR("x1_i") : PSTR("yi") );
-            SERIAL_ECHOPAIR(" out of bounds in z_correction_for_x_on_horizontal_mesh_line(rx0=", rx0);
-            SERIAL_ECHOPAIR(",x1_i=", x1_i);
-            SERIAL_ECHOPAIR(",yi=", yi);
-            SERIAL_CHAR(')');
-            SERIAL_EOL();
-          }
-        #endif
-
-        // The requested location is off the mesh. Return UBL_Z_RAISE_WHEN_OFF_MESH or NAN.
-        return (
-          #ifdef UBL_Z_RAISE_WHEN_OFF_MESH
-            UBL_Z_RAISE_WHEN_OFF_MESH
-          #else
-            NAN
-          #endif
-        );
-      }
-
-      const float xratio = (rx0 - mesh_index_to_xpos(x1_i)) * (1.0 / (MESH_X_DIST)),
-                  z1 = z_values[x1_i][yi];
-
-      return z1 + xratio * (z_values[min(x1_i, GRID_MAX_POINTS_X - 2) + 1][yi] - z1); // Don't allow x1_i+1 to be past the end of the array
-                                                                                      // If it is, it is clamped to the last element of the
-                                                                                      // z_values[][] array and no correction is applied.
-    }
-
-    //
-    // See comments above for z_correction_for_x_on_horizontal_mesh_line
-    //
-    inline static float z_correction_for_y_on_vertical_mesh_line(const float &ry0, const int xi, const int y1_i) {
-      if (!WITHIN(xi, 0, GRID_MAX_POINTS_X - 1) || !WITHIN(y1_i, 0, GRID_MAX_POINTS_Y - 1)) {
-        #if ENABLED(DEBUG_LEVELING_FEATURE)
-          if (DEBUGGING(LEVELING)) {
-            serialprintPGM( !WITHIN(xi, 0, GRID_MAX_POINTS_X - 1) ? PSTR("xi") : PSTR("y1_i") );
-            SERIAL_ECHOPAIR(" out of bounds in z_correction_for_y_on_vertical_mesh_line(ry0=", ry0);
-            SERIAL_ECHOPAIR(", xi=", xi);
-            SERIAL_ECHOPAIR(", y1_i=", y1_i);
-            SERIAL_CHAR(')');
-            SERIAL_EOL();
-          }
-        #endif
-
-        // The requested location is off the mesh. Return UBL_Z_RAISE_WHEN_OFF_MESH or NAN.
-        return (
-          #ifdef UBL_Z_RAISE_WHEN_OFF_MESH
-            UBL_Z_RAISE_WHEN_OFF_MESH
-          #else
-            NAN
-          #endif
-        );
-      }
-
-      const float yratio = (ry0 - mesh_index_to_ypos(y1_i)) * (1.0 / (MESH_Y_DIST)),
-                  z1 = z_values[xi][y1_i];
-
-      return z1 + yratio * (z_values[xi][min(y1_i, GRID_MAX_POINTS_Y - 2) + 1] - z1); // Don't allow y1_i+1 to be past the end of the array
-                                                                                      // If it is, it is clamped to the last element of the
-                                                                                      // z_values[][] array and no correction is applied.
+    // The correction at a point, given relative to the corner of its cell in mm
+    FORCE_INLINE static float cell_z(const bilinear_cell_t &cell, const float &dx, const float &dy) {
+      return cell.z(dx * (MESH_X_FACTOR), dy * (MESH_Y_FACTOR));
     }
 
     /**
-     * This is the generic Z-Correction. It works anywhere within a Mesh Cell. It first
-     * does a linear interpolation along both of the bounding X-Mesh-Lines to find the
-     * Z-Height at both ends. Then it does a linear interpolation of these heights based
-     * on the Y position within the cell.
+     * This is the generic Z-Correction. It works anywhere within a Mesh Cell, evaluating
+     * the bilinear patch of the cell at the position. Before the first mesh line the
+     * patch of the first cell is extended.
      */
     static float get_z_correction(const float &rx0, const float &ry0) {
       const int8_t cx = get_cell_index_x(rx0),
@@ -300,17 +228,9 @@ class unified_bed_leveling {
           return UBL_Z_RAISE_WHEN_OFF_MESH;
       #endif
 
-      const float z1 = calc_z0(rx0,
-                               mesh_index_to_xpos(cx), z_values[cx][cy],
-                               mesh_index_to_xpos(cx + 1), z_values[min(cx, GRID_MAX_POINTS_X - 2) + 1][cy]);
-
-      const float z2 = calc_z0(rx0,
-                               mesh_index_to_xpos(cx), z_values[cx][min(cy, GRID_MAX_POINTS_Y - 2) + 1],
-                               mesh_index_to_xpos(cx + 1), z_values[min(cx, GRID_MAX_POINTS_X - 2) + 1][min(cy, GRID_MAX_POINTS_Y - 2) + 1]);
-
-      float z0 = calc_z0(ry0,
-                         mesh_index_to_ypos(cy), z1,
-                         mesh_index_to_ypos(cy + 1), z2);
+      bilinear_cell_t cell;
+      get_cell(cell, cx, cy);
+      float z0 = cell_z(cell, rx0 - mesh_index_to_xpos(cx), ry0 - mesh_index_to_ypos(cy));
 
       #if ENABLED(DEBUG_LEVELING_FEATURE)
         if (DEBUGGING(MESH_ADJUST)) {
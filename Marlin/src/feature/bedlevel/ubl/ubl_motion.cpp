@@ -27,6 +27,7 @@
 #include "../../../module/planner.h"
 #include "../../../module/stepper.h"
 #include "../../../module/motion.h"
+#include "../../../module/segment_producer.h"
 
 #if ENABLED(DELTA)
   #include "../../../module/delta.h"
@@ -43,12 +44,82 @@
 
 #if !UBL_SEGMENTED
 
+  // The correction at a point of a move in cell (cx, cy), whose patch is 'cell'
+  static float _O2 ubl_line_z(const bilinear_cell_t &cell, const int8_t cx, const int8_t cy, const float &rx, const float &ry) {
+    #ifdef UBL_Z_RAISE_WHEN_OFF_MESH
+      if (!WITHIN(rx, MESH_MIN_X, MESH_MAX_X) || !WITHIN(ry, MESH_MIN_Y, MESH_MAX_Y))
+        return UBL_Z_RAISE_WHEN_OFF_MESH;
+    #endif
+
+    const float z0 = ubl.cell_z(cell, rx - ubl.mesh_index_to_xpos(cx), ry - ubl.mesh_index_to_ypos(cy));
+
+    // Undefined parts of the Mesh in z_values[][] are NAN.
+    // Replace NAN corrections with 0.0 to prevent NAN propagation.
+    return isnan(z0) ? 0.0 : z0;
+  }
+
+  /**
+   * A leveled Cartesian move that crosses mesh lines, cut at each crossing.
+   *
+   * The crossings are walked in order the way a DDA walks a grid: the
+   * fractions of the move at the next X and the next Y mesh line each
+   * grow by a constant per cell, and whichever is nearer comes next, or
+   * both where the move goes through a mesh point. The patch of a cell
+   * is computed once, when the walk enters it.
+   */
+  class UBLLineProducer : public SegmentProducer {
+    public:
+      float start[XYZE], end[XYZE], feedrate, fade_scaling_factor,
+            t_x, t_y,           // Fraction of the move at the next X and Y mesh lines
+            t_dx, t_dy;         // Fraction of the move across a cell in X and in Y
+      int8_t cell_x, cell_y,    // Cell the walk is in
+             step_x, step_y,    // Direction through the cells
+             lines_x, lines_y;  // Mesh lines left to cross
+      uint8_t extruder;
+      bilinear_cell_t cell;
+
+      bool _O2 next();
+  };
+
+  bool _O2 UBLLineProducer::next() {
+
+    if (!lines_x && !lines_y) {
+      // In the destination cell. The final move goes to the exact destination.
+      planner.buffer_segment(end[X_AXIS], end[Y_AXIS],
+        end[Z_AXIS] + ubl_line_z(cell, cell_x, cell_y, end[X_AXIS], end[Y_AXIS]) * fade_scaling_factor,
+        end[E_AXIS], feedrate, extruder);
+      return false;
+    }
+
+    const bool cross_x = lines_x && (!lines_y || t_x <= t_y),
+               cross_y = lines_y && (!lines_x || t_y <= t_x);
+    const float t = cross_x ? t_x : t_y;
+
+    // Skip the zero-length segment of a move that starts on a mesh line
+    if (t > 0) {
+      float raw[XYZE];
+      LOOP_XYZE(i) raw[i] = start[i] + (end[i] - start[i]) * t;
+      if (cross_x) raw[X_AXIS] = ubl.mesh_index_to_xpos(cell_x + (step_x > 0));
+      if (cross_y) raw[Y_AXIS] = ubl.mesh_index_to_ypos(cell_y + (step_y > 0));
+      planner.buffer_segment(raw[X_AXIS], raw[Y_AXIS],
+        raw[Z_AXIS] + ubl_line_z(cell, cell_x, cell_y, raw[X_AXIS], raw[Y_AXIS]) * fade_scaling_factor,
+        raw[E_AXIS], feedrate, extruder);
+    }
+
+    if (cross_x) { cell_x += step_x; t_x += t_dx; lines_x--; }
+    if (cross_y) { cell_y += step_y; t_y += t_dy; lines_y--; }
+    ubl.get_cell(cell, cell_x, cell_y);
+
+    return true;
+  }
+
+  static UBLLineProducer ubl_line;
+
   void unified_bed_leveling::line_to_destination_cartesian(const float &feed_rate, const uint8_t extruder) {
-    /**
-     * Much of the nozzle movement will be within the same cell. So we will do as little computation
-     * as possible to determine if this is the case. If this move is within the same cell, we will
-     * just do the required Z-Height correction, call the Planner's buffer_line() routine, and leave
-     */
+
+    // Only one move is segmented at a time
+    segment_feed.finish();
+
     #if ENABLED(SKEW_CORRECTION)
       // For skew correction just adjust the destination point and we're done
       float start[XYZE] = { current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS] },
@@ -60,10 +131,10 @@
                     (&end)[XYZE] = destination;
     #endif
 
-    const int cell_start_xi = get_cell_index_x(start[X_AXIS]),
-              cell_start_yi = get_cell_index_y(start[Y_AXIS]),
-              cell_dest_xi  = get_cell_index_x(end[X_AXIS]),
-              cell_dest_yi  = get_cell_index_y(end[Y_AXIS]);
+    const int8_t cell_start_xi = get_cell_index_x(start[X_AXIS]),
+                 cell_start_yi = get_cell_index_y(start[Y_AXIS]),
+                 cell_dest_xi  = get_cell_index_x(end[X_AXIS]),
+                 cell_dest_yi  = get_cell_index_y(end[Y_AXIS]);
 
     if (g26_debug_flag) {
       SERIAL_ECHOPAIR(" ubl.line_to_destination_cartesian(xe=", destination[X_AXIS]);
@@ -75,49 +146,15 @@
       debug_current_and_destination(PSTR("Start of ubl.line_to_destination_cartesian()"));
     }
 
+    const float fade_scaling_factor = planner.fade_scaling_factor_for_z(end[Z_AXIS]);
+
     // A move within the same cell needs no splitting
     if (cell_start_xi == cell_dest_xi && cell_start_yi == cell_dest_yi) {
-
-      // For a move off the bed, use a constant Z raise
-      if (!WITHIN(cell_dest_xi, 0, GRID_MAX_POINTS_X - 1) || !WITHIN(cell_dest_yi, 0, GRID_MAX_POINTS_Y - 1)) {
-
-        // Note: There is no Z Correction in this case. We are off the grid and don't know what
-        // a reasonable correction would be.  If the user has specified a UBL_Z_RAISE_WHEN_OFF_MESH
-        // value, that will be used instead of a calculated (Bi-Linear interpolation) correction.
-
-        const float z_raise = 0.0
-          #ifdef UBL_Z_RAISE_WHEN_OFF_MESH
-            + UBL_Z_RAISE_WHEN_OFF_MESH
-          #endif
-        ;
-        planner.buffer_segment(end[X_AXIS], end[Y_AXIS], end[Z_AXIS] + z_raise, end[E_AXIS], feed_rate, extruder);
-        set_current_from_destination();
-
-        if (g26_debug_flag)
-          debug_current_and_destination(PSTR("out of bounds in ubl.line_to_destination_cartesian()"));
-
-        return;
-      }
-
-      FINAL_MOVE:
-
-      // The distance is always MESH_X_DIST so multiply by the constant reciprocal.
-      const float xratio = (end[X_AXIS] - mesh_index_to_xpos(cell_dest_xi)) * (1.0 / (MESH_X_DIST));
-
-      float z1 = z_values[cell_dest_xi    ][cell_dest_yi    ] + xratio *
-                (z_values[cell_dest_xi + 1][cell_dest_yi    ] - z_values[cell_dest_xi][cell_dest_yi    ]),
-            z2 = z_values[cell_dest_xi    ][cell_dest_yi + 1] + xratio *
-                (z_values[cell_dest_xi + 1][cell_dest_yi + 1] - z_values[cell_dest_xi][cell_dest_yi + 1]);
-
-      if (cell_dest_xi >= GRID_MAX_POINTS_X - 1) z1 = z2 = 0.0;
-
-      // X cell-fraction done. Interpolate the two Z offsets with the Y fraction for the final Z offset.
-      const float yratio = (end[Y_AXIS] - mesh_index_to_ypos(cell_dest_yi)) * (1.0 / (MESH_Y_DIST)),
-                  z0 = cell_dest_yi < GRID_MAX_POINTS_Y - 1 ? (z1 + (z2 - z1) * yratio) * planner.fade_scaling_factor_for_z(end[Z_AXIS]) : 0.0;
-
-      // Undefined parts of the Mesh in z_values[][] are NAN.
-      // Replace NAN corrections with 0.0 to prevent NAN propagation.
-      planner.buffer_segment(end[X_AXIS], end[Y_AXIS], end[Z_AXIS] + (isnan(z0) ? 0.0 : z0), end[E_AXIS], feed_rate, extruder);
+      bilinear_cell_t cell;
+      get_cell(cell, cell_dest_xi, cell_dest_yi);
+      planner.buffer_segment(end[X_AXIS], end[Y_AXIS],
+        end[Z_AXIS] + ubl_line_z(cell, cell_dest_xi, cell_dest_yi, end[X_AXIS], end[Y_AXIS]) * fade_scaling_factor,
+        end[E_AXIS], feed_rate, extruder);
 
       if (g26_debug_flag)
         debug_current_and_destination(PSTR("FINAL_MOVE in ubl.line_to_destination_cartesian()"));
@@ -126,235 +163,36 @@
       return;
     }
 
-    /**
-     * Past this point the move is known to cross one or more mesh lines. Check for the most common
-     * case - crossing only one X or Y line - after details are worked out to reduce computation.
-     */
-
-    const float dx = end[X_AXIS] - start[X_AXIS],
-                dy = end[Y_AXIS] - start[Y_AXIS];
-
-    const int left_flag = dx < 0.0 ? 1 : 0,
-              down_flag = dy < 0.0 ? 1 : 0;
-
-    const float adx = left_flag ? -dx : dx,
-                ady = down_flag ? -dy : dy;
-
-    const int dxi = cell_start_xi == cell_dest_xi ? 0 : left_flag ? -1 : 1,
-              dyi = cell_start_yi == cell_dest_yi ? 0 : down_flag ? -1 : 1;
-
-    /**
-     * Compute the extruder scaling factor for each partial move, checking for
-     * zero-length moves that would result in an infinite scaling factor.
-     * A float divide is required for this, but then it just multiplies.
-     * Also select a scaling factor based on the larger of the X and Y
-     * components. The larger of the two is used to preserve precision.
-     */
-
-    const bool use_x_dist = adx > ady;
-
-    float on_axis_distance = use_x_dist ? dx : dy,
-          e_position = end[E_AXIS] - start[E_AXIS],
-          z_position = end[Z_AXIS] - start[Z_AXIS];
-
-    const float e_normalized_dist = e_position / on_axis_distance,
-                z_normalized_dist = z_position / on_axis_distance;
-
-    int current_xi = cell_start_xi,
-        current_yi = cell_start_yi;
-
-    const float m = dy / dx,
-                c = start[Y_AXIS] - m * start[X_AXIS];
-
-    const bool inf_normalized_flag = (isinf(e_normalized_dist) != 0),
-               inf_m_flag = (isinf(m) != 0);
-
-    /**
-     * Handle vertical lines that stay within one column.
-     * These need not be perfectly vertical.
-     */
-    if (dxi == 0) {             // Vertical line?
-      current_yi += down_flag;  // Line going down? Just go to the bottom.
-      while (current_yi != cell_dest_yi + down_flag) {
-        current_yi += dyi;
-        const float next_mesh_line_y = mesh_index_to_ypos(current_yi);
-
-        /**
-         * Skip the calculations for an infinite slope.
-         * For others the next X is the same so this can continue.
-         * Calculate X at the next Y mesh line.
-         */
-        const float rx = inf_m_flag ? start[X_AXIS] : (next_mesh_line_y - c) / m;
-
-        float z0 = z_correction_for_x_on_horizontal_mesh_line(rx, current_xi, current_yi)
-                   * planner.fade_scaling_factor_for_z(end[Z_AXIS]);
-
-        // Undefined parts of the Mesh in z_values[][] are NAN.
-        // Replace NAN corrections with 0.0 to prevent NAN propagation.
-        if (isnan(z0)) z0 = 0.0;
-
-        const float ry = mesh_index_to_ypos(current_yi);
-
-        /**
-         * Without this check, it's possible to generate a zero length move, as in the case where
-         * the line is heading down, starting exactly on a mesh line boundary. Since this is rare
-         * it might be fine to remove this check and let planner.buffer_segment() filter it out.
-         */
-        if (ry != start[Y_AXIS]) {
-          if (!inf_normalized_flag) {
-            on_axis_distance = use_x_dist ? rx - start[X_AXIS] : ry - start[Y_AXIS];
-            e_position = start[E_AXIS] + on_axis_distance * e_normalized_dist;
-            z_position = start[Z_AXIS] + on_axis_distance * z_normalized_dist;
-          }
-          else {
-            e_position = end[E_AXIS];
-            z_position = end[Z_AXIS];
-          }
-
-          planner.buffer_segment(rx, ry, z_position + z0, e_position, feed_rate, extruder);
-        } //else printf("FIRST MOVE PRUNED  ");
-      }
-
-      if (g26_debug_flag)
-        debug_current_and_destination(PSTR("vertical move done in ubl.line_to_destination_cartesian()"));
-
-      // At the final destination? Usually not, but when on a Y Mesh Line it's completed.
-      if (current_position[X_AXIS] != end[X_AXIS] || current_position[Y_AXIS] != end[Y_AXIS])
-        goto FINAL_MOVE;
-
-      set_current_from_destination();
-      return;
+    COPY(ubl_line.start, start);
+    COPY(ubl_line.end, end);
+    ubl_line.feedrate = feed_rate;
+    ubl_line.extruder = extruder;
+    ubl_line.fade_scaling_factor = fade_scaling_factor;
+
+    ubl_line.cell_x = cell_start_xi;
+    ubl_line.cell_y = cell_start_yi;
+    ubl_line.step_x = cell_dest_xi < cell_start_xi ? -1 : 1;
+    ubl_line.step_y = cell_dest_yi < cell_start_yi ? -1 : 1;
+    ubl_line.lines_x = (cell_dest_xi - cell_start_xi) * ubl_line.step_x;
+    ubl_line.lines_y = (cell_dest_yi - cell_start_yi) * ubl_line.step_y;
+
+    // One division per axis, then the walk only adds
+    if (ubl_line.lines_x) {
+      const float inv_dx = 1.0 / (end[X_AXIS] - start[X_AXIS]);
+      ubl_line.t_x = (mesh_index_to_xpos(cell_start_xi + (ubl_line.step_x > 0)) - start[X_AXIS]) * inv_dx;
+      ubl_line.t_dx = (MESH_X_DIST) * inv_dx * ubl_line.step_x;
     }
-
-    /**
-     * Handle horizontal lines that stay within one row.
-     * These need not be perfectly horizontal.
-     */
-    if (dyi == 0) {             // Horizontal line?
-      current_xi += left_flag;  // Heading left? Just go to the left edge of the cell for the first move.
-      while (current_xi != cell_dest_xi + left_flag) {
-        current_xi += dxi;
-        const float next_mesh_line_x = mesh_index_to_xpos(current_xi),
-                    ry = m * next_mesh_line_x + c;   // Calculate Y at the next X mesh line
-
-        float z0 = z_correction_for_y_on_vertical_mesh_line(ry, current_xi, current_yi)
-                   * planner.fade_scaling_factor_for_z(end[Z_AXIS]);
-
-        // Undefined parts of the Mesh in z_values[][] are NAN.
-        // Replace NAN corrections with 0.0 to prevent NAN propagation.
-        if (isnan(z0)) z0 = 0.0;
-
-        const float rx = mesh_index_to_xpos(current_xi);
-
-        /**
-         * Without this check, it's possible to generate a zero length move, as in the case where
-         * the line is heading left, starting exactly on a mesh line boundary. Since this is rare
-         * it might be fine to remove this check and let planner.buffer_segment() filter it out.
-         */
-        if (rx != start[X_AXIS]) {
-          if (!inf_normalized_flag) {
-            on_axis_distance = use_x_dist ? rx - start[X_AXIS] : ry - start[Y_AXIS];
-            e_position = start[E_AXIS] + on_axis_distance * e_normalized_dist;  // is based on X or Y because this is a horizontal move
-            z_position = start[Z_AXIS] + on_axis_distance * z_normalized_dist;
-          }
-          else {
-            e_position = end[E_AXIS];
-            z_position = end[Z_AXIS];
-          }
-
-          planner.buffer_segment(rx, ry, z_position + z0, e_position, feed_rate, extruder);
-        } //else printf("FIRST MOVE PRUNED  ");
-      }
-
-      if (g26_debug_flag)
-        debug_current_and_destination(PSTR("horizontal move done in ubl.line_to_destination_cartesian()"));
-
-      if (current_position[X_AXIS] != end[X_AXIS] || current_position[Y_AXIS] != end[Y_AXIS])
-        goto FINAL_MOVE;
-
-      set_current_from_destination();
-      return;
+    if (ubl_line.lines_y) {
+      const float inv_dy = 1.0 / (end[Y_AXIS] - start[Y_AXIS]);
+      ubl_line.t_y = (mesh_index_to_ypos(cell_start_yi + (ubl_line.step_y > 0)) - start[Y_AXIS]) * inv_dy;
+      ubl_line.t_dy = (MESH_Y_DIST) * inv_dy * ubl_line.step_y;
     }
 
-    /**
-     *
-     * Handle the generic case of a line crossing both X and Y Mesh lines.
-     *
-     */
-
-    int xi_cnt = cell_start_xi - cell_dest_xi,
-        yi_cnt = cell_start_yi - cell_dest_yi;
-
-    if (xi_cnt < 0) xi_cnt = -xi_cnt;
-    if (yi_cnt < 0) yi_cnt = -yi_cnt;
-
-    current_xi += left_flag;
-    current_yi += down_flag;
-
-    while (xi_cnt || yi_cnt) {
-
-      const float next_mesh_line_x = mesh_index_to_xpos(current_xi + dxi),
-                  next_mesh_line_y = mesh_index_to_ypos(current_yi + dyi),
-                  ry = m * next_mesh_line_x + c,   // Calculate Y at the next X mesh line
-                  rx = (next_mesh_line_y - c) / m; // Calculate X at the next Y mesh line
-                                                   // (No need to worry about m being zero.
-                                                   //  If that was the case, it was already detected
-                                                   //  as a vertical line move above.)
-
-      if (left_flag == (rx > next_mesh_line_x)) { // Check if we hit the Y line first
-        // Yes!  Crossing a Y Mesh Line next
-        float z0 = z_correction_for_x_on_horizontal_mesh_line(rx, current_xi - left_flag, current_yi + dyi)
-                   * planner.fade_scaling_factor_for_z(end[Z_AXIS]);
-
-        // Undefined parts of the Mesh in z_values[][] are NAN.
-        // Replace NAN corrections with 0.0 to prevent NAN propagation.
-        if (isnan(z0)) z0 = 0.0;
-
-        if (!inf_normalized_flag) {
-          on_axis_distance = use_x_dist ? rx - start[X_AXIS] : next_mesh_line_y - start[Y_AXIS];
-          e_position = start[E_AXIS] + on_axis_distance * e_normalized_dist;
-          z_position = start[Z_AXIS] + on_axis_distance * z_normalized_dist;
-        }
-        else {
-          e_position = end[E_AXIS];
-          z_position = end[Z_AXIS];
-        }
-        planner.buffer_segment(rx, next_mesh_line_y, z_position + z0, e_position, feed_rate, extruder);
-        current_yi += dyi;
-        yi_cnt--;
-      }
-      else {
-        // Yes!  Crossing a X Mesh Line next
-        float z0 = z_correction_for_y_on_vertical_mesh_line(ry, current_xi + dxi, current_yi - down_flag)
-                   * planner.fade_scaling_factor_for_z(end[Z_AXIS]);
-
-        // Undefined parts of the Mesh in z_values[][] are NAN.
-        // Replace NAN corrections with 0.0 to prevent NAN propagation.
-        if (isnan(z0)) z0 = 0.0;
-
-        if (!inf_normalized_flag) {
-          on_axis_distance = use_x_dist ? next_mesh_line_x - start[X_AXIS] : ry - start[Y_AXIS];
-          e_position = start[E_AXIS] + on_axis_distance * e_normalized_dist;
-          z_position = start[Z_AXIS] + on_axis_distance * z_normalized_dist;
-        }
-        else {
-          e_position = end[E_AXIS];
-          z_position = end[Z_AXIS];
-        }
-
-        planner.buffer_segment(next_mesh_line_x, ry, z_position + z0, e_position, feed_rate, extruder);
-        current_xi += dxi;
-        xi_cnt--;
-      }
-
-      if (xi_cnt < 0 || yi_cnt < 0) break; // Too far! Exit the loop and go to FINAL_MOVE
-    }
+    get_cell(ubl_line.cell, cell_start_xi, cell_start_yi);
+    segment_feed.start(ubl_line);
 
     if (g26_debug_flag)
-      debug_current_and_destination(PSTR("generic move done in ubl.line_to_destination_cartesian()"));
-
-    if (current_position[X_AXIS] != end[X_AXIS] || current_position[Y_AXIS] != end[Y_AXIS])
-      goto FINAL_MOVE;
+      debug_current_and_destination(PSTR("walk started in ubl.line_to_destination_cartesian()"));
 
     set_current_from_destination();
   }
@@ -415,164 +253,185 @@
   #endif
 
   /**
-   * Prepare a segmented linear move for DELTA/SCARA/CARTESIAN with UBL and FADE semantics.
-   * This calls planner.buffer_segment multiple times for small incremental moves.
-   * Returns true if did NOT move, false if moved (requires current_position update).
+   * The segments of a UBL move, buffered one at a time by the segment feed.
+   * The mesh cell invariants are computed again each time a segment
+   * leaves the cell.
    */
+  class UBLSegmentProducer : public SegmentProducer {
+    public:
+      float raw[XYZE], target[XYZE], diff[XYZE], feedrate,
+            cx, cy, z_cxy0, z_cxym, z_sxy0, z_sxym;
+      uint16_t segments;
+      bool leveled, in_cell;
 
-  bool _O2 unified_bed_leveling::prepare_segmented_line_to(const float (&rtarget)[XYZE], const float &feedrate) {
+      #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
+        float fade_scaling_factor;
+      #endif
 
-    if (!position_is_reachable(rtarget[X_AXIS], rtarget[Y_AXIS]))  // fail if moving outside reachable boundary
-      return true; // did not move, so current_position still accurate
+      bool _O2 next();
+  };
 
-    const float total[XYZE] = {
-      rtarget[X_AXIS] - current_position[X_AXIS],
-      rtarget[Y_AXIS] - current_position[Y_AXIS],
-      rtarget[Z_AXIS] - current_position[Z_AXIS],
-      rtarget[E_AXIS] - current_position[E_AXIS]
-    };
-
-    const float cartesian_xy_mm = HYPOT(total[X_AXIS], total[Y_AXIS]);  // total horizontal xy distance
-
-    #if IS_KINEMATIC
-      const float seconds = cartesian_xy_mm / feedrate;                                  // seconds to move xy distance at requested rate
-      uint16_t segments = lroundf(delta_segments_per_second * seconds),                  // preferred number of segments for distance @ feedrate
-               seglimit = lroundf(cartesian_xy_mm * (1.0 / (DELTA_SEGMENT_MIN_LENGTH))); // number of segments at minimum segment length
-      NOMORE(segments, seglimit);                                                        // limit to minimum segment length (fewer segments)
-    #else
-      uint16_t segments = lroundf(cartesian_xy_mm * (1.0 / (DELTA_SEGMENT_MIN_LENGTH))); // cartesian fixed segment length
-    #endif
+  bool _O2 UBLSegmentProducer::next() {
 
-    NOLESS(segments, 1);                        // must have at least one segment
-    const float inv_segments = 1.0 / segments;  // divide once, multiply thereafter
-
-    #if IS_SCARA // scale the feed rate from mm/s to degrees/s
-      scara_feed_factor = cartesian_xy_mm * inv_segments * feedrate;
-      scara_oldA = stepper.get_axis_position_degrees(A_AXIS);
-      scara_oldB = stepper.get_axis_position_degrees(B_AXIS);
-    #endif
-
-    const float diff[XYZE] = {
-      total[X_AXIS] * inv_segments,
-      total[Y_AXIS] * inv_segments,
-      total[Z_AXIS] * inv_segments,
-      total[E_AXIS] * inv_segments
-    };
-
-    // Note that E segment distance could vary slightly as z mesh height
-    // changes for each segment, but small enough to ignore.
-
-    float raw[XYZE] = {
-      current_position[X_AXIS],
-      current_position[Y_AXIS],
-      current_position[Z_AXIS],
-      current_position[E_AXIS]
-    };
-
-    // Only compute leveling per segment if ubl active and target below z_fade_height.
-    if (!planner.leveling_active || !planner.leveling_active_at_z(rtarget[Z_AXIS])) {   // no mesh leveling
-      while (--segments) {
+    if (!leveled) {                               // no mesh leveling
+      if (--segments) {
         LOOP_XYZE(i) raw[i] += diff[i];
         ubl_buffer_segment_raw(raw, feedrate);
+        return true;
       }
-      ubl_buffer_segment_raw(rtarget, feedrate);
-      return false; // moved but did not set_current_from_destination();
+      ubl_buffer_segment_raw(target, feedrate);
+      return false;
     }
 
-    // Otherwise perform per-segment leveling
-
-    #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
-      const float fade_scaling_factor = planner.fade_scaling_factor_for_z(rtarget[Z_AXIS]);
-    #endif
-
-    // increment to first segment destination
-    LOOP_XYZE(i) raw[i] += diff[i];
-
-    for (;;) {  // for each mesh cell encountered during the move
+    if (!in_cell) {  // entering a mesh cell
 
       // Compute mesh cell invariants that remain constant for all segments within cell.
       // Note for cell index, if point is outside the mesh grid (in MESH_INSET perimeter)
       // the bilinear interpolation from the adjacent cell within the mesh will still work.
-      // Inner loop will exit each time (because out of cell bounds) but will come back
-      // in top of loop and again re-find same adjacent cell and use it, just less efficient
+      // Each segment will leave the cell (because out of cell bounds) but the next
+      // one will again re-find same adjacent cell and use it, just less efficient
       // for mesh inset area.
 
-      int8_t cell_xi = (raw[X_AXIS] - (MESH_MIN_X)) * (1.0 / (MESH_X_DIST)),
-             cell_yi = (raw[Y_AXIS] - (MESH_MIN_Y)) * (1.0 / (MESH_Y_DIST));
-
-      cell_xi = constrain(cell_xi, 0, (GRID_MAX_POINTS_X) - 1);
-      cell_yi = constrain(cell_yi, 0, (GRID_MAX_POINTS_Y) - 1);
+      const int8_t cell_xi = ubl.get_cell_index_x(raw[X_AXIS]),
+                   cell_yi = ubl.get_cell_index_y(raw[Y_AXIS]);
 
-      const float x0 = mesh_index_to_xpos(cell_xi),   // 64 byte table lookup avoids mul+add
-                  y0 = mesh_index_to_ypos(cell_yi);
+      const float x0 = ubl.mesh_index_to_xpos(cell_xi),   // 64 byte table lookup avoids mul+add
+                  y0 = ubl.mesh_index_to_ypos(cell_yi);
 
-      float z_x0y0 = z_values[cell_xi  ][cell_yi  ],  // z at lower left corner
-            z_x1y0 = z_values[cell_xi+1][cell_yi  ],  // z at upper left corner
-            z_x0y1 = z_values[cell_xi  ][cell_yi+1],  // z at lower right corner
-            z_x1y1 = z_values[cell_xi+1][cell_yi+1];  // z at upper right corner
+      float z_x0y0 = ubl.z_values[cell_xi  ][cell_yi  ],  // z at lower left corner
+            z_x1y0 = ubl.z_values[cell_xi+1][cell_yi  ],  // z at upper left corner
+            z_x0y1 = ubl.z_values[cell_xi  ][cell_yi+1],  // z at lower right corner
+            z_x1y1 = ubl.z_values[cell_xi+1][cell_yi+1];  // z at upper right corner
 
       if (isnan(z_x0y0)) z_x0y0 = 0;              // ideally activating planner.leveling_active (G29 A)
       if (isnan(z_x1y0)) z_x1y0 = 0;              //   should refuse if any invalid mesh points
       if (isnan(z_x0y1)) z_x0y1 = 0;              //   in order to avoid isnan tests per cell,
       if (isnan(z_x1y1)) z_x1y1 = 0;              //   thus guessing zero for undefined points
 
-      float cx = raw[X_AXIS] - x0,   // cell-relative x and y
-            cy = raw[Y_AXIS] - y0;
+      cx = raw[X_AXIS] - x0;   // cell-relative x and y
+      cy = raw[Y_AXIS] - y0;
 
-      const float z_xmy0 = (z_x1y0 - z_x0y0) * (1.0 / (MESH_X_DIST)),   // z slope per x along y0 (lower left to lower right)
-                  z_xmy1 = (z_x1y1 - z_x0y1) * (1.0 / (MESH_X_DIST));   // z slope per x along y1 (upper left to upper right)
+      const float z_xmy0 = (z_x1y0 - z_x0y0) * (MESH_X_FACTOR),   // z slope per x along y0 (lower left to lower right)
+                  z_xmy1 = (z_x1y1 - z_x0y1) * (MESH_X_FACTOR);   // z slope per x along y1 (upper left to upper right)
 
-            float z_cxy0 = z_x0y0 + z_xmy0 * cx;            // z height along y0 at cx (changes for each cx in cell)
+      z_cxy0 = z_x0y0 + z_xmy0 * cx;                        // z height along y0 at cx (changes for each cx in cell)
 
       const float z_cxy1 = z_x0y1 + z_xmy1 * cx,            // z height along y1 at cx
                   z_cxyd = z_cxy1 - z_cxy0;                 // z height difference along cx from y0 to y1
 
-            float z_cxym = z_cxyd * (1.0 / (MESH_Y_DIST));  // z slope per y along cx from y0 to y1 (changes for each cx in cell)
+      z_cxym = z_cxyd * (MESH_Y_FACTOR);              // z slope per y along cx from y0 to y1 (changes for each cx in cell)
 
-      //    float z_cxcy = z_cxy0 + z_cxym * cy;            // interpolated mesh z height along cx at cy (do inside the segment loop)
+      //    float z_cxcy = z_cxy0 + z_cxym * cy;            // interpolated mesh z height along cx at cy (do for each segment)
 
       // As subsequent segments step through this cell, the z_cxy0 intercept will change
       // and the z_cxym slope will change, both as a function of cx within the cell, and
       // each change by a constant for fixed segment lengths.
 
-      const float z_sxy0 = z_xmy0 * diff[X_AXIS],                                     // per-segment adjustment to z_cxy0
-                  z_sxym = (z_xmy1 - z_xmy0) * (1.0 / (MESH_Y_DIST)) * diff[X_AXIS];  // per-segment adjustment to z_cxym
+      z_sxy0 = z_xmy0 * diff[X_AXIS];                                     // per-segment adjustment to z_cxy0
+      z_sxym = (z_xmy1 - z_xmy0) * (MESH_Y_FACTOR) * diff[X_AXIS];  // per-segment adjustment to z_cxym
 
-      for (;;) {  // for all segments within this mesh cell
+      in_cell = true;
+    }
 
-        if (--segments == 0)                      // if this is last segment, use rtarget for exact
-          COPY(raw, rtarget);
+    if (--segments == 0)                        // if this is last segment, use target for exact
+      COPY(raw, target);
 
-        const float z_cxcy = (z_cxy0 + z_cxym * cy) // interpolated mesh z height along cx at cy
-          #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
-            * fade_scaling_factor                   // apply fade factor to interpolated mesh height
-          #endif
-        ;
+    const float z_cxcy = (z_cxy0 + z_cxym * cy) // interpolated mesh z height along cx at cy
+      #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
+        * fade_scaling_factor                   // apply fade factor to interpolated mesh height
+      #endif
+    ;
 
-        const float z = raw[Z_AXIS];
-        raw[Z_AXIS] += z_cxcy;
-        ubl_buffer_segment_raw(raw, feedrate);
-        raw[Z_AXIS] = z;
+    const float z = raw[Z_AXIS];
+    raw[Z_AXIS] += z_cxcy;
+    ubl_buffer_segment_raw(raw, feedrate);
+    raw[Z_AXIS] = z;
 
-        if (segments == 0)                        // done with last segment
-          return false;                           // did not set_current_from_destination()
+    if (segments == 0)                          // done with last segment
+      return false;
 
-        LOOP_XYZE(i) raw[i] += diff[i];
+    LOOP_XYZE(i) raw[i] += diff[i];
+
+    cx += diff[X_AXIS];
+    cy += diff[Y_AXIS];
+
+    if (!WITHIN(cx, 0, MESH_X_DIST) || !WITHIN(cy, 0, MESH_Y_DIST))    // done within this cell, find the next
+      in_cell = false;
+    else {
+      // Next segment still within same mesh cell, adjust the per-segment
+      // slope and intercept to compute next z height.
+      z_cxy0 += z_sxy0;   // adjust z_cxy0 by per-segment z_sxy0
+      z_cxym += z_sxym;   // adjust z_cxym by per-segment z_sxym
+    }
+
+    return true;
+  }
+
+  static UBLSegmentProducer ubl_segments;
+
+  /**
+   * Prepare a segmented linear move for DELTA/SCARA/CARTESIAN with UBL and FADE semantics.
+   * This calls planner.buffer_segment multiple times for small incremental moves.
+   * Returns true if did NOT move, false if moved (requires current_position update).
+   */
 
-        cx += diff[X_AXIS];
-        cy += diff[Y_AXIS];
+  bool _O2 unified_bed_leveling::prepare_segmented_line_to(const float (&rtarget)[XYZE], const float &feedrate) {
 
-        if (!WITHIN(cx, 0, MESH_X_DIST) || !WITHIN(cy, 0, MESH_Y_DIST))    // done within this cell, break to next
-          break;
+    if (!position_is_reachable(rtarget[X_AXIS], rtarget[Y_AXIS]))  // fail if moving outside reachable boundary
+      return true; // did not move, so current_position still accurate
 
-        // Next segment still within same mesh cell, adjust the per-segment
-        // slope and intercept to compute next z height.
+    const float total[XYZE] = {
+      rtarget[X_AXIS] - current_position[X_AXIS],
+      rtarget[Y_AXIS] - current_position[Y_AXIS],
+      rtarget[Z_AXIS] - current_position[Z_AXIS],
+      rtarget[E_AXIS] - current_position[E_AXIS]
+    };
 
-        z_cxy0 += z_sxy0;   // adjust z_cxy0 by per-segment z_sxy0
-        z_cxym += z_sxym;   // adjust z_cxym by per-segment z_sxym
+    const float cartesian_xy_mm = HYPOT(total[X_AXIS], total[Y_AXIS]);  // total horizontal xy distance
+
+    #if IS_KINEMATIC
+      const float seconds = cartesian_xy_mm / feedrate;                                  // seconds to move xy distance at requested rate
+      uint16_t segments = lroundf(delta_segments_per_second * seconds),                  // preferred number of segments for distance @ feedrate
+               seglimit = lroundf(cartesian_xy_mm * (1.0 / (DELTA_SEGMENT_MIN_LENGTH))); // number of segments at minimum segment length
+      NOMORE(segments, seglimit);                                                        // limit to minimum segment length (fewer segments)
+    #else
+      uint16_t segments = lroundf(cartesian_xy_mm * (1.0 / (DELTA_SEGMENT_MIN_LENGTH))); // cartesian fixed segment length
+    #endif
+
+    NOLESS(segments, 1);                        // must have at least one segment
+    const float inv_segments = 1.0 / segments;  // divide once, multiply thereafter
+
+    #if IS_SCARA // scale the feed rate from mm/s to degrees/s
+      scara_feed_factor = cartesian_xy_mm * inv_segments * feedrate;
+      scara_oldA = stepper.get_axis_position_degrees(A_AXIS);
+      scara_oldB = stepper.get_axis_position_degrees(B_AXIS);
+    #endif
+
+    LOOP_XYZE(i) {
+      ubl_segments.diff[i] = total[i] * inv_segments;
+      ubl_segments.raw[i] = current_position[i];
+      ubl_segments.target[i] = rtarget[i];
+    }
+
+    // Note that E segment distance could vary slightly as z mesh height
+    // changes for each segment, but small enough to ignore.
+
+    ubl_segments.feedrate = feedrate;
+    ubl_segments.segments = segments;
+
+    // Only compute leveling per segment if ubl active and target below z_fade_height.
+    ubl_segments.leveled = planner.leveling_active && planner.leveling_active_at_z(rtarget[Z_AXIS]);
+    if (ubl_segments.leveled) {
+      #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
+        ubl_segments.fade_scaling_factor = planner.fade_scaling_factor_for_z(rtarget[Z_AXIS]);
+      #endif
+
+      // increment to first segment destination
+      LOOP_XYZE(i) ubl_segments.raw[i] += ubl_segments.diff[i];
+      ubl_segments.in_cell = false;
+    }
 
-      } // segment loop
-    } // cell loop
+    segment_feed.start(ubl_segments);
 
     return false; // caller will update current_position
   }
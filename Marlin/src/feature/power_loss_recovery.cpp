@@ -24,6 +24,25 @@
  * power_loss_recovery.cpp - Resume an SD print after power-loss
  */
 
+/**
+ * The journal is a file of JOB_RECOVERY_BLOCKS consecutive blocks on the
+ * SD card, allocated once and written a whole block at a time, straight to
+ * the card without going through the FAT:
+ *
+ *   Block 0          The job: its number, the file name, and whether it's
+ *                    still printing
+ *   Blocks 1 to N-1  A ring of journal blocks. Each has a header with the
+ *                    job, a sequence number and the settings that seldom
+ *                    change, then an entry for each command run from the
+ *                    file: its position in the file, the position and
+ *                    feedrate after it, and the elapsed time.
+ *
+ * Entries collect in RAM, and the block is written when it's full, when the
+ * nozzle rises, when the settings change (which starts the next block) or
+ * after SAVE_INFO_INTERVAL_MS. Recovery takes the last entry with a good CRC
+ * from the newest block of the job.
+ */
+
 #include "../inc/MarlinConfigPre.h"
 
 #if ENABLED(POWER_LOSS_RECOVERY)
@@ -37,203 +56,371 @@
 #include "../module/temperature.h"
 #include "../sd/cardreader.h"
 #include "../core/serial.h"
+#include "../core/utility.h"
 
 // Recovery data
 job_recovery_info_t job_recovery_info;
 JobRecoveryPhase job_recovery_phase = JOB_RECOVERY_IDLE;
 uint8_t job_recovery_commands_count; //=0
-char job_recovery_commands[BUFSIZE + APPEND_CMD_COUNT][MAX_CMD_SIZE];
+char job_recovery_commands[APPEND_CMD_COUNT][MAX_CMD_SIZE];
+
+#define JOURNAL_MAGIC       0x4C50524DUL  // "MRPL"
+#define JOURNAL_BLOCK_SIZE  512
+#define JOURNAL_RING        (JOB_RECOVERY_BLOCKS - 1)
+
+typedef struct {
+  uint32_t magic, job;
+  bool printing;                        // Cleared when the job finishes or is aborted
+  char sd_filename[MAXPATHNAMELENGTH];
+  uint16_t crc;
+} journal_job_t;
+
+typedef struct {
+  uint32_t magic, job, sequence;
+  job_recovery_state_t state;
+  uint16_t crc;
+} journal_header_t;
+
+#define JOURNAL_ENTRIES ((JOURNAL_BLOCK_SIZE - sizeof(journal_header_t)) / sizeof(job_recovery_entry_t))
+
+typedef union {
+  uint8_t data[JOURNAL_BLOCK_SIZE];
+  journal_job_t job;
+  struct {
+    journal_header_t header;
+    job_recovery_entry_t entry[JOURNAL_ENTRIES];
+  } ring;
+} journal_block_t;
+
+static_assert(sizeof(journal_block_t) == JOURNAL_BLOCK_SIZE, "A journal block must be one SD block.");
+static_assert(JOB_RECOVERY_BLOCKS > 2, "JOB_RECOVERY_BLOCKS must be at least 3.");
+
+static journal_block_t block;           // The block being filled, or read at boot
+static uint32_t journal_job,            // Job being journaled, 0 for none
+                journal_sequence;       // Sequence of the block being filled
+static uint16_t journal_slot;           // Ring block being filled, 1 to JOURNAL_RING
+static uint8_t journal_count,           // Entries in the block
+               journal_depth;           // Subroutine depth of the file being journaled
+static bool journal_started,            // The block holds a header of the job
+            journal_dirty;              // Entries not yet written
+static float journal_z;                 // Z when the block was last written
+
+static inline uint16_t job_crc() {
+  uint16_t crc = 0;
+  crc16(&crc, &block.job, offsetof(journal_job_t, crc));
+  return crc;
+}
+
+static inline uint16_t header_crc() {
+  uint16_t crc = 0;
+  crc16(&crc, &block.ring.header, offsetof(journal_header_t, crc));
+  return crc;
+}
+
+static inline uint16_t entry_crc(const job_recovery_entry_t &entry) {
+  uint16_t crc = block.ring.header.crc;   // Tie the entry to the job and sequence of its block
+  crc16(&crc, &entry, offsetof(job_recovery_entry_t, crc));
+  return crc;
+}
+
+static inline bool job_is_valid() {
+  return block.job.magic == JOURNAL_MAGIC && block.job.crc == job_crc();
+}
+
+static inline bool header_is_valid(const uint32_t job) {
+  return block.ring.header.magic == JOURNAL_MAGIC && block.ring.header.job == job
+      && block.ring.header.crc == header_crc();
+}
 
-// Private
-static char sd_filename[MAXPATHNAMELENGTH];
+// Entries in the block, up to the first one that isn't valid
+static uint8_t valid_entries() {
+  uint8_t count = 0;
+  while (count < JOURNAL_ENTRIES && block.ring.entry[count].crc == entry_crc(block.ring.entry[count])) count++;
+  return count;
+}
 
 #if ENABLED(DEBUG_POWER_LOSS_RECOVERY)
   void debug_print_job_recovery(const bool recovery) {
-    SERIAL_PROTOCOLPAIR("valid_head:", (int)job_recovery_info.valid_head);
-    SERIAL_PROTOCOLLNPAIR(" valid_foot:", (int)job_recovery_info.valid_foot);
-    if (job_recovery_info.valid_head) {
-      if (job_recovery_info.valid_head == job_recovery_info.valid_foot) {
-        SERIAL_PROTOCOLPGM("current_position");
-        LOOP_XYZE(i) SERIAL_PROTOCOLPAIR(": ", job_recovery_info.current_position[i]);
-        SERIAL_EOL();
-        SERIAL_PROTOCOLLNPAIR("feedrate: ", job_recovery_info.feedrate);
-        SERIAL_PROTOCOLPGM("target_temperature");
-        HOTEND_LOOP() SERIAL_PROTOCOLPAIR(": ", job_recovery_info.target_temperature[e]);
-        SERIAL_EOL();
-        SERIAL_PROTOCOLPGM("fanSpeeds");
-        for(uint8_t i = 0; i < FAN_COUNT; i++) SERIAL_PROTOCOLPAIR(": ", job_recovery_info.fanSpeeds[i]);
-        SERIAL_EOL();
-        #if HAS_LEVELING
-          SERIAL_PROTOCOLPAIR("leveling: ", int(job_recovery_info.leveling));
-          SERIAL_PROTOCOLLNPAIR(" fade: ", int(job_recovery_info.fade));
-        #endif
-        #if HAS_HEATED_BED
-          SERIAL_PROTOCOLLNPAIR("target_temperature_bed: ", job_recovery_info.target_temperature_bed);
-        #endif
-        SERIAL_PROTOCOLLNPAIR("cmd_queue_index_r: ", job_recovery_info.cmd_queue_index_r);
-        SERIAL_PROTOCOLLNPAIR("commands_in_queue: ", job_recovery_info.commands_in_queue);
-        if (recovery)
-          for (uint8_t i = 0; i < job_recovery_commands_count; i++) SERIAL_PROTOCOLLNPAIR("> ", job_recovery_commands[i]);
-        else
-          for (uint8_t i = 0; i < job_recovery_info.commands_in_queue; i++) SERIAL_PROTOCOLLNPAIR("> ", job_recovery_info.command_queue[i]);
-        SERIAL_PROTOCOLLNPAIR("sd_filename: ", sd_filename);
-        SERIAL_PROTOCOLLNPAIR("sdpos: ", job_recovery_info.sdpos);
-        SERIAL_PROTOCOLLNPAIR("print_job_elapsed: ", job_recovery_info.print_job_elapsed);
-      }
-      else
-        SERIAL_PROTOCOLLNPGM("INVALID DATA");
+    if (recovery) {
+      if (!job_recovery_info.valid) { SERIAL_PROTOCOLLNPGM("NO VALID DATA"); return; }
+      SERIAL_PROTOCOLLNPAIR("sd_filename: ", job_recovery_info.sd_filename);
     }
+    else
+      SERIAL_PROTOCOLLNPAIR("journal_sequence: ", journal_sequence);
+    const job_recovery_state_t &state = recovery ? job_recovery_info.state : block.ring.header.state;
+    const job_recovery_entry_t &entry = recovery ? job_recovery_info.entry : block.ring.entry[journal_count - 1];
+    SERIAL_PROTOCOLPGM("current_position");
+    LOOP_XYZE(i) SERIAL_PROTOCOLPAIR(": ", entry.current_position[i]);
+    SERIAL_EOL();
+    SERIAL_PROTOCOLLNPAIR("feedrate: ", entry.feedrate);
+    SERIAL_PROTOCOLPGM("target_temperature");
+    HOTEND_LOOP() SERIAL_PROTOCOLPAIR(": ", state.target_temperature[e]);
+    SERIAL_EOL();
+    SERIAL_PROTOCOLPGM("fanSpeeds");
+    for(uint8_t i = 0; i < FAN_COUNT; i++) SERIAL_PROTOCOLPAIR(": ", state.fanSpeeds[i]);
+    SERIAL_EOL();
+    #if HAS_LEVELING
+      SERIAL_PROTOCOLPAIR("leveling: ", int(state.leveling));
+      SERIAL_PROTOCOLLNPAIR(" fade: ", int(state.fade));
+    #endif
+    #if HAS_HEATED_BED
+      SERIAL_PROTOCOLLNPAIR("target_temperature_bed: ", state.target_temperature_bed);
+    #endif
+    if (recovery)
+      for (uint8_t i = 0; i < job_recovery_commands_count; i++) SERIAL_PROTOCOLLNPAIR("> ", job_recovery_commands[i]);
+    SERIAL_PROTOCOLLNPAIR("sdpos: ", entry.sdpos);
+    SERIAL_PROTOCOLLNPAIR("print_job_elapsed: ", entry.print_job_elapsed);
   }
 #endif // DEBUG_POWER_LOSS_RECOVERY
 
 /**
  * Check for Print Job Recovery
- * If the file has a saved state, populate the job_recovery_commands queue
+ * If the journal holds a job that was printing, populate the
+ * job_recovery_commands queue, and continue the journal of that job
  */
 void do_print_job_recovery() {
   //if (job_recovery_commands_count > 0) return;
   memset(&job_recovery_info, 0, sizeof(job_recovery_info));
   ZERO(job_recovery_commands);
+  journal_job = 0;
 
   if (!card.cardOK) card.initsd();
 
-  if (card.cardOK) {
+  if (card.cardOK && card.openJobRecoveryFile(JOB_RECOVERY_BLOCKS)
+    && card.readJobRecoveryBlock(0, block.data) && job_is_valid() && block.job.printing
+  ) {
+    const uint32_t job = block.job.job;
+    strcpy(job_recovery_info.sd_filename, block.job.sd_filename);
+
+    // Find the newest block with a valid entry. A block torn by the power
+    // failure has no valid entries, or valid ones up to the torn part.
+    uint16_t slot = 0;
+    uint32_t sequence = 0;
+    for (uint16_t s = 1; s <= JOURNAL_RING; s++)
+      if (card.readJobRecoveryBlock(s, block.data) && header_is_valid(job) && valid_entries()
+        && (!slot || (int32_t)(block.ring.header.sequence - sequence) > 0)
+      ) {
+        slot = s;
+        sequence = block.ring.header.sequence;
+      }
+
+    if (slot && card.readJobRecoveryBlock(slot, block.data)) {
+      const uint8_t count = valid_entries();
+      if (header_is_valid(job) && count) {
+        job_recovery_info.state = block.ring.header.state;
+        job_recovery_info.entry = block.ring.entry[count - 1];
+        job_recovery_info.valid = true;
+
+        // A recovered print goes on in the same journal, after this block
+        journal_job = job;
+        journal_slot = slot;
+        journal_sequence = sequence;
+        journal_count = JOURNAL_ENTRIES;
+        journal_depth = 0;
+        journal_started = true;
+        journal_dirty = false;
+      }
+    }
+  }
+
+  #if ENABLED(DEBUG_POWER_LOSS_RECOVERY)
+    SERIAL_PROTOCOLLNPAIR("Journal entries per block: ", (int)JOURNAL_ENTRIES);
+  #endif
+
+  if (job_recovery_info.valid) {
+
+    uint8_t ind = 0;
+
+    #if HAS_LEVELING
+      strcpy_P(job_recovery_commands[ind++], PSTR("M420 S0 Z0"));               // Leveling off before G92 or G28
+    #endif
+
+    strcpy_P(job_recovery_commands[ind++], PSTR("G92.0 Z0"));                   // Ensure Z is equal to 0
+    strcpy_P(job_recovery_commands[ind++], PSTR("G1 Z2"));                      // Raise Z by 2mm (we hope!)
+    strcpy_P(job_recovery_commands[ind++], PSTR("G28 R0"
+      #if !IS_KINEMATIC
+        " X Y"                                                                  // Home X and Y for Cartesian
+      #endif
+    ));
+
+    #if HAS_LEVELING
+      // Restore leveling state before G92 sets Z
+      // This ensures the steppers correspond to the native Z
+      char str_fade[16];
+      dtostrf(job_recovery_info.state.fade, 1, 1, str_fade);
+      sprintf_P(job_recovery_commands[ind++], PSTR("M420 S%i Z%s"), int(job_recovery_info.state.leveling), str_fade);
+    #endif
+
+    char str_1[16], str_2[16];
+    dtostrf(job_recovery_info.entry.current_position[Z_AXIS] + 2, 1, 3, str_1);
+    dtostrf(job_recovery_info.entry.current_position[E_AXIS]
+      #if ENABLED(SAVE_EACH_CMD_MODE)
+        - 5
+      #endif
+      , 1, 3, str_2
+    );
+    sprintf_P(job_recovery_commands[ind++], PSTR("G92.0 Z%s E%s"), str_1, str_2); // Current Z + 2 and E
+
+    strcpy_P(job_recovery_commands[ind++], PSTR("M117 Continuing..."));
+
+    job_recovery_commands_count = ind;
 
     #if ENABLED(DEBUG_POWER_LOSS_RECOVERY)
-      SERIAL_PROTOCOLLNPAIR("Init job recovery info. Size: ", (int)sizeof(job_recovery_info));
+      debug_print_job_recovery(true);
     #endif
 
-    if (card.jobRecoverFileExists()) {
-      card.openJobRecoveryFile(true);
-      card.loadJobRecoveryInfo();
-      card.closeJobRecoveryFile();
-      //card.removeJobRecoveryFile();
-
-      if (job_recovery_info.valid_head && job_recovery_info.valid_head == job_recovery_info.valid_foot) {
-
-        uint8_t ind = 0;
-
-        #if HAS_LEVELING
-          strcpy_P(job_recovery_commands[ind++], PSTR("M420 S0 Z0"));               // Leveling off before G92 or G28
-        #endif
-
-        strcpy_P(job_recovery_commands[ind++], PSTR("G92.0 Z0"));                   // Ensure Z is equal to 0
-        strcpy_P(job_recovery_commands[ind++], PSTR("G1 Z2"));                      // Raise Z by 2mm (we hope!)
-        strcpy_P(job_recovery_commands[ind++], PSTR("G28 R0"
-          #if !IS_KINEMATIC
-            " X Y"                                                                  // Home X and Y for Cartesian
-          #endif
-        ));
-
-        #if HAS_LEVELING
-          // Restore leveling state before G92 sets Z
-          // This ensures the steppers correspond to the native Z
-          sprintf_P(job_recovery_commands[ind++], PSTR("M420 S%i Z%s"), int(job_recovery_info.leveling), job_recovery_info.fade);
-        #endif
-
-        char str_1[16], str_2[16];
-        dtostrf(job_recovery_info.current_position[Z_AXIS] + 2, 1, 3, str_1);
-        dtostrf(job_recovery_info.current_position[E_AXIS]
-          #if ENABLED(SAVE_EACH_CMD_MODE)
-            - 5
-          #endif
-          , 1, 3, str_2
-        );
-        sprintf_P(job_recovery_commands[ind++], PSTR("G92.0 Z%s E%s"), str_1, str_2); // Current Z + 2 and E
-
-        strcpy_P(job_recovery_commands[ind++], PSTR("M117 Continuing..."));
-
-        uint8_t r = job_recovery_info.cmd_queue_index_r;
-        while (job_recovery_info.commands_in_queue) {
-          strcpy(job_recovery_commands[ind++], job_recovery_info.command_queue[r]);
-          job_recovery_info.commands_in_queue--;
-          r = (r + 1) % BUFSIZE;
-        }
-
-        job_recovery_commands_count = ind;
-
-        #if ENABLED(DEBUG_POWER_LOSS_RECOVERY)
-          debug_print_job_recovery(true);
-        #endif
-
-        card.openFile(sd_filename, true);
-        card.setIndex(job_recovery_info.sdpos);
-      }
-      else {
-        if (job_recovery_info.valid_head != job_recovery_info.valid_foot)
-          LCD_ALERTMESSAGEPGM("INVALID DATA");
-        memset(&job_recovery_info, 0, sizeof(job_recovery_info));
-      }
-    }
+    card.openFile(job_recovery_info.sd_filename, true);
+    card.setIndex(job_recovery_info.entry.sdpos);
   }
 }
 
+// Write the job block, with a new job number if 'printing'
+static bool write_job(const bool printing) {
+  uint32_t job = 0;
+  if (card.readJobRecoveryBlock(0, block.data) && job_is_valid()) job = block.job.job;
+  if (printing) {
+    if (!++job) ++job;  // non-zero in sequence
+  }
+  else if (!job || !block.job.printing) return true;
+
+  memset(block.data, 0, sizeof(block.data));
+  block.job.magic = JOURNAL_MAGIC;
+  block.job.job = job;
+  block.job.printing = printing;
+  if (printing) card.getAbsFilename(block.job.sd_filename);
+  block.job.crc = job_crc();
+  if (!card.writeJobRecoveryBlock(0, block.data)) return false;
+
+  journal_job = printing ? job : 0;
+  journal_started = journal_dirty = false;
+  journal_z = 0;  // A new job, so the next layer of it gets written
+  return true;
+}
+
+/**
+ * Start journaling the file being printed as a new job. The journal file is
+ * made on first use, and cleared of anything its blocks held before.
+ */
+static bool start_journal() {
+  journal_job = 0;
+  journal_z = 0;
+  if (!card.cardOK || !card.isFileOpen()) return false;
+  if (!card.openJobRecoveryFile(JOB_RECOVERY_BLOCKS)) {
+    if (!card.createJobRecoveryFile(JOB_RECOVERY_BLOCKS)) return false;
+    memset(block.data, 0, sizeof(block.data));
+    for (uint16_t n = 0; n < JOB_RECOVERY_BLOCKS; n++)
+      if (!card.writeJobRecoveryBlock(n, block.data)) return false;
+  }
+  journal_depth = card.getSubcallDepth();
+  return write_job(true);
+}
+
+static void write_journal() {
+  #if ENABLED(DEBUG_POWER_LOSS_RECOVERY)
+    SERIAL_PROTOCOLLNPGM("Writing journal block");
+    debug_print_job_recovery(false);
+  #endif
+  if (card.writeJobRecoveryBlock(journal_slot, block.data)) {
+    journal_dirty = false;
+    journal_z = current_position[Z_AXIS];
+  }
+  else {
+    SERIAL_PROTOCOLLNPGM("Power-loss journal write failed.");
+    journal_job = 0;  // Start again with the next command
+  }
+}
+
+/**
+ * Start journaling the file being printed. Called when a print is started
+ * or resumed, so the journal never points into a different file.
+ */
+void start_job_recovery() {
+  if (card.isFileOpen() && !start_journal()) SERIAL_PROTOCOLLNPGM("Power-loss journal unavailable.");
+}
+
 /**
- * Save the current machine state to the "bin" file
+ * Journal the state after a command from the SD file. 'sdpos' is where the
+ * next command starts, the place to resume the print.
  */
-void save_job_recovery_info() {
+void save_job_recovery_info(const uint32_t sdpos) {
+  // A subroutine file starts a job of its own, and so does returning from one
+  if ((!journal_job || journal_depth != card.getSubcallDepth()) && !start_journal()) return;
+
+  job_recovery_state_t state;
+  memset(&state, 0, sizeof(state));
+  COPY(state.target_temperature, thermalManager.target_temperature);
+  #if HAS_HEATED_BED
+    state.target_temperature_bed = thermalManager.target_temperature_bed;
+  #endif
+  COPY(state.fanSpeeds, fanSpeeds);
+  #if HAS_LEVELING
+    state.leveling = planner.leveling_active;
+    state.fade = (
+      #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
+        planner.z_fade_height
+      #else
+        0
+      #endif
+    );
+  #endif
+
+  // New settings start the next block, and so does a full one
+  const bool changed = !journal_started || memcmp(&state, &block.ring.header.state, sizeof(state));
+  if (changed || journal_count == JOURNAL_ENTRIES) {
+    if (journal_dirty) {
+      write_journal();
+      if (!journal_job) return;
+    }
+    memset(block.data, 0, sizeof(block.data));
+    journal_slot = journal_slot < JOURNAL_RING ? journal_slot + 1 : 1;
+    block.ring.header.magic = JOURNAL_MAGIC;
+    block.ring.header.job = journal_job;
+    block.ring.header.sequence = ++journal_sequence;
+    block.ring.header.state = state;
+    block.ring.header.crc = header_crc();
+    journal_count = 0;
+    journal_started = true;
+  }
+
+  job_recovery_entry_t &entry = block.ring.entry[journal_count++];
+  entry.sdpos = sdpos;
+  COPY(entry.current_position, current_position);
+  entry.feedrate = feedrate_mm_s;
+  entry.print_job_elapsed = print_job_timer.duration() * 1000UL;
+  entry.crc = entry_crc(entry);
+  journal_dirty = true;
+
   #if SAVE_INFO_INTERVAL_MS > 0
     static millis_t next_save_ms; // = 0;  // Init on reset
-    millis_t ms = millis();
+    const millis_t ms = millis();
   #endif
   if (
-    #if SAVE_INFO_INTERVAL_MS > 0
-      ELAPSED(ms, next_save_ms) ||
-    #endif
     #if ENABLED(SAVE_EACH_CMD_MODE)
       true
     #else
-      (current_position[Z_AXIS] > 0 && current_position[Z_AXIS] > job_recovery_info.current_position[Z_AXIS])
+      changed || journal_count == JOURNAL_ENTRIES
+      || (current_position[Z_AXIS] > 0 && current_position[Z_AXIS] > journal_z)
+      #if SAVE_INFO_INTERVAL_MS > 0
+        || ELAPSED(ms, next_save_ms)
+      #endif
     #endif
   ) {
     #if SAVE_INFO_INTERVAL_MS > 0
       next_save_ms = ms + SAVE_INFO_INTERVAL_MS;
     #endif
-
-    // Head and foot will match if valid data was saved
-    if (!++job_recovery_info.valid_head) ++job_recovery_info.valid_head; // non-zero in sequence
-    job_recovery_info.valid_foot = job_recovery_info.valid_head;
-
-    // Machine state
-    COPY(job_recovery_info.current_position, current_position);
-    job_recovery_info.feedrate = feedrate_mm_s;
-    COPY(job_recovery_info.target_temperature, thermalManager.target_temperature);
-    #if HAS_HEATED_BED
-      job_recovery_info.target_temperature_bed = thermalManager.target_temperature_bed;
-    #endif
-    COPY(job_recovery_info.fanSpeeds, fanSpeeds);
-
-    #if HAS_LEVELING
-      job_recovery_info.leveling = planner.leveling_active;
-      job_recovery_info.fade = (
-        #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
-          planner.z_fade_height
-        #else
-          0
-        #endif
-      );
-    #endif
-
-    // Commands in the queue
-    job_recovery_info.cmd_queue_index_r = cmd_queue_index_r;
-    job_recovery_info.commands_in_queue = commands_in_queue;
-    COPY(job_recovery_info.command_queue, command_queue);
-
-    // Elapsed print job time
-    job_recovery_info.print_job_elapsed = print_job_timer.duration() * 1000UL;
-
-    // SD file position
-    card.getAbsFilename(sd_filename);
-    job_recovery_info.sdpos = card.getIndex();
-
-    #if ENABLED(DEBUG_POWER_LOSS_RECOVERY)
-      SERIAL_PROTOCOLLNPGM("Saving job_recovery_info");
-      debug_print_job_recovery(false);
-    #endif
-
-    card.openJobRecoveryFile(false);
-    (void)card.saveJobRecoveryInfo();
+    write_journal();
   }
 }
 
+/**
+ * The print finished or was aborted. Mark the job as no longer printing,
+ * so there's nothing to recover at the next boot.
+ */
+void cancel_job_recovery() {
+  job_recovery_commands_count = 0;
+  job_recovery_info.valid = false;
+  if (card.cardOK && card.openJobRecoveryFile(JOB_RECOVERY_BLOCKS)) (void)write_job(false);
+  journal_job = 0;
+}
+
 #endif // POWER_LOSS_RECOVERY
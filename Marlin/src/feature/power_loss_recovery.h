@@ -31,15 +31,14 @@
 #include "../core/types.h"
 #include "../inc/MarlinConfigPre.h"
 
-#define SAVE_INFO_INTERVAL_MS 0
-//#define SAVE_EACH_CMD_MODE
+#define SAVE_INFO_INTERVAL_MS 0   // Also write the journal at this interval
+//#define SAVE_EACH_CMD_MODE        // Write the journal after every command
 //#define DEBUG_POWER_LOSS_RECOVERY
 
-typedef struct {
-  uint8_t valid_head;
+#define JOB_RECOVERY_BLOCKS 64    // Size of the journal file, in SD blocks
 
-  // Machine state
-  float current_position[NUM_AXIS], feedrate;
+// Settings that seldom change, saved at the head of each journal block
+typedef struct {
   int16_t target_temperature[HOTENDS],
           fanSpeeds[FAN_COUNT];
 
@@ -51,18 +50,22 @@ typedef struct {
     bool leveling;
     float fade;
   #endif
+} job_recovery_state_t;
 
-  // Command queue
-  uint8_t cmd_queue_index_r, commands_in_queue;
-  char command_queue[BUFSIZE][MAX_CMD_SIZE];
-
-  // SD File position
-  uint32_t sdpos;
-
-  // Job elapsed time
+// Saved after each command from the SD file
+typedef struct {
+  uint32_t sdpos;                       // Start of the next command
+  float current_position[NUM_AXIS], feedrate;
   millis_t print_job_elapsed;
+  uint16_t crc;                         // Of the entry and the header of its block
+} job_recovery_entry_t;
 
-  uint8_t valid_foot;
+// The last state found in the journal at boot
+typedef struct {
+  bool valid;
+  char sd_filename[MAXPATHNAMELENGTH];
+  job_recovery_state_t state;
+  job_recovery_entry_t entry;
 } job_recovery_info_t;
 
 extern job_recovery_info_t job_recovery_info;
@@ -80,10 +83,12 @@ extern JobRecoveryPhase job_recovery_phase;
   #define APPEND_CMD_COUNT 5
 #endif
 
-extern char job_recovery_commands[BUFSIZE + APPEND_CMD_COUNT][MAX_CMD_SIZE];
+extern char job_recovery_commands[APPEND_CMD_COUNT][MAX_CMD_SIZE];
 extern uint8_t job_recovery_commands_count;
 
 void do_print_job_recovery();
-void save_job_recovery_info();
+void start_job_recovery();
+void save_job_recovery_info(const uint32_t sdpos);
+void cancel_job_recovery();
 
 #endif // _POWER_LOSS_RECOVERY_H_
@@ -0,0 +1,131 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * feature/profiler.cpp - Time the main loop tasks and the ISRs
+ */
+
+#include "../inc/MarlinConfigPre.h"
+
+#if ENABLED(CODE_PROFILER)
+
+#include "profiler.h"
+#include "../core/serial.h"
+
+Profiler profiler;
+
+volatile uint32_t Profiler::isr_ticks; // = 0
+profiler_zone_t Profiler::zones[PROFILE_ZONES];
+millis_t Profiler::start_ms; // = 0
+
+void Profiler::reset() {
+  #ifdef PROFILER_USES_DWT
+    PROFILER_DEMCR |= _BV(24);        // TRCENA: enable the DWT
+    PROFILER_DWT_LAR = 0xC5ACCE55;    // Unlock it, needed on Cortex-M7
+    PROFILER_DWT_CTRL |= _BV(0);      // CYCCNTENA: start the cycle counter
+  #endif
+  // isr_ticks keeps running, for the zones being timed
+  CRITICAL_SECTION_START;
+    memset(zones, 0, sizeof(zones));
+    for (uint8_t i = 0; i < PROFILE_ZONES; i++) zones[i].min = 0xFFFFFFFF;
+    start_ms = millis();
+  CRITICAL_SECTION_END;
+}
+
+void Profiler::add(const ProfilerZoneId zone, const uint32_t ticks) {
+  if (zone >= PROFILE_STEPPER_ISR) {
+    // The temperature ISR can be interrupted by the stepper ISR
+    CRITICAL_SECTION_START;
+      isr_ticks += ticks;
+    CRITICAL_SECTION_END;
+  }
+
+  profiler_zone_t &z = zones[zone];
+  z.count++;
+  z.total += ticks;
+  NOMORE(z.min, ticks);
+  NOLESS(z.max, ticks);
+
+  // Bucket b counts the calls under 2^b µs, the last one all the longer calls
+  uint8_t b = 0;
+  for (uint32_t us = ticks / (PROFILER_TICKS_PER_US); us && b < PROFILER_BUCKETS - 1; us >>= 1) b++;
+  z.histogram[b]++;
+}
+
+static void print_us(const uint32_t ticks) {
+  SERIAL_PROTOCOL_F(float(ticks) / (PROFILER_TICKS_PER_US), 2);
+}
+
+void Profiler::report() {
+  static const char str_idle[] PROGMEM = "idle",
+                    str_manage_heater[] PROGMEM = "manage_heater",
+                    str_lcd_update[] PROGMEM = "lcd_update",
+                    str_get_commands[] PROGMEM = "get_available_commands",
+                    str_stepper_isr[] PROGMEM = "Stepper::isr",
+                    str_temperature_isr[] PROGMEM = "Temperature::isr";
+
+  static const char* const zone_names[PROFILE_ZONES] PROGMEM = {
+    str_idle, str_manage_heater, str_lcd_update, str_get_commands, str_stepper_isr, str_temperature_isr
+  };
+
+  const float seconds = (millis() - start_ms) * 0.001f;
+  uint64_t isr_total = 0;
+  for (uint8_t i = PROFILE_STEPPER_ISR; i < PROFILE_ZONES; i++) {
+    CRITICAL_SECTION_START;
+      isr_total += zones[i].total;
+    CRITICAL_SECTION_END;
+  }
+
+  SERIAL_ECHO_START();
+  SERIAL_ECHOPAIR("Profiler over ", seconds);
+  SERIAL_ECHOPGM("s, ISR load ");
+  SERIAL_ECHO_F(seconds > 0 ? isr_total * (100.0f / 1000000 / (PROFILER_TICKS_PER_US)) / seconds : 0, 2);
+  SERIAL_ECHOLNPGM("%");
+
+  for (uint8_t i = 0; i < PROFILE_ZONES; i++) {
+    profiler_zone_t z;
+    CRITICAL_SECTION_START;
+      z = zones[i];
+    CRITICAL_SECTION_END;
+
+    SERIAL_ECHO_START();
+    serialprintPGM((char*)pgm_read_ptr(&zone_names[i]));
+    SERIAL_ECHOPAIR(" n:", z.count);
+    if (z.count) {
+      SERIAL_ECHOPAIR(" rate:", seconds > 0 ? z.count / seconds : 0);
+      SERIAL_ECHOPGM("/s min:");
+      print_us(z.min);
+      SERIAL_ECHOPGM(" avg:");
+      SERIAL_PROTOCOL_F(float(z.total) / z.count / (PROFILER_TICKS_PER_US), 2);
+      SERIAL_ECHOPGM(" max:");
+      print_us(z.max);
+      SERIAL_ECHOPGM("us hist:");
+      for (uint8_t b = 0; b < PROFILER_BUCKETS; b++) {
+        if (b) SERIAL_CHAR(',');
+        SERIAL_ECHO(z.histogram[b]);
+      }
+    }
+    SERIAL_EOL();
+  }
+}
+
+#endif // CODE_PROFILER
@@ -0,0 +1,140 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * feature/profiler.h - Time the main loop tasks and the ISRs
+ *
+ * PROFILE_ZONE(zone) times the rest of the enclosing block. The clock is
+ * the DWT cycle counter on Cortex-M, timer 0 (through micros(), in 4µs
+ * steps at 16MHz) on AVR, and clock_gettime() on the Linux host.
+ *
+ * Time spent in ISRs is taken out of the zones they interrupt, so every
+ * zone shows its own cost, but idle() still includes manage_heater() and
+ * lcd_update(). The histogram counts the calls that took under 1, 2, 4 ...
+ * 1024µs, and longer. M577 reports the zones and the ISR load.
+ */
+
+#ifndef _PROFILER_H_
+#define _PROFILER_H_
+
+#include "../inc/MarlinConfig.h"
+
+#if defined(__AVR__)
+
+  #define PROFILER_TICKS_PER_US 1
+  FORCE_INLINE static uint32_t profiler_ticks() { return micros(); }
+
+#elif defined(__PLAT_LINUX__)
+
+  #include <time.h>
+
+  #define PROFILER_TICKS_PER_US 1000
+  FORCE_INLINE static uint32_t profiler_ticks() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return uint32_t(now.tv_sec) * 1000000000UL + now.tv_nsec;
+  }
+
+#else // Cortex-M3 and up
+
+  #define PROFILER_USES_DWT
+  #define PROFILER_DEMCR       (*(volatile uint32_t*)0xE000EDFC)
+  #define PROFILER_DWT_CTRL    (*(volatile uint32_t*)0xE0001000)
+  #define PROFILER_DWT_CYCCNT  (*(volatile uint32_t*)0xE0001004)
+  #define PROFILER_DWT_LAR     (*(volatile uint32_t*)0xE0001FB0)
+
+  #ifdef F_CPU
+    #define PROFILER_TICKS_PER_US ((F_CPU) / 1000000UL)
+  #else
+    #define PROFILER_TICKS_PER_US (SystemCoreClock / 1000000UL)
+  #endif
+  FORCE_INLINE static uint32_t profiler_ticks() { return PROFILER_DWT_CYCCNT; }
+
+#endif
+
+enum ProfilerZoneId : uint8_t {
+  PROFILE_IDLE,
+  PROFILE_MANAGE_HEATER,
+  PROFILE_LCD_UPDATE,
+  PROFILE_GET_COMMANDS,
+  PROFILE_STEPPER_ISR,      // ISR zones from here on
+  PROFILE_TEMPERATURE_ISR,
+  PROFILE_ZONES
+};
+
+#define PROFILER_BUCKETS 12
+
+typedef struct {
+  uint32_t count, min, max;   // Calls, and the shortest and longest in ticks
+  uint64_t total;             // Ticks
+  uint32_t histogram[PROFILER_BUCKETS];
+} profiler_zone_t;
+
+class Profiler {
+  public:
+    Profiler() {}
+
+    static volatile uint32_t isr_ticks; // Spent in the ISR zones, to take out of the zones they interrupt
+
+    static void reset();
+    static void report();
+
+    FORCE_INLINE static uint32_t get_isr_ticks() {
+      #ifdef __AVR__
+        CRITICAL_SECTION_START;
+          const uint32_t ticks = isr_ticks;
+        CRITICAL_SECTION_END;
+        return ticks;
+      #else
+        return isr_ticks; // 32-bit reads are atomic
+      #endif
+    }
+
+    static void add(const ProfilerZoneId zone, const uint32_t ticks);
+
+  private:
+    static profiler_zone_t zones[PROFILE_ZONES];
+    static millis_t start_ms;
+};
+
+extern Profiler profiler;
+
+class ProfilerZone {
+  public:
+    // An ISR counted by isr_ticks ran entirely between the two clock reads
+    FORCE_INLINE ProfilerZone(const ProfilerZoneId z) : zone(z) {
+      start = profiler_ticks();
+      isr_start = Profiler::get_isr_ticks();
+    }
+    FORCE_INLINE ~ProfilerZone() {
+      const uint32_t nested = Profiler::get_isr_ticks() - isr_start;
+      Profiler::add(zone, profiler_ticks() - start - nested);
+    }
+
+  private:
+    const ProfilerZoneId zone;
+    uint32_t start, isr_start;
+};
+
+#define PROFILE_ZONE(Z) const ProfilerZone _profiler_zone(Z)
+
+#endif // _PROFILER_H_
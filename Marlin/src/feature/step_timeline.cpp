@@ -0,0 +1,127 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * feature/step_timeline.cpp - Record the step events emitted by the stepper ISR
+ */
+
+#include "../inc/MarlinConfigPre.h"
+
+#if ENABLED(STEP_TIMELINE)
+
+#include "step_timeline.h"
+#include "../core/serial.h"
+#include "../core/utility.h"
+#include "../module/planner.h"
+
+#define STEP_TIMELINE_MOD(n) ((n)&(STEP_TIMELINE_SIZE-1))
+
+StepTimeline step_timeline;
+
+bool StepTimeline::active; // = false
+uint32_t StepTimeline::records, StepTimeline::dropped;
+uint32_t StepTimeline::buffer[STEP_TIMELINE_SIZE];
+volatile uint8_t StepTimeline::head, StepTimeline::tail;
+uint32_t StepTimeline::pending_ticks;
+bool StepTimeline::overrun;
+
+void StepTimeline::add(const uint32_t record) {
+  uint8_t h = head;
+
+  // With no room, drop the record but keep its time for the next one
+  if (STEP_TIMELINE_MOD(tail - h - 1) < (overrun ? 2 : 1)) {
+    dropped++;
+    overrun = true;
+    return;
+  }
+  if (overrun) {
+    buffer[h] = uint32_t(TIMELINE_DROPPED) << 28;
+    h = STEP_TIMELINE_MOD(h + 1);
+    overrun = false;
+  }
+
+  const uint32_t ticks = min(pending_ticks, STEP_TIMELINE_MAX_TICKS);
+  pending_ticks -= ticks;
+  buffer[h] = record | ticks;
+  head = STEP_TIMELINE_MOD(h + 1);
+  records++;
+}
+
+void StepTimeline::start() {
+  if (active) return;
+
+  head = tail = 0;
+  pending_ticks = records = dropped = 0;
+  overrun = false;
+
+  // Everything the host needs to turn records into motion
+  SERIAL_ECHO_START();
+  SERIAL_ECHOPAIR("Step timeline: rate ", uint32_t(HAL_STEPPER_TIMER_RATE));
+  SERIAL_ECHOPAIR(" pulse ", MINIMUM_STEPPER_PULSE);
+  LOOP_XYZE(i) {
+    SERIAL_CHAR(' ');
+    SERIAL_CHAR(axis_codes[i]);
+    SERIAL_ECHOPAIR(" ", planner.axis_steps_per_mm[i]);
+    SERIAL_ECHOPAIR("/", planner.max_feedrate_mm_s[i]);
+    SERIAL_ECHOPAIR("/", planner.max_acceleration_mm_per_s2[i]);
+    SERIAL_ECHOPAIR("/", planner.max_jerk[i]);
+  }
+  SERIAL_EOL();
+
+  active = true;
+}
+
+void StepTimeline::stop() {
+  if (!active) return;
+  active = false;
+  stream();
+  SERIAL_ECHO_START();
+  SERIAL_ECHOPAIR("Step timeline: off, records ", records);
+  SERIAL_ECHOLNPAIR(" dropped ", dropped);
+}
+
+void StepTimeline::stream() {
+  // Only what's buffered now, so a fast move can't keep idle() here
+  const uint8_t end = head;
+  uint8_t t = tail;
+  while (t != end) {
+    uint8_t frame[1 + 4 * (STEP_TIMELINE_FRAME_RECORDS)], len = 1;
+    for (; t != end && len < sizeof(frame); t = STEP_TIMELINE_MOD(t + 1)) {
+      const uint32_t record = buffer[t];
+      frame[len++] = record;
+      frame[len++] = record >> 8;
+      frame[len++] = record >> 16;
+      frame[len++] = record >> 24;
+    }
+    tail = t;
+    frame[0] = len >> 2;
+
+    uint16_t crc = 0;
+    crc16(&crc, frame, len);
+    SERIAL_CHAR(STEP_TIMELINE_FRAME_START);
+    for (uint8_t i = 0; i < len; i++) SERIAL_CHAR(frame[i]);
+    SERIAL_CHAR(uint8_t(crc));
+    SERIAL_CHAR(uint8_t(crc >> 8));
+  }
+}
+
+#endif // STEP_TIMELINE
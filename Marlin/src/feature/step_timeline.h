@@ -0,0 +1,103 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * feature/step_timeline.h - Record the step events emitted by the stepper ISR
+ *
+ * While enabled with M576 every step event is logged into a ring buffer
+ * from the stepper ISR, and the buffer is streamed to the host in binary
+ * frames between the usual text lines:
+ *
+ *   0xA6, count, count records (4 bytes each, little-endian), CRC-16 (LE)
+ *
+ * The CRC-16/CCITT covers the count and the records. A record holds the
+ * step timer ticks since the previous record in bits 0-23, the steppers
+ * (X Y Z E, or A B C E) that stepped in bits 24-27 and their directions
+ * (set = negative) in bits 28-31. Events in one ISR have 0 ticks between
+ * them. A record with no steps is a marker (StepTimelineMarker) in bits
+ * 28-31 instead.
+ *
+ * Frames only go out where no text line can be half sent: from the main
+ * loop between commands, while a move waits for room in the planner, and
+ * while M576 S0 waits for the moves to end. Records that fill the buffer
+ * during other waits (M400, G28, M109) are dropped and marked.
+ *
+ * M576 S1 prints the timer rate and axis settings needed to convert the
+ * records before the first frame. See buildroot/share/scripts/step_timeline.py.
+ */
+
+#ifndef _STEP_TIMELINE_H_
+#define _STEP_TIMELINE_H_
+
+#include "../inc/MarlinConfig.h"
+
+#define STEP_TIMELINE_FRAME_START 0xA6
+#define STEP_TIMELINE_FRAME_RECORDS 32
+#define STEP_TIMELINE_MAX_TICKS 0xFFFFFFUL
+
+enum StepTimelineMarker : uint8_t {
+  TIMELINE_ELAPSED,   // Time passed without steps
+  TIMELINE_BLOCK,     // The stepper started a new block
+  TIMELINE_DROPPED    // Records were lost before this one (the buffer was full)
+};
+
+class StepTimeline {
+  public:
+    StepTimeline() {}
+
+    static bool active;
+    static uint32_t records, dropped;
+
+    static void start();
+    static void stop();
+
+    // Send the buffered records to the host. Call only at the start of a line.
+    static void stream();
+
+    // Called from the stepper ISR with the ticks since the previous ISR
+    FORCE_INLINE static void elapse(const hal_timer_t ticks) {
+      if (!active) return;
+      pending_ticks += ticks;
+      if (pending_ticks > STEP_TIMELINE_MAX_TICKS) mark(TIMELINE_ELAPSED);
+    }
+
+    // Called from the stepper ISRs for every step event
+    FORCE_INLINE static void record(const uint8_t step_bits, const uint8_t dir_bits) {
+      if (active) add(uint32_t((step_bits & 0x0F) | ((dir_bits & step_bits) << 4)) << 24);
+    }
+
+    FORCE_INLINE static void mark(const StepTimelineMarker marker) {
+      if (active) add(uint32_t(marker) << 28);
+    }
+
+  private:
+    static uint32_t buffer[STEP_TIMELINE_SIZE];
+    static volatile uint8_t head, tail;
+    static uint32_t pending_ticks;
+    static bool overrun;
+
+    static void add(const uint32_t record);
+};
+
+extern StepTimeline step_timeline;
+
+#endif // _STEP_TIMELINE_H_
@@ -290,9 +290,7 @@ void GcodeSuite::G29() {
         if (WITHIN(i, 0, GRID_MAX_POINTS_X - 1) && WITHIN(j, 0, GRID_MAX_POINTS_Y)) {
           set_bed_leveling_enabled(false);
           z_values[i][j] = rz;
-          #if ENABLED(ABL_BILINEAR_SUBDIVISION)
-            bed_level_virt_interpolate();
-          #endif
+          refresh_bed_level();
           set_bed_leveling_enabled(abl_should_enable);
           if (abl_should_enable) report_current_position();
         }
@@ -55,9 +55,7 @@ void GcodeSuite::M421() {
   }
   else {
     z_values[ix][iy] = parser.value_linear_units() + (hasQ ? z_values[ix][iy] : 0);
-    #if ENABLED(ABL_BILINEAR_SUBDIVISION)
-      bed_level_virt_interpolate();
-    #endif
+    refresh_bed_level();
   }
 }
 
@@ -0,0 +1,59 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+#ifdef ARC_CHORD_TOLERANCE
+
+#include "../gcode.h"
+
+/**
+ * M214: Set how G2/G3 arcs are cut into segments
+ *
+ *   P<mm> - Chord tolerance: the most a segment may stray from the arc.
+ *           P0 cuts arcs into MM_PER_ARC_SEGMENT segments instead.
+ *   S<ms> - Minimum segment time. Segments are made long enough to take
+ *           at least this long at the arc's feedrate.
+ *
+ * With no parameters, report the current settings.
+ */
+void GcodeSuite::M214() {
+  bool report = true;
+  if (parser.seenval('P')) {
+    arc_chord_tolerance = parser.value_linear_units();
+    NOLESS(arc_chord_tolerance, 0);
+    report = false;
+  }
+  if (parser.seenval('S')) {
+    arc_min_segment_time = parser.value_ushort();
+    report = false;
+  }
+
+  if (report) {
+    SERIAL_ECHO_START();
+    SERIAL_ECHOPGM("Arc chord tolerance:");
+    SERIAL_ECHO_F(arc_chord_tolerance, 4);
+    SERIAL_ECHOLNPAIR(" min segment time:", arc_min_segment_time);
+  }
+}
+
+#endif // ARC_CHORD_TOLERANCE
@@ -0,0 +1,89 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(MPCTEMP)
+
+#include "../gcode.h"
+#include "../../module/temperature.h"
+
+/**
+ * M306: Set or identify the thermal model of a hotend for MPCTEMP
+ *
+ *   E[hotend] Hotend to set (default 0)
+ *   P[float]  Heater power (W)
+ *   C[float]  Heat capacity of the heater block (J/K)
+ *   R[float]  Sensor responsiveness (1/s)
+ *   A[float]  Heat loss to the surroundings (W/K)
+ *   H[float]  Heat capacity of the filament (J/K per mm)
+ *
+ *   T         Identify C, R and A by heating to MPC_TUNING_TEMP and cooling.
+ *             Start with the hotend at room temperature.
+ */
+void GcodeSuite::M306() {
+  const uint8_t e = parser.byteval('E');
+  if (e >= HOTENDS) {
+    SERIAL_ERROR_START();
+    SERIAL_ERRORLNPGM(MSG_INVALID_EXTRUDER);
+    return;
+  }
+
+  if (parser.seen('T')) {
+    #if DISABLED(BUSY_WHILE_HEATING)
+      KEEPALIVE_STATE(NOT_BUSY);
+    #endif
+
+    thermalManager.MPC_autotune(e);
+
+    #if DISABLED(BUSY_WHILE_HEATING)
+      KEEPALIVE_STATE(IN_HANDLER);
+    #endif
+    return;
+  }
+
+  mpc_t &model = thermalManager.mpc[e];
+  if (parser.seenval('P')) model.heater_power = parser.value_float();
+  if (parser.seenval('C')) model.block_heat_capacity = parser.value_float();
+  if (parser.seenval('R')) model.sensor_responsiveness = parser.value_float();
+  if (parser.seenval('A')) model.ambient_xfer_coeff = parser.value_float();
+  if (parser.seenval('H')) model.filament_heat_capacity = parser.value_float();
+  NOLESS(model.heater_power, 1);
+  NOLESS(model.block_heat_capacity, 0.1);
+  NOLESS(model.sensor_responsiveness, 0.001);
+  NOLESS(model.ambient_xfer_coeff, 0);
+  NOLESS(model.filament_heat_capacity, 0);
+  thermalManager.updatePID();
+
+  SERIAL_ECHO_START();
+  #if HOTENDS > 1
+    SERIAL_ECHOPAIR(" e:", e);
+  #endif
+  SERIAL_ECHOPAIR(" p:", model.heater_power);
+  SERIAL_ECHOPAIR(" c:", model.block_heat_capacity);
+  SERIAL_ECHOPGM(" r:"); SERIAL_ECHO_F(model.sensor_responsiveness, 4);
+  SERIAL_ECHOPGM(" a:"); SERIAL_ECHO_F(model.ambient_xfer_coeff, 4);
+  SERIAL_ECHOPGM(" h:"); SERIAL_ECHO_F(model.filament_heat_capacity, 4);
+  SERIAL_EOL();
+}
+
+#endif // MPCTEMP
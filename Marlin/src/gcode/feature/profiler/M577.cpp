@@ -0,0 +1,46 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../../inc/MarlinConfig.h"
+
+#if ENABLED(CODE_PROFILER)
+
+#include "../../gcode.h"
+#include "../../../feature/profiler.h"
+
+/**
+ * M577: Report the profiler zones
+ *
+ * For idle(), manage_heater(), lcd_update(), get_available_commands() and
+ * the stepper and temperature ISRs: the calls, calls per second, the
+ * shortest, average and longest call in µs, and the histogram of calls
+ * under 1, 2, 4 ... 1024µs and longer. Then the share of the time spent in
+ * the ISRs.
+ *
+ *   R - Clear the counts after the report, to time the next stretch
+ */
+void GcodeSuite::M577() {
+  profiler.report();
+  if (parser.seen('R')) profiler.reset();
+}
+
+#endif // CODE_PROFILER
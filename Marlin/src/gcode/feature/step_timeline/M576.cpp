@@ -0,0 +1,64 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../../inc/MarlinConfig.h"
+
+#if ENABLED(STEP_TIMELINE)
+
+#include "../../gcode.h"
+#include "../../../feature/step_timeline.h"
+#include "../../../module/planner.h"
+#include "../../../module/stepper.h"
+#include "../../../module/segment_producer.h"
+#include "../../../Marlin.h"
+
+/**
+ * M576: Record the step timeline
+ *
+ *   S1 - Start recording the step events of the moves that follow
+ *   S0 - Wait for the queued moves to finish, send the rest and stop
+ *
+ * With no S, report whether recording is active.
+ */
+void GcodeSuite::M576() {
+  if (parser.seen('S')) {
+    if (parser.value_bool())
+      step_timeline.start();
+    else {
+      // Wait for the moves, sending their records as they come
+      segment_feed.finish();
+      while (planner.has_blocks_queued() || stepper.cleaning_buffer_counter) {
+        idle();
+        step_timeline.stream();
+      }
+      step_timeline.stop();
+    }
+  }
+  else {
+    SERIAL_ECHO_START();
+    SERIAL_ECHOPAIR("Step timeline: ", step_timeline.active ? "on" : "off");
+    SERIAL_ECHOPAIR(", records ", step_timeline.records);
+    SERIAL_ECHOLNPAIR(" dropped ", step_timeline.dropped);
+  }
+}
+
+#endif // STEP_TIMELINE
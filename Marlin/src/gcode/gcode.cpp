@@ -31,6 +31,7 @@ GcodeSuite gcode;
 #include "parser.h"
 #include "queue.h"
 #include "../module/motion.h"
+#include "../module/segment_producer.h"
 
 #if ENABLED(PRINTCOUNTER)
   #include "../module/printcounter.h"
@@ -56,6 +57,11 @@ bool GcodeSuite::axis_relative_modes[] = AXIS_RELATIVE_MODES;
   GcodeSuite::WorkspacePlane GcodeSuite::workspace_plane = PLANE_XY;
 #endif
 
+#ifdef ARC_CHORD_TOLERANCE
+  float GcodeSuite::arc_chord_tolerance = ARC_CHORD_TOLERANCE;
+  uint16_t GcodeSuite::arc_min_segment_time = ARC_MIN_SEGMENT_TIME;
+#endif
+
 #if ENABLED(CNC_COORDINATE_SYSTEMS)
   int8_t GcodeSuite::active_coordinate_system = -1; // machine space
   float GcodeSuite::coordinate_system[MAX_COORDINATE_SYSTEMS][XYZ];
@@ -176,499 +182,620 @@ void GcodeSuite::dwell(millis_t time) {
 #endif
 
 /**
- * Process the parsed command and dispatch it to its handler
+ * Parameters accepted by a dispatch table entry, from a string of
+ * letters. "*" accepts anything, for codes that take free text.
  */
-void GcodeSuite::process_parsed_command(
-  #if ENABLED(USE_EXECUTE_COMMANDS_IMMEDIATE)
-    const bool no_ok
-  #endif
-) {
-  KEEPALIVE_STATE(IN_HANDLER);
+#if ENABLED(STRICT_GCODE_PARAMETERS)
+  constexpr uint32_t dispatch_params(const char * const p) {
+    return *p == '*' ? 0xFFFFFFFFUL : *p ? _BV32(*p - 'A') | dispatch_params(p + 1) : 0UL;
+  }
+  #define _DISPATCH(L,N,S,H,F,P) { GCODE_KEY(L,N,S), F, dispatch_params(P), H }
+#else
+  #define _DISPATCH(L,N,S,H,F,P) { GCODE_KEY(L,N,S), F, H }
+#endif
 
-  // Handle a known G, M, or T
-  switch (parser.command_letter) {
-    case 'G': switch (parser.codenum) {
+#define G_CODE(N,H,P)         _DISPATCH('G', N, 0, H, 0, P)
+#define G_SUBCODE(N,S,H,P)    _DISPATCH('G', N, S, H, 0, P)
+#define M_CODE(N,H,P)         _DISPATCH('M', N, 0, H, 0, P)
+#define M_CODE_FLAGS(N,H,F,P) _DISPATCH('M', N, 0, H, F, P)
 
-      case 0: case 1: G0_G1(                                      // G0: Fast Move, G1: Linear Move
-                        #if IS_SCARA
-                          parser.codenum == 0
-                        #endif
-                      );
-                      break;
+// Parameters of codes that share helpers
+#if ENABLED(MIXING_EXTRUDER) && ENABLED(DIRECT_MIXING_IN_G1)
+  #define MOVE_PARAMS "XYZEF" "ABCDHI"
+#else
+  #define MOVE_PARAMS "XYZEF"
+#endif
+#if ENABLED(AUTOTEMP)
+  #define M104_M109_PARAMS "RST" "BF"
+#else
+  #define M104_M109_PARAMS "RST"
+#endif
+#if ENABLED(AUTO_BED_LEVELING_UBL)
+  #define G29_PARAMS "ABCDEFHIJKLPQRSTUVWXY"
+  #define M421_PARAMS "CIJNQZ"
+#elif ENABLED(MESH_BED_LEVELING)
+  #define G29_PARAMS "SXYZ"
+  #define M421_PARAMS "IJQXYZ"
+#else
+  #define G29_PARAMS "ABCDEFIJLPQRSTVWXYZ"
+  #define M421_PARAMS "IJQZ"
+#endif
 
-      #if ENABLED(ARC_SUPPORT) && DISABLED(SCARA)
-        case 2: case 3: G2_G3(parser.codenum == 2); break;        // G2: CW ARC, G3: CCW ARC
-      #endif
+template<size_t N>
+constexpr bool dispatch_sorted(const GcodeSuite::dispatch_t (&table)[N], const size_t i=1) {
+  return i >= N || (table[i - 1].key < table[i].key && dispatch_sorted(table, i + 1));
+}
 
-      case 4: G4(); break;                                        // G4: Dwell
+template<size_t N>
+static const GcodeSuite::dispatch_t* dispatch_search(const GcodeSuite::dispatch_t (&table)[N], const uint16_t key) {
+  uint16_t lo = 0, hi = N;
+  while (lo < hi) {
+    const uint16_t mid = (lo + hi) >> 1, k = pgm_read_word(&table[mid].key);
+    if (k < key) lo = mid + 1;
+    else if (k > key) hi = mid;
+    else return &table[mid];
+  }
+  return NULL;
+}
 
-      #if ENABLED(BEZIER_CURVE_SUPPORT)
-        case 5: G5(); break;                                      // G5: Cubic B_spline
-      #endif
+const GcodeSuite::dispatch_t* GcodeSuite::find_handler() {
 
-      #if ENABLED(FWRETRACT)
-        case 10: G10(); break;                                    // G10: Retract / Swap Retract
-        case 11: G11(); break;                                    // G11: Recover / Swap Recover
-      #endif
+  static constexpr dispatch_t table[] PROGMEM = {
 
-      #if ENABLED(NOZZLE_CLEAN_FEATURE)
-        case 12: G12(); break;                                    // G12: Nozzle Clean
-      #endif
+    G_CODE(0, G0_G1, MOVE_PARAMS),                              // G0: Fast Move
+    G_CODE(1, G0_G1, MOVE_PARAMS),                              // G1: Linear Move
 
-      #if ENABLED(CNC_WORKSPACE_PLANES)
-        case 17: G17(); break;                                    // G17: Select Plane XY
-        case 18: G18(); break;                                    // G18: Select Plane ZX
-        case 19: G19(); break;                                    // G19: Select Plane YZ
-      #endif
+    #if ENABLED(ARC_SUPPORT) && DISABLED(SCARA)
+      G_CODE(2, G2_G3, MOVE_PARAMS "IJPR"),                     // G2: CW ARC
+      G_CODE(3, G2_G3, MOVE_PARAMS "IJPR"),                     // G3: CCW ARC
+    #endif
 
-      #if ENABLED(INCH_MODE_SUPPORT)
-        case 20: G20(); break;                                    // G20: Inch Mode
-        case 21: G21(); break;                                    // G21: MM Mode
-      #endif
+    G_CODE(4, G4, "PS"),                                        // G4: Dwell
 
-      #if ENABLED(G26_MESH_VALIDATION)
-        case 26: G26(); break;                                    // G26: Mesh Validation Pattern generation
-      #endif
+    #if ENABLED(BEZIER_CURVE_SUPPORT)
+      G_CODE(5, G5, MOVE_PARAMS "IJPQ"),                        // G5: Cubic B_spline
+    #endif
 
-      #if ENABLED(NOZZLE_PARK_FEATURE)
-        case 27: G27(); break;                                    // G27: Nozzle Park
-      #endif
+    #if ENABLED(FWRETRACT)
+      G_CODE(10, G10, "S"),                                     // G10: Retract / Swap Retract
+      G_CODE(11, G11, "S"),                                     // G11: Recover / Swap Recover
+    #endif
 
-      case 28: G28(false); break;                                 // G28: Home all axes, one at a time
+    #if ENABLED(NOZZLE_CLEAN_FEATURE)
+      G_CODE(12, G12, "PRST"),                                  // G12: Nozzle Clean
+    #endif
 
-      #if HAS_LEVELING
-        case 29:                                                  // G29: Bed leveling calibration
-          #if ENABLED(G29_RETRY_AND_RECOVER)
-            G29_with_retry();
-          #else
-            G29();
-          #endif
-          break;
-      #endif // HAS_LEVELING
+    #if ENABLED(CNC_WORKSPACE_PLANES)
+      G_CODE(17, G17, ""),                                      // G17: Select Plane XY
+      G_CODE(18, G18, ""),                                      // G18: Select Plane ZX
+      G_CODE(19, G19, ""),                                      // G19: Select Plane YZ
+    #endif
 
-      #if HAS_BED_PROBE
-        case 30: G30(); break;                                    // G30: Single Z probe
-        #if ENABLED(Z_PROBE_SLED)
-          case 31: G31(); break;                                  // G31: dock the sled
-          case 32: G32(); break;                                  // G32: undock the sled
-        #endif
-      #endif
+    #if ENABLED(INCH_MODE_SUPPORT)
+      G_CODE(20, G20, ""),                                      // G20: Inch Mode
+      G_CODE(21, G21, ""),                                      // G21: MM Mode
+    #endif
 
-      #if ENABLED(DELTA_AUTO_CALIBRATION)
-        case 33: G33(); break;                                    // G33: Delta Auto-Calibration
+    #if ENABLED(G26_MESH_VALIDATION)
+      G_CODE(26, G26, "BCDFHKLOPQRSUXY"),                       // G26: Mesh Validation Pattern generation
+    #endif
+
+    #if ENABLED(NOZZLE_PARK_FEATURE)
+      G_CODE(27, G27, "P"),                                     // G27: Nozzle Park
+    #endif
+
+    G_CODE(28, G28, "RXYZ"),                                    // G28: Home all axes, one at a time
+
+    #if HAS_LEVELING
+      #if ENABLED(G29_RETRY_AND_RECOVER)
+        G_CODE(29, G29_with_retry, G29_PARAMS),                 // G29: Bed leveling calibration
+      #else
+        G_CODE(29, G29, G29_PARAMS),                            // G29: Bed leveling calibration
       #endif
+    #endif
 
-      #if ENABLED(G38_PROBE_TARGET)
-        case 38:                                                  // G38.2 & G38.3
-          if (parser.subcode == 2 || parser.subcode == 3)
-            G38(parser.subcode == 2);
-          break;
+    #if HAS_BED_PROBE
+      G_CODE(30, G30, "EXY"),                                   // G30: Single Z probe
+      #if ENABLED(Z_PROBE_SLED)
+        G_CODE(31, G31, ""),                                    // G31: dock the sled
+        G_CODE(32, G32, ""),                                    // G32: undock the sled
       #endif
+    #endif
 
-      case 90: relative_mode = false; break;                      // G90: Relative Mode
-      case 91: relative_mode = true; break;                       // G91: Absolute Mode
+    #if ENABLED(DELTA_AUTO_CALIBRATION)
+      G_CODE(33, G33, "CEFPSTV"),                               // G33: Delta Auto-Calibration
+    #endif
 
-      case 92: G92(); break;                                      // G92: Set current axis position(s)
+    #if ENABLED(G38_PROBE_TARGET)
+      G_SUBCODE(38, 2, G38, MOVE_PARAMS),                       // G38.2: Probe toward workpiece, error on failure
+      G_SUBCODE(38, 3, G38, MOVE_PARAMS),                       // G38.3: Probe toward workpiece
+    #endif
 
-      #if HAS_MESH
-        case 42: G42(); break;                                    // G42: Coordinated move to a mesh point
-      #endif
+    #if HAS_MESH
+      G_CODE(42, G42, "FIJP"),                                  // G42: Coordinated move to a mesh point
+    #endif
 
-      #if ENABLED(DEBUG_GCODE_PARSER)
-        case 800: parser.debug(); break;                          // G800: GCode Parser Test for G
-      #endif
-    }
-    break;
+    G_CODE(90, G90, ""),                                        // G90: Absolute Mode
+    G_CODE(91, G91, ""),                                        // G91: Relative Mode
+    G_CODE(92, G92, "EXYZ"),                                    // G92: Set current axis position(s)
 
-    case 'M': switch (parser.codenum) {
-      #if HAS_RESUME_CONTINUE
-        case 0:                                                   // M0: Unconditional stop - Wait for user button press on LCD
-        case 1: M0_M1(); break;                                   // M1: Conditional stop - Wait for user button press on LCD
-      #endif
+    #if ENABLED(DEBUG_GCODE_PARSER)
+      G_CODE(800, GCodeParser::debug, "*"),                     // G800: GCode Parser Test for G
+    #endif
+
+    #if HAS_RESUME_CONTINUE
+      M_CODE(0, M0_M1, "*"),                                    // M0: Unconditional stop - Wait for user button press on LCD
+      M_CODE(1, M0_M1, "*"),                                    // M1: Conditional stop - Wait for user button press on LCD
+    #endif
+
+    #if ENABLED(SPINDLE_LASER_ENABLE)
+      M_CODE(3, M3_M4, "OS"),                                   // M3: turn spindle/laser on, set laser/spindle power/speed, set rotation direction CW
+      M_CODE(4, M3_M4, "OS"),                                   // M4: turn spindle/laser on, set laser/spindle power/speed, set rotation direction CCW
+      M_CODE(5, M5, ""),                                        // M5 - turn spindle/laser off
+    #endif
+
+    M_CODE(17, M17, ""),                                        // M17: Enable all stepper motors
+    M_CODE(18, M18_M84, "ESXYZ"),                               // M18: Disable Steppers / Set Timeout
+
+    #if ENABLED(SDSUPPORT)
+      M_CODE(20, M20, ""),                                      // M20: list SD card
+      M_CODE(21, M21, ""),                                      // M21: init SD card
+      M_CODE(22, M22, ""),                                      // M22: release SD card
+      M_CODE(23, M23, "*"),                                     // M23: Select file
+      M_CODE(24, M24, ""),                                      // M24: Start SD print
+      M_CODE(25, M25, ""),                                      // M25: Pause SD print
+      M_CODE(26, M26, "S"),                                     // M26: Set SD index
+      M_CODE(27, M27, "CS"),                                    // M27: Get SD status
+      M_CODE(28, M28, "*"),                                     // M28: Start SD write
+      M_CODE(29, M29, ""),                                      // M29: Stop SD write
+      M_CODE(30, M30, "*"),                                     // M30 <filename> Delete File
+    #endif
 
-      #if ENABLED(SPINDLE_LASER_ENABLE)
-        case 3: M3_M4(true ); break;                              // M3: turn spindle/laser on, set laser/spindle power/speed, set rotation direction CW
-        case 4: M3_M4(false); break;                              // M4: turn spindle/laser on, set laser/spindle power/speed, set rotation direction CCW
-        case 5: M5(); break;                                      // M5 - turn spindle/laser off
+    M_CODE(31, M31, ""),                                        // M31: Report time since the start of SD print or last M109
+
+    #if ENABLED(SDSUPPORT)
+      M_CODE(32, M32, "*"),                                     // M32: Select file and start SD print
+      #if ENABLED(LONG_FILENAME_HOST_SUPPORT)
+        M_CODE(33, M33, "*"),                                   // M33: Get the long full path to a file or folder
+      #endif
+      #if ENABLED(SDCARD_SORT_ALPHA) && ENABLED(SDSORT_GCODE)
+        M_CODE(34, M34, "FS"),                                  // M34: Set SD card sorting options
       #endif
+    #endif
 
-      case 17: M17(); break;                                      // M17: Enable all stepper motors
-
-      #if ENABLED(SDSUPPORT)
-        case 20: M20(); break;                                    // M20: list SD card
-        case 21: M21(); break;                                    // M21: init SD card
-        case 22: M22(); break;                                    // M22: release SD card
-        case 23: M23(); break;                                    // M23: Select file
-        case 24: M24(); break;                                    // M24: Start SD print
-        case 25: M25(); break;                                    // M25: Pause SD print
-        case 26: M26(); break;                                    // M26: Set SD index
-        case 27: M27(); break;                                    // M27: Get SD status
-        case 28: M28(); break;                                    // M28: Start SD write
-        case 29: M29(); break;                                    // M29: Stop SD write
-        case 30: M30(); break;                                    // M30 <filename> Delete File
-        case 32: M32(); break;                                    // M32: Select file and start SD print
-
-        #if ENABLED(LONG_FILENAME_HOST_SUPPORT)
-          case 33: M33(); break;                                  // M33: Get the long full path to a file or folder
-        #endif
+    M_CODE(42, M42, "PS"),                                      // M42: Change pin state
 
-        #if ENABLED(SDCARD_SORT_ALPHA) && ENABLED(SDSORT_GCODE)
-          case 34: M34(); break;                                  // M34: Set SD card sorting options
-        #endif
+    #if ENABLED(PINS_DEBUGGING)
+      M_CODE(43, M43, "EIPRSTW"),                               // M43: Read pin state
+    #endif
 
-        case 928: M928(); break;                                  // M928: Start SD write
-      #endif // SDSUPPORT
+    #if ENABLED(Z_MIN_PROBE_REPEATABILITY_TEST)
+      M_CODE(48, M48, "ELPSVXY"),                               // M48: Z probe repeatability test
+    #endif
 
-      case 31: M31(); break;                                      // M31: Report time since the start of SD print or last M109
-      case 42: M42(); break;                                      // M42: Change pin state
+    #if ENABLED(G26_MESH_VALIDATION)
+      M_CODE(49, M49, ""),                                      // M49: Turn on or off G26 debug flag for verbose output
+    #endif
 
-      #if ENABLED(PINS_DEBUGGING)
-        case 43: M43(); break;                                    // M43: Read pin state
-      #endif
+    #if ENABLED(ULTRA_LCD) && ENABLED(LCD_SET_PROGRESS_MANUALLY)
+      M_CODE(73, M73, "P"),                                     // M73: Set progress percentage (for display on LCD)
+    #endif
 
-      #if ENABLED(Z_MIN_PROBE_REPEATABILITY_TEST)
-        case 48: M48(); break;                                    // M48: Z probe repeatability test
-      #endif
+    M_CODE(75, M75, ""),                                        // M75: Start print timer
+    M_CODE(76, M76, ""),                                        // M76: Pause print timer
+    M_CODE(77, M77, ""),                                        // M77: Stop print timer
 
-      #if ENABLED(G26_MESH_VALIDATION)
-        case 49: M49(); break;                                    // M49: Turn on or off G26 debug flag for verbose output
-      #endif
+    #if ENABLED(PRINTCOUNTER)
+      M_CODE(78, M78, "S"),                                     // M78: Show print statistics
+    #endif
 
-      #if ENABLED(ULTRA_LCD) && ENABLED(LCD_SET_PROGRESS_MANUALLY)
-        case 73: M73(); break;                                    // M73: Set progress percentage (for display on LCD)
-      #endif
+    #if HAS_POWER_SWITCH
+      M_CODE(80, M80, "S"),                                     // M80: Turn on Power Supply
+    #endif
+    M_CODE(81, M81, ""),                                        // M81: Turn off Power, including Power Supply, if possible
 
-      case 75: M75(); break;                                      // M75: Start print timer
-      case 76: M76(); break;                                      // M76: Pause print timer
-      case 77: M77(); break;                                      // M77: Stop print timer
+    M_CODE(82, M82, ""),                                        // M82: Set E axis normal mode (same as other axes)
+    M_CODE(83, M83, ""),                                        // M83: Set E axis relative mode
+    M_CODE(84, M18_M84, "ESXYZ"),                               // M84: Disable Steppers / Set Timeout
+    M_CODE(85, M85, "S"),                                       // M85: Set inactivity stepper shutdown timeout
+    M_CODE(92, M92, "EXYZT"),                                   // M92: Set the steps-per-unit for one or more axes
 
-      #if ENABLED(PRINTCOUNTER)
-        case 78: M78(); break;                                    // M78: Show print statistics
-      #endif
+    #if ENABLED(M100_FREE_MEMORY_WATCHER)
+      M_CODE(100, M100, "CDFI"),                                // M100: Free Memory Report
+    #endif
 
-      #if ENABLED(M100_FREE_MEMORY_WATCHER)
-        case 100: M100(); break;                                  // M100: Free Memory Report
-      #endif
+    M_CODE(104, M104, M104_M109_PARAMS),                        // M104: Set hot end temperature
+    M_CODE_FLAGS(105, M105, DISPATCH_NO_OK, "T"),               // M105: Report Temperatures (and say "ok")
 
-      case 104: M104(); break;                                    // M104: Set hot end temperature
-      case 109: M109(); break;                                    // M109: Wait for hotend temperature to reach target
-      case 110: M110(); break;                                    // M110: Set Current Line Number
-      case 111: M111(); break;                                    // M111: Set debug level
+    #if FAN_COUNT > 0
+      M_CODE(106, M106, "PST"),                                 // M106: Fan On
+      M_CODE(107, M107, "P"),                                   // M107: Fan Off
+    #endif
 
-      #if DISABLED(EMERGENCY_PARSER)
-        case 108: M108(); break;                                  // M108: Cancel Waiting
-        case 112: M112(); break;                                  // M112: Emergency Stop
-        case 410: M410(); break;                                  // M410: Quickstop - Abort all the planned moves.
-      #endif
+    #if DISABLED(EMERGENCY_PARSER)
+      M_CODE(108, M108, ""),                                    // M108: Cancel Waiting
+    #endif
 
-      #if ENABLED(HOST_KEEPALIVE_FEATURE)
-        case 113: M113(); break;                                  // M113: Set Host Keepalive interval
-      #endif
+    M_CODE(109, M109, M104_M109_PARAMS),                        // M109: Wait for hotend temperature to reach target
+    M_CODE(110, M110, "N"),                                     // M110: Set Current Line Number
+    M_CODE(111, M111, "S"),                                     // M111: Set debug level
 
-      #if HAS_HEATED_BED
-        case 140: M140(); break;                                  // M140: Set bed temperature
-        case 190: M190(); break;                                  // M190: Wait for bed temperature to reach target
-      #endif
+    #if DISABLED(EMERGENCY_PARSER)
+      M_CODE(112, M112, ""),                                    // M112: Emergency Stop
+    #endif
 
-      case 105: M105(); KEEPALIVE_STATE(NOT_BUSY); return;        // M105: Report Temperatures (and say "ok")
+    #if ENABLED(HOST_KEEPALIVE_FEATURE)
+      M_CODE(113, M113, "S"),                                   // M113: Set Host Keepalive interval
+    #endif
 
-      #if ENABLED(AUTO_REPORT_TEMPERATURES) && HAS_TEMP_SENSOR
-        case 155: M155(); break;                                  // M155: Set temperature auto-report interval
-      #endif
+    M_CODE(114, M114, "D"),                                     // M114: Report current position
+    M_CODE(115, M115, ""),                                      // M115: Report capabilities
+    M_CODE(117, M117, "*"),                                     // M117: Set LCD message text, if possible
+    M_CODE(118, M118, "*"),                                     // M118: Display a message in the host console
+    M_CODE(119, M119, ""),                                      // M119: Report endstop states
+    M_CODE(120, M120, ""),                                      // M120: Enable endstops
+    M_CODE(121, M121, ""),                                      // M121: Disable endstops
+
+    #if HAS_TRINAMIC && ENABLED(TMC_DEBUG)
+      M_CODE(122, M122, "SVXYZE"),                              // M122: Report driver parameters
+    #endif
 
-      #if FAN_COUNT > 0
-        case 106: M106(); break;                                  // M106: Fan On
-        case 107: M107(); break;                                  // M107: Fan Off
+    #if ENABLED(PARK_HEAD_ON_PAUSE)
+      M_CODE(125, M125, "LXYZ"),                                // M125: Store current position and move to filament change position
+    #endif
+
+    #if ENABLED(BARICUDA)
+      // PWM for HEATER_1_PIN
+      #if HAS_HEATER_1
+        M_CODE(126, M126, "S"),                                 // M126: valve open
+        M_CODE(127, M127, ""),                                  // M127: valve closed
       #endif
 
-      #if ENABLED(PARK_HEAD_ON_PAUSE)
-        case 125: M125(); break;                                  // M125: Store current position and move to filament change position
+      // PWM for HEATER_2_PIN
+      #if HAS_HEATER_2
+        M_CODE(128, M128, "S"),                                 // M128: valve open
+        M_CODE(129, M129, ""),                                  // M129: valve closed
       #endif
+    #endif // BARICUDA
 
-      #if ENABLED(BARICUDA)
-        // PWM for HEATER_1_PIN
-        #if HAS_HEATER_1
-          case 126: M126(); break;                                // M126: valve open
-          case 127: M127(); break;                                // M127: valve closed
-        #endif
+    #if HAS_HEATED_BED
+      M_CODE(140, M140, "S"),                                   // M140: Set bed temperature
+    #endif
 
-        // PWM for HEATER_2_PIN
-        #if HAS_HEATER_2
-          case 128: M128(); break;                                // M128: valve open
-          case 129: M129(); break;                                // M129: valve closed
-        #endif
-      #endif // BARICUDA
+    #if ENABLED(ULTIPANEL)
+      M_CODE(145, M145, "BFHS"),                                // M145: Set material heatup parameters
+    #endif
+
+    #if ENABLED(TEMPERATURE_UNITS_SUPPORT)
+      M_CODE(149, M149, "CFK"),                                 // M149: Set temperature units
+    #endif
 
-      #if HAS_POWER_SWITCH
-        case 80: M80(); break;                                    // M80: Turn on Power Supply
+    #if HAS_COLOR_LEDS
+      M_CODE(150, M150, "BPRUW"),                               // M150: Set Status LED Color
+    #endif
+
+    #if ENABLED(AUTO_REPORT_TEMPERATURES) && HAS_TEMP_SENSOR
+      M_CODE(155, M155, "S"),                                   // M155: Set temperature auto-report interval
+    #endif
+
+    #if ENABLED(MIXING_EXTRUDER)
+      M_CODE(163, M163, "PS"),                                  // M163: Set a component weight for mixing extruder
+      #if MIXING_VIRTUAL_TOOLS > 1
+        M_CODE(164, M164, "S"),                                 // M164: Save current mix as a virtual extruder
       #endif
-      case 81: M81(); break;                                      // M81: Turn off Power, including Power Supply, if possible
-
-      case 82: M82(); break;                                      // M82: Set E axis normal mode (same as other axes)
-      case 83: M83(); break;                                      // M83: Set E axis relative mode
-      case 18: case 84: M18_M84(); break;                         // M18/M84: Disable Steppers / Set Timeout
-      case 85: M85(); break;                                      // M85: Set inactivity stepper shutdown timeout
-      case 92: M92(); break;                                      // M92: Set the steps-per-unit for one or more axes
-      case 114: M114(); break;                                    // M114: Report current position
-      case 115: M115(); break;                                    // M115: Report capabilities
-      case 117: M117(); break;                                    // M117: Set LCD message text, if possible
-      case 118: M118(); break;                                    // M118: Display a message in the host console
-      case 119: M119(); break;                                    // M119: Report endstop states
-      case 120: M120(); break;                                    // M120: Enable endstops
-      case 121: M121(); break;                                    // M121: Disable endstops
-
-      #if ENABLED(ULTIPANEL)
-        case 145: M145(); break;                                  // M145: Set material heatup parameters
+      #if ENABLED(DIRECT_MIXING_IN_G1)
+        M_CODE(165, M165, "ABCDHI"),                            // M165: Set multiple mix weights
       #endif
+    #endif
 
-      #if ENABLED(TEMPERATURE_UNITS_SUPPORT)
-        case 149: M149(); break;                                  // M149: Set temperature units
-      #endif
+    #if HAS_HEATED_BED
+      M_CODE(190, M190, "RS"),                                  // M190: Wait for bed temperature to reach target
+    #endif
 
-      #if HAS_COLOR_LEDS
-        case 150: M150(); break;                                  // M150: Set Status LED Color
-      #endif
+    #if DISABLED(NO_VOLUMETRICS)
+      M_CODE(200, M200, "DT"),                                  // M200: Set filament diameter, E to cubic units
+    #endif
 
-      #if ENABLED(MIXING_EXTRUDER)
-        case 163: M163(); break;                                  // M163: Set a component weight for mixing extruder
-        #if MIXING_VIRTUAL_TOOLS > 1
-          case 164: M164(); break;                                // M164: Save current mix as a virtual extruder
-        #endif
-        #if ENABLED(DIRECT_MIXING_IN_G1)
-          case 165: M165(); break;                                // M165: Set multiple mix weights
-        #endif
-      #endif
+    M_CODE(201, M201, "EXYZT"),                                 // M201: Set max acceleration for print moves (units/s^2)
+    M_CODE(203, M203, "EXYZT"),                                 // M203: Set max feedrate (units/sec)
+    M_CODE(204, M204, "PRST"),                                  // M204: Set acceleration
+    M_CODE(205, M205, "BEJSTXYZ"),                              // M205: Set advanced settings
 
-      #if DISABLED(NO_VOLUMETRICS)
-        case 200: M200(); break;                                  // M200: Set filament diameter, E to cubic units
-      #endif
+    #if HAS_M206_COMMAND
+      M_CODE(206, M206, "PTXYZ"),                               // M206: Set home offsets
+    #endif
 
-      case 201: M201(); break;                                    // M201: Set max acceleration for print moves (units/s^2)
+    #if ENABLED(FWRETRACT)
+      M_CODE(207, M207, "FSWZ"),                                // M207: Set Retract Length, Feedrate, and Z lift
+      M_CODE(208, M208, "FRSW"),                                // M208: Set Recover (unretract) Additional Length and Feedrate
+      M_CODE(209, M209, "S"),                                   // M209: Turn Automatic Retract Detection on/off
+    #endif
 
-      #if 0
-        case 202: M202(); break;                                  // M202: Not used for Sprinter/grbl gen6
-      #endif
+    M_CODE(211, M211, "S"),                                     // M211: Enable, Disable, and/or Report software endstops
 
-      case 203: M203(); break;                                    // M203: Set max feedrate (units/sec)
-      case 204: M204(); break;                                    // M204: Set acceleration
-      case 205: M205(); break;                                    // M205: Set advanced settings
+    #ifdef ARC_CHORD_TOLERANCE
+      M_CODE(214, M214, "PS"),                                  // M214: Set arc chord tolerance and minimum segment time
+    #endif
 
-      #if HAS_M206_COMMAND
-        case 206: M206(); break;                                  // M206: Set home offsets
-      #endif
+    #if HOTENDS > 1
+      M_CODE(218, M218, "TXYZ"),                                // M218: Set a tool offset
+    #endif
 
-      #if ENABLED(DELTA)
-        case 665: M665(); break;                                  // M665: Set delta configurations
-      #endif
+    M_CODE(220, M220, "S"),                                     // M220: Set Feedrate Percentage: S<percent> ("FR" on your LCD)
+    M_CODE(221, M221, "ST"),                                    // M221: Set Flow Percentage
+    M_CODE(226, M226, "PS"),                                    // M226: Wait until a pin reaches a state
 
-      #if ENABLED(DELTA) || ENABLED(X_DUAL_ENDSTOPS) || ENABLED(Y_DUAL_ENDSTOPS) || ENABLED(Z_DUAL_ENDSTOPS)
-        case 666: M666(); break;                                  // M666: Set delta or dual endstop adjustment
-      #endif
+    #if defined(CHDK) || HAS_PHOTOGRAPH
+      M_CODE(240, M240, ""),                                    // M240: Trigger a camera by emulating a Canon RC-1 : http://www.doc-diy.net/photo/rc-1_hacked/
+    #endif
 
-      #if ENABLED(FWRETRACT)
-        case 207: M207(); break;                                  // M207: Set Retract Length, Feedrate, and Z lift
-        case 208: M208(); break;                                  // M208: Set Recover (unretract) Additional Length and Feedrate
-        case 209:
-          if (MIN_AUTORETRACT <= MAX_AUTORETRACT) M209();         // M209: Turn Automatic Retract Detection on/off
-          break;
-      #endif
+    #if HAS_LCD_CONTRAST
+      M_CODE(250, M250, "C"),                                   // M250: Set LCD contrast
+    #endif
 
-      case 211: M211(); break;                                    // M211: Enable, Disable, and/or Report software endstops
+    #if ENABLED(EXPERIMENTAL_I2CBUS)
+      M_CODE(260, M260, "ABRS"),                                // M260: Send data to an i2c slave
+      M_CODE(261, M261, "ABRS"),                                // M261: Request data from an i2c slave
+    #endif
 
-      #if HOTENDS > 1
-        case 218: M218(); break;                                  // M218: Set a tool offset
-      #endif
+    #if HAS_SERVOS
+      M_CODE(280, M280, "PS"),                                  // M280: Set servo position absolute
+    #endif
 
-      case 220: M220(); break;                                    // M220: Set Feedrate Percentage: S<percent> ("FR" on your LCD)
-      case 221: M221(); break;                                    // M221: Set Flow Percentage
-      case 226: M226(); break;                                    // M226: Wait until a pin reaches a state
+    #if ENABLED(BABYSTEPPING)
+      M_CODE(290, M290, "EPSXYZ"),                              // M290: Babystepping
+    #endif
 
-      #if HAS_SERVOS
-        case 280: M280(); break;                                  // M280: Set servo position absolute
-      #endif
+    #if HAS_BUZZER
+      M_CODE(300, M300, "PS"),                                  // M300: Play beep tone
+    #endif
 
-      #if ENABLED(BABYSTEPPING)
-        case 290: M290(); break;                                  // M290: Babystepping
-      #endif
+    #if ENABLED(PIDTEMP)
+      M_CODE(301, M301, "CDEILP"),                              // M301: Set hotend PID parameters
+    #endif
 
-      #if HAS_BUZZER
-        case 300: M300(); break;                                  // M300: Play beep tone
-      #endif
+    #if ENABLED(PREVENT_COLD_EXTRUSION)
+      M_CODE(302, M302, "PS"),                                  // M302: Allow cold extrudes (set the minimum extrude temperature)
+    #endif
 
-      #if ENABLED(PIDTEMP)
-        case 301: M301(); break;                                  // M301: Set hotend PID parameters
-      #endif
+    M_CODE(303, M303, "CEFRSU"),                                // M303: PID autotune
 
-      #if ENABLED(PIDTEMPBED)
-        case 304: M304(); break;                                  // M304: Set bed PID parameters
-      #endif
+    #if ENABLED(PIDTEMPBED)
+      M_CODE(304, M304, "DIP"),                                 // M304: Set bed PID parameters
+    #endif
 
-      #if defined(CHDK) || HAS_PHOTOGRAPH
-        case 240: M240(); break;                                  // M240: Trigger a camera by emulating a Canon RC-1 : http://www.doc-diy.net/photo/rc-1_hacked/
-      #endif
+    #if ENABLED(MPCTEMP)
+      M_CODE(306, M306, "ACEHPRT"),                             // M306: Set or identify the hotend thermal model
+    #endif
 
-      #if HAS_LCD_CONTRAST
-        case 250: M250(); break;                                  // M250: Set LCD contrast
-      #endif
+    #if HAS_MICROSTEPS
+      M_CODE(350, M350, "BESXYZ"),                              // M350: Set microstepping mode. Warning: Steps per unit remains unchanged. S code sets stepping mode for all drivers.
+      M_CODE(351, M351, "BESXYZ"),                              // M351: Toggle MS1 MS2 pins directly, S# determines MS1 or MS2, X# sets the pin high/low.
+    #endif
 
-      #if ENABLED(EXPERIMENTAL_I2CBUS)
-        case 260: M260(); break;                                  // M260: Send data to an i2c slave
-        case 261: M261(); break;                                  // M261: Request data from an i2c slave
-      #endif
+    M_CODE(355, M355, "PS"),                                    // M355: Set case light brightness
 
-      #if ENABLED(PREVENT_COLD_EXTRUSION)
-        case 302: M302(); break;                                  // M302: Allow cold extrudes (set the minimum extrude temperature)
-      #endif
+    #if ENABLED(MORGAN_SCARA)
+      M_CODE_FLAGS(360, M360, DISPATCH_NO_OK_IF_RUNNING, ""),   // M360: SCARA Theta pos1
+      M_CODE_FLAGS(361, M361, DISPATCH_NO_OK_IF_RUNNING, ""),   // M361: SCARA Theta pos2
+      M_CODE_FLAGS(362, M362, DISPATCH_NO_OK_IF_RUNNING, ""),   // M362: SCARA Psi pos1
+      M_CODE_FLAGS(363, M363, DISPATCH_NO_OK_IF_RUNNING, ""),   // M363: SCARA Psi pos2
+      M_CODE_FLAGS(364, M364, DISPATCH_NO_OK_IF_RUNNING, ""),   // M364: SCARA Psi pos3 (90 deg to Theta)
+    #endif
 
-      case 303: M303(); break;                                    // M303: PID autotune
+    #if ENABLED(EXT_SOLENOID)
+      M_CODE(380, M380, ""),                                    // M380: Activate solenoid on active extruder
+      M_CODE(381, M381, ""),                                    // M381: Disable all solenoids
+    #endif
 
-      #if ENABLED(MORGAN_SCARA)
-        case 360: if (M360()) return; break;                      // M360: SCARA Theta pos1
-        case 361: if (M361()) return; break;                      // M361: SCARA Theta pos2
-        case 362: if (M362()) return; break;                      // M362: SCARA Psi pos1
-        case 363: if (M363()) return; break;                      // M363: SCARA Psi pos2
-        case 364: if (M364()) return; break;                      // M364: SCARA Psi pos3 (90 deg to Theta)
-      #endif
+    M_CODE(400, M400, ""),                                      // M400: Finish all moves
 
-      #if ENABLED(EXT_SOLENOID)
-        case 380: M380(); break;                                  // M380: Activate solenoid on active extruder
-        case 381: M381(); break;                                  // M381: Disable all solenoids
-      #endif
+    #if HAS_BED_PROBE
+      M_CODE(401, M401, ""),                                    // M401: Deploy probe
+      M_CODE(402, M402, ""),                                    // M402: Stow probe
+    #endif
 
-      case 400: M400(); break;                                    // M400: Finish all moves
+    #if ENABLED(FILAMENT_WIDTH_SENSOR)
+      M_CODE(404, M404, "W"),                                   // M404: Enter the nominal filament width (3mm, 1.75mm ) N<3.0> or display nominal filament width
+      M_CODE(405, M405, "D"),                                   // M405: Turn on filament sensor for control
+      M_CODE(406, M406, ""),                                    // M406: Turn off filament sensor for control
+      M_CODE(407, M407, ""),                                    // M407: Display measured filament diameter
+    #endif
 
-      #if HAS_BED_PROBE
-        case 401: M401(); break;                                  // M401: Deploy probe
-        case 402: M402(); break;                                  // M402: Stow probe
-      #endif
+    #if DISABLED(EMERGENCY_PARSER)
+      M_CODE(410, M410, ""),                                    // M410: Quickstop - Abort all the planned moves.
+    #endif
 
-      #if ENABLED(FILAMENT_WIDTH_SENSOR)
-        case 404: M404(); break;                                  // M404: Enter the nominal filament width (3mm, 1.75mm ) N<3.0> or display nominal filament width
-        case 405: M405(); break;                                  // M405: Turn on filament sensor for control
-        case 406: M406(); break;                                  // M406: Turn off filament sensor for control
-        case 407: M407(); break;                                  // M407: Display measured filament diameter
-      #endif
+    #if HAS_LEVELING
+      M_CODE(420, M420, "LSTVZ"),                               // M420: Enable/Disable Bed Leveling
+    #endif
 
-      #if HAS_LEVELING
-        case 420: M420(); break;                                  // M420: Enable/Disable Bed Leveling
-      #endif
+    #if HAS_MESH
+      M_CODE(421, M421, M421_PARAMS),                           // M421: Set a Mesh Bed Leveling Z coordinate
+    #endif
 
-      #if HAS_MESH
-        case 421: M421(); break;                                  // M421: Set a Mesh Bed Leveling Z coordinate
-      #endif
+    #if HAS_M206_COMMAND
+      M_CODE(428, M428, ""),                                    // M428: Apply current_position to home_offset
+    #endif
 
-      #if HAS_M206_COMMAND
-        case 428: M428(); break;                                  // M428: Apply current_position to home_offset
-      #endif
+    M_CODE(500, M500, ""),                                      // M500: Store settings in EEPROM
+    M_CODE(501, M501, ""),                                      // M501: Read settings from EEPROM
+    M_CODE(502, M502, ""),                                      // M502: Revert to default settings
+    #if DISABLED(DISABLE_M503)
+      M_CODE(503, M503, "S"),                                   // M503: print settings currently in memory
+    #endif
+    #if ENABLED(EEPROM_SETTINGS)
+      M_CODE(504, M504, ""),                                    // M504: Validate EEPROM contents
+    #endif
 
-      case 500: M500(); break;                                    // M500: Store settings in EEPROM
-      case 501: M501(); break;                                    // M501: Read settings from EEPROM
-      case 502: M502(); break;                                    // M502: Revert to default settings
-      #if DISABLED(DISABLE_M503)
-        case 503: M503(); break;                                  // M503: print settings currently in memory
-      #endif
-      #if ENABLED(EEPROM_SETTINGS)
-        case 504: M504(); break;                                  // M504: Validate EEPROM contents
-      #endif
+    #if ENABLED(ABORT_ON_ENDSTOP_HIT_FEATURE_ENABLED)
+      M_CODE(540, M540, "S"),                                   // M540: Set abort on endstop hit for SD printing
+    #endif
 
-      #if ENABLED(ABORT_ON_ENDSTOP_HIT_FEATURE_ENABLED)
-        case 540: M540(); break;                                  // M540: Set abort on endstop hit for SD printing
-      #endif
+    #if ENABLED(SERIAL_CREDIT_FLOW)
+      M_CODE(575, M575, "S"),                                   // M575: Set credit flow control
+    #endif
 
-      #if HAS_BED_PROBE
-        case 851: M851(); break;                                  // M851: Set Z Probe Z Offset
-      #endif
+    #if ENABLED(STEP_TIMELINE)
+      M_CODE(576, M576, "S"),                                   // M576: Record the step timeline
+    #endif
 
-      #if ENABLED(SKEW_CORRECTION_GCODE)
-        case 852: M852(); break;                                  // M852: Set Skew factors
-      #endif
+    #if ENABLED(CODE_PROFILER)
+      M_CODE(577, M577, "R"),                                   // M577: Report the profiler zones
+    #endif
 
-      #if ENABLED(ADVANCED_PAUSE_FEATURE)
-        case 600: M600(); break;                                  // M600: Pause for Filament Change
-        case 603: M603(); break;                                  // M603: Configure Filament Change
-      #endif
+    #if ENABLED(ADVANCED_PAUSE_FEATURE)
+      M_CODE(600, M600, "BELTUXYZ"),                            // M600: Pause for Filament Change
+      M_CODE(603, M603, "LTU"),                                 // M603: Configure Filament Change
+    #endif
 
-      #if ENABLED(DUAL_X_CARRIAGE) || ENABLED(DUAL_NOZZLE_DUPLICATION_MODE)
-        case 605: M605(); break;                                  // M605: Set Dual X Carriage movement mode
-      #endif
+    #if ENABLED(DUAL_X_CARRIAGE) || ENABLED(DUAL_NOZZLE_DUPLICATION_MODE)
+      M_CODE(605, M605, "RSX"),                                 // M605: Set Dual X Carriage movement mode
+    #endif
 
-      #if ENABLED(FILAMENT_LOAD_UNLOAD_GCODES)
-        case 701: M701(); break;                                  // M701: Load Filament
-        case 702: M702(); break;                                  // M702: Unload Filament
-      #endif
+    #if ENABLED(DELTA)
+      M_CODE(665, M665, "ABHLPRSTXYZ"),                         // M665: Set delta configurations
+    #endif
 
-      #if ENABLED(LIN_ADVANCE)
-        case 900: M900(); break;                                  // M900: Set advance K factor.
-      #endif
+    #if ENABLED(DELTA) || ENABLED(X_DUAL_ENDSTOPS) || ENABLED(Y_DUAL_ENDSTOPS) || ENABLED(Z_DUAL_ENDSTOPS)
+      M_CODE(666, M666, "EXYZ"),                                // M666: Set delta or dual endstop adjustment
+    #endif
 
-      #if HAS_DIGIPOTSS || HAS_MOTOR_CURRENT_PWM || ENABLED(DIGIPOT_I2C) || ENABLED(DAC_STEPPER_CURRENT)
-        case 907: M907(); break;                                  // M907: Set digital trimpot motor current using axis codes.
-        #if HAS_DIGIPOTSS || ENABLED(DAC_STEPPER_CURRENT)
-          case 908: M908(); break;                                // M908: Control digital trimpot directly.
-          #if ENABLED(DAC_STEPPER_CURRENT)
-            case 909: M909(); break;                              // M909: Print digipot/DAC current value
-            case 910: M910(); break;                              // M910: Commit digipot/DAC value to external EEPROM
-          #endif
-        #endif
-      #endif
+    #if ENABLED(FILAMENT_LOAD_UNLOAD_GCODES)
+      M_CODE(701, M701, "LTZ"),                                 // M701: Load Filament
+      M_CODE(702, M702, "TUZ"),                                 // M702: Unload Filament
+    #endif
 
-      #if HAS_TRINAMIC
-        #if ENABLED(TMC_DEBUG)
-          case 122: M122(); break;
-        #endif
-        case 906: M906(); break;                                  // M906: Set motor current in milliamps using axis codes X, Y, Z, E
-        case 911: M911(); break;                                  // M911: Report TMC2130 prewarn triggered flags
-        case 912: M912(); break;                                  // M912: Clear TMC2130 prewarn triggered flags
-        #if ENABLED(HYBRID_THRESHOLD)
-          case 913: M913(); break;                                // M913: Set HYBRID_THRESHOLD speed.
-        #endif
-        #if ENABLED(SENSORLESS_HOMING)
-          case 914: M914(); break;                                // M914: Set SENSORLESS_HOMING sensitivity.
-        #endif
-        #if ENABLED(TMC_Z_CALIBRATION)
-          case 915: M915(); break;                                // M915: TMC Z axis calibration.
+    #if ENABLED(DEBUG_GCODE_PARSER)
+      M_CODE(800, GCodeParser::debug, "*"),                     // M800: GCode Parser Test for M
+    #endif
+
+    #if HAS_BED_PROBE
+      M_CODE(851, M851, "Z"),                                   // M851: Set Z Probe Z Offset
+    #endif
+
+    #if ENABLED(SKEW_CORRECTION_GCODE)
+      M_CODE(852, M852, "IJKS"),                                // M852: Set Skew factors
+    #endif
+
+    #if ENABLED(I2C_POSITION_ENCODERS)
+      M_CODE(860, M860, "AEIOPRSTUXYZ"),                        // M860: Report encoder module position
+      M_CODE(861, M861, "AEIOPRSTUXYZ"),                        // M861: Report encoder module status
+      M_CODE(862, M862, "AEIOPRSTUXYZ"),                        // M862: Perform axis test
+      M_CODE(863, M863, "AEIOPRSTUXYZ"),                        // M863: Calibrate steps/mm
+      M_CODE(864, M864, "AEIOPRSTUXYZ"),                        // M864: Change module address
+      M_CODE(865, M865, "AEIOPRSTUXYZ"),                        // M865: Check module firmware version
+      M_CODE(866, M866, "AEIOPRSTUXYZ"),                        // M866: Report axis error count
+      M_CODE(867, M867, "AEIOPRSTUXYZ"),                        // M867: Toggle error correction
+      M_CODE(868, M868, "AEIOPRSTUXYZ"),                        // M868: Set error correction threshold
+      M_CODE(869, M869, "AEIOPRSTUXYZ"),                        // M869: Report axis error
+    #endif
+
+    #if ENABLED(LIN_ADVANCE)
+      M_CODE(900, M900, "K"),                                   // M900: Set advance K factor.
+    #endif
+
+    #if HAS_TRINAMIC
+      M_CODE(906, M906, "EITXYZ"),                              // M906: Set motor current in milliamps using axis codes X, Y, Z, E
+    #endif
+
+    #if HAS_DIGIPOTSS || HAS_MOTOR_CURRENT_PWM || ENABLED(DIGIPOT_I2C) || ENABLED(DAC_STEPPER_CURRENT)
+      M_CODE(907, M907, "BEPSXYZ"),                             // M907: Set digital trimpot motor current using axis codes.
+      #if HAS_DIGIPOTSS || ENABLED(DAC_STEPPER_CURRENT)
+        M_CODE(908, M908, "PS"),                                // M908: Control digital trimpot directly.
+        #if ENABLED(DAC_STEPPER_CURRENT)
+          M_CODE(909, M909, ""),                                // M909: Print digipot/DAC current value
+          M_CODE(910, M910, ""),                                // M910: Commit digipot/DAC value to external EEPROM
         #endif
       #endif
+    #endif
 
-      #if HAS_MICROSTEPS
-        case 350: M350(); break;                                  // M350: Set microstepping mode. Warning: Steps per unit remains unchanged. S code sets stepping mode for all drivers.
-        case 351: M351(); break;                                  // M351: Toggle MS1 MS2 pins directly, S# determines MS1 or MS2, X# sets the pin high/low.
+    #if HAS_TRINAMIC
+      M_CODE(911, M911, ""),                                    // M911: Report TMC2130 prewarn triggered flags
+      M_CODE(912, M912, "EXYZ"),                                // M912: Clear TMC2130 prewarn triggered flags
+      #if ENABLED(HYBRID_THRESHOLD)
+        M_CODE(913, M913, "EITXYZ"),                            // M913: Set HYBRID_THRESHOLD speed.
+      #endif
+      #if ENABLED(SENSORLESS_HOMING)
+        M_CODE(914, M914, "IXYZ"),                              // M914: Set SENSORLESS_HOMING sensitivity.
       #endif
+      #if ENABLED(TMC_Z_CALIBRATION)
+        M_CODE(915, M915, "SZ"),                                // M915: TMC Z axis calibration.
+      #endif
+    #endif
+
+    #if ENABLED(SDSUPPORT)
+      M_CODE(928, M928, "*"),                                   // M928: Start SD write
+    #endif
 
-      case 355: M355(); break;                                    // M355: Set case light brightness
+    M_CODE(999, M999, "S")                                      // M999: Restart after being Stopped
+  };
 
-      #if ENABLED(DEBUG_GCODE_PARSER)
-        case 800: parser.debug(); break;                          // M800: GCode Parser Test for M
-      #endif
+  static_assert(dispatch_sorted(table), "The G-code dispatch table must be sorted by code.");
 
-      #if ENABLED(I2C_POSITION_ENCODERS)
-        case 860: M860(); break;                                  // M860: Report encoder module position
-        case 861: M861(); break;                                  // M861: Report encoder module status
-        case 862: M862(); break;                                  // M862: Perform axis test
-        case 863: M863(); break;                                  // M863: Calibrate steps/mm
-        case 864: M864(); break;                                  // M864: Change module address
-        case 865: M865(); break;                                  // M865: Check module firmware version
-        case 866: M866(); break;                                  // M866: Report axis error count
-        case 867: M867(); break;                                  // M867: Toggle error correction
-        case 868: M868(); break;                                  // M868: Set error correction threshold
-        case 869: M869(); break;                                  // M869: Report axis error
-      #endif
+  if ((parser.command_letter != 'G' && parser.command_letter != 'M') || parser.codenum > 0x7FF) return NULL;
+  const uint16_t key = GCODE_KEY(parser.command_letter, parser.codenum, 0);
 
-      case 999: M999(); break;                                    // M999: Restart after being Stopped
+  #if USE_GCODE_SUBCODES
+    if (WITHIN(parser.subcode, 1, 15)) {
+      const dispatch_t * const entry = dispatch_search(table, key | parser.subcode);
+      if (entry) return entry;
     }
-    break;
+  #endif
+
+  return dispatch_search(table, key);
+}
+
+/**
+ * Process the parsed command and dispatch it to its handler
+ */
+void GcodeSuite::process_parsed_command(
+  #if ENABLED(USE_EXECUTE_COMMANDS_IMMEDIATE)
+    const bool no_ok
+  #endif
+) {
+  KEEPALIVE_STATE(IN_HANDLER);
+
+  bool send_ok = true;
+
+  // Handle a known G, M, or T
+  switch (parser.command_letter) {
+    case 'G': case 'M': {
+      const dispatch_t * const entry = find_handler();
+      if (!entry) break;                                          // Unsupported codes are ignored
+
+      #if ENABLED(STRICT_GCODE_PARAMETERS)
+        const char c = parser.unknown_parameter(pgm_read_dword(&entry->params));
+        if (c) { parser.unknown_parameter_error(c); break; }
+      #endif
 
-    case 'T': T(parser.codenum); break;                           // Tn: Tool Change
+      const uint8_t flags = pgm_read_byte(&entry->flags);
+      if ((flags & DISPATCH_NO_OK) || ((flags & DISPATCH_NO_OK_IF_RUNNING) && IsRunning()))
+        send_ok = false;
+
+      ((gcode_handler_t)pgm_read_ptr(&entry->handler))();
+    } break;
+
+    case 'T':                                                     // Tn: Tool Change
+      #if ENABLED(STRICT_GCODE_PARAMETERS)
+        if (const char c = parser.unknown_parameter(_BV32('F' - 'A') | _BV32('S' - 'A'))) {
+          parser.unknown_parameter_error(c);
+          break;
+        }
+      #endif
+      T(parser.codenum);
+      break;
 
     default: parser.unknown_command_error();
   }
 
   KEEPALIVE_STATE(NOT_BUSY);
 
-  #if ENABLED(USE_EXECUTE_COMMANDS_IMMEDIATE)
-    if (!no_ok)
-  #endif
-      ok_to_send();
+  if (send_ok
+    #if ENABLED(USE_EXECUTE_COMMANDS_IMMEDIATE)
+      && !no_ok
+    #endif
+  ) ok_to_send();
 }
 
 /**
@@ -678,6 +805,20 @@ void GcodeSuite::process_parsed_command(
 void GcodeSuite::process_next_command() {
   char * const current_command = command_queue[cmd_queue_index_r];
 
+  #if ENABLED(BINARY_GCODE_TRANSPORT)
+    if (command_queue_binary[cmd_queue_index_r]) {
+      // The record is already parsed. Just unpack it.
+      parser.parse_binary((uint8_t*)current_command);
+      if (DEBUGGING(ECHO)) {
+        SERIAL_ECHO_START();
+        SERIAL_ECHOLN(parser.command_ptr);
+      }
+      reset_stepper_timeout(); // Keep steppers powered
+      process_parsed_command();
+      return;
+    }
+  #endif
+
   if (DEBUGGING(ECHO)) {
     SERIAL_ECHO_START();
     SERIAL_ECHOLN(current_command);
@@ -690,7 +831,12 @@ void GcodeSuite::process_next_command() {
   reset_stepper_timeout(); // Keep steppers powered
 
   // Parse the next command in the queue
-  parser.parse(current_command);
+  #if ENABLED(SERIAL_LINE_TOKENS)
+    if (command_queue_tokens[cmd_queue_index_r].letter)
+      parser.parse_tokens(current_command, command_queue_tokens[cmd_queue_index_r]);
+    else
+  #endif
+      parser.parse(current_command);
   process_parsed_command();
 }
 
@@ -717,10 +863,16 @@ void GcodeSuite::process_next_command() {
       // Parse the next command in the string
       parser.parse(cmd);
       process_parsed_command(true);
+      segment_feed.finish(); // Buffer all of a move before the next command
     }
 
     // Restore the parser state
-    parser.parse(saved_cmd);
+    #if ENABLED(BINARY_GCODE_TRANSPORT)
+      if (command_queue_binary[cmd_queue_index_r])
+        parser.parse_binary((uint8_t*)command_queue[cmd_queue_index_r]);
+      else
+    #endif
+        parser.parse(saved_cmd);
   }
 #endif
 
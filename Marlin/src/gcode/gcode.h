@@ -156,6 +156,7 @@
  * M205 - Set advanced settings. Current units apply:
             S<print> T<travel> minimum speeds
             B<minimum segment time>
+            J<junction deviation> (Requires JUNCTION_DEVIATION)
             X<max X jerk>, Y<max Y jerk>, Z<max Z jerk>, E<max E jerk>
  * M206 - Set additional homing offset. (Disabled by NO_WORKSPACE_OFFSETS or DELTA)
  * M207 - Set Retract Length: S<length>, Feedrate: F<units/min>, and Z lift: Z<distance>. (Requires FWRETRACT)
@@ -163,6 +164,7 @@
  * M209 - Turn Automatic Retract Detection on/off: S<0|1> (For slicers that don't support G10/11). (Requires FWRETRACT)
           Every normal extrude-only move will be classified as retract depending on the direction.
  * M211 - Enable, Disable, and/or Report software endstops: S<0|1> (Requires MIN_SOFTWARE_ENDSTOPS or MAX_SOFTWARE_ENDSTOPS)
+ * M214 - Set arc segmentation: "M214 P<chord tolerance> S<min segment ms>". P0 for fixed segments. (Requires ARC_CHORD_TOLERANCE)
  * M218 - Set/get a tool offset: "M218 T<index> X<offset> Y<offset>". (Requires 2 or more extruders)
  * M220 - Set Feedrate Percentage: "M220 S<percent>" (i.e., "FR" on the LCD)
  * M221 - Set Flow Percentage: "M221 S<percent>"
@@ -177,7 +179,9 @@
  * M301 - Set PID parameters P I and D. (Requires PIDTEMP)
  * M302 - Allow cold extrudes, or set the minimum extrude S<temperature>. (Requires PREVENT_COLD_EXTRUSION)
  * M303 - PID relay autotune S<temperature> sets the target temperature. Default 150C. (Requires PIDTEMP)
+ *        With F fit a model to one heat-up instead, and with R refine it with one relay cycle. (Requires PID_AUTOTUNE_FIT)
  * M304 - Set bed PID parameters P I and D. (Requires PIDTEMPBED)
+ * M306 - Set the hotend thermal model P C R A H, or identify it with T. (Requires MPCTEMP)
  * M350 - Set microstepping mode. (Requires digital microstepping pins.)
  * M351 - Toggle MS1 MS2 pins directly. (Requires digital microstepping pins.)
  * M355 - Set Case Light on/off and set brightness. (Requires CASE_LIGHT_PIN)
@@ -199,6 +203,9 @@
  * M502 - Revert to the default "factory settings". ** Does not write them to EEPROM! **
  * M503 - Print the current settings (in memory): "M503 S<verbose>". S0 specifies compact output.
  * M540 - Enable/disable SD card abort on endstop hit: "M540 S<state>". (Requires ABORT_ON_ENDSTOP_HIT_FEATURE_ENABLED)
+ * M575 - Set or report credit flow control: "M575 S1" for cumulative "ok N<line> R<bytes> B<slots>". (Requires SERIAL_CREDIT_FLOW)
+ * M576 - Record the step timeline: "M576 S1" to start, "M576 S0" to stop after the queued moves. (Requires STEP_TIMELINE)
+ * M577 - Report the time spent in the main loop tasks and the ISRs: "M577 R" to clear the counts after the report. (Requires CODE_PROFILER)
  * M600 - Pause for filament change: "M600 X<pos> Y<pos> Z<raise> E<first_retract> L<later_retract>". (Requires ADVANCED_PAUSE_FEATURE)
  * M603 - Configure filament change: "M603 T<tool> U<unload_length> L<load_length>". (Requires ADVANCED_PAUSE_FEATURE)
  * M605 - Set Dual X-Carriage movement mode: "M605 S<mode> [X<x_offset>] [R<temp_offset>]". (Requires DUAL_X_CARRIAGE)
@@ -273,6 +280,11 @@ public:
     static WorkspacePlane workspace_plane;
   #endif
 
+  #ifdef ARC_CHORD_TOLERANCE
+    static float arc_chord_tolerance;     // (mm) 0 for MM_PER_ARC_SEGMENT
+    static uint16_t arc_min_segment_time; // (ms)
+  #endif
+
   #define MAX_COORDINATE_SYSTEMS 9
   #if ENABLED(CNC_COORDINATE_SYSTEMS)
     static int8_t active_coordinate_system;
@@ -296,6 +308,33 @@ public:
     static void process_subcommands_now_P(const char *pgcode);
   #endif
 
+  /**
+   * G and M codes are dispatched through a table in PROGMEM, sorted by
+   * a key packing the letter, code and subcode. Codes up to 2047 and
+   * subcodes up to 15 can be keyed. A subcode with no entry of its own
+   * falls back to the plain code.
+   */
+  #define GCODE_KEY(L,N,S) uint16_t(((L) == 'M' ? 0x8000 : 0) | ((N) << 4) | (S))
+
+  enum DispatchFlag : uint8_t {
+    DISPATCH_NO_OK            = _BV(0),   // The handler sends no "ok"
+    DISPATCH_NO_OK_IF_RUNNING = _BV(1)    // ...if the machine is running
+  };
+
+  typedef void (*gcode_handler_t)();
+
+  typedef struct {
+    uint16_t key;                         // GCODE_KEY
+    uint8_t flags;                        // DispatchFlag bits
+    #if ENABLED(STRICT_GCODE_PARAMETERS)
+      uint32_t params;                    // Parameters the handler accepts, bit 0 = A
+    #endif
+    gcode_handler_t handler;
+  } dispatch_t;
+
+  // The table entry (in PROGMEM) for the parsed command, or NULL if there's none
+  static const dispatch_t* find_handler();
+
   FORCE_INLINE static void home_all_axes() { G28(true); }
 
   /**
@@ -340,14 +379,10 @@ public:
 
 private:
 
-  static void G0_G1(
-    #if IS_SCARA
-      bool fast_move=false
-    #endif
-  );
+  static void G0_G1();
 
   #if ENABLED(ARC_SUPPORT)
-    static void G2_G3(const bool clockwise);
+    static void G2_G3();
   #endif
 
   static void G4();
@@ -385,6 +420,7 @@ private:
   #endif
 
   static void G28(const bool always_home_all);
+  static void G28() { G28(false); }    // As a command, homing only the given axes
 
   #if HAS_LEVELING
     static void G29();
@@ -406,7 +442,7 @@ private:
   #endif
 
   #if ENABLED(G38_PROBE_TARGET)
-    static void G38(const bool is_38_2);
+    static void G38();
   #endif
 
   #if HAS_MESH
@@ -423,6 +459,8 @@ private:
     static void G59();
   #endif
 
+  static void G90();
+  static void G91();
   static void G92();
 
   #if HAS_RESUME_CONTINUE
@@ -430,7 +468,7 @@ private:
   #endif
 
   #if ENABLED(SPINDLE_LASER_ENABLE)
-    static void M3_M4(bool is_M3);
+    static void M3_M4();
     static void M5();
   #endif
 
@@ -601,6 +639,10 @@ private:
 
   static void M211();
 
+  #ifdef ARC_CHORD_TOLERANCE
+    static void M214();
+  #endif
+
   #if HOTENDS > 1
     static void M218();
   #endif
@@ -648,6 +690,10 @@ private:
     static void M304();
   #endif
 
+  #if ENABLED(MPCTEMP)
+    static void M306();
+  #endif
+
   #if HAS_MICROSTEPS
     static void M350();
     static void M351();
@@ -656,11 +702,11 @@ private:
   static void M355();
 
   #if ENABLED(MORGAN_SCARA)
-    static bool M360();
-    static bool M361();
-    static bool M362();
-    static bool M363();
-    static bool M364();
+    static void M360();
+    static void M361();
+    static void M362();
+    static void M363();
+    static void M364();
   #endif
 
   #if ENABLED(EXT_SOLENOID)
@@ -705,6 +751,18 @@ private:
     static void M540();
   #endif
 
+  #if ENABLED(SERIAL_CREDIT_FLOW)
+    static void M575();
+  #endif
+
+  #if ENABLED(STEP_TIMELINE)
+    static void M576();
+  #endif
+
+  #if ENABLED(CODE_PROFILER)
+    static void M577();
+  #endif
+
   #if ENABLED(ADVANCED_PAUSE_FEATURE)
     static void M600();
     static void M603();
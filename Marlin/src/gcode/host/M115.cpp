@@ -153,5 +153,12 @@ void GcodeSuite::M115() {
       #endif
     );
 
+    // SERIAL_CREDIT_FLOW (M575)
+    cap_line(PSTR("CREDIT_FLOW")
+      #if ENABLED(SERIAL_CREDIT_FLOW)
+        , true
+      #endif
+    );
+
   #endif // EXTENDED_CAPABILITIES_REPORT
 }
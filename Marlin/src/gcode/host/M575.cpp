@@ -0,0 +1,48 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(SERIAL_CREDIT_FLOW)
+
+#include "../gcode.h"
+#include "../queue.h"
+
+/**
+ * M575: Set or report credit flow control
+ *
+ *   S<bool> Optional. 1 to acknowledge lines cumulatively with
+ *           "ok N<line> R<bytes> B<slots>", 0 for an "ok" per line.
+ *
+ * The "ok" of M575 S1 is the first acknowledgment with credit.
+ */
+void GcodeSuite::M575() {
+  if (parser.seen('S'))
+    set_credit_flow(parser.value_bool());
+  else {
+    SERIAL_ECHO_START();
+    SERIAL_ECHOPAIR("M575 S", int(credit_flow));
+    SERIAL_ECHOLNPAIR(" RX buffer ", int(RX_BUFFER_SIZE));
+  }
+}
+
+#endif // SERIAL_CREDIT_FLOW
@@ -46,11 +46,7 @@ extern float destination[XYZE];
 /**
  * G0, G1: Coordinated movement of X Y Z E axes
  */
-void GcodeSuite::G0_G1(
-  #if IS_SCARA
-    bool fast_move/*=false*/
-  #endif
-) {
+void GcodeSuite::G0_G1() {
   if (IsRunning() && G0_G1_CONDITION) {
     get_destination_from_command(); // For X Y Z E F
 
@@ -72,9 +68,9 @@ void GcodeSuite::G0_G1(
     #endif // FWRETRACT
 
     #if IS_SCARA
-      fast_move ? prepare_uninterpolated_move_to_destination() : prepare_move_to_destination();
+      parser.codenum == 0 ? prepare_uninterpolated_move_to_destination() : start_move_to_destination(); // G0 is a fast move
     #else
-      prepare_move_to_destination();
+      start_move_to_destination();
     #endif
 
     #if ENABLED(NANODLP_Z_SYNC)
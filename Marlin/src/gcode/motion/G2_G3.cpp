@@ -27,6 +27,7 @@
 #include "../gcode.h"
 #include "../../module/motion.h"
 #include "../../module/planner.h"
+#include "../../module/segment_producer.h"
 #include "../../module/temperature.h"
 
 #if ENABLED(DELTA)
@@ -44,6 +45,94 @@
   #define N_ARC_CORRECTION 1
 #endif
 
+/**
+ * The segments of an arc, buffered one at a time by the segment feed.
+ * plan_arc() sets it up from the arc's geometry.
+ */
+class ArcProducer : public SegmentProducer {
+  public:
+    float target[XYZE], raw[XYZE], offset[2],
+          center_P, center_Q, r_P, r_Q,
+          theta_per_segment, linear_per_segment, extruder_per_segment,
+          sin_T, cos_T, fr_mm_s;
+    AxisEnum p_axis, q_axis, l_axis;
+    uint16_t i, segments;
+
+    #if N_ARC_CORRECTION > 1
+      int8_t arc_recalc_count;
+    #endif
+
+    #if ENABLED(SCARA_FEEDRATE_SCALING)
+      float inverse_secs, oldA, oldB;
+    #endif
+
+    bool next();
+};
+
+bool ArcProducer::next() {
+  if (++i < segments) { // Iterate (segments-1) times
+
+    #if N_ARC_CORRECTION > 1
+      if (--arc_recalc_count) {
+        // Apply vector rotation matrix to previous r_P / 1
+        const float r_new_Y = r_P * sin_T + r_Q * cos_T;
+        r_P = r_P * cos_T - r_Q * sin_T;
+        r_Q = r_new_Y;
+      }
+      else
+    #endif
+    {
+      #if N_ARC_CORRECTION > 1
+        arc_recalc_count = N_ARC_CORRECTION;
+      #endif
+
+      // Arc correction to radius vector. Computed only every N_ARC_CORRECTION increments.
+      // Compute exact location by applying transformation matrix from initial radius vector(=-offset).
+      // To reduce stuttering, the sin and cos could be computed at different times.
+      // For now, compute both at the same time.
+      const float cos_Ti = cos(i * theta_per_segment), sin_Ti = sin(i * theta_per_segment);
+      r_P = -offset[0] * cos_Ti + offset[1] * sin_Ti;
+      r_Q = -offset[0] * sin_Ti - offset[1] * cos_Ti;
+    }
+
+    // Update raw location
+    raw[p_axis] = center_P + r_P;
+    raw[q_axis] = center_Q + r_Q;
+    raw[l_axis] += linear_per_segment;
+    raw[E_AXIS] += extruder_per_segment;
+
+    clamp_to_software_endstops(raw);
+
+    #if ENABLED(SCARA_FEEDRATE_SCALING)
+      // For SCARA scale the feed rate from mm/s to degrees/s
+      // i.e., Complete the angular vector in the given time.
+      inverse_kinematics(raw);
+      ADJUST_DELTA(raw);
+      planner.buffer_segment(delta[A_AXIS], delta[B_AXIS], raw[Z_AXIS], raw[E_AXIS], HYPOT(delta[A_AXIS] - oldA, delta[B_AXIS] - oldB) * inverse_secs, active_extruder);
+      oldA = delta[A_AXIS]; oldB = delta[B_AXIS];
+    #else
+      planner.buffer_line_kinematic(raw, fr_mm_s, active_extruder);
+    #endif
+
+    return true;
+  }
+
+  // Ensure last segment arrives at target location.
+  #if ENABLED(SCARA_FEEDRATE_SCALING)
+    inverse_kinematics(target);
+    ADJUST_DELTA(target);
+    const float diff2 = HYPOT2(delta[A_AXIS] - oldA, delta[B_AXIS] - oldB);
+    if (diff2)
+      planner.buffer_segment(delta[A_AXIS], delta[B_AXIS], target[Z_AXIS], target[E_AXIS], SQRT(diff2) * inverse_secs, active_extruder);
+  #else
+    planner.buffer_line_kinematic(target, fr_mm_s, active_extruder);
+  #endif
+
+  return false;
+}
+
+static ArcProducer arc;
+
 /**
  * Plan an arc in 2 dimensions
  *
@@ -51,13 +140,25 @@
  * The length of each segment is configured in MM_PER_ARC_SEGMENT (Default 1mm)
  * Arcs should only be made relatively large (over 5mm), as larger arcs with
  * larger segments will tend to be more efficient. Your slicer should have
- * options for G2/G3 arc generation. In future these options may be GCode tunable.
+ * options for G2/G3 arc generation.
+ *
+ * With ARC_CHORD_TOLERANCE the segments are instead as long as they can be
+ * while staying within the chord tolerance (M214 P) of the true arc, so the
+ * count follows the radius: few segments for large arcs, more for small ones.
+ * They are made longer again if needed to last at least the minimum segment
+ * time (M214 S) at the arc's feedrate, so the planner can keep up.
+ *
+ * The segments are not buffered here. The arc is handed to the segment
+ * feed, which buffers them as the planner makes room.
  */
 void plan_arc(
   const float (&cart)[XYZE],  // Destination position
   const float (&offset)[2],   // Center of rotation relative to current_position
   const uint8_t clockwise     // Clockwise?
 ) {
+  // Only one arc is cut at a time
+  segment_feed.finish();
+
   #if ENABLED(CNC_WORKSPACE_PLANES)
     AxisEnum p_axis, q_axis, l_axis;
     switch (gcode.workspace_plane) {
@@ -94,8 +195,33 @@ void plan_arc(
               mm_of_travel = linear_travel ? HYPOT(flat_mm, linear_travel) : FABS(flat_mm);
   if (mm_of_travel < 0.001) return;
 
-  uint16_t segments = FLOOR(mm_of_travel / (MM_PER_ARC_SEGMENT));
-  if (segments == 0) segments = 1;
+  const float fr_mm_s = MMS_SCALED(feedrate_mm_s);
+
+  uint16_t segments;
+  #ifdef ARC_CHORD_TOLERANCE
+    const bool chordal = gcode.arc_chord_tolerance > 0;
+    if (chordal) {
+      // A chord over the angle T strays r * (1 - cos(T / 2)) from the arc at its middle.
+      // Keep at least 4 segments per circle.
+      const float tolerance = gcode.arc_chord_tolerance,
+                  max_theta = tolerance < radius * (1 - cos(RADIANS(45))) ? 2 * acos(1 - tolerance / radius) : RADIANS(90);
+      float count = CEIL(FABS(angular_travel) / max_theta);
+
+      // No shorter than the planner can handle at this feedrate
+      const float min_mm = fr_mm_s * gcode.arc_min_segment_time * 0.001;
+      if (min_mm * count > mm_of_travel) count = FLOOR(mm_of_travel / min_mm);
+
+      // ...but keep chords within 90°, so a small fast circle still gets 4 segments
+      NOLESS(count, CEIL(FABS(angular_travel) * (1.0f / RADIANS(90)) - 0.001f));
+
+      segments = constrain(count, 1, 65535);
+    }
+    else
+  #endif
+  {
+    segments = FLOOR(mm_of_travel / (MM_PER_ARC_SEGMENT));
+    if (segments == 0) segments = 1;
+  }
 
   /**
    * Vector rotation by transformation matrix: r is the original vector, r_T is the rotated vector,
@@ -123,97 +249,53 @@ void plan_arc(
    * a correction, the planner should have caught up to the lag caused by the initial plan_arc overhead.
    * This is important when there are successive arc motions.
    */
+  arc.theta_per_segment = angular_travel / segments;
+  arc.linear_per_segment = linear_travel / segments;
+  arc.extruder_per_segment = extruder_travel / segments;
+
   // Vector rotation matrix values
-  float raw[XYZE];
-  const float theta_per_segment = angular_travel / segments,
-              linear_per_segment = linear_travel / segments,
-              extruder_per_segment = extruder_travel / segments,
-              sin_T = theta_per_segment,
-              cos_T = 1 - 0.5 * sq(theta_per_segment); // Small angle approximation
+  #ifdef ARC_CHORD_TOLERANCE
+    // Chordal segments may be too long for the small angle approximation
+    arc.sin_T = chordal ? sin(arc.theta_per_segment) : arc.theta_per_segment;
+    arc.cos_T = chordal ? cos(arc.theta_per_segment) : 1 - 0.5 * sq(arc.theta_per_segment);
+  #else
+    arc.sin_T = arc.theta_per_segment;
+    arc.cos_T = 1 - 0.5 * sq(arc.theta_per_segment); // Small angle approximation
+  #endif
+
+  arc.p_axis = p_axis;
+  arc.q_axis = q_axis;
+  arc.l_axis = l_axis;
+  arc.center_P = center_P;
+  arc.center_Q = center_Q;
+  arc.r_P = r_P;
+  arc.r_Q = r_Q;
+  arc.offset[0] = offset[0];
+  arc.offset[1] = offset[1];
+  COPY(arc.target, cart);
+  arc.fr_mm_s = fr_mm_s;
+  arc.segments = segments;
+  arc.i = 0;
 
   // Initialize the linear axis
-  raw[l_axis] = current_position[l_axis];
+  arc.raw[l_axis] = current_position[l_axis];
 
   // Initialize the extruder axis
-  raw[E_AXIS] = current_position[E_AXIS];
-
-  const float fr_mm_s = MMS_SCALED(feedrate_mm_s);
-
-  millis_t next_idle_ms = millis() + 200UL;
+  arc.raw[E_AXIS] = current_position[E_AXIS];
 
   #if ENABLED(SCARA_FEEDRATE_SCALING)
     // SCARA needs to scale the feed rate from mm/s to degrees/s
-    const float inv_segment_length = 1.0 / (MM_PER_ARC_SEGMENT),
-                inverse_secs = inv_segment_length * fr_mm_s;
-    float oldA = planner.position_float[A_AXIS],
-          oldB = planner.position_float[B_AXIS];
+    const float inv_segment_length = segments / mm_of_travel;
+    arc.inverse_secs = inv_segment_length * fr_mm_s;
+    arc.oldA = planner.position_float[A_AXIS];
+    arc.oldB = planner.position_float[B_AXIS];
   #endif
 
   #if N_ARC_CORRECTION > 1
-    int8_t arc_recalc_count = N_ARC_CORRECTION;
+    arc.arc_recalc_count = N_ARC_CORRECTION;
   #endif
 
-  for (uint16_t i = 1; i < segments; i++) { // Iterate (segments-1) times
-
-    thermalManager.manage_heater();
-    if (ELAPSED(millis(), next_idle_ms)) {
-      next_idle_ms = millis() + 200UL;
-      idle();
-    }
-
-    #if N_ARC_CORRECTION > 1
-      if (--arc_recalc_count) {
-        // Apply vector rotation matrix to previous r_P / 1
-        const float r_new_Y = r_P * sin_T + r_Q * cos_T;
-        r_P = r_P * cos_T - r_Q * sin_T;
-        r_Q = r_new_Y;
-      }
-      else
-    #endif
-    {
-      #if N_ARC_CORRECTION > 1
-        arc_recalc_count = N_ARC_CORRECTION;
-      #endif
-
-      // Arc correction to radius vector. Computed only every N_ARC_CORRECTION increments.
-      // Compute exact location by applying transformation matrix from initial radius vector(=-offset).
-      // To reduce stuttering, the sin and cos could be computed at different times.
-      // For now, compute both at the same time.
-      const float cos_Ti = cos(i * theta_per_segment), sin_Ti = sin(i * theta_per_segment);
-      r_P = -offset[0] * cos_Ti + offset[1] * sin_Ti;
-      r_Q = -offset[0] * sin_Ti - offset[1] * cos_Ti;
-    }
-
-    // Update raw location
-    raw[p_axis] = center_P + r_P;
-    raw[q_axis] = center_Q + r_Q;
-    raw[l_axis] += linear_per_segment;
-    raw[E_AXIS] += extruder_per_segment;
-
-    clamp_to_software_endstops(raw);
-
-    #if ENABLED(SCARA_FEEDRATE_SCALING)
-      // For SCARA scale the feed rate from mm/s to degrees/s
-      // i.e., Complete the angular vector in the given time.
-      inverse_kinematics(raw);
-      ADJUST_DELTA(raw);
-      planner.buffer_segment(delta[A_AXIS], delta[B_AXIS], raw[Z_AXIS], raw[E_AXIS], HYPOT(delta[A_AXIS] - oldA, delta[B_AXIS] - oldB) * inverse_secs, active_extruder);
-      oldA = delta[A_AXIS]; oldB = delta[B_AXIS];
-    #else
-      planner.buffer_line_kinematic(raw, fr_mm_s, active_extruder);
-    #endif
-  }
-
-  // Ensure last segment arrives at target location.
-  #if ENABLED(SCARA_FEEDRATE_SCALING)
-    inverse_kinematics(cart);
-    ADJUST_DELTA(cart);
-    const float diff2 = HYPOT2(delta[A_AXIS] - oldA, delta[B_AXIS] - oldB);
-    if (diff2)
-      planner.buffer_segment(delta[A_AXIS], delta[B_AXIS], cart[Z_AXIS], cart[E_AXIS], SQRT(diff2) * inverse_secs, active_extruder);
-  #else
-    planner.buffer_line_kinematic(cart, fr_mm_s, active_extruder);
-  #endif
+  segment_feed.start(arc);
 
   // As far as the parser is concerned, the position is now == target. In reality the
   // motion control system might still be processing the action and the real tool position
@@ -247,8 +329,9 @@ void plan_arc(
  *    G2 I10           ; CW circle centered at X+10
  *    G3 X20 Y12 R14   ; CCW circle with r=14 ending at X20 Y12
  */
-void GcodeSuite::G2_G3(const bool clockwise) {
+void GcodeSuite::G2_G3() {
   if (MOTION_CONDITIONS) {
+    const bool clockwise = parser.codenum == 2;
 
     #if ENABLED(SF_ARC_FIX)
       const bool relative_mode_backup = relative_mode;
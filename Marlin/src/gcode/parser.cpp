@@ -54,12 +54,16 @@ int GCodeParser::codenum;
   uint8_t GCodeParser::subcode;
 #endif
 
-#if ENABLED(FASTER_GCODE_PARSER)
-  // Optimized Parameters
-  uint32_t GCodeParser::codebits;  // found bits
-  uint8_t GCodeParser::param[26];  // parameter offsets from command_ptr
-#else
-  char *GCodeParser::command_args; // start of parameters
+// Optimized Parameters
+uint32_t GCodeParser::codebits;  // found bits
+uint8_t GCodeParser::param[26];  // parameter offsets from command_ptr
+
+#if ENABLED(BINARY_GCODE_TRANSPORT)
+  bool GCodeParser::binary;
+  uint8_t GCodeParser::value_scale;
+  uint32_t GCodeParser::fixedbits, GCodeParser::finebits;
+  int32_t GCodeParser::bin_value[26];
+  char GCodeParser::bin_command[8];
 #endif
 
 // Create a global instance of the GCode parser singleton
@@ -78,9 +82,10 @@ void GCodeParser::reset() {
   #if USE_GCODE_SUBCODES
     subcode = 0;                        // No command sub-code
   #endif
-  #if ENABLED(FASTER_GCODE_PARSER)
-    codebits = 0;                       // No codes yet
-    //ZERO(param);                      // No parameters (should be safe to comment out this line)
+  codebits = 0;                         // No codes yet
+  //ZERO(param);                        // No parameters (should be safe to comment out this line)
+  #if ENABLED(BINARY_GCODE_TRANSPORT)
+    binary = false;                     // Values are text
   #endif
 }
 
@@ -95,9 +100,7 @@ void GCodeParser::parse(char *p) {
 
   // Skip N[-0-9] if included in the command line
   if (*p == 'N' && NUMERIC_SIGNED(p[1])) {
-    #if ENABLED(FASTER_GCODE_PARSER)
-      //set('N', p + 1);     // (optional) Set the 'N' parameter value
-    #endif
+    //set('N', p + 1);       // (optional) Set the 'N' parameter value
     p += 2;                  // skip N[-0-9]
     while (NUMERIC(*p)) ++p; // skip [0-9]*
     while (*p == ' ')   ++p; // skip [ ]*
@@ -150,10 +153,6 @@ void GCodeParser::parse(char *p) {
 
   // The command parameters (if any) start here, for sure!
 
-  #if DISABLED(FASTER_GCODE_PARSER)
-    command_args = p; // Scan for parameters in seen()
-  #endif
-
   // Only use string_arg for these M codes
   if (letter == 'M') switch (codenum) { case 23: case 28: case 30: case 117: case 118: case 928: string_arg = p; return; default: break; }
 
@@ -182,13 +181,7 @@ void GCodeParser::parse(char *p) {
     }
 
     // Arguments MUST be uppercase for fast GCode parsing
-    #if ENABLED(FASTER_GCODE_PARSER)
-      #define PARAM_TEST WITHIN(code, 'A', 'Z')
-    #else
-      #define PARAM_TEST true
-    #endif
-
-    if (PARAM_TEST) {
+    if (WITHIN(code, 'A', 'Z')) {
 
       while (*p == ' ') p++;                    // Skip spaces between parameters & values
 
@@ -213,9 +206,7 @@ void GCodeParser::parse(char *p) {
         if (debug) SERIAL_EOL();
       #endif
 
-      #if ENABLED(FASTER_GCODE_PARSER)
-        set(code, has_num ? p : NULL);          // Set parameter exists and pointer (NULL for no number)
-      #endif
+      set(code, has_num ? p : NULL);            // Set parameter exists and pointer (NULL for no number)
     }
     else if (!string_arg) {                     // Not A-Z? First time, keep as the string_arg
       string_arg = p - 1;
@@ -231,20 +222,178 @@ void GCodeParser::parse(char *p) {
   }
 }
 
+#if ENABLED(SERIAL_LINE_TOKENS)
+
+  /**
+   * Tokenize a line with the same rules as parse(), for a line that's queued
+   * while another command may be using the parser. Return false if the line
+   * needs a full parse(). With a leading N also get the line number.
+   */
+  bool GCodeParser::tokenize(const char * const line, gcode_tokens_t &tokens, long &line_number) {
+    const char *p = line;
+
+    // Get N[-0-9] if included in the command line
+    if (*p == 'N' && NUMERIC_SIGNED(p[1])) {
+      const bool negative = p[1] == '-';
+      p += NUMERIC(p[1]) ? 1 : 2;
+      long n = 0;
+      while (NUMERIC(*p)) n = n * 10 + *p++ - '0';
+      line_number = negative ? -n : n;
+      while (*p == ' ') ++p;
+    }
+
+    // The command letter must be G, M, or T, with a code number
+    const char * const command = p;
+    const char letter = *p++;
+    switch (letter) { case 'G': case 'M': case 'T': break; default: return false; }
+    while (*p == ' ') p++;
+    if (!NUMERIC(*p)) return false;
+
+    uint16_t code = 0;
+    do {
+      code = code * 10 + *p++ - '0';
+    } while (NUMERIC(*p));
+
+    #if USE_GCODE_SUBCODES
+      tokens.subcode = 0;
+      if (*p == '.') {
+        p++;
+        while (NUMERIC(*p)) tokens.subcode = tokens.subcode * 10 + *p++ - '0';
+      }
+    #endif
+
+    // Codes with a string argument need parse()
+    if (letter == 'M') switch (code) { case 23: case 28: case 30: case 32: case 117: case 118: case 928: return false; default: break; }
+
+    while (*p == ' ') p++;
+
+    // Every parameter must be A-Z with a value, up to the '*' or the end
+    uint32_t bits = 0;
+    for (;;) {
+      const char c = *p;
+      if (!c || c == '*') break;
+      if (!WITHIN(c, 'A', 'Z')) return false;
+      p++;
+      while (*p == ' ') p++;
+      if (!valid_float(p)) return false;
+      const uint8_t ind = LETTER_BIT(c);
+      SBI32(bits, ind);
+      tokens.param[ind] = p - command;
+      if (!WITHIN(*p, 'A', 'Z')) {
+        while (DECIMAL_SIGNED(*p)) p++;
+        while (*p == ' ') p++;
+      }
+    }
+
+    // Drop the '*' and the spaces before it. Keep trailing spaces otherwise.
+    if (*p == '*') while (p[-1] == ' ') p--;
+
+    tokens.letter = letter;
+    tokens.command = command - line;
+    tokens.end = p - line;
+    tokens.codenum = code;
+    tokens.codebits = bits;
+    return true;
+  }
+
+  // Populate all fields from a tokenized line
+  void GCodeParser::parse_tokens(char * const line, const gcode_tokens_t &tokens) {
+    reset();
+    command_ptr = line + tokens.command;
+    line[tokens.end] = '\0';             // Nullify asterisk and trailing whitespace
+    command_letter = tokens.letter;
+    codenum = tokens.codenum;
+    #if USE_GCODE_SUBCODES
+      subcode = tokens.subcode;
+    #endif
+    codebits = tokens.codebits;
+    COPY(param, tokens.param);
+  }
+
+#endif // SERIAL_LINE_TOKENS
+
+#if ENABLED(BINARY_GCODE_TRANSPORT)
+
+  /**
+   * Populate all fields from a binary record. Values are kept
+   * as they came and only scaled when they're fetched.
+   */
+  void GCodeParser::parse_binary(const uint8_t *data) {
+
+    reset(); // No codes to report
+
+    // Nothing is read past the record's length
+    const uint8_t * const end = data + 1 + data[0];
+    data++;
+
+    if (end - data >= 3) {
+      const uint8_t header = data[0];
+      command_letter = header & 0x02 ? 'T' : header & 0x01 ? 'M' : 'G';
+      codenum = data[1] | (data[2] << 8);
+      data += 3;
+      if (TEST(header, 2) && data < end) {
+        #if USE_GCODE_SUBCODES
+          subcode = *data;
+        #endif
+        data++;
+      }
+    }
+    else
+      data = end; // Too short for a command. Runs as unknown.
+
+    // Keep the letter and code as text, for echo and errors
+    char *p = bin_command;
+    *p++ = command_letter;
+    uint16_t c = codenum, d = 10000;
+    while (d > 1 && c < d) d /= 10;
+    for (; d; d /= 10) *p++ = '0' + (c / d) % 10;
+    *p = '\0';
+    command_ptr = bin_command;
+    string_arg = p;                     // Empty, for codes expecting a string
+
+    binary = true;
+    fixedbits = finebits = 0;
+    while (data < end) {
+      const uint8_t spec = *data++, ind = spec & 0x1F, format = spec >> 5;
+      uint8_t size;
+      switch (format) {
+        case BINARY_NONE: size = 0; break;
+        case BINARY_INT8: size = 1; break;
+        case BINARY_INT16: case BINARY_INT16_MILLI: case BINARY_INT16_FINE: size = 2; break;
+        default: size = 4; break;
+      }
+      if (end - data < size) break;       // A value cut off by the end of the record is dropped
+      int32_t v = 0;
+      switch (size) {
+        case 1: v = (int8_t)data[0]; break;
+        case 2: v = (int16_t)(data[0] | (data[1] << 8)); break;
+        case 4: v = (int32_t)((uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24)); break;
+      }
+      data += size;
+      if (ind >= COUNT(param)) continue;  // Only A-Z
+      SBI32(codebits, ind);               // parameter exists
+      param[ind] = format != BINARY_NONE; // has a value
+      bin_value[ind] = v;
+      switch (format) {
+        case BINARY_INT16_FINE: case BINARY_INT32_FINE: SBI32(finebits, ind); // no break
+        case BINARY_INT16_MILLI: case BINARY_INT32_MILLI: SBI32(fixedbits, ind);
+        default: break;
+      }
+    }
+  }
+
+#endif // BINARY_GCODE_TRANSPORT
+
 #if ENABLED(CNC_COORDINATE_SYSTEMS)
 
   // Parse the next parameter as a new command
   bool GCodeParser::chain() {
-    #if ENABLED(FASTER_GCODE_PARSER)
-      char *next_command = command_ptr;
-      if (next_command) {
-        while (*next_command && *next_command != ' ') ++next_command;
-        while (*next_command == ' ') ++next_command;
-        if (!*next_command) next_command = NULL;
-      }
-    #else
-      const char *next_command = command_args;
-    #endif
+    char *next_command = command_ptr;
+    if (next_command) {
+      while (*next_command && *next_command != ' ') ++next_command;
+      while (*next_command == ' ') ++next_command;
+      if (!*next_command) next_command = NULL;
+    }
     if (next_command) parse(next_command);
     return !!next_command;
   }
@@ -261,6 +410,21 @@ void GCodeParser::unknown_command_error() {
   SERIAL_EOL_P(port);
 }
 
+#if ENABLED(STRICT_GCODE_PARAMETERS)
+
+  void GCodeParser::unknown_parameter_error(const char c) {
+    #if NUM_SERIAL > 1
+      const int16_t port = command_queue_port[cmd_queue_index_r];
+    #endif
+    SERIAL_ECHO_START_P(port);
+    SERIAL_ECHOPAIR_P(port, MSG_UNKNOWN_PARAMETER, c);
+    SERIAL_ECHOPAIR_P(port, MSG_UNKNOWN_PARAMETER_IN, command_ptr);
+    SERIAL_CHAR_P(port, '"');
+    SERIAL_EOL_P(port);
+  }
+
+#endif // STRICT_GCODE_PARAMETERS
+
 #if ENABLED(DEBUG_GCODE_PARSER)
 
   void GCodeParser::debug() {
@@ -268,13 +432,9 @@ void GCodeParser::unknown_command_error() {
     SERIAL_ECHOPAIR(" (", command_letter);
     SERIAL_ECHO(codenum);
     SERIAL_ECHOLNPGM(")");
-    #if ENABLED(FASTER_GCODE_PARSER)
-      SERIAL_ECHOPGM(" args: \"");
-      for (char c = 'A'; c <= 'Z'; ++c)
-        if (seen(c)) { SERIAL_CHAR(c); SERIAL_CHAR(' '); }
-    #else
-      SERIAL_ECHOPAIR(" args: \"", command_args);
-    #endif
+    SERIAL_ECHOPGM(" args: \"");
+    for (char c = 'A'; c <= 'Z'; ++c)
+      if (seen(c)) { SERIAL_CHAR(c); SERIAL_CHAR(' '); }
     SERIAL_CHAR('"');
     if (string_arg) {
       SERIAL_ECHOPGM(" string: \"");
@@ -36,13 +36,32 @@
   #include "../libs/hex_print_routines.h"
 #endif
 
+#if ENABLED(SERIAL_LINE_TOKENS)
+  /**
+   * A text line tokenized by GCodeParser::tokenize() when it was queued, with
+   * the fields parse() would set, so parsing it is just a copy. Lines it can't
+   * give the same result for (string arguments, parameters without a value,
+   * lowercase or other characters) have no letter and get a full parse().
+   */
+  typedef struct {
+    char letter;                // G, M or T, or 0 to parse() the text
+    uint8_t command,            // Offset of the command letter in the line
+            end;                // Offset after the command, before '*' and trailing spaces
+    uint16_t codenum;
+    #if USE_GCODE_SUBCODES
+      uint8_t subcode;
+    #endif
+    uint32_t codebits;          // As GCodeParser::codebits
+    uint8_t param[26];          // As GCodeParser::param, offsets from the command letter
+  } gcode_tokens_t;
+#endif
+
 /**
  * GCode parser
  *
  *  - Parse a single gcode line for its letter, code, subcode, and parameters
- *  - FASTER_GCODE_PARSER:
- *    - Flags existing params (1 bit each)
- *    - Stores value offsets (1 byte each)
+ *  - Flag existing params (1 bit each)
+ *  - Store value offsets (1 byte each)
  *  - Provide accessors for parameters:
  *    - Parameter exists
  *    - Parameter has value
@@ -52,12 +71,19 @@ class GCodeParser {
 
 private:
   static char *value_ptr;           // Set by seen, used to fetch the value
+  #if ENABLED(BINARY_GCODE_TRANSPORT)
+    static uint8_t value_scale;     // Set by seen, the binary value is 0:whole, 1:thousandths, 2:hundred-thousandths
+  #endif
 
-  #if ENABLED(FASTER_GCODE_PARSER)
-    static uint32_t codebits;       // Parameters pre-scanned
-    static uint8_t param[26];       // For A-Z, offsets into command args
-  #else
-    static char *command_args;      // Args start here, for slow scan
+  static uint32_t codebits;         // Parameters pre-scanned
+  static uint8_t param[26];         // For A-Z, offsets into command args
+
+  #if ENABLED(BINARY_GCODE_TRANSPORT)
+    static bool binary;             // Values came pre-parsed in a binary record
+    static uint32_t fixedbits,      // Values given in thousandths...
+                    finebits;       // ...or in hundred-thousandths
+    static int32_t bin_value[26];   // For A-Z, values from the record
+    static char bin_command[8];     // The command letter and code, to echo
   #endif
 
 public:
@@ -85,7 +111,7 @@ public:
   #endif
 
   #if ENABLED(DEBUG_GCODE_PARSER)
-    void debug();
+    static void debug();
   #endif
 
   // Reset is done before parsing
@@ -101,61 +127,50 @@ public:
     return valid_signless(p) || ((p[0] == '-' || p[0] == '+') && valid_signless(&p[1])); // [-+]?.?[0-9]
   }
 
-  #if ENABLED(FASTER_GCODE_PARSER)
+  FORCE_INLINE static bool valid_int(const char * const p) {
+    return NUMERIC(p[0]) || ((p[0] == '-' || p[0] == '+') && NUMERIC(p[1])); // [-+]?[0-9]
+  }
 
-    FORCE_INLINE static bool valid_int(const char * const p) {
-      return NUMERIC(p[0]) || ((p[0] == '-' || p[0] == '+') && NUMERIC(p[1])); // [-+]?[0-9]
-    }
+  // Set the flag and pointer for a parameter
+  static void set(const char c, char * const ptr) {
+    const uint8_t ind = LETTER_BIT(c);
+    if (ind >= COUNT(param)) return;           // Only A-Z
+    SBI32(codebits, ind);                      // parameter exists
+    param[ind] = ptr ? ptr - command_ptr : 0;  // parameter offset or 0
+    #if ENABLED(DEBUG_GCODE_PARSER)
+      if (codenum == 800) {
+        SERIAL_ECHOPAIR("Set bit ", (int)ind);
+        SERIAL_ECHOPAIR(" of codebits (", hex_address((void*)(codebits >> 16)));
+        print_hex_word((uint16_t)(codebits & 0xFFFF));
+        SERIAL_ECHOLNPAIR(") | param = ", (int)param[ind]);
+      }
+    #endif
+  }
 
-    // Set the flag and pointer for a parameter
-    static void set(const char c, char * const ptr) {
-      const uint8_t ind = LETTER_BIT(c);
-      if (ind >= COUNT(param)) return;           // Only A-Z
-      SBI32(codebits, ind);                      // parameter exists
-      param[ind] = ptr ? ptr - command_ptr : 0;  // parameter offset or 0
-      #if ENABLED(DEBUG_GCODE_PARSER)
-        if (codenum == 800) {
-          SERIAL_ECHOPAIR("Set bit ", (int)ind);
-          SERIAL_ECHOPAIR(" of codebits (", hex_address((void*)(codebits >> 16)));
-          print_hex_word((uint16_t)(codebits & 0xFFFF));
-          SERIAL_ECHOLNPAIR(") | param = ", (int)param[ind]);
+  // Code seen bit was set. If not found, value_ptr is unchanged.
+  // This allows "if (seen('A')||seen('B'))" to use the last-found value.
+  static bool seen(const char c) {
+    const uint8_t ind = LETTER_BIT(c);
+    if (ind >= COUNT(param)) return false; // Only A-Z
+    const bool b = TEST32(codebits, ind);
+    if (b) {
+      #if ENABLED(BINARY_GCODE_TRANSPORT)
+        if (binary) {
+          // value_ptr points at the binary value, not text
+          value_ptr = param[ind] ? (char*)&bin_value[ind] : (char*)NULL;
+          value_scale = TEST32(finebits, ind) ? 2 : TEST32(fixedbits, ind) ? 1 : 0;
+          return b;
         }
       #endif
+      char * const ptr = command_ptr + param[ind];
+      value_ptr = param[ind] && valid_float(ptr) ? ptr : (char*)NULL;
     }
+    return b;
+  }
 
-    // Code seen bit was set. If not found, value_ptr is unchanged.
-    // This allows "if (seen('A')||seen('B'))" to use the last-found value.
-    static bool seen(const char c) {
-      const uint8_t ind = LETTER_BIT(c);
-      if (ind >= COUNT(param)) return false; // Only A-Z
-      const bool b = TEST32(codebits, ind);
-      if (b) {
-        char * const ptr = command_ptr + param[ind];
-        value_ptr = param[ind] && valid_float(ptr) ? ptr : (char*)NULL;
-      }
-      return b;
-    }
-
-    static bool seen_any() { return !!codebits; }
-
-    #define SEEN_TEST(L) TEST32(codebits, LETTER_BIT(L))
-
-  #else // !FASTER_GCODE_PARSER
-
-    // Code is found in the string. If not found, value_ptr is unchanged.
-    // This allows "if (seen('A')||seen('B'))" to use the last-found value.
-    static bool seen(const char c) {
-      const char *p = strchr(command_args, c);
-      const bool b = !!p;
-      if (b) value_ptr = valid_float(&p[1]) ? &p[1] : (char*)NULL;
-      return b;
-    }
-
-    static bool seen_any() { return *command_args == '\0'; }
-
-    #define SEEN_TEST(L) !!strchr(command_args, L)
+  static bool seen_any() { return !!codebits; }
 
-  #endif // !FASTER_GCODE_PARSER
+  #define SEEN_TEST(L) TEST32(codebits, LETTER_BIT(L))
 
   // Seen any axis parameter
   static bool seen_axis() {
@@ -166,6 +181,37 @@ public:
   // This uses 54 bytes of SRAM to speed up seen/value
   static void parse(char * p);
 
+  #if ENABLED(SERIAL_LINE_TOKENS)
+    // Tokenize a line for parse_tokens() without changing the parser state
+    static bool tokenize(const char * const line, gcode_tokens_t &tokens, long &line_number);
+
+    // Populate all fields from a tokenized line
+    static void parse_tokens(char * const line, const gcode_tokens_t &tokens);
+  #endif
+
+  #if ENABLED(BINARY_GCODE_TRANSPORT)
+    /**
+     * Populate all fields from a binary record, preceded by its length:
+     *
+     *   header: bits 0-1 letter (0=G 1=M 2=T), bit 2 a subcode byte follows the code
+     *   code:   uint16
+     *   params: bits 0-4 letter (0=A ... 25=Z), bits 5-7 BinaryFormat, then the value
+     *
+     * Multi-byte values are LSB first.
+     */
+    enum BinaryFormat : uint8_t {
+      BINARY_NONE,          // No value
+      BINARY_INT8,
+      BINARY_INT16,
+      BINARY_INT32,
+      BINARY_INT16_MILLI,   // Thousandths
+      BINARY_INT32_MILLI,
+      BINARY_INT32_FINE,    // Hundred-thousandths
+      BINARY_INT16_FINE
+    };
+    static void parse_binary(const uint8_t * data);
+  #endif
+
   #if ENABLED(CNC_COORDINATE_SYSTEMS)
     // Parse the next parameter as a new command
     static bool chain();
@@ -177,8 +223,24 @@ public:
   // Seen a parameter with a value
   inline static bool seenval(const char c) { return seen(c) && has_value(); }
 
+  #if ENABLED(BINARY_GCODE_TRANSPORT)
+    FORCE_INLINE static int32_t value_binary() { return *(int32_t*)value_ptr; }
+    FORCE_INLINE static float value_binary_float() {
+      const int32_t v = value_binary();
+      return value_scale == 2 ? v / 100000.0f : value_scale ? v / 1000.0f : (float)v;
+    }
+    FORCE_INLINE static int32_t value_binary_long() {
+      const int32_t v = value_binary();
+      return value_scale == 2 ? v / 100000L : value_scale ? v / 1000L : v;
+    }
+    #define BINARY_VALUE(V) if (binary) return value_ptr ? (V) : 0
+  #else
+    #define BINARY_VALUE(V) NOOP
+  #endif
+
   // Float removes 'E' to prevent scientific notation interpretation
   inline static float value_float() {
+    BINARY_VALUE(value_binary_float());
     if (value_ptr) {
       char *e = value_ptr;
       for (;;) {
@@ -198,8 +260,14 @@ public:
   }
 
   // Code value as a long or ulong
-  inline static int32_t value_long() { return value_ptr ? strtol(value_ptr, NULL, 10) : 0L; }
-  inline static uint32_t value_ulong() { return value_ptr ? strtoul(value_ptr, NULL, 10) : 0UL; }
+  inline static int32_t value_long() {
+    BINARY_VALUE(value_binary_long());
+    return value_ptr ? strtol(value_ptr, NULL, 10) : 0L;
+  }
+  inline static uint32_t value_ulong() {
+    BINARY_VALUE(uint32_t(value_binary_long()));
+    return value_ptr ? strtoul(value_ptr, NULL, 10) : 0UL;
+  }
 
   // Code value for use as time
   FORCE_INLINE static millis_t value_millis() { return value_ulong(); }
@@ -307,6 +375,16 @@ public:
 
   void unknown_command_error();
 
+  #if ENABLED(STRICT_GCODE_PARAMETERS)
+    // The first parameter not among the given letters (bit 0 = A), or 0 if none
+    static char unknown_parameter(const uint32_t accepted) {
+      const uint32_t bits = codebits & ~accepted;
+      if (bits) for (uint8_t i = 0; i < COUNT(param); i++) if (TEST32(bits, i)) return 'A' + i;
+      return 0;
+    }
+    static void unknown_parameter_error(const char c);
+  #endif
+
   // Provide simple value accessors with default option
   FORCE_INLINE static float    floatval(const char c, const float dval=0.0)   { return seenval(c) ? value_float()        : dval; }
   FORCE_INLINE static bool     boolval(const char c)                          { return seenval(c) ? value_bool()         : seen(c); }
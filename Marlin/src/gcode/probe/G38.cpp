@@ -97,7 +97,9 @@ static bool G38_run_probe() {
  *
  * Like G28 except uses Z min probe for all axes
  */
-void GcodeSuite::G38(const bool is_38_2) {
+void GcodeSuite::G38() {
+  const bool is_38_2 = parser.subcode == 2;
+
   // Get X Y Z E F
   get_destination_from_command();
 
@@ -41,6 +41,10 @@
   #include "../feature/power_loss_recovery.h"
 #endif
 
+#if ENABLED(CODE_PROFILER)
+  #include "../feature/profiler.h"
+#endif
+
 /**
  * GCode line number handling. Hosts may opt to include line numbers when
  * sending commands to Marlin, and lines will be checked for sequentiality.
@@ -70,6 +74,18 @@ char command_queue[BUFSIZE][MAX_CMD_SIZE];
   int16_t command_queue_port[BUFSIZE];
 #endif
 
+#if ENABLED(BINARY_GCODE_TRANSPORT)
+  bool command_queue_binary[BUFSIZE]; // The entry holds a binary record. Cleared when it's dequeued.
+#endif
+
+#if ENABLED(SERIAL_LINE_TOKENS)
+  gcode_tokens_t command_queue_tokens[BUFSIZE]; // Serial lines tokenized when they were read. Cleared when they're dequeued.
+#endif
+
+#if ENABLED(POWER_LOSS_RECOVERY)
+  static uint32_t command_queue_sdpos[BUFSIZE]; // Where the SD file resumes after each command from it, or 0. Cleared when it's dequeued.
+#endif
+
 /**
  * Serial command injection
  */
@@ -77,8 +93,37 @@ char command_queue[BUFSIZE][MAX_CMD_SIZE];
 // Number of characters read in the current line of serial input
 static int serial_count[NUM_SERIAL] = { 0 };
 
+/**
+ * The line being read from serial. With one port it's assembled in place,
+ * in a free slot of the queue, and it's usually the write slot when it's
+ * committed. Otherwise each port has a buffer.
+ */
+#if NUM_SERIAL > 1
+  static char serial_line_buffer[NUM_SERIAL][MAX_CMD_SIZE];
+  #define SERIAL_LINE(P) serial_line_buffer[P]
+#else
+  static uint8_t serial_slot;
+  #define SERIAL_LINE(P) command_queue[serial_slot]
+#endif
+
 bool send_ok[BUFSIZE];
 
+#if ENABLED(SERIAL_CREDIT_FLOW)
+  bool credit_flow; // = false
+
+  static uint16_t command_queue_bytes[BUFSIZE], // Serial bytes of each queued line, out of the RX buffer until it runs
+                  serial_line_bytes,            // Serial bytes of the line being read
+                  credit_held,                  // Sum of command_queue_bytes
+                  credit_unnumbered;            // Bytes of the unnumbered lines run since line credit_N
+  static long credit_N;                         // Line number of the last numbered line run
+  static uint8_t credit_lines;                  // Lines run since the last acknowledgment
+#endif
+
+#define HAS_COMMAND_QUEUE_N (ENABLED(SERIAL_CREDIT_FLOW) || (ENABLED(BINARY_GCODE_TRANSPORT) && ENABLED(ADVANCED_OK)))
+#if HAS_COMMAND_QUEUE_N
+  static long command_queue_N[BUFSIZE];         // Line number of each queued serial line, for its acknowledgment
+#endif
+
 /**
  * Next Injected Command pointer. NULL if no commands are being injected.
  * Used by Marlin internally to ensure that commands initiated from within
@@ -96,6 +141,19 @@ void queue_setup() {
  */
 void clear_command_queue() {
   cmd_queue_index_r = cmd_queue_index_w = commands_in_queue = 0;
+  #if ENABLED(BINARY_GCODE_TRANSPORT)
+    ZERO(command_queue_binary);
+  #endif
+  #if ENABLED(SERIAL_LINE_TOKENS)
+    for (uint8_t i = 0; i < BUFSIZE; i++) command_queue_tokens[i].letter = 0;
+  #endif
+  #if ENABLED(POWER_LOSS_RECOVERY)
+    ZERO(command_queue_sdpos);
+  #endif
+  #if ENABLED(SERIAL_CREDIT_FLOW)
+    ZERO(command_queue_bytes);
+    credit_held = 0;
+  #endif
 }
 
 /**
@@ -110,10 +168,37 @@ inline void _commit_command(bool say_ok
   #if NUM_SERIAL > 1
     command_queue_port[cmd_queue_index_w] = port;
   #endif
+  #if HAS_COMMAND_QUEUE_N
+    if (say_ok) command_queue_N[cmd_queue_index_w] = gcode_LastN;
+  #endif
+  #if ENABLED(SERIAL_CREDIT_FLOW)
+    // Only serial lines say "ok", and they hold their bytes until they run
+    if (say_ok) {
+      command_queue_bytes[cmd_queue_index_w] = serial_line_bytes;
+      credit_held += serial_line_bytes;
+      serial_line_bytes = 0;
+    }
+  #endif
   if (++cmd_queue_index_w >= BUFSIZE) cmd_queue_index_w = 0;
   commands_in_queue++;
 }
 
+/**
+ * Make sure the write slot is free for a command. A partial serial line
+ * in the slot moves on to the next one, if there's room.
+ */
+static bool free_write_slot() {
+  #if NUM_SERIAL == 1
+    if (serial_count[0] && serial_slot == cmd_queue_index_w) {
+      if (commands_in_queue >= BUFSIZE - 1) return false;
+      serial_slot = cmd_queue_index_w + 1 < BUFSIZE ? cmd_queue_index_w + 1 : 0;
+      memcpy(command_queue[serial_slot], command_queue[cmd_queue_index_w], serial_count[0]);
+      return true;
+    }
+  #endif
+  return commands_in_queue < BUFSIZE;
+}
+
 /**
  * Copy a command from RAM into the main command buffer.
  * Return true if the command was successfully added.
@@ -124,7 +209,7 @@ inline bool _enqueuecommand(const char* cmd, bool say_ok=false
     , int16_t port = -1
   #endif
 ) {
-  if (*cmd == ';' || commands_in_queue >= BUFSIZE) return false;
+  if (*cmd == ';' || !free_write_slot()) return false;
   strcpy(command_queue[cmd_queue_index_w], cmd);
   _commit_command(say_ok
     #if NUM_SERIAL > 1
@@ -209,9 +294,18 @@ void ok_to_send() {
     if (port < 0) return;
   #endif
   if (!send_ok[cmd_queue_index_r]) return;
+  #if ENABLED(SERIAL_CREDIT_FLOW)
+    if (credit_flow) return; // Credited as the line leaves the queue
+  #endif
   SERIAL_PROTOCOLPGM_P(port, MSG_OK);
   #if ENABLED(ADVANCED_OK)
     char* p = command_queue[cmd_queue_index_r];
+    #if ENABLED(BINARY_GCODE_TRANSPORT)
+      if (command_queue_binary[cmd_queue_index_r]) {
+        SERIAL_PROTOCOLPAIR_P(port, " N", command_queue_N[cmd_queue_index_r]);
+      }
+      else
+    #endif
     if (*p == 'N') {
       SERIAL_PROTOCOL_P(port, ' ');
       SERIAL_ECHO_P(port, *p++);
@@ -224,6 +318,49 @@ void ok_to_send() {
   SERIAL_EOL_P(port);
 }
 
+#if ENABLED(SERIAL_CREDIT_FLOW)
+
+  void set_credit_flow(const bool enable) {
+    credit_flow = enable;
+    credit_lines = credit_unnumbered = 0;
+  }
+
+  /**
+   * Count a serial line that has run toward the next acknowledgment, whether
+   * its handler said "ok" or printed its own (M105). A numbered line moves N
+   * on. An unnumbered line leaves N alone, so its bytes go into R instead.
+   */
+  static void credit_line(const uint8_t index) {
+    if (command_queue[index][0] == 'N'
+      #if ENABLED(BINARY_GCODE_TRANSPORT)
+        || command_queue_binary[index]
+      #endif
+    ) {
+      credit_N = command_queue_N[index];
+      credit_unnumbered = 0;
+    }
+    else
+      credit_unnumbered += command_queue_bytes[index];
+    credit_lines++;
+  }
+
+  /**
+   * Acknowledge the lines run since the last acknowledgment. While the
+   * queue stays full and more lines wait in the RX buffer the host has
+   * nothing to gain from it, so it's held back for up to half a queue.
+   */
+  static void send_credit() {
+    if (!credit_lines) return;
+    if (commands_in_queue >= BUFSIZE - 1 && MYSERIAL0.available() && credit_lines < (BUFSIZE + 1) / 2) return;
+    credit_lines = 0;
+    SERIAL_PROTOCOLPGM(MSG_OK);
+    SERIAL_PROTOCOLPAIR(" N", credit_N);
+    SERIAL_PROTOCOLPAIR(" R", int32_t(RX_BUFFER_SIZE - 1) + credit_held + serial_line_bytes + credit_unnumbered);
+    SERIAL_PROTOCOLLNPAIR(" B", BUFSIZE - commands_in_queue);
+  }
+
+#endif // SERIAL_CREDIT_FLOW
+
 /**
  * Send a "Resend: nnn" message to the host to
  * indicate that a command needs to be re-sent.
@@ -236,6 +373,10 @@ void flush_and_request_resend() {
   SERIAL_FLUSH_P(port);
   SERIAL_PROTOCOLPGM_P(port, MSG_RESEND);
   SERIAL_PROTOCOLLN_P(port, gcode_LastN + 1);
+  #if ENABLED(SERIAL_CREDIT_FLOW)
+    serial_line_bytes = 0; // Flushed with the RX buffer
+    if (credit_flow) return;
+  #endif
   ok_to_send();
 }
 
@@ -265,14 +406,123 @@ static int read_serial(const int index) {
   }
 }
 
+#if DISABLED(EMERGENCY_PARSER)
+
+  /**
+   * Process critical commands early, as they're read
+   * from serial, before the commands queued ahead of them
+   */
+  static void process_critical_command(const uint16_t mcode) {
+    switch (mcode) {
+      case 108:
+        wait_for_heatup = false;
+        #if ENABLED(ULTIPANEL)
+          wait_for_user = false;
+        #endif
+        break;
+      case 112: kill(PSTR(MSG_KILLED)); break;
+      case 410: quickstop_stepper(); break;
+    }
+  }
+
+#endif
+
+#if ENABLED(BINARY_GCODE_TRANSPORT)
+
+  /**
+   * Check a complete binary frame from serial and queue its record.
+   * Errors ask for the frame to be sent again, like bad text lines.
+   */
+  static void enqueue_binary_frame(const uint8_t * const frame, const uint8_t port) {
+    const uint8_t len = frame[1];
+    uint16_t crc = 0;
+    crc16(&crc, &frame[1], len + 2);
+    if (crc != (frame[len + 3] | (frame[len + 4] << 8)))
+      return gcode_line_error(PSTR(MSG_ERR_CHECKSUM_MISMATCH), port);
+
+    gcode_N = gcode_LastN + 1;
+    if (frame[2] != (uint8_t)gcode_N)
+      return gcode_line_error(PSTR(MSG_ERR_LINE_NO), port);
+
+    if (len < 3
+      #if ENABLED(SDSUPPORT)
+        || card.saving
+      #endif
+    ) return gcode_line_error(PSTR(MSG_ERR_BINARY_FRAME), port);
+
+    gcode_LastN = gcode_N;
+
+    const uint8_t * const record = &frame[3];
+    const char letter = record[0] & 0x02 ? 'T' : record[0] & 0x01 ? 'M' : 'G';
+    const uint16_t codenum = record[1] | (record[2] << 8);
+
+    // Movement commands alert when stopped
+    if (IsStopped() && letter == 'G' && codenum <= 3) {
+      SERIAL_ERRORLNPGM_P(port, MSG_ERR_STOPPED);
+      LCD_MESSAGEPGM(MSG_STOPPED);
+    }
+
+    #if DISABLED(EMERGENCY_PARSER)
+      if (letter == 'M') process_critical_command(codenum);
+    #endif
+
+    // Add the record to the queue, after its length. The frame may be in the same slot.
+    char * const command = command_queue[cmd_queue_index_w];
+    command[0] = len;
+    memmove(&command[1], record, len);
+    command_queue_binary[cmd_queue_index_w] = true;
+    _commit_command(true
+      #if NUM_SERIAL > 1
+        , port
+      #endif
+    );
+  }
+
+#endif // BINARY_GCODE_TRANSPORT
+
+// The checksum of the line being read from serial
+static uint8_t serial_checksum[NUM_SERIAL],      // XOR of the characters so far...
+               serial_star_checksum[NUM_SERIAL], // ...and up to the last '*'
+               serial_star[NUM_SERIAL];          // Offset after the last '*', or 0
+
+/**
+ * Store the next character of a serial line, keeping its checksum.
+ * Spaces before the line are dropped.
+ */
+FORCE_INLINE static void store_serial_char(const uint8_t i, const char c) {
+  if (!serial_count[i]) {
+    if (c == ' ') return;
+    #if NUM_SERIAL == 1
+      serial_slot = cmd_queue_index_w;          // A new line starts in the write slot
+    #endif
+    serial_checksum[i] = serial_star[i] = 0;
+  }
+  if (c == '*') {
+    serial_star_checksum[i] = serial_checksum[i];
+    serial_star[i] = serial_count[i] + 1;
+  }
+  serial_checksum[i] ^= c;
+  SERIAL_LINE(i)[serial_count[i]++] = c;
+}
+
 /**
  * Get all commands waiting on the serial port and queue them.
  * Exit when the buffer is full or when no more characters are
  * left on the serial port.
+ *
+ * Lines are stripped of comments and checksummed as they're taken
+ * from the serial buffer. With SERIAL_LINE_TOKENS they're also
+ * tokenized by one pass when complete.
  */
 inline void get_serial_commands() {
-  static char serial_line_buffer[NUM_SERIAL][MAX_CMD_SIZE];
   static bool serial_comment_mode[NUM_SERIAL] = { false };
+  #if ENABLED(BINARY_GCODE_TRANSPORT)
+    static bool serial_binary[NUM_SERIAL] = { false };
+  #endif
+
+  #if ENABLED(SERIAL_CREDIT_FLOW)
+    if (credit_flow) send_credit();
+  #endif
 
   // If the command buffer is empty for too long,
   // send "wait" to indicate Marlin is still waiting.
@@ -295,6 +545,37 @@ inline void get_serial_commands() {
 
       char serial_char = c;
 
+      #if ENABLED(SERIAL_CREDIT_FLOW)
+        serial_line_bytes++;
+      #endif
+
+      #if ENABLED(BINARY_GCODE_TRANSPORT)
+        /**
+         * A binary frame can start wherever a line could,
+         * and is collected whole before it's checked
+         */
+        if (serial_binary[i] || (!serial_count[i] && !serial_comment_mode[i] && c == BINARY_FRAME_START)) {
+          #if NUM_SERIAL == 1
+            if (!serial_count[i]) serial_slot = cmd_queue_index_w;
+          #endif
+          SERIAL_LINE(i)[serial_count[i]++] = serial_char;
+          serial_binary[i] = true;
+          if (serial_count[i] == 2 && (uint8_t)serial_char > BINARY_RECORD_MAX) {
+            serial_binary[i] = false;
+            return gcode_line_error(PSTR(MSG_ERR_BINARY_FRAME), i);
+          }
+          if (serial_count[i] > 2 && serial_count[i] == (uint8_t)SERIAL_LINE(i)[1] + BINARY_FRAME_OVERHEAD) {
+            serial_binary[i] = false;
+            serial_count[i] = 0;
+            #if defined(NO_TIMEOUTS) && NO_TIMEOUTS > 0
+              last_command_time = ms;
+            #endif
+            enqueue_binary_frame((uint8_t*)SERIAL_LINE(i), i);
+          }
+          continue;
+        }
+      #endif
+
       /**
        * If the character ends the line
        */
@@ -303,35 +584,50 @@ inline void get_serial_commands() {
         serial_comment_mode[i] = false;                   // end of line == end of comment
 
         // Skip empty lines and comments
-        if (!serial_count[i]) { thermalManager.manage_heater(); continue; }
+        if (!serial_count[i]) {
+          #if ENABLED(SERIAL_CREDIT_FLOW)
+            serial_line_bytes = 0;
+          #endif
+          thermalManager.manage_heater();
+          continue;
+        }
 
-        serial_line_buffer[i][serial_count[i]] = 0;       // Terminate string
+        char * const command = SERIAL_LINE(i);
+        const uint8_t length = serial_count[i];
+        command[length] = 0;                              // Terminate string
         serial_count[i] = 0;                              // Reset buffer
 
-        char* command = serial_line_buffer[i];
-
-        while (*command == ' ') command++;                // Skip leading spaces
-        char *npos = (*command == 'N') ? command : NULL;  // Require the N parameter to start the line
+        #if ENABLED(SERIAL_LINE_TOKENS)
+          // Tokenize the line for the parser
+          gcode_tokens_t tokens;
+          long line_number = 0;
+          const bool tokenized = parser.tokenize(command, tokens, line_number);
+        #endif
 
-        if (npos) {
+        if (*command == 'N') {                            // Require the N parameter to start the line
 
-          bool M110 = strstr_P(command, PSTR("M110")) != NULL;
+          const bool M110 =
+            #if ENABLED(SERIAL_LINE_TOKENS)
+              tokenized ? tokens.letter == 'M' && tokens.codenum == 110 :
+            #endif
+            strstr_P(command, PSTR("M110")) != NULL;
 
           if (M110) {
             char* n2pos = strchr(command + 4, 'N');
-            if (n2pos) npos = n2pos;
+            gcode_N = strtol((n2pos ? n2pos : command) + 1, NULL, 10);
           }
-
-          gcode_N = strtol(npos + 1, NULL, 10);
+          else
+            gcode_N =
+              #if ENABLED(SERIAL_LINE_TOKENS)
+                NUMERIC_SIGNED(command[1]) ? line_number :
+              #endif
+              strtol(command + 1, NULL, 10);
 
           if (gcode_N != gcode_LastN + 1 && !M110)
             return gcode_line_error(PSTR(MSG_ERR_LINE_NO), i);
 
-          char *apos = strrchr(command, '*');
-          if (apos) {
-            uint8_t checksum = 0, count = uint8_t(apos - command);
-            while (count) checksum ^= command[--count];
-            if (strtol(apos + 1, NULL, 10) != checksum)
+          if (serial_star[i]) {
+            if (strtol(command + serial_star[i], NULL, 10) != serial_star_checksum[i])
               return gcode_line_error(PSTR(MSG_ERR_CHECKSUM_MISMATCH), i);
           }
           else
@@ -362,23 +658,23 @@ inline void get_serial_commands() {
         }
 
         #if DISABLED(EMERGENCY_PARSER)
-          // Process critical commands early
-          if (strcmp(command, "M108") == 0) {
-            wait_for_heatup = false;
-            #if ENABLED(ULTIPANEL)
-              wait_for_user = false;
-            #endif
-          }
-          if (strcmp(command, "M112") == 0) kill(PSTR(MSG_KILLED));
-          if (strcmp(command, "M410") == 0) quickstop_stepper();
+          #if ENABLED(SERIAL_LINE_TOKENS)
+            if (tokenized) { if (tokens.letter == 'M') process_critical_command(tokens.codenum); }
+            else
+          #endif
+          if (*command == 'M') process_critical_command(strtol(command + 1, NULL, 10));
         #endif
 
         #if defined(NO_TIMEOUTS) && NO_TIMEOUTS > 0
           last_command_time = ms;
         #endif
 
-        // Add the command to the queue
-        _enqueuecommand(serial_line_buffer[i], true
+        // Add the command to the queue. It's usually in place already.
+        if (command != command_queue[cmd_queue_index_w]) memcpy(command_queue[cmd_queue_index_w], command, length + 1);
+        #if ENABLED(SERIAL_LINE_TOKENS)
+          if (tokenized) command_queue_tokens[cmd_queue_index_w] = tokens;
+        #endif
+        _commit_command(true
           #if NUM_SERIAL > 1
             , i
           #endif
@@ -390,12 +686,16 @@ inline void get_serial_commands() {
       }
       else if (serial_char == '\\') {  // Handle escapes
         // if we have one more character, copy it over
-        if ((c = read_serial(i)) >= 0 && !serial_comment_mode[i])
-          serial_line_buffer[i][serial_count[i]++] = (char)c;
+        if ((c = read_serial(i)) >= 0) {
+          #if ENABLED(SERIAL_CREDIT_FLOW)
+            serial_line_bytes++;
+          #endif
+          if (!serial_comment_mode[i]) store_serial_char(i, (char)c);
+        }
       }
       else { // it's not a newline, carriage return or escape char
         if (serial_char == ';') serial_comment_mode[i] = true;
-        if (!serial_comment_mode[i]) serial_line_buffer[i][serial_count[i]++] = serial_char;
+        if (!serial_comment_mode[i]) store_serial_char(i, serial_char);
       }
     } // for NUM_SERIAL
   } // queue has space, serial has data
@@ -409,8 +709,7 @@ inline void get_serial_commands() {
    * can also interrupt buffering.
    */
   inline void get_sdcard_commands() {
-    static bool stop_buffering = false,
-                sd_comment_mode = false;
+    static bool stop_buffering = false;
 
     if (!IS_SD_PRINTING) return;
 
@@ -423,70 +722,61 @@ inline void get_serial_commands() {
 
     if (commands_in_queue == 0) stop_buffering = false;
 
-    uint16_t sd_count = 0;
-    bool card_eof = card.eof();
-    while (commands_in_queue < BUFSIZE && !card_eof && !stop_buffering) {
-      const int16_t n = card.get();
-      char sd_char = (char)n;
-      card_eof = card.eof();
-      if (card_eof || n == -1
-          || sd_char == '\n' || sd_char == '\r'
-          || ((sd_char == '#' || sd_char == ':') && !sd_comment_mode)
-      ) {
-        if (card_eof) {
-
-          card.printingHasFinished();
-
-          if (card.sdprinting)
-            sd_count = 0; // If a sub-file was printing, continue from call point
-          else {
-            SERIAL_PROTOCOLLNPGM(MSG_FILE_PRINTED);
-            #if ENABLED(PRINTER_EVENT_LEDS)
-              LCD_MESSAGEPGM(MSG_INFO_COMPLETED_PRINTS);
-              leds.set_green();
-              #if HAS_RESUME_CONTINUE
-                gcode.lights_off_after_print = true;
-                enqueue_and_echo_commands_P(PSTR("M0 S"
-                  #if ENABLED(NEWPANEL)
-                    "1800"
-                  #else
-                    "60"
-                  #endif
-                ));
-              #else
-                safe_delay(2000);
-                leds.set_off();
-              #endif
-            #endif // PRINTER_EVENT_LEDS
-            card.checkautostart(true);
-          }
-        }
-        else if (n == -1) {
-          SERIAL_ERROR_START();
-          SERIAL_ECHOLNPGM(MSG_SD_ERR_READ);
-        }
-        if (sd_char == '#') stop_buffering = true;
-
-        sd_comment_mode = false; // for new command
+    // Commands are split out of the card's read-ahead buffer a whole line at a time
+    while (!card.eof() && !stop_buffering && free_write_slot()) {
+      uint8_t sd_count;
+      const int16_t term = card.getCommand(command_queue[cmd_queue_index_w], sd_count);
 
-        // Skip empty lines and comments
-        if (!sd_count) { thermalManager.manage_heater(); continue; }
+      if (term == -1) {
 
-        command_queue[cmd_queue_index_w][sd_count] = '\0'; // terminate string
-        sd_count = 0; // clear sd line buffer
+        // Queue a last line with no newline first. Finishing waits for moves in idle(),
+        // which takes serial commands, into the write slot this line is holding.
+        if (sd_count) {
+          _commit_command(false);
+          sd_count = 0;
+        }
 
-        _commit_command(false);
+        card.printingHasFinished();
+
+        if (card.sdprinting)
+          sd_count = 0; // If a sub-file was printing, continue from call point
+        else {
+          SERIAL_PROTOCOLLNPGM(MSG_FILE_PRINTED);
+          #if ENABLED(PRINTER_EVENT_LEDS)
+            LCD_MESSAGEPGM(MSG_INFO_COMPLETED_PRINTS);
+            leds.set_green();
+            #if HAS_RESUME_CONTINUE
+              gcode.lights_off_after_print = true;
+              enqueue_and_echo_commands_P(PSTR("M0 S"
+                #if ENABLED(NEWPANEL)
+                  "1800"
+                #else
+                  "60"
+                #endif
+              ));
+            #else
+              safe_delay(2000);
+              leds.set_off();
+            #endif
+          #endif // PRINTER_EVENT_LEDS
+          card.checkautostart(true);
+        }
       }
-      else if (sd_count >= MAX_CMD_SIZE - 1) {
-        /**
-         * Keep fetching, but ignore normal characters beyond the max length
-         * The command will be injected when EOL is reached
-         */
-      }
-      else {
-        if (sd_char == ';') sd_comment_mode = true;
-        if (!sd_comment_mode) command_queue[cmd_queue_index_w][sd_count++] = sd_char;
+      else if (term == -2) {
+        SERIAL_ERROR_START();
+        SERIAL_ECHOLNPGM(MSG_SD_ERR_READ);
+        return;
       }
+      else if (term == '#') stop_buffering = true;
+
+      // Skip empty lines and comments
+      if (!sd_count) { thermalManager.manage_heater(); continue; }
+
+      #if ENABLED(POWER_LOSS_RECOVERY)
+        command_queue_sdpos[cmd_queue_index_w] = card.getIndex();
+      #endif
+
+      _commit_command(false);
     }
   }
 
@@ -515,6 +805,9 @@ inline void get_serial_commands() {
  *  - The SD card file being actively printed
  */
 void get_available_commands() {
+  #if ENABLED(CODE_PROFILER)
+    PROFILE_ZONE(PROFILE_GET_COMMANDS);
+  #endif
 
   // if any immediate commands remain, don't get other commands yet
   if (drain_injected_commands_P()) return;
@@ -540,7 +833,11 @@ void advance_command_queue() {
 
   #if ENABLED(SDSUPPORT)
 
-    if (card.saving) {
+    if (card.saving
+      #if ENABLED(BINARY_GCODE_TRANSPORT)
+        && !command_queue_binary[cmd_queue_index_r] // Queued before M28, so run it
+      #endif
+    ) {
       char* command = command_queue[cmd_queue_index_r];
       if (strstr_P(command, PSTR("M29"))) {
         // M29 closes the file
@@ -571,7 +868,9 @@ void advance_command_queue() {
     else {
       gcode.process_next_command();
       #if ENABLED(POWER_LOSS_RECOVERY)
-        if (card.cardOK && card.sdprinting) save_job_recovery_info();
+        // Journal the commands from the file, with the place to resume after them
+        if (command_queue_sdpos[cmd_queue_index_r] && card.cardOK && card.sdprinting)
+          save_job_recovery_info(command_queue_sdpos[cmd_queue_index_r]);
       #endif
     }
 
@@ -584,6 +883,20 @@ void advance_command_queue() {
   // The queue may be reset by a command handler or by code invoked by idle() within a handler
   if (commands_in_queue) {
     --commands_in_queue;
+    #if ENABLED(SERIAL_CREDIT_FLOW)
+      if (credit_flow && send_ok[cmd_queue_index_r]) credit_line(cmd_queue_index_r);
+      credit_held -= command_queue_bytes[cmd_queue_index_r];
+      command_queue_bytes[cmd_queue_index_r] = 0;
+    #endif
+    #if ENABLED(BINARY_GCODE_TRANSPORT)
+      command_queue_binary[cmd_queue_index_r] = false;
+    #endif
+    #if ENABLED(SERIAL_LINE_TOKENS)
+      command_queue_tokens[cmd_queue_index_r].letter = 0;
+    #endif
+    #if ENABLED(POWER_LOSS_RECOVERY)
+      command_queue_sdpos[cmd_queue_index_r] = 0;
+    #endif
     if (++cmd_queue_index_r >= BUFSIZE) cmd_queue_index_r = 0;
   }
 
@@ -29,6 +29,7 @@
 #define GCODE_QUEUE_H
 
 #include "../inc/MarlinConfig.h"
+#include "parser.h"
 
 /**
  * GCode line number handling. Hosts may include line numbers when sending
@@ -58,6 +59,35 @@ extern char command_queue[BUFSIZE][MAX_CMD_SIZE];
   extern int16_t command_queue_port[BUFSIZE];
 #endif
 
+#if ENABLED(BINARY_GCODE_TRANSPORT)
+
+  /**
+   * Binary G-code frames, accepted on serial wherever a line could start:
+   *
+   *   BINARY_FRAME_START, length, line number (low byte), record, CRC-16 (LSB first)
+   *
+   * The CRC (see crc16) covers the length, line number and record. The line
+   * number must be the next one, as for text lines with N and a checksum.
+   * The record is the pre-parsed command (see GCodeParser::parse_binary).
+   * The queue keeps the length and record, and command_queue_binary marks it.
+   */
+  #define BINARY_FRAME_START    0xA5
+  #define BINARY_FRAME_OVERHEAD 5     // Start, length, line number, CRC
+  #define BINARY_RECORD_MAX     (MAX_CMD_SIZE - (BINARY_FRAME_OVERHEAD))
+
+  extern bool command_queue_binary[BUFSIZE];
+
+#endif
+
+#if ENABLED(SERIAL_LINE_TOKENS)
+  /**
+   * Serial lines are tokenized when they're read (see GCodeParser::tokenize),
+   * and the parser takes them from here instead of scanning them again.
+   * A letter of 0 marks a command that has no tokens.
+   */
+  extern gcode_tokens_t command_queue_tokens[BUFSIZE];
+#endif
+
 /**
  * Initialization of queue for setup()
  */
@@ -85,6 +115,27 @@ void flush_and_request_resend();
  */
 void ok_to_send();
 
+#if ENABLED(SERIAL_CREDIT_FLOW)
+
+  /**
+   * Credit flow control, set with M575. Instead of an "ok" for each
+   * line, serial lines are acknowledged cumulatively with:
+   *
+   *   ok N<int> R<int> B<int>
+   *
+   *   N  Line number of the last command run
+   *   R  Bytes the host may have sent after line N: the free RX buffer
+   *      plus the bytes of later lines already taken out of it
+   *   B  Command queue space remaining
+   *
+   * The host keeps the bytes it has sent after line N within R.
+   */
+  extern bool credit_flow;
+
+  void set_credit_flow(const bool enable);
+
+#endif
+
 /**
  * Record one or many commands to run from program memory.
  * Aborts the current queue, if any.
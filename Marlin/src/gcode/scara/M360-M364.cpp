@@ -29,56 +29,55 @@
 #include "../../module/motion.h"
 #include "../../Marlin.h" // for IsRunning()
 
-inline bool SCARA_move_to_cal(const uint8_t delta_a, const uint8_t delta_b) {
+// No "ok" follows a calibration move. See process_parsed_command.
+inline void SCARA_move_to_cal(const uint8_t delta_a, const uint8_t delta_b) {
   if (IsRunning()) {
     forward_kinematics_SCARA(delta_a, delta_b);
     destination[X_AXIS] = cartes[X_AXIS];
     destination[Y_AXIS] = cartes[Y_AXIS];
     destination[Z_AXIS] = current_position[Z_AXIS];
     prepare_move_to_destination();
-    return true;
   }
-  return false;
 }
 
 /**
  * M360: SCARA calibration: Move to cal-position ThetaA (0 deg calibration)
  */
-bool GcodeSuite::M360() {
+void GcodeSuite::M360() {
   SERIAL_ECHOLNPGM(" Cal: Theta 0");
-  return SCARA_move_to_cal(0, 120);
+  SCARA_move_to_cal(0, 120);
 }
 
 /**
  * M361: SCARA calibration: Move to cal-position ThetaB (90 deg calibration - steps per degree)
  */
-bool GcodeSuite::M361() {
+void GcodeSuite::M361() {
   SERIAL_ECHOLNPGM(" Cal: Theta 90");
-  return SCARA_move_to_cal(90, 130);
+  SCARA_move_to_cal(90, 130);
 }
 
 /**
  * M362: SCARA calibration: Move to cal-position PsiA (0 deg calibration)
  */
-bool GcodeSuite::M362() {
+void GcodeSuite::M362() {
   SERIAL_ECHOLNPGM(" Cal: Psi 0");
-  return SCARA_move_to_cal(60, 180);
+  SCARA_move_to_cal(60, 180);
 }
 
 /**
  * M363: SCARA calibration: Move to cal-position PsiB (90 deg calibration - steps per degree)
  */
-bool GcodeSuite::M363() {
+void GcodeSuite::M363() {
   SERIAL_ECHOLNPGM(" Cal: Psi 90");
-  return SCARA_move_to_cal(50, 90);
+  SCARA_move_to_cal(50, 90);
 }
 
 /**
  * M364: SCARA calibration: Move to cal-position PsiC (90 deg to Theta calibration position)
  */
-bool GcodeSuite::M364() {
+void GcodeSuite::M364() {
   SERIAL_ECHOLNPGM(" Cal: Theta-Psi 90");
-  return SCARA_move_to_cal(45, 135);
+  SCARA_move_to_cal(45, 135);
 }
 
 #endif // MORGAN_SCARA
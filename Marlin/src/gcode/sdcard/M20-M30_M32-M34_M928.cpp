@@ -81,16 +81,16 @@ void GcodeSuite::M23() {
  * M24: Start or Resume SD Print
  */
 void GcodeSuite::M24() {
-  #if ENABLED(POWER_LOSS_RECOVERY)
-    card.removeJobRecoveryFile();
-  #endif
-
   #if ENABLED(PARK_HEAD_ON_PAUSE)
     resume_print();
   #endif
 
   card.startFileprint();
   print_job_timer.start();
+
+  #if ENABLED(POWER_LOSS_RECOVERY)
+    start_job_recovery();
+  #endif
 }
 
 /**
@@ -192,6 +192,10 @@ void GcodeSuite::M32() {
 
     // Procedure calls count as normal print time.
     if (!call_procedure) print_job_timer.start();
+
+    #if ENABLED(POWER_LOSS_RECOVERY)
+      start_job_recovery();
+    #endif
   }
 }
 
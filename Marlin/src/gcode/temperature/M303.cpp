@@ -30,6 +30,8 @@
  *       E<extruder> (-1 for the bed) (default 0)
  *       C<cycles>
  *       U<bool> with a non-zero value will apply the result to current settings
+ *       F Fit a model to one heat-up instead of timing relay cycles (Requires PID_AUTOTUNE_FIT)
+ *       R With F, refine the model with one relay cycle
  */
 void GcodeSuite::M303() {
   #if HAS_PID_HEATING
@@ -45,7 +47,12 @@ void GcodeSuite::M303() {
       KEEPALIVE_STATE(NOT_BUSY);
     #endif
 
-    thermalManager.PID_autotune(temp, e, c, u);
+    #if ENABLED(PID_AUTOTUNE_FIT)
+      const bool f = parser.seen('F');
+      thermalManager.PID_autotune(temp, e, f ? parser.seen('R') : c, u, f);
+    #else
+      thermalManager.PID_autotune(temp, e, c, u);
+    #endif
 
     #if DISABLED(BUSY_WHILE_HEATING)
       KEEPALIVE_STATE(IN_HANDLER);
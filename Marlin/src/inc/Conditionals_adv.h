@@ -35,8 +35,7 @@
     #ifndef RX_BUFFER_SIZE
       #define RX_BUFFER_SIZE 128
     #endif
-    // 256 is the max TX buffer limit due to uint8_t head and tail
-    // : [0, 4, 8, 16, 32, 64, 128, 256]
+    // : [0, 4, 8, 16, 32, 64, 128, 256, 512, 1024, ...]
     #ifndef TX_BUFFER_SIZE
       #define TX_BUFFER_SIZE 32
     #endif
@@ -45,4 +44,9 @@
     #undef SERIAL_XON_XOFF
   #endif
 
+  // For configurations from before ARC_MIN_SEGMENT_TIME
+  #if defined(ARC_CHORD_TOLERANCE) && !defined(ARC_MIN_SEGMENT_TIME)
+    #define ARC_MIN_SEGMENT_TIME 5
+  #endif
+
 #endif // CONDITIONALS_ADV_H
@@ -270,6 +270,8 @@
   #error "AUTOMATIC_CURRENT_CONTROL is now MONITOR_DRIVER_STATUS. Please update your configuration."
 #elif defined(FILAMENT_CHANGE_LOAD_LENGTH)
   #error "FILAMENT_CHANGE_LOAD_LENGTH is now FILAMENT_CHANGE_FAST_LOAD_LENGTH. Please update your configuration."
+#elif defined(FASTER_GCODE_PARSER)
+  #error "FASTER_GCODE_PARSER is obsolete, as the parser always indexes parameters now. Please remove it from your Configuration_adv.h."
 #elif ENABLED(LEVEL_BED_CORNERS) && !defined(LEVEL_CORNERS_INSET)
   #error "LEVEL_BED_CORNERS requires a LEVEL_CORNERS_INSET value. Please update your Configuration.h."
 #endif
@@ -311,8 +313,8 @@
     #error "SERIAL_XON_XOFF requires RX_BUFFER_SIZE >= 1024 for reliable transfers without drops."
   #elif RX_BUFFER_SIZE && (RX_BUFFER_SIZE < 2 || !IS_POWER_OF_2(RX_BUFFER_SIZE))
     #error "RX_BUFFER_SIZE must be a power of 2 greater than 1."
-  #elif TX_BUFFER_SIZE && (TX_BUFFER_SIZE < 2 || TX_BUFFER_SIZE > 256 || !IS_POWER_OF_2(TX_BUFFER_SIZE))
-    #error "TX_BUFFER_SIZE must be 0, a power of 2 greater than 1, and no greater than 256."
+  #elif TX_BUFFER_SIZE && (TX_BUFFER_SIZE < 2 || !IS_POWER_OF_2(TX_BUFFER_SIZE))
+    #error "TX_BUFFER_SIZE must be 0 or a power of 2 greater than 1."
   #endif
 #elif ENABLED(SERIAL_XON_XOFF) || ENABLED(SERIAL_STATS_MAX_RX_QUEUED) || ENABLED(SERIAL_STATS_DROPPED_RX)
   #error "SERIAL_XON_XOFF and SERIAL_STATS_* features not supported on USB-native AVR devices."
@@ -322,6 +324,18 @@
   #error "Set SERIAL_PORT to the port on your board. Usually this is 0."
 #endif
 
+#if ENABLED(SERIAL_CREDIT_FLOW)
+  #if defined(__AVR__) && defined(USBCON)
+    #error "SERIAL_CREDIT_FLOW is not supported on USB-native AVR devices."
+  #elif defined(TARGET_LPC1768) || defined(__STM32F1__) || defined(TARGET_STM32F1) || defined(STM32F4) || defined(STM32F7) || defined(__MK64FX512__) || defined(__MK66FX1M0__)
+    #error "SERIAL_CREDIT_FLOW is only supported on AVR, Due and the Linux HAL, where the serial port receives into a buffer of RX_BUFFER_SIZE."
+  #elif defined(ARDUINO_ARCH_SAM) && SERIAL_PORT < 0
+    #error "SERIAL_CREDIT_FLOW is not supported on the Due's native USB port."
+  #elif NUM_SERIAL > 1
+    #error "SERIAL_CREDIT_FLOW only supports a single serial port."
+  #endif
+#endif
+
 /**
  * Dual Stepper Drivers
  */
@@ -604,6 +618,27 @@ static_assert(X_MAX_LENGTH >= X_BED_SIZE && Y_MAX_LENGTH >= Y_BED_SIZE,
   );
 #endif
 
+/**
+ * Step pattern buffer requirements
+ */
+#ifdef STEP_PATTERN_BUFFER
+  #ifndef CPU_32_BIT
+    #error "STEP_PATTERN_BUFFER requires a 32-bit board."
+  #elif ENABLED(LIN_ADVANCE)
+    #error "STEP_PATTERN_BUFFER is incompatible with LIN_ADVANCE."
+  #elif ENABLED(MIXING_EXTRUDER)
+    #error "STEP_PATTERN_BUFFER is incompatible with MIXING_EXTRUDER."
+  #elif !WITHIN(STEP_PATTERN_BUFFER, 8, 128) || (STEP_PATTERN_BUFFER & (STEP_PATTERN_BUFFER - 1))
+    #error "STEP_PATTERN_BUFFER must be a power of 2 from 8 to 128."
+  #endif
+#endif
+
+#if ENABLED(STEP_TIMELINE)
+  #if !WITHIN(STEP_TIMELINE_SIZE, 2, 256) || (STEP_TIMELINE_SIZE & (STEP_TIMELINE_SIZE - 1))
+    #error "STEP_TIMELINE_SIZE must be a power of 2 up to 256."
+  #endif
+#endif
+
 /**
  * Parking Extruder requirements
  */
@@ -670,6 +705,20 @@ static_assert(X_MAX_LENGTH >= X_BED_SIZE && Y_MAX_LENGTH >= Y_BED_SIZE,
   #error "To use BED_LIMIT_SWITCHING you must disable PIDTEMPBED."
 #endif
 
+/**
+ * Model Predictive Hotend Control
+ */
+#if ENABLED(MPCTEMP)
+  #if DISABLED(PIDTEMP)
+    #error "MPCTEMP requires PIDTEMP."
+  #elif ENABLED(PID_EXTRUSION_SCALING)
+    #error "MPCTEMP feeds forward the extrusion rate itself. Disable PID_EXTRUSION_SCALING."
+  #elif ENABLED(PID_OPENLOOP)
+    #error "MPCTEMP is incompatible with PID_OPENLOOP."
+  #endif
+  static_assert(WITHIN(MPC_SMOOTHING_FACTOR, 0, 1), "MPC_SMOOTHING_FACTOR must be between 0 and 1.");
+#endif
+
 /**
  * Kinematics
  */
@@ -1728,8 +1777,34 @@ static_assert(COUNT(sanity_arr_3) <= XYZE_N, "DEFAULT_MAX_ACCELERATION has too m
   #endif
 #endif
 
-#if ENABLED(POWER_LOSS_RECOVERY) && !ENABLED(ULTIPANEL)
+#if ENABLED(EEPROM_JOURNAL)
+  #if DISABLED(EEPROM_SETTINGS)
+    #error "EEPROM_JOURNAL requires EEPROM_SETTINGS."
+  #elif !defined(__PLAT_LINUX__) && !(defined(__STM32F1__) && ENABLED(FLASH_EEPROM_EMULATION))
+    #error "EEPROM_JOURNAL requires flash EEPROM emulation on STM32F1 (FLASH_EEPROM_EMULATION) or the Linux HAL."
+  #endif
+#endif
+
+#if ENABLED(POWER_LOSS_RECOVERY) && !ENABLED(ULTIPANEL) && !defined(__PLAT_LINUX__) // The Linux HAL journals prints for --benchmark-recovery
   #error "POWER_LOSS_RECOVERY currently requires an LCD Controller."
 #endif
 
+#if ENABLED(DOGM_DIRTY_STRIPES)
+  #if DISABLED(DOGLCD)
+    #error "DOGM_DIRTY_STRIPES requires a graphical display (DOGLCD)."
+  #elif ENABLED(LIGHTWEIGHT_UI)
+    #error "DOGM_DIRTY_STRIPES is not compatible with LIGHTWEIGHT_UI, which has its own Info Screen."
+  #endif
+#endif
+
+#if ENABLED(AUTO_REPORT_COALESCE)
+  #if DISABLED(AUTO_REPORT_TEMPERATURES) && DISABLED(AUTO_REPORT_SD_STATUS)
+    #error "AUTO_REPORT_COALESCE requires AUTO_REPORT_TEMPERATURES or AUTO_REPORT_SD_STATUS."
+  #elif defined(TARGET_LPC1768) || defined(__STM32F1__) || defined(TARGET_STM32F1) || defined(STM32F4) || defined(STM32F7) || defined(__MK64FX512__) || defined(__MK66FX1M0__)
+    #error "AUTO_REPORT_COALESCE is only supported on AVR, Due and the Linux HAL."
+  #elif ((defined(__AVR__) && !defined(USBCON)) || (defined(ARDUINO_ARCH_SAM) && SERIAL_PORT >= 0)) && TX_BUFFER_SIZE < 256
+    #error "AUTO_REPORT_COALESCE requires TX_BUFFER_SIZE of 256 or more, so a whole report fits in the TX buffer."
+  #endif
+#endif
+
 #endif // _SANITYCHECK_H_
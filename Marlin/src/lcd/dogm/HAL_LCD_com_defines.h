@@ -61,6 +61,17 @@
   uint8_t u8g_com_HAL_LPC1768_ssd_hw_i2c_fn(u8g_t *u8g, uint8_t msg, uint8_t arg_val, void *arg_ptr);
   #define U8G_COM_SSD_I2C_HAL u8g_com_HAL_LPC1768_ssd_hw_i2c_fn
 
+#elif defined(__PLAT_LINUX__)
+  // The simulated ST7920 is the only display
+  uint8_t u8g_com_HAL_LINUX_st7920_fn(u8g_t *u8g, uint8_t msg, uint8_t arg_val, void *arg_ptr);
+  #define U8G_COM_ST7920_HAL_SW_SPI u8g_com_HAL_LINUX_st7920_fn
+  #define U8G_COM_ST7920_HAL_HW_SPI u8g_com_HAL_LINUX_st7920_fn
+
+  uint8_t u8g_com_null_fn(u8g_t *u8g, uint8_t msg, uint8_t arg_val, void *arg_ptr);
+  #define U8G_COM_HAL_SW_SPI_FN u8g_com_null_fn
+  #define U8G_COM_HAL_HW_SPI_FN u8g_com_null_fn
+  #define U8G_COM_SSD_I2C_HAL u8g_com_null_fn
+
 #else  // need to give them some definition or else get compiler errors
   uint8_t u8g_com_null_fn(u8g_t *u8g, uint8_t msg, uint8_t arg_val, void *arg_ptr);
   #define U8G_COM_HAL_SW_SPI_FN u8g_com_null_fn
@@ -40,84 +40,72 @@ FORCE_INLINE void _draw_centered_temp(const int16_t temp, const uint8_t x, const
   #define HEAT_INDICATOR_X 8
 #endif
 
-FORCE_INLINE void _draw_heater_status(const uint8_t x, const int8_t heater, const bool blink) {
-  #if !HEATER_IDLE_HANDLER
-    UNUSED(blink);
-  #endif
+#if HOTENDS < 4 && HAS_HEATED_BED
+  #define STATUS_HEATERS (HOTENDS + 1)  // The bed comes after the hotends
+#else
+  #define STATUS_HEATERS HOTENDS
+#endif
 
-  #if HAS_HEATED_BED
-    const bool isBed = heater < 0;
-  #else
-    constexpr bool isBed = false;
-  #endif
+#if ENABLED(SDSUPPORT) || ENABLED(LCD_SET_PROGRESS_MANUALLY)
+  #define STATUS_PROGRESS
+#endif
 
-  if (PAGE_UNDER(7)) {
-    #if HEATER_IDLE_HANDLER
-      const bool is_idle = (
-        #if HAS_HEATED_BED
-          isBed ? thermalManager.is_bed_idle() :
-        #endif
-        thermalManager.is_heater_idle(heater)
-      );
+enum AxisLabel : char { AXIS_LABEL_NAME, AXIS_LABEL_UNHOMED = '?', AXIS_LABEL_UNKNOWN = ' ' };
 
-      if (blink || !is_idle)
-    #endif
-        _draw_centered_temp(0.5 + (
-            #if HAS_HEATED_BED
-              isBed ? thermalManager.degTargetBed() :
-            #endif
-            thermalManager.degTargetHotend(heater)
-          ), x, 7
-        );
-  }
+/**
+ * The values shown on the Info Screen, taken once at the first page of a
+ * frame so every page draws the same ones. With DOGM_DIRTY_STRIPES they are
+ * compared with those of the last frame to find the bands that changed.
+ */
+typedef struct {
+  uint8_t header;                       // Frame of the fan animation
+  int16_t target[STATUS_HEATERS],
+          temp[STATUS_HEATERS];
+  uint8_t target_shown,                 // One bit for each heater
+          heating;
+  #if HAS_FAN0
+    uint8_t fan_percent;
+  #endif
+  #if ENABLED(SDSUPPORT)
+    bool sd_open;
+  #endif
+  #if ENABLED(STATUS_PROGRESS)
+    uint8_t progress;
+    char elapsed[10];
+  #endif
+  char axis_label[XYZ], xstring[5], ystring[5], zstring[7];
+  int16_t feedrate;
+  #if ENABLED(FILAMENT_LCD_DISPLAY)
+    char wstring[5], mstring[4];
+  #endif
+  #if ENABLED(FILAMENT_LCD_DISPLAY) && ENABLED(SDSUPPORT)
+    bool show_filament;                 // The status line shows the filament instead of the message
+  #endif
+  #if ENABLED(DOGM_DIRTY_STRIPES)
+    uint16_t message_hash;              // Of the message and its scroll position
+  #endif
+} status_fields_t;
 
-  if (PAGE_CONTAINS(21, 28))
-    _draw_centered_temp(0.5 + (
-        #if HAS_HEATED_BED
-          isBed ? thermalManager.degBed() :
-        #endif
-        thermalManager.degHotend(heater)
-      ), x, 28
-    );
+static status_fields_t status_fields;
 
-  if (PAGE_CONTAINS(17, 20)) {
-    const uint8_t h = isBed ? 7 : HEAT_INDICATOR_X,
-                  y = isBed ? 18 : 17;
-    if (
-      #if HAS_HEATED_BED
-        isBed ? thermalManager.isHeatingBed() :
-      #endif
-      thermalManager.isHeatingHotend(heater)
-    ) {
-      u8g.setColorIndex(0); // white on black
-      u8g.drawBox(x + h, y, 2, 2);
-      u8g.setColorIndex(1); // black on white
-    }
-    else
-      u8g.drawBox(x + h, y, 2, 2);
-  }
-}
+#if ENABLED(STATUS_MESSAGE_SCROLLING)
 
-FORCE_INLINE void _draw_axis_label(const AxisEnum axis, const char* const pstr, const bool blink) {
-  if (blink)
-    lcd_put_u8str_rom(pstr);
-  else {
-    if (!axis_homed[axis])
-      lcd_put_wchar('?');
-    else {
-      #if DISABLED(HOME_AFTER_DEACTIVATE) && DISABLED(DISABLE_REDUCED_ACCURACY_WARNING)
-        if (!axis_known_position[axis])
-          lcd_put_wchar(' ');
-        else
-      #endif
-          lcd_put_u8str_rom(pstr);
-    }
+  // Scroll the status message once per blink
+  static void lcd_implementation_status_scroll(const bool blink) {
+    static bool last_blink = false;
+    if (last_blink == blink) return;
+    last_blink = blink;
+    const uint8_t slen = utf8_strlen(lcd_status_message);
+    if (slen <= LCD_WIDTH) return;
+    // Skip any non-printing bytes
+    if (status_scroll_pos < slen) while (!PRINTABLE(lcd_status_message[status_scroll_pos])) status_scroll_pos++;
+    if (++status_scroll_pos >= slen + 2) status_scroll_pos = 0;
   }
-}
 
-inline void lcd_implementation_status_message(const bool blink) {
+#endif
+
+inline void lcd_implementation_status_message() {
   #if ENABLED(STATUS_MESSAGE_SCROLLING)
-    static bool last_blink = false;
     const uint8_t slen = utf8_strlen(lcd_status_message);
     const char *stat = lcd_status_message + status_scroll_pos;
     if (slen <= LCD_WIDTH)
@@ -138,30 +126,254 @@ inline void lcd_implementation_status_message(const bool blink) {
           if (chars) lcd_put_u8str_max(lcd_status_message, chars);  // Print a second copy of the message
         }
       }
-      if (last_blink != blink) {
-        last_blink = blink;
-        // Skip any non-printing bytes
-        if (status_scroll_pos < slen) while (!PRINTABLE(lcd_status_message[status_scroll_pos])) status_scroll_pos++;
-        if (++status_scroll_pos >= slen + 2) status_scroll_pos = 0;
-      }
     }
   #else
-    UNUSED(blink);
     lcd_put_u8str(lcd_status_message);
   #endif
 }
 
-static void lcd_implementation_status_screen() {
+// Before homing the axis letters are blinking 'X' <-> '?'.
+// When axis is homed but axis_known_position is false the axis letters are blinking 'X' <-> ' '.
+// When everything is ok you see a constant 'X'.
+FORCE_INLINE char _axis_label(const AxisEnum axis, const bool blink) {
+  if (blink) return AXIS_LABEL_NAME;
+  if (!axis_homed[axis]) return AXIS_LABEL_UNHOMED;
+  #if DISABLED(HOME_AFTER_DEACTIVATE) && DISABLED(DISABLE_REDUCED_ACCURACY_WARNING)
+    if (!axis_known_position[axis]) return AXIS_LABEL_UNKNOWN;
+  #endif
+  return AXIS_LABEL_NAME;
+}
+
+FORCE_INLINE void _draw_axis_label(const char label, const char* const pstr) {
+  if (label == AXIS_LABEL_NAME)
+    lcd_put_u8str_rom(pstr);
+  else
+    lcd_put_wchar(label);
+}
+
+static void _take_status_fields(status_fields_t &f) {
 
   const bool blink = lcd_blink();
 
-  #if FAN_ANIM_FRAMES > 2
-    static bool old_blink;
-    static uint8_t fan_frame;
-    if (old_blink != blink) {
-      old_blink = blink;
-      if (!fanSpeeds[0] || ++fan_frame >= FAN_ANIM_FRAMES) fan_frame = 0;
+  #if ENABLED(STATUS_MESSAGE_SCROLLING)
+    lcd_implementation_status_scroll(blink);
+  #endif
+
+  #if HAS_FAN0
+    #if FAN_ANIM_FRAMES > 2
+      static bool old_blink;
+      static uint8_t fan_frame;
+      if (old_blink != blink) {
+        old_blink = blink;
+        if (!fanSpeeds[0] || ++fan_frame >= FAN_ANIM_FRAMES) fan_frame = 0;
+      }
+      f.header = fan_frame;
+    #else
+      f.header = blink && fanSpeeds[0];
+    #endif
+  #else
+    f.header = 0;
+  #endif
+
+  f.target_shown = f.heating = 0;
+  for (uint8_t h = 0; h < STATUS_HEATERS; h++) {
+    #if HAS_HEATED_BED
+      const bool isBed = h >= HOTENDS;
+      #define _HEATER_VALUE(B, H) (isBed ? thermalManager.B() : thermalManager.H(h))
+    #else
+      #define _HEATER_VALUE(B, H) thermalManager.H(h)
+    #endif
+    f.target[h] = 0.5 + _HEATER_VALUE(degTargetBed, degTargetHotend);
+    f.temp[h] = 0.5 + _HEATER_VALUE(degBed, degHotend);
+    #if HEATER_IDLE_HANDLER
+      if (blink || !_HEATER_VALUE(is_bed_idle, is_heater_idle))
+    #endif
+        SBI(f.target_shown, h);
+    if (_HEATER_VALUE(isHeatingBed, isHeatingHotend)) SBI(f.heating, h);
+    #undef _HEATER_VALUE
+  }
+
+  #if HAS_FAN0
+    f.fan_percent = ((fanSpeeds[0] + 1) * 100) / 256;
+  #endif
+
+  #if ENABLED(SDSUPPORT)
+    f.sd_open = card.isFileOpen();
+  #endif
+
+  #if ENABLED(STATUS_PROGRESS)
+    #if ENABLED(LCD_SET_PROGRESS_MANUALLY)
+      f.progress = progress_bar_percent;
+    #else
+      f.progress = card.percentDone();
+    #endif
+    duration_t elapsed = print_job_timer.duration();
+    elapsed.toDigital(f.elapsed, elapsed.value >= 60*60*24L);
+  #endif
+
+  f.axis_label[X_AXIS] = _axis_label(X_AXIS, blink);
+  f.axis_label[Y_AXIS] = _axis_label(Y_AXIS, blink);
+  f.axis_label[Z_AXIS] = _axis_label(Z_AXIS, blink);
+  strcpy(f.xstring, ftostr4sign(LOGICAL_X_POSITION(current_position[X_AXIS])));
+  strcpy(f.ystring, ftostr4sign(LOGICAL_Y_POSITION(current_position[Y_AXIS])));
+  strcpy(f.zstring, ftostr52sp(FIXFLOAT(LOGICAL_Z_POSITION(current_position[Z_AXIS]))));
+
+  f.feedrate = feedrate_percentage;
+
+  #if ENABLED(FILAMENT_LCD_DISPLAY)
+    strcpy(f.wstring, ftostr12ns(filament_width_meas));
+    strcpy(f.mstring, itostr3(100.0 * (
+        parser.volumetric_enabled
+          ? planner.volumetric_area_nominal / planner.volumetric_multiplier[FILAMENT_SENSOR_EXTRUDER_NUM]
+          : planner.volumetric_multiplier[FILAMENT_SENSOR_EXTRUDER_NUM]
+      )
+    ));
+  #endif
+
+  #if ENABLED(FILAMENT_LCD_DISPLAY) && ENABLED(SDSUPPORT)
+    f.show_filament = !PENDING(millis(), previous_lcd_status_ms + 5000UL);
+  #endif
+
+  #if ENABLED(DOGM_DIRTY_STRIPES)
+    uint16_t hash = 0;
+    #if ENABLED(STATUS_MESSAGE_SCROLLING)
+      hash = status_scroll_pos;
+    #endif
+    for (const char *c = lcd_status_message; *c; c++) hash = (hash << 5) - hash + (uint8_t)*c;
+    f.message_hash = hash;
+  #endif
+}
+
+//
+// Layout of the Info Screen
+//
+
+#define HEADER_BOTTOM         (STATUS_SCREENHEIGHT + 1)
+#define TARGET_TOP            0
+#define TARGET_BOTTOM         7
+#define HEATING_TOP           17
+#define HEATING_BOTTOM        20
+#define TEMP_TOP              21
+#define TEMP_BOTTOM           28
+#define FAN_TOP               20
+#define FAN_BOTTOM            27
+
+#define SD_SYMBOL_TOP         (42 - (TALL_FONT_CORRECTION))
+#define SD_SYMBOL_BOTTOM      (51 - (TALL_FONT_CORRECTION))
+
+#define PROGRESS_BAR_X        54
+#define PROGRESS_BAR_WIDTH    (LCD_PIXEL_WIDTH - PROGRESS_BAR_X)
+#define PROGRESS_BAR_TOP      49
+#define PROGRESS_BAR_BOTTOM   (52 - (TALL_FONT_CORRECTION))
+#define PROGRESS_TEXT_TOP     41
+#define PROGRESS_TEXT_BOTTOM  48
+
+#define XYZ_BASELINE          (30 + INFO_FONT_HEIGHT)
+
+#define X_LABEL_POS  3
+#define X_VALUE_POS 11
+#define XYZ_SPACING 40
+
+#if ENABLED(XYZ_HOLLOW_FRAME)
+  #define XYZ_FRAME_TOP 29
+  #define XYZ_FRAME_HEIGHT INFO_FONT_HEIGHT + 3
+#else
+  #define XYZ_FRAME_TOP 30
+  #define XYZ_FRAME_HEIGHT INFO_FONT_HEIGHT + 1
+#endif
+#define XYZ_FRAME_BOTTOM      (XYZ_FRAME_TOP + XYZ_FRAME_HEIGHT - 1)
+
+#define FEEDRATE_TOP          (51 - INFO_FONT_HEIGHT)
+#define FEEDRATE_BOTTOM       49
+
+#define STATUS_BASELINE       (55 + INFO_FONT_HEIGHT)
+#define STATUS_TOP            (STATUS_BASELINE - (INFO_FONT_HEIGHT - 1))
+
+#if ENABLED(DOGM_DIRTY_STRIPES)
+
+  // Mark the bands of the fields that differ from the last frame
+  static void _mark_changed_fields(const status_fields_t &now, const status_fields_t &was) {
+    #define _CHANGED(F) memcmp(&now.F, &was.F, sizeof(now.F))
+    #define _MARK(ya, yb) (lcd_dirty_bands |= LCD_BANDS(ya, yb))
+
+    if (_CHANGED(header)) _MARK(0, HEADER_BOTTOM);
+    if (_CHANGED(target) || _CHANGED(target_shown)) _MARK(TARGET_TOP, TARGET_BOTTOM);
+    if (_CHANGED(heating)) _MARK(HEATING_TOP, HEATING_BOTTOM);
+    if (_CHANGED(temp)) _MARK(TEMP_TOP, TEMP_BOTTOM);
+    #if HAS_FAN0
+      if (_CHANGED(fan_percent)) _MARK(FAN_TOP, FAN_BOTTOM);
+    #endif
+    #if ENABLED(SDSUPPORT)
+      if (_CHANGED(sd_open)) _MARK(SD_SYMBOL_TOP, SD_SYMBOL_BOTTOM);
+    #endif
+    #if ENABLED(STATUS_PROGRESS)
+      if (_CHANGED(progress)) _MARK(PROGRESS_TEXT_TOP, PROGRESS_BAR_BOTTOM);
+      if (_CHANGED(elapsed)) _MARK(PROGRESS_TEXT_TOP, PROGRESS_TEXT_BOTTOM);
+    #endif
+    if (_CHANGED(axis_label) || _CHANGED(xstring) || _CHANGED(ystring) || _CHANGED(zstring)) _MARK(XYZ_FRAME_TOP, XYZ_FRAME_BOTTOM);
+    if (_CHANGED(feedrate)) _MARK(FEEDRATE_TOP, FEEDRATE_BOTTOM + 1);
+    #if ENABLED(FILAMENT_LCD_DISPLAY)
+      if (_CHANGED(wstring) || _CHANGED(mstring))
+        #if ENABLED(SDSUPPORT)
+          _MARK(STATUS_TOP, STATUS_BASELINE);
+        #else
+          _MARK(FEEDRATE_TOP, FEEDRATE_BOTTOM + 1);
+        #endif
+    #endif
+    #if ENABLED(FILAMENT_LCD_DISPLAY) && ENABLED(SDSUPPORT)
+      if (_CHANGED(show_filament)) _MARK(STATUS_TOP, STATUS_BASELINE);
+    #endif
+    if (_CHANGED(message_hash)) _MARK(STATUS_TOP, STATUS_BASELINE);
+
+    #undef _CHANGED
+    #undef _MARK
+  }
+
+#endif // DOGM_DIRTY_STRIPES
+
+FORCE_INLINE void _draw_heater_status(const uint8_t x, const uint8_t h) {
+  #if HAS_HEATED_BED
+    const bool isBed = h >= HOTENDS;
+  #else
+    constexpr bool isBed = false;
+  #endif
+
+  if (PAGE_UNDER(TARGET_BOTTOM) && TEST(status_fields.target_shown, h))
+    _draw_centered_temp(status_fields.target[h], x, TARGET_BOTTOM);
+
+  if (PAGE_CONTAINS(TEMP_TOP, TEMP_BOTTOM))
+    _draw_centered_temp(status_fields.temp[h], x, TEMP_BOTTOM);
+
+  if (PAGE_CONTAINS(HEATING_TOP, HEATING_BOTTOM)) {
+    const uint8_t hx = isBed ? 7 : HEAT_INDICATOR_X,
+                  y = isBed ? 18 : 17;
+    if (TEST(status_fields.heating, h)) {
+      u8g.setColorIndex(0); // white on black
+      u8g.drawBox(x + hx, y, 2, 2);
+      u8g.setColorIndex(1); // black on white
     }
+    else
+      u8g.drawBox(x + hx, y, 2, 2);
+  }
+}
+
+static void lcd_implementation_status_screen() {
+
+  // At the first page, take the values for the whole frame
+  if (page.page == 0) {
+    #if ENABLED(DOGM_DIRTY_STRIPES)
+      status_fields_t now;
+      _take_status_fields(now);
+      _mark_changed_fields(now, status_fields);
+      status_fields = now;
+    #else
+      _take_status_fields(status_fields);
+    #endif
+  }
+
+  #if ENABLED(DOGM_DIRTY_STRIPES)
+    // Pages with no changes are stepped over by lcd_update
+    if (!lcd_page_dirty()) return;
   #endif
 
   // Status Menu Font
@@ -179,26 +391,18 @@ static void lcd_implementation_status_screen() {
   // - May be offset in X
   // - Includes all nozzle(s), bed(s), and the fan.
   //
-  // TODO:
-  //
-  // - Only draw the whole header on the first
-  //   entry to the status screen. Nozzle, bed, and
-  //   fan outline bits don't change.
-  //
-  if (PAGE_UNDER(STATUS_SCREENHEIGHT + 1)) {
+  if (PAGE_UNDER(HEADER_BOTTOM)) {
 
     u8g.drawBitmapP(
       STATUS_SCREEN_X, STATUS_SCREEN_Y,
       (STATUS_SCREENWIDTH + 7) / 8, STATUS_SCREENHEIGHT,
       #if HAS_FAN0
+        status_fields.header == 1 ? status_screen1_bmp :
         #if FAN_ANIM_FRAMES > 2
-          fan_frame == 1 ? status_screen1_bmp :
-          fan_frame == 2 ? status_screen2_bmp :
+          status_fields.header == 2 ? status_screen2_bmp :
           #if FAN_ANIM_FRAMES > 3
-            fan_frame == 3 ? status_screen3_bmp :
+            status_fields.header == 3 ? status_screen3_bmp :
           #endif
-        #else
-          blink && fanSpeeds[0] ? status_screen1_bmp :
         #endif
       #endif
       status_screen0_bmp
@@ -210,22 +414,21 @@ static void lcd_implementation_status_screen() {
   // Temperature Graphics and Info
   //
 
-  if (PAGE_UNDER(28)) {
+  if (PAGE_UNDER(TEMP_BOTTOM)) {
     // Extruders
-    HOTEND_LOOP() _draw_heater_status(STATUS_SCREEN_HOTEND_TEXT_X(e), e, blink);
+    HOTEND_LOOP() _draw_heater_status(STATUS_SCREEN_HOTEND_TEXT_X(e), e);
 
     // Heated bed
     #if HOTENDS < 4 && HAS_HEATED_BED
-      _draw_heater_status(STATUS_SCREEN_BED_TEXT_X, -1, blink);
+      _draw_heater_status(STATUS_SCREEN_BED_TEXT_X, HOTENDS);
     #endif
 
     #if HAS_FAN0
-      if (PAGE_CONTAINS(20, 27)) {
+      if (PAGE_CONTAINS(FAN_TOP, FAN_BOTTOM)) {
         // Fan
-        const int16_t per = ((fanSpeeds[0] + 1) * 100) / 256;
-        if (per) {
+        if (status_fields.fan_percent) {
           lcd_moveto(STATUS_SCREEN_FAN_TEXT_X, STATUS_SCREEN_FAN_TEXT_Y);
-          lcd_put_u8str(itostr3(per));
+          lcd_put_u8str(itostr3(status_fields.fan_percent));
           lcd_put_wchar('%');
         }
       }
@@ -236,7 +439,7 @@ static void lcd_implementation_status_screen() {
     //
     // SD Card Symbol
     //
-    if (card.isFileOpen() && PAGE_CONTAINS(42 - (TALL_FONT_CORRECTION), 51 - (TALL_FONT_CORRECTION))) {
+    if (status_fields.sd_open && PAGE_CONTAINS(SD_SYMBOL_TOP, SD_SYMBOL_BOTTOM)) {
       // Upper box
       u8g.drawBox(42, 42 - (TALL_FONT_CORRECTION), 8, 7);     // 42-48 (or 41-47)
       // Right edge
@@ -248,24 +451,17 @@ static void lcd_implementation_status_screen() {
     }
   #endif // SDSUPPORT
 
-  #if ENABLED(SDSUPPORT) || ENABLED(LCD_SET_PROGRESS_MANUALLY)
+  #if ENABLED(STATUS_PROGRESS)
     //
     // Progress bar frame
     //
-    #define PROGRESS_BAR_X 54
-    #define PROGRESS_BAR_WIDTH (LCD_PIXEL_WIDTH - PROGRESS_BAR_X)
-
-    if (PAGE_CONTAINS(49, 52 - (TALL_FONT_CORRECTION)))       // 49-52 (or 49-51)
+    if (PAGE_CONTAINS(PROGRESS_BAR_TOP, PROGRESS_BAR_BOTTOM)) // 49-52 (or 49-51)
       u8g.drawFrame(
         PROGRESS_BAR_X, 49,
         PROGRESS_BAR_WIDTH, 4 - (TALL_FONT_CORRECTION)
       );
 
-    #if DISABLED(LCD_SET_PROGRESS_MANUALLY)
-      const uint8_t progress_bar_percent = card.percentDone();
-    #endif
-
-    if (progress_bar_percent > 1) {
+    if (status_fields.progress > 1) {
 
       //
       // Progress bar solid part
@@ -274,7 +470,7 @@ static void lcd_implementation_status_screen() {
       if (PAGE_CONTAINS(50, 51 - (TALL_FONT_CORRECTION)))     // 50-51 (or just 50)
         u8g.drawBox(
           PROGRESS_BAR_X + 1, 50,
-          (uint16_t)((PROGRESS_BAR_WIDTH - 2) * progress_bar_percent * 0.01), 2 - (TALL_FONT_CORRECTION)
+          (uint16_t)((PROGRESS_BAR_WIDTH - 2) * status_fields.progress * 0.01), 2 - (TALL_FONT_CORRECTION)
         );
 
       //
@@ -282,10 +478,10 @@ static void lcd_implementation_status_screen() {
       //
 
       #if ENABLED(DOGM_SD_PERCENT)
-        if (PAGE_CONTAINS(41, 48)) {
+        if (PAGE_CONTAINS(PROGRESS_TEXT_TOP, PROGRESS_TEXT_BOTTOM)) {
           // Percent complete
           lcd_moveto(55, 48);
-          lcd_put_u8str(itostr3(progress_bar_percent));
+          lcd_put_u8str(itostr3(status_fields.progress));
           lcd_put_wchar('%');
         }
       #endif
@@ -301,61 +497,19 @@ static void lcd_implementation_status_screen() {
       #define SD_DURATION_X (LCD_PIXEL_WIDTH - len * DOG_CHAR_WIDTH)
     #endif
 
-    if (PAGE_CONTAINS(41, 48)) {
-      char buffer[10];
-      duration_t elapsed = print_job_timer.duration();
-      bool has_days = (elapsed.value >= 60*60*24L);
-      uint8_t len = elapsed.toDigital(buffer, has_days);
+    if (PAGE_CONTAINS(PROGRESS_TEXT_TOP, PROGRESS_TEXT_BOTTOM)) {
+      const uint8_t len = strlen(status_fields.elapsed);
       lcd_moveto(SD_DURATION_X, 48);
-      lcd_put_u8str(buffer);
+      lcd_put_u8str(status_fields.elapsed);
     }
 
-  #endif // SDSUPPORT || LCD_SET_PROGRESS_MANUALLY
+  #endif // STATUS_PROGRESS
 
   //
   // XYZ Coordinates
   //
 
-  #define XYZ_BASELINE (30 + INFO_FONT_HEIGHT)
-
-  #define X_LABEL_POS  3
-  #define X_VALUE_POS 11
-  #define XYZ_SPACING 40
-
-  #if ENABLED(XYZ_HOLLOW_FRAME)
-    #define XYZ_FRAME_TOP 29
-    #define XYZ_FRAME_HEIGHT INFO_FONT_HEIGHT + 3
-  #else
-    #define XYZ_FRAME_TOP 30
-    #define XYZ_FRAME_HEIGHT INFO_FONT_HEIGHT + 1
-  #endif
-
-  // Before homing the axis letters are blinking 'X' <-> '?'.
-  // When axis is homed but axis_known_position is false the axis letters are blinking 'X' <-> ' '.
-  // When everything is ok you see a constant 'X'.
-
-  static char xstring[5], ystring[5], zstring[7];
-  #if ENABLED(FILAMENT_LCD_DISPLAY)
-    static char wstring[5], mstring[4];
-  #endif
-
-  // At the first page, regenerate the XYZ strings
-  if (page.page == 0) {
-    strcpy(xstring, ftostr4sign(LOGICAL_X_POSITION(current_position[X_AXIS])));
-    strcpy(ystring, ftostr4sign(LOGICAL_Y_POSITION(current_position[Y_AXIS])));
-    strcpy(zstring, ftostr52sp(FIXFLOAT(LOGICAL_Z_POSITION(current_position[Z_AXIS]))));
-    #if ENABLED(FILAMENT_LCD_DISPLAY)
-      strcpy(wstring, ftostr12ns(filament_width_meas));
-      strcpy(mstring, itostr3(100.0 * (
-          parser.volumetric_enabled
-            ? planner.volumetric_area_nominal / planner.volumetric_multiplier[FILAMENT_SENSOR_EXTRUDER_NUM]
-            : planner.volumetric_multiplier[FILAMENT_SENSOR_EXTRUDER_NUM]
-        )
-      ));
-    #endif
-  }
-
-  if (PAGE_CONTAINS(XYZ_FRAME_TOP, XYZ_FRAME_TOP + XYZ_FRAME_HEIGHT - 1)) {
+  if (PAGE_CONTAINS(XYZ_FRAME_TOP, XYZ_FRAME_BOTTOM)) {
 
     #if ENABLED(XYZ_HOLLOW_FRAME)
       u8g.drawFrame(0, XYZ_FRAME_TOP, LCD_PIXEL_WIDTH, XYZ_FRAME_HEIGHT); // 8: 29-40  7: 29-39
@@ -370,19 +524,19 @@ static void lcd_implementation_status_screen() {
       #endif
 
       lcd_moveto(0 * XYZ_SPACING + X_LABEL_POS, XYZ_BASELINE);
-      _draw_axis_label(X_AXIS, PSTR(MSG_X), blink);
+      _draw_axis_label(status_fields.axis_label[X_AXIS], PSTR(MSG_X));
       lcd_moveto(0 * XYZ_SPACING + X_VALUE_POS, XYZ_BASELINE);
-      lcd_put_u8str(xstring);
+      lcd_put_u8str(status_fields.xstring);
 
       lcd_moveto(1 * XYZ_SPACING + X_LABEL_POS, XYZ_BASELINE);
-      _draw_axis_label(Y_AXIS, PSTR(MSG_Y), blink);
+      _draw_axis_label(status_fields.axis_label[Y_AXIS], PSTR(MSG_Y));
       lcd_moveto(1 * XYZ_SPACING + X_VALUE_POS, XYZ_BASELINE);
-      lcd_put_u8str(ystring);
+      lcd_put_u8str(status_fields.ystring);
 
       lcd_moveto(2 * XYZ_SPACING + X_LABEL_POS, XYZ_BASELINE);
-      _draw_axis_label(Z_AXIS, PSTR(MSG_Z), blink);
+      _draw_axis_label(status_fields.axis_label[Z_AXIS], PSTR(MSG_Z));
       lcd_moveto(2 * XYZ_SPACING + X_VALUE_POS, XYZ_BASELINE);
-      lcd_put_u8str(zstring);
+      lcd_put_u8str(status_fields.zstring);
 
       #if DISABLED(XYZ_HOLLOW_FRAME)
         u8g.setColorIndex(1); // black on white
@@ -394,14 +548,14 @@ static void lcd_implementation_status_screen() {
   // Feedrate
   //
 
-  if (PAGE_CONTAINS(51 - INFO_FONT_HEIGHT, 49)) {
+  if (PAGE_CONTAINS(FEEDRATE_TOP, FEEDRATE_BOTTOM)) {
     lcd_setFont(FONT_MENU);
     lcd_moveto(3, 50);
     lcd_put_wchar(LCD_STR_FEEDRATE[0]);
 
     lcd_setFont(FONT_STATUSMENU);
     lcd_moveto(12, 50);
-    lcd_put_u8str(itostr3(feedrate_percentage));
+    lcd_put_u8str(itostr3(status_fields.feedrate));
     lcd_put_wchar('%');
 
     //
@@ -409,9 +563,9 @@ static void lcd_implementation_status_screen() {
     //
     #if ENABLED(FILAMENT_LCD_DISPLAY) && DISABLED(SDSUPPORT)
       lcd_moveto(56, 50);
-      lcd_put_u8str(wstring);
+      lcd_put_u8str(status_fields.wstring);
       lcd_moveto(102, 50);
-      lcd_put_u8str(mstring);
+      lcd_put_u8str(status_fields.mstring);
       lcd_put_wchar('%');
       lcd_setFont(FONT_MENU);
       lcd_moveto(47, 50);
@@ -425,26 +579,24 @@ static void lcd_implementation_status_screen() {
   // Status line
   //
 
-  #define STATUS_BASELINE (55 + INFO_FONT_HEIGHT)
-
-  if (PAGE_CONTAINS(STATUS_BASELINE - (INFO_FONT_HEIGHT - 1), STATUS_BASELINE)) {
+  if (PAGE_CONTAINS(STATUS_TOP, STATUS_BASELINE)) {
     lcd_moveto(0, STATUS_BASELINE);
 
     #if ENABLED(FILAMENT_LCD_DISPLAY) && ENABLED(SDSUPPORT)
-      if (PENDING(millis(), previous_lcd_status_ms + 5000UL)) {  //Display both Status message line and Filament display on the last line
-        lcd_implementation_status_message(blink);
+      if (!status_fields.show_filament) {  //Display both Status message line and Filament display on the last line
+        lcd_implementation_status_message();
       }
       else {
         lcd_put_u8str_rom(PSTR(LCD_STR_FILAM_DIA));
         lcd_put_wchar(':');
-        lcd_put_u8str(wstring);
+        lcd_put_u8str(status_fields.wstring);
         lcd_put_u8str_rom(PSTR("  " LCD_STR_FILAM_MUL));
         lcd_put_wchar(':');
-        lcd_put_u8str(mstring);
+        lcd_put_u8str(status_fields.mstring);
         lcd_put_wchar('%');
       }
     #else
-      lcd_implementation_status_message(blink);
+      lcd_implementation_status_message();
     #endif
   }
 }
@@ -85,6 +85,13 @@ static const uint8_t u8g_dev_st7920_128x64_HAL_init_seq[] PROGMEM = {
   U8G_ESC_END         // end of sequence
 };
 
+#if ENABLED(DOGM_DIRTY_STRIPES) && DISABLED(LCD_SCREEN_ROT_90) && DISABLED(LCD_SCREEN_ROT_180) && DISABLED(LCD_SCREEN_ROT_270)
+  extern uint8_t lcd_dirty_bands;
+  #define ST7920_ROW_CHANGED(y) TEST(lcd_dirty_bands, (y) >> 3)
+#else
+  #define ST7920_ROW_CHANGED(y) true
+#endif
+
 void clear_graphics_DRAM(u8g_t *u8g, u8g_dev_t *dev){
   u8g_SetChipSelect(u8g, dev, 1);
   u8g_Delay(1);
@@ -124,6 +131,11 @@ uint8_t u8g_dev_st7920_128x64_HAL_fn(u8g_t *u8g, u8g_dev_t *dev, uint8_t msg, vo
       y = pb->p.page_y0;
       ptr = (uint8_t *)pb->buf;
       for (i = 0; i < 8; i ++) {
+        if (!ST7920_ROW_CHANGED(y)) {         /* the display already shows this row */
+          ptr += WIDTH/8;
+          y++;
+          continue;
+        }
         u8g_SetAddress(u8g, dev, 0);           /* cmd mode */
         u8g_WriteByte(u8g, dev, 0x03e );      /* enable extended mode */
 
@@ -169,6 +181,11 @@ uint8_t u8g_dev_st7920_128x64_HAL_4x_fn(u8g_t *u8g, u8g_dev_t *dev, uint8_t msg,
       y = pb->p.page_y0;
       ptr = (uint8_t *)pb->buf;
       for (i = 0; i < 32; i ++) {
+        if (!ST7920_ROW_CHANGED(y)) {         /* the display already shows this row */
+          ptr += WIDTH/8;
+          y++;
+          continue;
+        }
         u8g_SetAddress(u8g, dev, 0);           /* cmd mode */
         u8g_WriteByte(u8g, dev, 0x03e );      /* enable extended mode */
 
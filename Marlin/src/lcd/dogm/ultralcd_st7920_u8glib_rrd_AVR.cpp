@@ -114,6 +114,13 @@ static void ST7920_SWSPI_SND_8BIT(uint8_t val) {
 #define ST7920_WRITE_BYTE(a)     { ST7920_SWSPI_SND_8BIT((uint8_t)((a)&0xF0u)); ST7920_SWSPI_SND_8BIT((uint8_t)((a)<<4u)); U8G_DELAY(); }
 #define ST7920_WRITE_BYTES(p,l)  { for (uint8_t i = l + 1; --i;) { ST7920_SWSPI_SND_8BIT(*p&0xF0); ST7920_SWSPI_SND_8BIT(*p<<4); p++; } U8G_DELAY(); }
 
+#if ENABLED(DOGM_DIRTY_STRIPES) && DISABLED(LCD_SCREEN_ROT_90) && DISABLED(LCD_SCREEN_ROT_180) && DISABLED(LCD_SCREEN_ROT_270)
+  extern uint8_t lcd_dirty_bands;
+  #define ST7920_ROW_CHANGED(y) TEST(lcd_dirty_bands, (y) >> 3)
+#else
+  #define ST7920_ROW_CHANGED(y) true
+#endif
+
 uint8_t u8g_dev_rrd_st7920_128x64_fn(u8g_t *u8g, u8g_dev_t *dev, uint8_t msg, void *arg) {
   uint8_t i, y;
   switch (msg) {
@@ -154,6 +161,11 @@ uint8_t u8g_dev_rrd_st7920_128x64_fn(u8g_t *u8g, u8g_dev_t *dev, uint8_t msg, vo
 
       ST7920_CS();
       for (i = 0; i < PAGE_HEIGHT; i ++) {
+        if (!ST7920_ROW_CHANGED(y)) {       // The display already shows this row
+          ptr += (LCD_PIXEL_WIDTH) / 8;
+          y++;
+          continue;
+        }
         ST7920_SET_CMD();
         if (y < 32) {
           ST7920_WRITE_BYTE(0x80 | y);       //y
@@ -60,6 +60,10 @@
 
 #include "../Marlin.h"
 
+#if ENABLED(CODE_PROFILER)
+  #include "../feature/profiler.h"
+#endif
+
 // On the Malyan M200, this will be Serial1. On a RAMPS board,
 // it might not be.
 #define LCD_SERIAL Serial1
@@ -394,6 +398,10 @@ void update_usb_status(const bool forceUpdate) {
  * error for amtel.
  */
 void lcd_update() {
+  #if ENABLED(CODE_PROFILER)
+    PROFILE_ZONE(PROFILE_LCD_UPDATE);
+  #endif
+
   static char inbound_buffer[MAX_CURLY_COMMAND];
 
   // First report USB status.
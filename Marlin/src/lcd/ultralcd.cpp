@@ -32,6 +32,7 @@
 #include "../module/stepper.h"
 #include "../module/motion.h"
 #include "../module/probe.h"
+#include "../module/segment_producer.h"
 #include "../module/printcounter.h"
 #include "../gcode/gcode.h"
 #include "../gcode/queue.h"
@@ -76,6 +77,10 @@
   #include "../feature/tmc_util.h"
 #endif
 
+#if ENABLED(CODE_PROFILER)
+  #include "../feature/profiler.h"
+#endif
+
 #if ENABLED(AUTO_BED_LEVELING_UBL) || ENABLED(G26_MESH_VALIDATION)
   bool lcd_external_control; // = false
 #endif
@@ -878,11 +883,7 @@ void kill_screen(const char* lcd_msg) {
       lcd_return_to_status();
 
       #if ENABLED(POWER_LOSS_RECOVERY)
-        card.openJobRecoveryFile(false);
-        job_recovery_info.valid_head = job_recovery_info.valid_foot = 0;
-        (void)card.saveJobRecoveryInfo();
-        card.closeJobRecoveryFile();
-        job_recovery_commands_count = 0;
+        cancel_job_recovery();
       #endif
     }
 
@@ -905,19 +906,19 @@ void kill_screen(const char* lcd_msg) {
 
       #if HAS_HEATED_BED
         // Restore the bed temperature
-        sprintf_P(cmd, PSTR("M190 S%i"), job_recovery_info.target_temperature_bed);
+        sprintf_P(cmd, PSTR("M190 S%i"), job_recovery_info.state.target_temperature_bed);
         enqueue_and_echo_command(cmd);
       #endif
 
       // Restore all hotend temperatures
       HOTEND_LOOP() {
-        sprintf_P(cmd, PSTR("M109 S%i"), job_recovery_info.target_temperature[e]);
+        sprintf_P(cmd, PSTR("M109 S%i"), job_recovery_info.state.target_temperature[e]);
         enqueue_and_echo_command(cmd);
       }
 
       // Restore print cooling fan speeds
       for (uint8_t i = 0; i < FAN_COUNT; i++) {
-        sprintf_P(cmd, PSTR("M106 P%i S%i"), i, job_recovery_info.fanSpeeds[i]);
+        sprintf_P(cmd, PSTR("M106 P%i S%i"), i, job_recovery_info.state.fanSpeeds[i]);
         enqueue_and_echo_command(cmd);
       }
 
@@ -925,8 +926,8 @@ void kill_screen(const char* lcd_msg) {
       job_recovery_phase = JOB_RECOVERY_YES;
 
       // Resume the print job timer
-      if (job_recovery_info.print_job_elapsed)
-        print_job_timer.resume(job_recovery_info.print_job_elapsed);
+      if (job_recovery_info.entry.print_job_elapsed)
+        print_job_timer.resume(job_recovery_info.entry.print_job_elapsed);
 
       // Start getting commands from SD
       card.startFileprint();
@@ -2692,6 +2693,7 @@ void kill_screen(const char* lcd_msg) {
 
     void _lcd_do_nothing() {}
     void _lcd_hard_stop() {
+      segment_feed.abort();
       stepper.quick_stop();
       const screenFunc_t old_screen = currentScreen;
       currentScreen = _lcd_do_nothing;
@@ -3948,6 +3950,9 @@ void kill_screen(const char* lcd_msg) {
       START_MENU();
       MENU_BACK(MSG_MOTION);
 
+      #if ENABLED(JUNCTION_DEVIATION)
+        MENU_ITEM_EDIT(float43, MSG_JUNCTION_DEVIATION, &planner.junction_deviation_mm, 0.01, 0.3);
+      #endif
       MENU_ITEM_EDIT(float3, MSG_VA_JERK, &planner.max_jerk[A_AXIS], 1, 990);
       MENU_ITEM_EDIT(float3, MSG_VB_JERK, &planner.max_jerk[B_AXIS], 1, 990);
       #if ENABLED(DELTA)
@@ -5300,6 +5305,9 @@ bool lcd_blink() {
  * No worries. This function is only called from the main thread.
  */
 void lcd_update() {
+  #if ENABLED(CODE_PROFILER)
+    PROFILE_ZONE(PROFILE_LCD_UPDATE);
+  #endif
 
   #if ENABLED(ULTIPANEL)
     static millis_t return_to_status_ms = 0;
@@ -5344,7 +5352,7 @@ void lcd_update() {
     const bool sd_status = IS_SD_INSERTED;
     if (sd_status != lcd_sd_status && lcd_detected()) {
 
-      bool old_sd_status = lcd_sd_status; // prevent re-entry to this block!
+      const uint8_t old_sd_status = lcd_sd_status; // prevent re-entry to this block!
       lcd_sd_status = sd_status;
 
       if (sd_status) {
@@ -5520,9 +5528,22 @@ void lcd_update() {
           constexpr bool do_u8g_loop = true;
         #endif
         if (do_u8g_loop) {
+          #if ENABLED(DOGM_DIRTY_STRIPES)
+            static bool status_frame;                   // Drawing the Info Screen
+          #endif
           if (!drawing_screen) {                        // If not already drawing pages
             u8g.firstPage();                            // Start the first page
             drawing_screen = first_page = true;         // Flag as drawing pages
+            #if ENABLED(DOGM_DIRTY_STRIPES)
+              // The Info Screen marks its changes over the last complete frame. Anything else is redrawn.
+              #if ENABLED(ULTIPANEL)
+                status_frame = currentScreen == lcd_status_screen;
+              #else
+                status_frame = true;
+              #endif
+              lcd_dirty_bands = status_frame && lcd_frame_retained ? 0x00 : 0xFF;
+              lcd_frame_retained = false;               // Until this frame is complete
+            #endif
           }
           lcd_setFont(FONT_MENU);                       // Setup font for every page draw
           u8g.setColorIndex(1);                         // And reset the color
@@ -5532,7 +5553,15 @@ void lcd_update() {
           // The screen handler can clear drawing_screen for an action that changes the screen.
           // If still drawing and there's another page, update max-time and return now.
           // The nextPage will already be set up on the next call.
-          if (drawing_screen && (drawing_screen = u8g.nextPage())) {
+          #if ENABLED(DOGM_DIRTY_STRIPES)
+            if (!drawing_screen)
+              lcd_dirty_bands = 0xFF;                   // Interrupted, so the next frame is drawn in full
+            else if (!(drawing_screen = lcd_next_page()))
+              lcd_frame_retained = status_frame;        // Complete, so the next Info Screen frame can update it
+            if (drawing_screen) {
+          #else
+            if (drawing_screen && (drawing_screen = u8g.nextPage())) {
+          #endif
             NOLESS(max_display_update_time, millis() - ms);
             return;
           }
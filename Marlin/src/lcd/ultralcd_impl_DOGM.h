@@ -207,6 +207,45 @@ u8g_page_t &page = ((u8g_pb_t *)((u8g.getU8g())->dev->dev_mem))->p;
 #define PAGE_UNDER(yb) (u8g.getU8g()->current_page.y0 <= (yb))
 #define PAGE_CONTAINS(ya, yb) (PAGE_UNDER(yb) && u8g.getU8g()->current_page.y1 >= (ya))
 
+#if ENABLED(DOGM_DIRTY_STRIPES)
+
+  /**
+   * Dirty stripes
+   *
+   * The rows of the display are grouped in 8-row bands. A screen marks the
+   * bands it has changed since the last complete frame, and the pages that
+   * don't touch any of them are neither drawn nor sent to the display. The
+   * ST7920 devices also leave out the clean rows of the pages they send.
+   * Screens other than the Info Screen don't track changes, so all their
+   * bands are dirty.
+   */
+  #define LCD_BAND(y) ((y) >> 3 > 7 ? 7 : (y) >> 3)
+  #define LCD_BANDS(ya, yb) (uint8_t)((0xFFU >> (7 - LCD_BAND(yb))) & (0xFFU << LCD_BAND(ya)))
+
+  uint8_t lcd_dirty_bands = 0xFF; // Bands of the frame being drawn that differ from the display
+  bool lcd_frame_retained;        // The display holds the last complete Info Screen frame
+
+  inline bool lcd_page_dirty() {
+    const u8g_box_t &box = u8g.getU8g()->current_page;
+    return lcd_dirty_bands & LCD_BANDS(box.y0, box.y1);
+  }
+
+  // Send the page just drawn if it's dirty, then step over the clean pages that follow
+  static bool lcd_next_page() {
+    u8g_dev_t * const dev = u8g.getU8g()->dev;
+    const u8g_com_fnptr com_fn = dev->com_fn;
+    bool more;
+    do {
+      if (!lcd_page_dirty()) dev->com_fn = u8g_com_null_fn;
+      more = u8g.nextPage();
+      dev->com_fn = com_fn;
+    } while (more && !lcd_page_dirty());
+    if (!more) lcd_dirty_bands = 0xFF;  // Screens drawn outside of lcd_update are sent in full
+    return more;
+  }
+
+#endif
+
 static void lcd_setFont(const char font_nr) {
   switch (font_nr) {
     case FONT_STATUSMENU : {u8g.setFont(FONT_STATUSMENU_NAME); currentfont = FONT_STATUSMENU;}; break;
@@ -326,6 +365,10 @@ static void lcd_implementation_init() {
   #endif
 
   uxg_SetUtf8Fonts (g_fontinfo, NUM_ARRAY(g_fontinfo));
+
+  #if ENABLED(DOGM_DIRTY_STRIPES)
+    lcd_frame_retained = false; // The display may have been reset
+  #endif
 }
 
 // The kill screen is displayed for unrecoverable conditions
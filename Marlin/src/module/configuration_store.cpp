@@ -37,7 +37,7 @@
  */
 
 // Change EEPROM version if the structure changes
-#define EEPROM_VERSION "V54"
+#define EEPROM_VERSION "V56"
 #define EEPROM_OFFSET 100
 
 // Check the integrity of data offsets.
@@ -92,6 +92,7 @@
 
 typedef struct PID { float Kp, Ki, Kd; } PID;
 typedef struct PIDC { float Kp, Ki, Kd, Kc; } PIDC;
+typedef struct MPC { float P, C, R, A, H; } MPC;
 
 /**
  * Current EEPROM Layout
@@ -118,6 +119,7 @@ typedef struct SettingsDataStruct {
             planner_min_travel_feedrate_mm_s;           // M205 T     planner.min_travel_feedrate_mm_s
   uint32_t  planner_min_segment_time_us;                // M205 B     planner.min_segment_time_us
   float     planner_max_jerk[XYZE];                     // M205 XYZE  planner.max_jerk[XYZE]
+  float     planner_junction_deviation_mm;              // M205 J     planner.junction_deviation_mm
 
   float home_offset[XYZ];                               // M206 XYZ
 
@@ -205,6 +207,11 @@ typedef struct SettingsDataStruct {
   //
   PID bedPID;                                           // M304 PID / M303 E-1 U
 
+  //
+  // MPCTEMP
+  //
+  MPC hotendMPC[MAX_EXTRUDERS];                         // M306 En PCRAH / M306 En T
+
   //
   // HAS_LCD_CONTRAST
   //
@@ -337,6 +344,18 @@ void MarlinSettings::postprocess() {
 #if ENABLED(EEPROM_SETTINGS)
   #include "../HAL/persistent_store_api.h"
 
+  #if ENABLED(EEPROM_JOURNAL)
+    #include "../HAL/persistent_store_journal.h"
+    // A compaction copies everything saved into one bank: the settings, and the UBL mesh slots below the MAT
+    #if ENABLED(AUTO_BED_LEVELING_UBL)
+      static_assert(JOURNAL_BANK_NEEDS(E2END - 127 - (EEPROM_OFFSET), 2) <= JOURNAL_BANK_SIZE,
+        "EEPROM_JOURNAL: The settings and the UBL mesh slots up to E2END don't fit in one journal bank. Lower E2END.");
+    #else
+      static_assert(JOURNAL_BANK_NEEDS(sizeof(SettingsData), 1) <= JOURNAL_BANK_SIZE,
+        "EEPROM_JOURNAL: The settings don't fit in one journal bank.");
+    #endif
+  #endif
+
   #define DUMMY_PID_VALUE 3000.0f
   #define EEPROM_START() int eeprom_index = EEPROM_OFFSET; HAL::PersistentStore::access_start()
   #define EEPROM_FINISH() HAL::PersistentStore::access_finish()
@@ -383,8 +402,8 @@ void MarlinSettings::postprocess() {
     EEPROM_START();
 
     eeprom_error = false;
-    #if ENABLED(FLASH_EEPROM_EMULATION)
-      EEPROM_SKIP(ver);   // Flash doesn't allow rewriting without erase
+    #if ENABLED(FLASH_EEPROM_EMULATION) || ENABLED(EEPROM_JOURNAL)
+      EEPROM_SKIP(ver);   // Flash doesn't allow rewriting without erase. The journal commits a save all at once.
     #else
       EEPROM_WRITE(ver);  // invalidate data first
     #endif
@@ -409,6 +428,13 @@ void MarlinSettings::postprocess() {
     EEPROM_WRITE(planner.min_segment_time_us);
     EEPROM_WRITE(planner.max_jerk);
 
+    #if ENABLED(JUNCTION_DEVIATION)
+      EEPROM_WRITE(planner.junction_deviation_mm);
+    #else
+      dummy = 0.02;
+      EEPROM_WRITE(dummy);
+    #endif
+
     _FIELD_TEST(home_offset);
 
     #if !HAS_HOME_OFFSET
@@ -607,6 +633,17 @@ void MarlinSettings::postprocess() {
       EEPROM_WRITE(thermalManager.bedKd);
     #endif
 
+    _FIELD_TEST(hotendMPC);
+
+    #if ENABLED(MPCTEMP)
+      HOTEND_LOOP() EEPROM_WRITE(thermalManager.mpc[e]);
+      dummy = 0.0f;
+      for (uint8_t q = (MAX_EXTRUDERS - HOTENDS) * 5; q--;) EEPROM_WRITE(dummy);
+    #else
+      dummy = 0.0f;
+      for (uint8_t q = MAX_EXTRUDERS * 5; q--;) EEPROM_WRITE(dummy); // P, C, R, A, H
+    #endif
+
     _FIELD_TEST(lcd_contrast);
 
     #if !HAS_LCD_CONTRAST
@@ -895,27 +932,34 @@ void MarlinSettings::postprocess() {
     //
     // Validate CRC and Data Size
     //
+    const uint16_t eeprom_size = eeprom_index - (EEPROM_OFFSET),
+                   final_crc = working_crc;
     if (!eeprom_error) {
-      const uint16_t eeprom_size = eeprom_index - (EEPROM_OFFSET),
-                     final_crc = working_crc;
-
       // Write the EEPROM header
       eeprom_index = EEPROM_OFFSET;
 
       EEPROM_WRITE(version);
       EEPROM_WRITE(final_crc);
 
-      // Report storage size
-      #if ENABLED(EEPROM_CHITCHAT)
+      eeprom_error |= size_error(eeprom_size);
+    }
+
+    // Flash emulations (EEPROM_JOURNAL) only write the data here
+    if (!EEPROM_FINISH()) {
+      SERIAL_ERROR_START_P(port);
+      SERIAL_ERRORLNPGM_P(port, MSG_ERR_EEPROM_WRITE);
+      eeprom_error = true;
+    }
+
+    // Report storage size
+    #if ENABLED(EEPROM_CHITCHAT)
+      if (!eeprom_error) {
         SERIAL_ECHO_START_P(port);
         SERIAL_ECHOPAIR_P(port, "Settings Stored (", eeprom_size);
         SERIAL_ECHOPAIR_P(port, " bytes; crc ", (uint32_t)final_crc);
         SERIAL_ECHOLNPGM_P(port, ")");
-      #endif
-
-      eeprom_error |= size_error(eeprom_size);
-    }
-    EEPROM_FINISH();
+      }
+    #endif
 
     //
     // UBL Mesh
@@ -998,6 +1042,12 @@ void MarlinSettings::postprocess() {
       EEPROM_READ(planner.min_segment_time_us);
       EEPROM_READ(planner.max_jerk);
 
+      #if ENABLED(JUNCTION_DEVIATION)
+        EEPROM_READ(planner.junction_deviation_mm);
+      #else
+        EEPROM_READ(dummy);
+      #endif
+
       //
       // Home Offset (M206)
       //
@@ -1219,6 +1269,19 @@ void MarlinSettings::postprocess() {
         for (uint8_t q=3; q--;) EEPROM_READ(dummy); // bedKp, bedKi, bedKd
       #endif
 
+      //
+      // Hotend Thermal Model
+      //
+
+      _FIELD_TEST(hotendMPC);
+
+      #if ENABLED(MPCTEMP)
+        HOTEND_LOOP() EEPROM_READ(thermalManager.mpc[e]);
+        for (uint8_t q = (MAX_EXTRUDERS - HOTENDS) * 5; q--;) EEPROM_READ(dummy);
+      #else
+        for (uint8_t q = MAX_EXTRUDERS * 5; q--;) EEPROM_READ(dummy); // P, C, R, A, H
+      #endif
+
       //
       // LCD Contrast
       //
@@ -1616,8 +1679,8 @@ void MarlinSettings::postprocess() {
         uint16_t crc = 0;
 
         HAL::PersistentStore::access_start();
-        const bool status = HAL::PersistentStore::write_data(pos, (uint8_t *)&ubl.z_values, sizeof(ubl.z_values), &crc);
-        HAL::PersistentStore::access_finish();
+        bool status = HAL::PersistentStore::write_data(pos, (uint8_t *)&ubl.z_values, sizeof(ubl.z_values), &crc);
+        if (!HAL::PersistentStore::access_finish()) status = true;
 
         if (status)
           SERIAL_PROTOCOLPGM("?Unable to save mesh data.\n");
@@ -1713,6 +1776,10 @@ void MarlinSettings::reset(PORTARG_SOLO) {
   planner.max_jerk[Z_AXIS] = DEFAULT_ZJERK;
   planner.max_jerk[E_AXIS] = DEFAULT_EJERK;
 
+  #if ENABLED(JUNCTION_DEVIATION)
+    planner.junction_deviation_mm = JUNCTION_DEVIATION_MM;
+  #endif
+
   #if HAS_HOME_OFFSET
     ZERO(home_offset);
   #endif
@@ -1817,6 +1884,16 @@ void MarlinSettings::reset(PORTARG_SOLO) {
     #if ENABLED(PID_EXTRUSION_SCALING)
       lpq_len = 20; // default last-position-queue size
     #endif
+    #if ENABLED(MPCTEMP)
+      HOTEND_LOOP() {
+        mpc_t &mpc = thermalManager.mpc[e];
+        mpc.heater_power = MPC_HEATER_POWER;
+        mpc.block_heat_capacity = MPC_BLOCK_HEAT_CAPACITY;
+        mpc.sensor_responsiveness = MPC_SENSOR_RESPONSIVENESS;
+        mpc.ambient_xfer_coeff = MPC_AMBIENT_XFER_COEFF;
+        mpc.filament_heat_capacity = MPC_FILAMENT_HEAT_CAPACITY;
+      }
+    #endif
   #endif // PIDTEMP
 
   #if ENABLED(PIDTEMPBED)
@@ -2071,12 +2148,19 @@ void MarlinSettings::reset(PORTARG_SOLO) {
 
     if (!forReplay) {
       CONFIG_ECHO_START;
-      SERIAL_ECHOLNPGM_P(port, "Advanced: S<min_feedrate> T<min_travel_feedrate> B<min_segment_time_us> X<max_xy_jerk> Z<max_z_jerk> E<max_e_jerk>");
+      SERIAL_ECHOLNPGM_P(port, "Advanced: S<min_feedrate> T<min_travel_feedrate> B<min_segment_time_us>"
+        #if ENABLED(JUNCTION_DEVIATION)
+          " J<junc_dev>"
+        #endif
+        " X<max_xy_jerk> Z<max_z_jerk> E<max_e_jerk>");
     }
     CONFIG_ECHO_START;
     SERIAL_ECHOPAIR_P(port, "  M205 S", LINEAR_UNIT(planner.min_feedrate_mm_s));
     SERIAL_ECHOPAIR_P(port, " T", LINEAR_UNIT(planner.min_travel_feedrate_mm_s));
     SERIAL_ECHOPAIR_P(port, " B", planner.min_segment_time_us);
+    #if ENABLED(JUNCTION_DEVIATION)
+      SERIAL_ECHOPAIR_P(port, " J", LINEAR_UNIT(planner.junction_deviation_mm));
+    #endif
     SERIAL_ECHOPAIR_P(port, " X", LINEAR_UNIT(planner.max_jerk[X_AXIS]));
     SERIAL_ECHOPAIR_P(port, " Y", LINEAR_UNIT(planner.max_jerk[Y_AXIS]));
     SERIAL_ECHOPAIR_P(port, " Z", LINEAR_UNIT(planner.max_jerk[Z_AXIS]));
@@ -2300,6 +2384,29 @@ void MarlinSettings::reset(PORTARG_SOLO) {
 
     #endif // PIDTEMP || PIDTEMPBED
 
+    #if ENABLED(MPCTEMP)
+
+      if (!forReplay) {
+        CONFIG_ECHO_START;
+        SERIAL_ECHOLNPGM_P(port, "Hotend thermal model: P<W> C<J/K> R<1/s> A<W/K> H<J/K/mm>");
+      }
+      HOTEND_LOOP() {
+        const mpc_t &mpc = thermalManager.mpc[e];
+        CONFIG_ECHO_START;
+        SERIAL_ECHOPGM_P(port, "  M306");
+        #if HOTENDS > 1
+          SERIAL_ECHOPAIR_P(port, " E", e);
+        #endif
+        SERIAL_ECHOPAIR_P(port, " P", mpc.heater_power);
+        SERIAL_ECHOPAIR_P(port, " C", mpc.block_heat_capacity);
+        SERIAL_ECHOPGM_P(port, " R"); SERIAL_ECHO_F_P(port, mpc.sensor_responsiveness, 4);
+        SERIAL_ECHOPGM_P(port, " A"); SERIAL_ECHO_F_P(port, mpc.ambient_xfer_coeff, 4);
+        SERIAL_ECHOPGM_P(port, " H"); SERIAL_ECHO_F_P(port, mpc.filament_heat_capacity, 4);
+        SERIAL_EOL_P(port);
+      }
+
+    #endif // MPCTEMP
+
     #if HAS_LCD_CONTRAST
       if (!forReplay) {
         CONFIG_ECHO_START;
@@ -140,6 +140,102 @@ void inverse_kinematics(const float raw[XYZ]) {
   #endif
 }
 
+// Radicand of each tower, its change over the next segment, and the (constant) change of that
+static float segment_radicand[ABC], segment_step[ABC], segment_step_change;
+
+/**
+ * With w the XY vector from the start to a tower and s the XY
+ * distance per segment, the radicand after k segments is
+ *
+ *   q(k) = q(0) + 2k (w . s) - k^2 |s|^2
+ *
+ * so q(k+1) - q(k) = 2 (w . s) - (2k + 1) |s|^2 changes by
+ * -2 |s|^2 every segment.
+ */
+void delta_segments_init(const float raw[XYZ], const float segment[XYZ]) {
+  #if HOTENDS > 1
+    const float x = raw[X_AXIS] - hotend_offset[X_AXIS][active_extruder],
+                y = raw[Y_AXIS] - hotend_offset[Y_AXIS][active_extruder];
+  #else
+    const float x = raw[X_AXIS], y = raw[Y_AXIS];
+  #endif
+  const float s2 = HYPOT2(segment[X_AXIS], segment[Y_AXIS]);
+  segment_step_change = -2 * s2;
+  LOOP_XYZ(tower) {
+    const float wx = delta_tower[tower][X_AXIS] - x, wy = delta_tower[tower][Y_AXIS] - y;
+    segment_radicand[tower] = delta_diagonal_rod_2_tower[tower] - HYPOT2(wx, wy);
+    segment_step[tower] = 2 * (wx * segment[X_AXIS] + wy * segment[Y_AXIS]) - s2;
+  }
+}
+
+void delta_segments_next(const float z) {
+  LOOP_XYZ(tower) {
+    segment_radicand[tower] += segment_step[tower];
+    segment_step[tower] += segment_step_change;
+    delta[tower] = z + _SQRT(segment_radicand[tower]);
+  }
+}
+
+/**
+ * After k of the batch's segments the radicand is
+ *
+ *   q + k d + k (k - 1) / 2 c
+ *
+ * with q, d and c the stepping state above.
+ */
+void _O3 delta_segments_next(const uint8_t count, const float z, const float dz, float (&carriage)[ABC][DELTA_SEGMENT_BATCH]) {
+  float k[DELTA_SEGMENT_BATCH], triangle[DELTA_SEGMENT_BATCH];
+  for (uint8_t i = 0; i < DELTA_SEGMENT_BATCH; i++) {
+    k[i] = i + 1;
+    triangle[i] = k[i] * i * 0.5f;
+  }
+  const float c = segment_step_change;
+  LOOP_XYZ(tower) {
+    const float q = segment_radicand[tower], d = segment_step[tower];
+    float * const out = carriage[tower];
+    for (uint8_t i = 0; i < count; i++)
+      out[i] = z + k[i] * dz + _SQRT(q + k[i] * d + triangle[i] * c);
+    segment_radicand[tower] = q + k[count - 1] * d + triangle[count - 1] * c;
+    segment_step[tower] = d + count * c;
+  }
+}
+
+#ifdef DELTA_SEGMENT_TOLERANCE
+
+  /**
+   * The radicand in DELTA_Z for a tower: the squared rod length
+   * less the squared distance from the tower in XY.
+   */
+  static float delta_radicand(const uint8_t tower, const float raw[XYZ]) {
+    #if HOTENDS > 1
+      const float x = raw[X_AXIS] - hotend_offset[X_AXIS][active_extruder],
+                  y = raw[Y_AXIS] - hotend_offset[Y_AXIS][active_extruder];
+    #else
+      const float x = raw[X_AXIS], y = raw[Y_AXIS];
+    #endif
+    return delta_diagonal_rod_2_tower[tower] - HYPOT2(delta_tower[tower][X_AXIS] - x, delta_tower[tower][Y_AXIS] - y);
+  }
+
+  /**
+   * A carriage is at Z + sqrt(q) with q = L^2 - d^2 for rod length L
+   * and tower distance d. Over XY travel the second derivative of its
+   * height is at most L^2 / q^(3/2), and q is concave along a line so
+   * it's lowest at one end. A segment of length l strays l^2 / 8 times
+   * the second derivative from the true carriage path.
+   */
+  uint16_t delta_segments_for_tolerance(const float start[XYZ], const float target[XYZ], const float xy_mm) {
+    float curvature = 0;
+    LOOP_XYZ(tower) {
+      float q = min(delta_radicand(tower, start), delta_radicand(tower, target));
+      NOLESS(q, 1);
+      NOLESS(curvature, delta_diagonal_rod_2_tower[tower] / (q * SQRT(q)));
+    }
+    const float segments = xy_mm * SQRT(curvature * (1.0f / (8 * (DELTA_SEGMENT_TOLERANCE))));
+    return segments < 65534 ? uint16_t(segments) + 1 : 65535;
+  }
+
+#endif // DELTA_SEGMENT_TOLERANCE
+
 /**
  * Calculate the highest Z position where the
  * effector has the full range of XY motion.
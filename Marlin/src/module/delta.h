@@ -91,6 +91,40 @@ void recalc_delta_settings();
 
 void inverse_kinematics(const float raw[XYZ]);
 
+/**
+ * Delta Segment Kinematics
+ *
+ * Along a straight line the radicand in DELTA_Z is a quadratic
+ * in the segment index, so for equal segments it's updated with
+ * two additions per tower instead of being recomputed from the
+ * tower distances. Only the square roots remain.
+ *
+ * delta_segments_init sets up stepping from a raw position by a
+ * fixed distance per segment. Each delta_segments_next steps one
+ * segment and stores the tower positions for the given Z in the
+ * delta[] array, the same as inverse_kinematics.
+ */
+void delta_segments_init(const float raw[XYZ], const float segment[XYZ]);
+void delta_segments_next(const float z);
+
+/**
+ * Step the next count (up to DELTA_SEGMENT_BATCH) segments at once,
+ * storing the tower positions of segment i in carriage[][i], with
+ * Z going up by dz per segment from z. Each radicand is taken from
+ * the quadratic instead of the previous segment, so the loops have
+ * no dependencies between segments and can use vector instructions.
+ */
+#define DELTA_SEGMENT_BATCH 16
+void delta_segments_next(const uint8_t count, const float z, const float dz, float (&carriage)[ABC][DELTA_SEGMENT_BATCH]);
+
+#ifdef DELTA_SEGMENT_TOLERANCE
+  /**
+   * The number of segments needed to keep the carriages within
+   * DELTA_SEGMENT_TOLERANCE of their true paths on a move in XY.
+   */
+  uint16_t delta_segments_for_tolerance(const float start[XYZ], const float target[XYZ], const float xy_mm);
+#endif
+
 /**
  * Calculate the highest Z position where the
  * effector has the full range of XY motion.
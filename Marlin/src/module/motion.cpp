@@ -28,6 +28,7 @@
 #include "endstops.h"
 #include "stepper.h"
 #include "planner.h"
+#include "segment_producer.h"
 #include "temperature.h"
 
 #include "../gcode/gcode.h"
@@ -151,13 +152,13 @@ float cartes[XYZ];
  */
 void report_current_position() {
   SERIAL_PROTOCOLPGM("X:");
-  SERIAL_PROTOCOL(LOGICAL_X_POSITION(current_position[X_AXIS]));
+  SERIAL_PROTOCOL_F(LOGICAL_X_POSITION(current_position[X_AXIS]), 2);
   SERIAL_PROTOCOLPGM(" Y:");
-  SERIAL_PROTOCOL(LOGICAL_Y_POSITION(current_position[Y_AXIS]));
+  SERIAL_PROTOCOL_F(LOGICAL_Y_POSITION(current_position[Y_AXIS]), 2);
   SERIAL_PROTOCOLPGM(" Z:");
-  SERIAL_PROTOCOL(LOGICAL_Z_POSITION(current_position[Z_AXIS]));
+  SERIAL_PROTOCOL_F(LOGICAL_Z_POSITION(current_position[Z_AXIS]), 2);
   SERIAL_PROTOCOLPGM(" E:");
-  SERIAL_PROTOCOL(current_position[E_AXIS]);
+  SERIAL_PROTOCOL_F(current_position[E_AXIS], 2);
 
   stepper.report_positions();
 
@@ -269,6 +270,7 @@ void buffer_line_to_destination(const float fr_mm_s) {
     #if UBL_SEGMENTED
       // ubl segmented line will do z-only moves in single segment
       ubl.prepare_segmented_line_to(destination, MMS_SCALED(fr_mm_s ? fr_mm_s : feedrate_mm_s));
+      segment_feed.finish();
     #else
       if ( current_position[X_AXIS] == destination[X_AXIS]
         && current_position[Y_AXIS] == destination[Y_AXIS]
@@ -512,14 +514,110 @@ float soft_endstop_min[XYZ] = { X_MIN_BED, Y_MIN_BED, Z_MIN_POS },
     #define SCARA_MIN_SEGMENT_LENGTH 0.5
   #endif
 
+  /**
+   * The segments of a linear move in a DELTA or SCARA setup,
+   * buffered one at a time by the segment feed.
+   */
+  class KinematicMoveProducer : public SegmentProducer {
+    public:
+      float raw[XYZE], target[XYZE], segment_distance[XYZE], feedrate_mm_s;
+      uint16_t segments;
+
+      #if ENABLED(DELTA)
+        // Tower positions (and leveling) of the segments, a batch at a time
+        float carriage[ABC][DELTA_SEGMENT_BATCH];
+        #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
+          float z_offset[DELTA_SEGMENT_BATCH];
+        #endif
+        uint8_t batch_index, batch_size;
+      #endif
+
+      #if ENABLED(SCARA_FEEDRATE_SCALING)
+        float inverse_secs, oldA, oldB;
+      #else
+        float cartesian_segment_mm;
+      #endif
+
+      bool next();
+  };
+
+  bool KinematicMoveProducer::next() {
+    if (--segments) {
+
+      #if ENABLED(DELTA)
+        // Delta steps its kinematics along the line, a batch of segments at once
+        if (batch_index == batch_size) {
+          batch_size = min(segments, uint16_t(DELTA_SEGMENT_BATCH));
+          batch_index = 0;
+          delta_segments_next(batch_size, raw[Z_AXIS], segment_distance[Z_AXIS], carriage);
+          #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
+            if (planner.leveling_active) bilinear_z_offsets(raw, segment_distance, batch_size, z_offset);
+          #endif
+        }
+        LOOP_XYZE(i) raw[i] += segment_distance[i];
+        LOOP_XYZ(i) delta[i] = carriage[i][batch_index];
+        #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
+          // Adjust Z if bed leveling is enabled
+          if (planner.leveling_active) LOOP_XYZ(i) delta[i] += z_offset[batch_index];
+        #endif
+        batch_index++;
+      #else
+        LOOP_XYZE(i) raw[i] += segment_distance[i];
+        inverse_kinematics(raw);
+        ADJUST_DELTA(raw); // Adjust Z if bed leveling is enabled
+      #endif
+
+      #if ENABLED(SCARA_FEEDRATE_SCALING)
+        // For SCARA scale the feed rate from mm/s to degrees/s
+        // i.e., Complete the angular vector in the given time.
+        planner.buffer_segment(delta[A_AXIS], delta[B_AXIS], raw[Z_AXIS], raw[E_AXIS], HYPOT(delta[A_AXIS] - oldA, delta[B_AXIS] - oldB) * inverse_secs, active_extruder);
+        /*
+        SERIAL_ECHO(segments);
+        SERIAL_ECHOPAIR(": X=", raw[X_AXIS]); SERIAL_ECHOPAIR(" Y=", raw[Y_AXIS]);
+        SERIAL_ECHOPAIR(" A=", delta[A_AXIS]); SERIAL_ECHOPAIR(" B=", delta[B_AXIS]);
+        SERIAL_ECHOLNPAIR(" F", HYPOT(delta[A_AXIS] - oldA, delta[B_AXIS] - oldB) * inverse_secs * 60);
+        safe_delay(5);
+        //*/
+        oldA = delta[A_AXIS]; oldB = delta[B_AXIS];
+      #else
+        planner.buffer_line(delta[A_AXIS], delta[B_AXIS], delta[C_AXIS], raw[E_AXIS], feedrate_mm_s, active_extruder, cartesian_segment_mm);
+      #endif
+
+      return true;
+    }
+
+    // Ensure last segment arrives at target location.
+    #if ENABLED(SCARA_FEEDRATE_SCALING)
+      inverse_kinematics(target);
+      ADJUST_DELTA(target);
+      const float diff2 = HYPOT2(delta[A_AXIS] - oldA, delta[B_AXIS] - oldB);
+      if (diff2) {
+        planner.buffer_segment(delta[A_AXIS], delta[B_AXIS], target[Z_AXIS], target[E_AXIS], SQRT(diff2) * inverse_secs, active_extruder);
+        /*
+        SERIAL_ECHOPAIR("final: A=", delta[A_AXIS]); SERIAL_ECHOPAIR(" B=", delta[B_AXIS]);
+        SERIAL_ECHOPAIR(" adiff=", delta[A_AXIS] - oldA); SERIAL_ECHOPAIR(" bdiff=", delta[B_AXIS] - oldB);
+        SERIAL_ECHOLNPAIR(" F", (SQRT(diff2) * inverse_secs) * 60);
+        SERIAL_EOL();
+        safe_delay(5);
+        //*/
+      }
+    #else
+      planner.buffer_line_kinematic(target, feedrate_mm_s, active_extruder, cartesian_segment_mm);
+    #endif
+
+    return false;
+  }
+
+  static KinematicMoveProducer kinematic_move;
+
   /**
    * Prepare a linear move in a DELTA or SCARA setup.
    *
    * Called from prepare_move_to_destination as the
    * default Delta/SCARA segmenter.
    *
-   * This calls planner.buffer_line several times, adding
-   * small incremental moves for DELTA or SCARA.
+   * This hands the move to the segment feed, which buffers it
+   * as small incremental moves for DELTA or SCARA.
    *
    * For Unified Bed Leveling (Delta or Segmented Cartesian)
    * the ubl.prepare_segmented_line_to method replaces this.
@@ -529,6 +627,9 @@ float soft_endstop_min[XYZ] = { X_MIN_BED, Y_MIN_BED, Z_MIN_POS },
    */
   inline bool prepare_kinematic_move_to(const float (&rtarget)[XYZE]) {
 
+    // Only one move is segmented at a time
+    segment_feed.finish();
+
     // Get the top feedrate of the move in the XY plane
     const float _feedrate_mm_s = MMS_SCALED(feedrate_mm_s);
 
@@ -567,6 +668,17 @@ float soft_endstop_min[XYZ] = { X_MIN_BED, Y_MIN_BED, Z_MIN_POS },
     // For SCARA enforce a minimum segment size
     #if IS_SCARA
       NOMORE(segments, cartesian_mm * (1.0 / SCARA_MIN_SEGMENT_LENGTH));
+    #elif ENABLED(DELTA) && defined(DELTA_SEGMENT_TOLERANCE)
+      // For Delta use only as many segments as the carriage paths need,
+      // and with Bilinear leveling at least one per grid cell.
+      {
+        const float xy_mm = HYPOT(xdiff, ydiff);
+        uint16_t needed = delta_segments_for_tolerance(current_position, rtarget, xy_mm);
+        #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
+          NOLESS(needed, xy_mm / min(bilinear_grid_spacing[X_AXIS], bilinear_grid_spacing[Y_AXIS]));
+        #endif
+        NOMORE(segments, needed);
+      }
     #endif
 
     // At least one segment is required
@@ -583,6 +695,7 @@ float soft_endstop_min[XYZ] = { X_MIN_BED, Y_MIN_BED, Z_MIN_POS },
 
     #if DISABLED(SCARA_FEEDRATE_SCALING)
       const float cartesian_segment_mm = cartesian_mm * inv_segments;
+      kinematic_move.cartesian_segment_mm = cartesian_segment_mm;
     #endif
 
     /*
@@ -601,10 +714,13 @@ float soft_endstop_min[XYZ] = { X_MIN_BED, Y_MIN_BED, Z_MIN_POS },
       // i.e., Complete the angular vector in the given time.
       const float segment_length = cartesian_mm * inv_segments,
                   inv_segment_length = 1.0 / segment_length, // 1/mm/segs
-                  inverse_secs = inv_segment_length * _feedrate_mm_s;
+                  inverse_secs = inv_segment_length * _feedrate_mm_s,
+                  oldA = planner.position_float[A_AXIS],
+                  oldB = planner.position_float[B_AXIS];
 
-      float oldA = planner.position_float[A_AXIS],
-            oldB = planner.position_float[B_AXIS];
+      kinematic_move.inverse_secs = inverse_secs;
+      kinematic_move.oldA = oldA;
+      kinematic_move.oldB = oldB;
 
       /*
       SERIAL_ECHOPGM("Scaled kinematic move: ");
@@ -618,65 +734,20 @@ float soft_endstop_min[XYZ] = { X_MIN_BED, Y_MIN_BED, Z_MIN_POS },
       //*/
     #endif
 
-     // Get the current position as starting point
-    float raw[XYZE];
-    COPY(raw, current_position);
-
-    // Calculate and execute the segments
-    while (--segments) {
-
-      static millis_t next_idle_ms = millis() + 200UL;
-      thermalManager.manage_heater();  // This returns immediately if not really needed.
-      if (ELAPSED(millis(), next_idle_ms)) {
-        next_idle_ms = millis() + 200UL;
-        idle();
-      }
-
-      LOOP_XYZE(i) raw[i] += segment_distance[i];
-
-      #if ENABLED(DELTA) && HOTENDS < 2
-        DELTA_IK(raw); // Delta can inline its kinematics
-      #else
-        inverse_kinematics(raw);
-      #endif
-      ADJUST_DELTA(raw); // Adjust Z if bed leveling is enabled
-
-      #if ENABLED(SCARA_FEEDRATE_SCALING)
-        // For SCARA scale the feed rate from mm/s to degrees/s
-        // i.e., Complete the angular vector in the given time.
-        planner.buffer_segment(delta[A_AXIS], delta[B_AXIS], raw[Z_AXIS], raw[E_AXIS], HYPOT(delta[A_AXIS] - oldA, delta[B_AXIS] - oldB) * inverse_secs, active_extruder);
-        /*
-        SERIAL_ECHO(segments);
-        SERIAL_ECHOPAIR(": X=", raw[X_AXIS]); SERIAL_ECHOPAIR(" Y=", raw[Y_AXIS]);
-        SERIAL_ECHOPAIR(" A=", delta[A_AXIS]); SERIAL_ECHOPAIR(" B=", delta[B_AXIS]);
-        SERIAL_ECHOLNPAIR(" F", HYPOT(delta[A_AXIS] - oldA, delta[B_AXIS] - oldB) * inverse_secs * 60);
-        safe_delay(5);
-        //*/
-        oldA = delta[A_AXIS]; oldB = delta[B_AXIS];
-      #else
-        planner.buffer_line(delta[A_AXIS], delta[B_AXIS], delta[C_AXIS], raw[E_AXIS], _feedrate_mm_s, active_extruder, cartesian_segment_mm);
-      #endif
-    }
+    // Get the current position as starting point
+    COPY(kinematic_move.raw, current_position);
+    COPY(kinematic_move.target, rtarget);
+    COPY(kinematic_move.segment_distance, segment_distance);
+    kinematic_move.feedrate_mm_s = _feedrate_mm_s;
+    kinematic_move.segments = segments;
 
-    // Ensure last segment arrives at target location.
-    #if ENABLED(SCARA_FEEDRATE_SCALING)
-      inverse_kinematics(rtarget);
-      ADJUST_DELTA(rtarget);
-      const float diff2 = HYPOT2(delta[A_AXIS] - oldA, delta[B_AXIS] - oldB);
-      if (diff2) {
-        planner.buffer_segment(delta[A_AXIS], delta[B_AXIS], rtarget[Z_AXIS], rtarget[E_AXIS], SQRT(diff2) * inverse_secs, active_extruder);
-        /*
-        SERIAL_ECHOPAIR("final: A=", delta[A_AXIS]); SERIAL_ECHOPAIR(" B=", delta[B_AXIS]);
-        SERIAL_ECHOPAIR(" adiff=", delta[A_AXIS] - oldA); SERIAL_ECHOPAIR(" bdiff=", delta[B_AXIS] - oldB);
-        SERIAL_ECHOLNPAIR(" F", (SQRT(diff2) * inverse_secs) * 60);
-        SERIAL_EOL();
-        safe_delay(5);
-        //*/
-      }
-    #else
-      planner.buffer_line_kinematic(rtarget, _feedrate_mm_s, active_extruder, cartesian_segment_mm);
+    #if ENABLED(DELTA)
+      delta_segments_init(kinematic_move.raw, segment_distance);
+      kinematic_move.batch_index = kinematic_move.batch_size = 0;
     #endif
 
+    segment_feed.start(kinematic_move);
+
     return false; // caller will update current_position
   }
 
@@ -684,6 +755,11 @@ float soft_endstop_min[XYZ] = { X_MIN_BED, Y_MIN_BED, Z_MIN_POS },
 
   #if ENABLED(SEGMENT_LEVELED_MOVES)
 
+    // Bilinear leveling gets the Z of several segments in one pass over the grid.
+    // Skew correction moves each segment before leveling, so it levels them one by one.
+    #define ABL_BATCHED_SEGMENTS (ENABLED(AUTO_BED_LEVELING_BILINEAR) && DISABLED(SKEW_CORRECTION))
+    #define LEVELED_SEGMENT_BATCH 16
+
     /**
      * Prepare a segmented move on a CARTESIAN setup.
      *
@@ -736,6 +812,12 @@ float soft_endstop_min[XYZ] = { X_MIN_BED, Y_MIN_BED, Z_MIN_POS },
       float raw[XYZE];
       COPY(raw, current_position);
 
+      #if ABL_BATCHED_SEGMENTS
+        // Level the segments here, a batch at a time, instead of in the planner
+        float z_offset[LEVELED_SEGMENT_BATCH];
+        uint8_t batch_index = 0, batch_size = 0;
+      #endif
+
       // Calculate and execute the segments
       while (--segments) {
         static millis_t next_idle_ms = millis() + 200UL;
@@ -744,8 +826,21 @@ float soft_endstop_min[XYZ] = { X_MIN_BED, Y_MIN_BED, Z_MIN_POS },
           next_idle_ms = millis() + 200UL;
           idle();
         }
-        LOOP_XYZE(i) raw[i] += segment_distance[i];
-        planner.buffer_line_kinematic(raw, fr_mm_s, active_extruder, cartesian_segment_mm);
+        #if ABL_BATCHED_SEGMENTS
+          if (batch_index == batch_size) {
+            batch_size = min(segments, uint16_t(LEVELED_SEGMENT_BATCH));
+            batch_index = 0;
+            bilinear_z_offsets(raw, segment_distance, batch_size, z_offset);
+          }
+          LOOP_XYZE(i) raw[i] += segment_distance[i];
+          const float fade_scaling_factor = planner.fade_scaling_factor_for_z(raw[Z_AXIS]);
+          planner.buffer_segment(raw[X_AXIS], raw[Y_AXIS], raw[Z_AXIS] + (fade_scaling_factor ? fade_scaling_factor * z_offset[batch_index] : 0.0),
+                                 raw[E_AXIS], fr_mm_s, active_extruder, cartesian_segment_mm);
+          batch_index++;
+        #else
+          LOOP_XYZE(i) raw[i] += segment_distance[i];
+          planner.buffer_line_kinematic(raw, fr_mm_s, active_extruder, cartesian_segment_mm);
+        #endif
       }
 
       // Since segment_distance is only approximate,
@@ -907,11 +1002,13 @@ float soft_endstop_min[XYZ] = { X_MIN_BED, Y_MIN_BED, Z_MIN_POS },
  *
  * This may result in several calls to planner.buffer_line to
  * do smaller moves for DELTA, SCARA, mesh moves, etc.
+ * Moves that are cut into segments are handed to the segment
+ * feed, which may still be buffering them on return.
  *
  * Make sure current_position[E] and destination[E] are good
  * before calling or cold/lengthy extrusion may get missed.
  */
-void prepare_move_to_destination() {
+void start_move_to_destination() {
   clamp_to_software_endstops(destination);
 
   #if ENABLED(PREVENT_COLD_EXTRUSION) || ENABLED(PREVENT_LENGTHY_EXTRUDE)
@@ -954,6 +1051,14 @@ void prepare_move_to_destination() {
   set_current_from_destination();
 }
 
+/**
+ * Prepare a single move and buffer all of it before returning
+ */
+void prepare_move_to_destination() {
+  start_move_to_destination();
+  segment_feed.finish();
+}
+
 #if HAS_AXIS_UNHOMED_ERR
 
   bool axis_unhomed_error(const bool x/*=true*/, const bool y/*=true*/, const bool z/*=true*/) {
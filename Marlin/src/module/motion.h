@@ -144,6 +144,7 @@ void buffer_line_to_destination(const float fr_mm_s);
   void prepare_uninterpolated_move_to_destination(const float fr_mm_s=0.0);
 #endif
 
+void start_move_to_destination();
 void prepare_move_to_destination();
 
 /**
@@ -92,6 +92,10 @@
   #include "../feature/power.h"
 #endif
 
+#if ENABLED(STEP_TIMELINE)
+  #include "../feature/step_timeline.h"
+#endif
+
 Planner planner;
 
   // public:
@@ -100,8 +104,9 @@ Planner planner;
  * A ring buffer of moves described in steps
  */
 block_t Planner::block_buffer[BLOCK_BUFFER_SIZE];
-volatile uint8_t Planner::block_buffer_head, // Index of the next block to be pushed
-                 Planner::block_buffer_tail;
+volatile uint8_t Planner::block_buffer_head,    // Index of the next block to be pushed
+                 Planner::block_buffer_tail,    // Index of the busy block, if any
+                 Planner::block_buffer_planned; // Index of the optimally planned block
 
 float Planner::max_feedrate_mm_s[XYZE_N], // Max speeds in mm per second
       Planner::axis_steps_per_mm[XYZE_N],
@@ -134,6 +139,10 @@ float Planner::min_feedrate_mm_s,
       Planner::max_jerk[XYZE],       // The largest speed change requiring no acceleration
       Planner::min_travel_feedrate_mm_s;
 
+#if ENABLED(JUNCTION_DEVIATION)
+  float Planner::junction_deviation_mm;
+#endif
+
 #if HAS_LEVELING
   bool Planner::leveling_active = false; // Flag that auto bed leveling is enabled
   #if ABL_PLANAR
@@ -177,6 +186,10 @@ uint32_t Planner::cutoff_long;
 float Planner::previous_speed[NUM_AXIS],
       Planner::previous_nominal_speed;
 
+#if ENABLED(JUNCTION_DEVIATION)
+  float Planner::previous_unit_vec[XYZE];
+#endif
+
 #if ENABLED(DISABLE_INACTIVE_EXTRUDER)
   uint8_t Planner::g_uc_extruder_last_move[EXTRUDERS] = { 0 };
 #endif
@@ -730,8 +743,9 @@ void Planner::init() {
     // so we don´t need to reduce precision or to use assembly language at all.
 
     // This routine, for all the other archs, returns 0x100000000 / d ~= 0xFFFFFFFF / d
+    // A ramp with no time (d == 0) is never evaluated, but must not trap on the Linux host
     static FORCE_INLINE uint32_t get_period_inverse(uint32_t d) {
-      return 0xFFFFFFFF / d;
+      return d ? 0xFFFFFFFF / d : 0xFFFFFFFF;
     }
   #endif
 #endif
@@ -842,11 +856,15 @@ void Planner::reverse_pass_kernel(block_t* const current, const block_t * const
 /**
  * recalculate() needs to go over the current plan twice.
  * Once in reverse and once forward. This implements the reverse pass.
+ *
+ * Only the blocks after the optimally planned block are visited. That block
+ * is never behind the tail, so the running block is never altered.
  */
 void Planner::reverse_pass() {
   if (movesplanned() > 2) {
-    const uint8_t endnr = BLOCK_MOD(block_buffer_tail + 1); // tail is running. tail+1 shouldn't be altered because it's connected to the running block.
+    const uint8_t endnr = block_buffer_planned; // This block and all before it can no longer change
     uint8_t blocknr = prev_block_index(block_buffer_head);
+    if (blocknr == endnr) return;
     block_t* current = &block_buffer[blocknr];
 
     // Last/newest block in buffer:
@@ -860,12 +878,11 @@ void Planner::reverse_pass() {
       SBI(current->flag, BLOCK_BIT_RECALCULATE);
     }
 
-    do {
+    for (blocknr = prev_block_index(blocknr); blocknr != endnr; blocknr = prev_block_index(blocknr)) {
       const block_t * const next = current;
-      blocknr = prev_block_index(blocknr);
       current = &block_buffer[blocknr];
       reverse_pass_kernel(current, next);
-    } while (blocknr != endnr);
+    }
   }
 }
 
@@ -893,26 +910,39 @@ void Planner::forward_pass_kernel(const block_t * const previous, block_t* const
 /**
  * recalculate() needs to go over the current plan twice.
  * Once in reverse and once forward. This implements the forward pass.
+ *
+ * It also advances the optimally planned block. A block is optimal when its
+ * entry speed is at the maximum, or when it's limited by accelerating through
+ * the whole previous block. The reverse pass only ever raises entry speeds
+ * as blocks are added, so neither case can change again.
  */
 void Planner::forward_pass() {
-  block_t* block[3] = { NULL, NULL, NULL };
-
-  for (uint8_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b)) {
-    block[0] = block[1];
-    block[1] = block[2];
-    block[2] = &block_buffer[b];
-    forward_pass_kernel(block[0], block[1]);
+  uint8_t blocknr = block_buffer_planned, planned = blocknr;
+  if (blocknr == block_buffer_head) return;
+
+  const block_t *previous = &block_buffer[blocknr];
+  for (blocknr = next_block_index(blocknr); blocknr != block_buffer_head; blocknr = next_block_index(blocknr)) {
+    block_t * const current = &block_buffer[blocknr];
+    const float entry_speed = current->entry_speed;
+    forward_pass_kernel(previous, current);
+    if (current->entry_speed != entry_speed || current->entry_speed == current->max_entry_speed)
+      planned = blocknr;
+    previous = current;
   }
-  forward_pass_kernel(block[1], block[2]);
+
+  // Unless the stepper ISR has already moved past it
+  CRITICAL_SECTION_START;
+    if (BLOCK_MOD(planned - block_buffer_tail) < movesplanned()) block_buffer_planned = planned;
+  CRITICAL_SECTION_END;
 }
 
 /**
- * Recalculate the trapezoid speed profiles for all blocks in the plan
- * according to the entry_factor for each junction. Must be called by
- * recalculate() after updating the blocks.
+ * Recalculate the trapezoid speed profiles for the blocks in the plan,
+ * starting at first_index, according to the entry_factor for each junction.
+ * Must be called by recalculate() after updating the blocks.
  */
-void Planner::recalculate_trapezoids() {
-  int8_t block_index = block_buffer_tail;
+void Planner::recalculate_trapezoids(const uint8_t first_index) {
+  int8_t block_index = first_index;
   block_t *current, *next = NULL;
 
   while (block_index != block_buffer_head) {
@@ -974,11 +1004,19 @@ void Planner::recalculate_trapezoids() {
  * jerk is jerkier than the set limit, Jerky. Finally it will:
  *
  *   3. Recalculate "trapezoids" for all blocks.
+ *
+ * Blocks up to the optimally planned block (block_buffer_planned) are final,
+ * so each pass starts (or stops) there. Adding a block costs only the blocks
+ * that can still change, instead of the whole buffer.
  */
 void Planner::recalculate() {
+  // Blocks after this one may change
+  uint8_t first_index = block_buffer_planned;
   reverse_pass();
   forward_pass();
-  recalculate_trapezoids();
+  // The stepper ISR may have released it meanwhile
+  if (BLOCK_MOD(first_index - block_buffer_tail) >= movesplanned()) first_index = block_buffer_tail;
+  recalculate_trapezoids(first_index);
 }
 
 #if ENABLED(AUTOTEMP)
@@ -1007,6 +1045,28 @@ void Planner::recalculate() {
 
 #endif // AUTOTEMP
 
+#if ENABLED(MPCTEMP)
+
+  /**
+   * The mean extrusion rate (mm/s of filament) of an extruder over about
+   * the next 'seconds' of queued moves, for the hotend heater to supply
+   * the heat the filament will take before the nozzle has cooled. Blocks
+   * are timed at their nominal speed and retractions don't count.
+   */
+  float Planner::get_extrusion_rate(const uint8_t extruder, const float seconds) {
+    float filament = 0.0, time = 0.0;
+    for (uint8_t b = block_buffer_tail; b != block_buffer_head && time < seconds; b = next_block_index(b)) {
+      const block_t * const block = &block_buffer[b];
+      if (block->nominal_speed <= 0.0) continue;
+      if (block->active_extruder == extruder && !TEST(block->direction_bits, E_AXIS))
+        filament += block->steps[E_AXIS] * steps_to_mm[E_AXIS_N];
+      time += block->millimeters / block->nominal_speed;
+    }
+    return time > 0.0 ? filament / time : 0.0;
+  }
+
+#endif // MPCTEMP
+
 /**
  * Maintain fans, paste extruder pressure,
  */
@@ -1387,7 +1447,12 @@ void Planner::_buffer_steps(const int32_t (&target)[XYZE]
 
   // If the buffer is full: good! That means we are well ahead of the robot.
   // Rest here until there is room in the buffer.
-  while (block_buffer_tail == next_buffer_head) idle();
+  while (block_buffer_tail == next_buffer_head) {
+    idle();
+    #if ENABLED(STEP_TIMELINE)
+      step_timeline.stream(); // A move prints nothing before it's buffered
+    #endif
+  }
 
   // Prepare to set up new block
   block_t* block = &block_buffer[block_buffer_head];
@@ -1873,16 +1938,35 @@ void Planner::_buffer_steps(const int32_t (&target)[XYZE]
   // Initial limit on the segment entry velocity
   float vmax_junction;
 
-  #if 0  // Use old jerk for now
+  #if ENABLED(JUNCTION_DEVIATION)
 
-    float junction_deviation = 0.1;
-
-    // Compute path unit vector
-    double unit_vec[XYZ] = {
-      delta_mm[A_AXIS] * inverse_millimeters,
-      delta_mm[B_AXIS] * inverse_millimeters,
-      delta_mm[C_AXIS] * inverse_millimeters
+    // Unit vector of the path, so the junction cosine is just a dot product with the previous one
+    float unit_vec[XYZE] = {
+      #if CORE_IS_XY
+        delta_mm[X_HEAD], delta_mm[Y_HEAD], delta_mm[Z_AXIS], 0
+      #elif CORE_IS_XZ
+        delta_mm[X_HEAD], delta_mm[Y_AXIS], delta_mm[Z_HEAD], 0
+      #elif CORE_IS_YZ
+        delta_mm[X_AXIS], delta_mm[Y_HEAD], delta_mm[Z_HEAD], 0
+      #else
+        delta_mm[A_AXIS], delta_mm[B_AXIS], delta_mm[C_AXIS], 0
+      #endif
     };
+    if (block->steps[A_AXIS] < MIN_STEPS_PER_SEGMENT && block->steps[B_AXIS] < MIN_STEPS_PER_SEGMENT && block->steps[C_AXIS] < MIN_STEPS_PER_SEGMENT) {
+      // An E-only move (retract or prime) runs along E, so one in the same direction is straight on
+      unit_vec[X_AXIS] = unit_vec[Y_AXIS] = unit_vec[Z_AXIS] = 0;
+      unit_vec[E_AXIS] = delta_mm[E_AXIS] < 0 ? -1 : 1;
+    }
+    else {
+      #if IS_KINEMATIC
+        // Kinematic blocks move the joints, and their length is given in Cartesian space
+        const float joint_mm = SQRT(sq(unit_vec[A_AXIS]) + sq(unit_vec[B_AXIS]) + sq(unit_vec[C_AXIS])),
+                    inverse_unit = joint_mm ? 1.0 / joint_mm : 0.0;
+      #else
+        const float inverse_unit = inverse_millimeters;
+      #endif
+      LOOP_XYZ(i) unit_vec[i] *= inverse_unit;
+    }
 
     /*
        Compute maximum allowable entry speed at junction by centripetal acceleration approximation.
@@ -1900,99 +1984,124 @@ void Planner::_buffer_steps(const int32_t (&target)[XYZE]
        it takes into account the nonlinearities of both the junction angle and junction velocity.
      */
 
-    vmax_junction = MINIMUM_PLANNER_SPEED; // Set default max junction speed
-
     // Skip first block or when previous_nominal_speed is used as a flag for homing and offset cycles.
     if (moves_queued && !UNEAR_ZERO(previous_nominal_speed)) {
       // Compute cosine of angle between previous and current path. (prev_unit_vec is negative)
       // NOTE: Max junction velocity is computed without sin() or acos() by trig half angle identity.
-      const float cos_theta = - previous_unit_vec[X_AXIS] * unit_vec[X_AXIS]
-                              - previous_unit_vec[Y_AXIS] * unit_vec[Y_AXIS]
-                              - previous_unit_vec[Z_AXIS] * unit_vec[Z_AXIS];
-      // Skip and use default max junction speed for 0 degree acute junction.
-      if (cos_theta < 0.95) {
-        vmax_junction = min(previous_nominal_speed, block->nominal_speed);
-        // Skip and avoid divide by zero for straight junctions at 180 degrees. Limit to min() of nominal speeds.
-        if (cos_theta > -0.95) {
-          // Compute maximum junction velocity based on maximum acceleration and junction deviation
-          float sin_theta_d2 = SQRT(0.5 * (1.0 - cos_theta)); // Trig half angle identity. Always positive.
-          NOMORE(vmax_junction, SQRT(block->acceleration * junction_deviation * sin_theta_d2 / (1.0 - sin_theta_d2)));
+      float cos_theta = - previous_unit_vec[X_AXIS] * unit_vec[X_AXIS]
+                        - previous_unit_vec[Y_AXIS] * unit_vec[Y_AXIS]
+                        - previous_unit_vec[Z_AXIS] * unit_vec[Z_AXIS]
+                        - previous_unit_vec[E_AXIS] * unit_vec[E_AXIS];
+
+      if (cos_theta > 0.999999) {
+        // Reversal (0 degree acute junction). Come to a full stop.
+        vmax_junction = MINIMUM_PLANNER_SPEED;
+      }
+      else {
+        NOLESS(cos_theta, -0.999999); // Straight on. Avoid a divide by zero.
+
+        // Compute maximum junction velocity based on maximum acceleration and junction deviation
+        const float sin_theta_d2 = SQRT(0.5 * (1.0 - cos_theta)); // Trig half angle identity. Always positive.
+        vmax_junction = SQRT(block->acceleration * junction_deviation_mm * sin_theta_d2 / (1.0 - sin_theta_d2));
+
+        // Short segments are usually a curve cut into chords, whose gentle junctions would each allow
+        // nearly full speed. Over a wide angle, limit to the centripetal speed of the approximated arc.
+        if (block->millimeters < 1.0) {
+          // Fast acos approximation, minus the error bar to be safe
+          const float junction_theta = (RADIANS(-40) * sq(cos_theta) - RADIANS(50)) * cos_theta + RADIANS(90) - 0.18;
+          if (junction_theta > RADIANS(135))
+            NOMORE(vmax_junction, SQRT(block->millimeters / (RADIANS(180) - junction_theta) * block->acceleration));
         }
       }
+
+      // The junction velocity is shared between successive segments. Limit it to the smaller nominal speed.
+      NOMORE(vmax_junction, min(block->nominal_speed, previous_nominal_speed));
+
+      // E is left out of the path of a move of the head, so limit the change of extrusion speed by
+      // the E jerk. The E speeds on both sides are in proportion to the junction velocity.
+      const float e_jerk_per_speed = FABS(previous_speed[E_AXIS] / previous_nominal_speed - current_speed[E_AXIS] / block->nominal_speed);
+      if (e_jerk_per_speed * vmax_junction > max_jerk[E_AXIS]) vmax_junction = max_jerk[E_AXIS] / e_jerk_per_speed;
     }
-  #endif
+    else
+      vmax_junction = MINIMUM_PLANNER_SPEED; // Start from rest. The planner will correct this later.
 
-  /**
-   * Adapted from Průša MKS firmware
-   * https://github.com/prusa3d/Prusa-Firmware
-   *
-   * Start with a safe speed (from which the machine may halt to stop immediately).
-   */
+    COPY(previous_unit_vec, unit_vec);
 
-  // Exit speed limited by a jerk to full halt of a previous last segment
-  static float previous_safe_speed;
+  #else // !JUNCTION_DEVIATION
 
-  float safe_speed = block->nominal_speed;
-  uint8_t limited = 0;
-  LOOP_XYZE(i) {
-    const float jerk = FABS(current_speed[i]), maxj = max_jerk[i];
-    if (jerk > maxj) {
-      if (limited) {
-        const float mjerk = maxj * block->nominal_speed;
-        if (jerk * safe_speed > mjerk) safe_speed = mjerk / jerk;
-      }
-      else {
-        ++limited;
-        safe_speed = maxj;
+    /**
+     * Adapted from Průša MKS firmware
+     * https://github.com/prusa3d/Prusa-Firmware
+     *
+     * Start with a safe speed (from which the machine may halt to stop immediately).
+     */
+
+    // Exit speed limited by a jerk to full halt of a previous last segment
+    static float previous_safe_speed;
+
+    float safe_speed = block->nominal_speed;
+    uint8_t limited = 0;
+    LOOP_XYZE(i) {
+      const float jerk = FABS(current_speed[i]), maxj = max_jerk[i];
+      if (jerk > maxj) {
+        if (limited) {
+          const float mjerk = maxj * block->nominal_speed;
+          if (jerk * safe_speed > mjerk) safe_speed = mjerk / jerk;
+        }
+        else {
+          ++limited;
+          safe_speed = maxj;
+        }
       }
     }
-  }
 
-  if (moves_queued && !UNEAR_ZERO(previous_nominal_speed)) {
-    // Estimate a maximum velocity allowed at a joint of two successive segments.
-    // If this maximum velocity allowed is lower than the minimum of the entry / exit safe velocities,
-    // then the machine is not coasting anymore and the safe entry / exit velocities shall be used.
-
-    // The junction velocity will be shared between successive segments. Limit the junction velocity to their minimum.
-    // Pick the smaller of the nominal speeds. Higher speed shall not be achieved at the junction during coasting.
-    vmax_junction = min(block->nominal_speed, previous_nominal_speed);
-
-    // Factor to multiply the previous / current nominal velocities to get componentwise limited velocities.
-    float v_factor = 1;
-    limited = 0;
-
-    // Now limit the jerk in all axes.
-    const float smaller_speed_factor = vmax_junction / previous_nominal_speed;
-    LOOP_XYZE(axis) {
-      // Limit an axis. We have to differentiate: coasting, reversal of an axis, full stop.
-      float v_exit = previous_speed[axis] * smaller_speed_factor,
-            v_entry = current_speed[axis];
-      if (limited) {
-        v_exit *= v_factor;
-        v_entry *= v_factor;
-      }
+    if (moves_queued && !UNEAR_ZERO(previous_nominal_speed)) {
+      // Estimate a maximum velocity allowed at a joint of two successive segments.
+      // If this maximum velocity allowed is lower than the minimum of the entry / exit safe velocities,
+      // then the machine is not coasting anymore and the safe entry / exit velocities shall be used.
+
+      // The junction velocity will be shared between successive segments. Limit the junction velocity to their minimum.
+      // Pick the smaller of the nominal speeds. Higher speed shall not be achieved at the junction during coasting.
+      vmax_junction = min(block->nominal_speed, previous_nominal_speed);
+
+      // Factor to multiply the previous / current nominal velocities to get componentwise limited velocities.
+      float v_factor = 1;
+      limited = 0;
+
+      // Now limit the jerk in all axes.
+      const float smaller_speed_factor = vmax_junction / previous_nominal_speed;
+      LOOP_XYZE(axis) {
+        // Limit an axis. We have to differentiate: coasting, reversal of an axis, full stop.
+        float v_exit = previous_speed[axis] * smaller_speed_factor,
+              v_entry = current_speed[axis];
+        if (limited) {
+          v_exit *= v_factor;
+          v_entry *= v_factor;
+        }
 
-      // Calculate jerk depending on whether the axis is coasting in the same direction or reversing.
-      const float jerk = (v_exit > v_entry)
-          ? //                                  coasting             axis reversal
-            ( (v_entry > 0 || v_exit < 0) ? (v_exit - v_entry) : max(v_exit, -v_entry) )
-          : // v_exit <= v_entry                coasting             axis reversal
-            ( (v_entry < 0 || v_exit > 0) ? (v_entry - v_exit) : max(-v_exit, v_entry) );
+        // Calculate jerk depending on whether the axis is coasting in the same direction or reversing.
+        const float jerk = (v_exit > v_entry)
+            ? //                                  coasting             axis reversal
+              ( (v_entry > 0 || v_exit < 0) ? (v_exit - v_entry) : max(v_exit, -v_entry) )
+            : // v_exit <= v_entry                coasting             axis reversal
+              ( (v_entry < 0 || v_exit > 0) ? (v_entry - v_exit) : max(-v_exit, v_entry) );
 
-      if (jerk > max_jerk[axis]) {
-        v_factor *= max_jerk[axis] / jerk;
-        ++limited;
+        if (jerk > max_jerk[axis]) {
+          v_factor *= max_jerk[axis] / jerk;
+          ++limited;
+        }
       }
+      if (limited) vmax_junction *= v_factor;
+      // Now the transition velocity is known, which maximizes the shared exit / entry velocity while
+      // respecting the jerk factors, it may be possible, that applying separate safe exit / entry velocities will achieve faster prints.
+      const float vmax_junction_threshold = vmax_junction * 0.99f;
+      if (previous_safe_speed > vmax_junction_threshold && safe_speed > vmax_junction_threshold)
+        vmax_junction = safe_speed;
     }
-    if (limited) vmax_junction *= v_factor;
-    // Now the transition velocity is known, which maximizes the shared exit / entry velocity while
-    // respecting the jerk factors, it may be possible, that applying separate safe exit / entry velocities will achieve faster prints.
-    const float vmax_junction_threshold = vmax_junction * 0.99f;
-    if (previous_safe_speed > vmax_junction_threshold && safe_speed > vmax_junction_threshold)
+    else
       vmax_junction = safe_speed;
-  }
-  else
-    vmax_junction = safe_speed;
+
+  #endif // !JUNCTION_DEVIATION
 
   // Max entry speed of this block equals the max exit speed of the previous block.
   block->max_entry_speed = vmax_junction;
@@ -2016,7 +2125,9 @@ void Planner::_buffer_steps(const int32_t (&target)[XYZE]
   // Update previous path unit_vector and nominal speed
   COPY(previous_speed, current_speed);
   previous_nominal_speed = block->nominal_speed;
-  previous_safe_speed = safe_speed;
+  #if DISABLED(JUNCTION_DEVIATION)
+    previous_safe_speed = safe_speed;
+  #endif
 
   // Move buffer head
   block_buffer_head = next_buffer_head;
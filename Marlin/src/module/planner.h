@@ -158,10 +158,15 @@ class Planner {
      *
      *  Writer of head is Planner::buffer_segment().
      *  Reader of tail is Stepper::isr(). Always consider tail busy / read-only
+     *
+     *  planned : the last block whose entry speed is optimal. No block added
+     *            later can change it or any block before it, so recalculate()
+     *            only re-plans the blocks after it. Never lags behind tail.
      */
     static block_t block_buffer[BLOCK_BUFFER_SIZE];
     static volatile uint8_t block_buffer_head,      // Index of the next block to be pushed
-                            block_buffer_tail;      // Index of the busy block, if any
+                            block_buffer_tail,      // Index of the busy block, if any
+                            block_buffer_planned;   // Index of the optimally planned block
 
     #if ENABLED(DISTINCT_E_FACTORS)
       static uint8_t last_extruder;                 // Respond to extruder change
@@ -192,6 +197,10 @@ class Planner {
                  max_jerk[XYZE],       // The largest speed change requiring no acceleration
                  min_travel_feedrate_mm_s;
 
+    #if ENABLED(JUNCTION_DEVIATION)
+      static float junction_deviation_mm; // Use 'M205 J<mm>' to override
+    #endif
+
     #if HAS_LEVELING
       static bool leveling_active;          // Flag that bed leveling is enabled
       #if ABL_PLANAR
@@ -247,6 +256,13 @@ class Planner {
      */
     static float previous_nominal_speed;
 
+    #if ENABLED(JUNCTION_DEVIATION)
+      /**
+       * Unit vector of previous path line segment
+       */
+      static float previous_unit_vec[XYZE];
+    #endif
+
     /**
      * Limit where 64bit math is necessary for acceleration calculation
      */
@@ -309,7 +325,7 @@ class Planner {
      */
     FORCE_INLINE static uint8_t movesplanned() { return BLOCK_MOD(block_buffer_head - block_buffer_tail + BLOCK_BUFFER_SIZE); }
 
-    FORCE_INLINE static void clear_block_buffer() { block_buffer_head = block_buffer_tail = 0; }
+    FORCE_INLINE static void clear_block_buffer() { block_buffer_head = block_buffer_tail = block_buffer_planned = 0; }
 
     FORCE_INLINE static bool is_full() { return block_buffer_tail == next_block_index(block_buffer_head); }
 
@@ -535,8 +551,11 @@ class Planner {
      * Called when the current block is no longer needed.
      */
     FORCE_INLINE static void discard_current_block() {
-      if (has_blocks_queued())
+      if (has_blocks_queued()) {
+        // The optimal block pointer follows the tail, so it never refers to a released block
+        if (block_buffer_planned == block_buffer_tail) block_buffer_planned = BLOCK_MOD(block_buffer_tail + 1);
         block_buffer_tail = BLOCK_MOD(block_buffer_tail + 1);
+      }
     }
 
     /**
@@ -611,6 +630,10 @@ class Planner {
       static void autotemp_M104_M109();
     #endif
 
+    #if ENABLED(MPCTEMP)
+      static float get_extrusion_rate(const uint8_t extruder, const float seconds);
+    #endif
+
   private:
 
     /**
@@ -667,7 +690,7 @@ class Planner {
     static void reverse_pass();
     static void forward_pass();
 
-    static void recalculate_trapezoids();
+    static void recalculate_trapezoids(const uint8_t first_index);
 
     static void recalculate();
 
@@ -33,7 +33,7 @@
 
 #include "planner.h"
 #include "motion.h"
-#include "temperature.h"
+#include "segment_producer.h"
 
 #include "../Marlin.h"
 #include "../core/language.h"
@@ -107,91 +107,111 @@ inline static float dist1(float x1, float y1, float x2, float y2) { return FABS(
  * estimates; however, given the improbability of such configurations,
  * the mitigation offered by MIN_STEP and the small computational
  * power available on Arduino, I think it is not wise to implement it.
+ *
+ * Each call to next() takes one step and buffers one segment, so the
+ * segment feed can interleave the curve with the rest of the firmware.
  */
-void cubic_b_spline(const float position[NUM_AXIS], const float target[NUM_AXIS], const float offset[4], float fr_mm_s, uint8_t extruder) {
-  // Absolute first and second control points are recovered.
-  const float first0 = position[X_AXIS] + offset[0],
-              first1 = position[Y_AXIS] + offset[1],
-              second0 = target[X_AXIS] + offset[2],
-              second1 = target[Y_AXIS] + offset[3];
-  float t = 0.0;
-
-  float bez_target[4];
-  bez_target[X_AXIS] = position[X_AXIS];
-  bez_target[Y_AXIS] = position[Y_AXIS];
-  float step = MAX_STEP;
-
-  millis_t next_idle_ms = millis() + 200UL;
-
-  while (t < 1.0) {
-
-    thermalManager.manage_heater();
-    millis_t now = millis();
-    if (ELAPSED(now, next_idle_ms)) {
-      next_idle_ms = now + 200UL;
-      idle();
-    }
+class CubicProducer : public SegmentProducer {
+  public:
+    float start[XYZE], end[XYZE], bez_target[XYZE],
+          first0, first1, second0, second1,
+          t, step, fr_mm_s;
+    uint8_t extruder;
+
+    bool next();
+};
+
+bool CubicProducer::next() {
+  // First try to reduce the step in order to make it sufficiently
+  // close to a linear interpolation.
+  bool did_reduce = false;
+  float new_t = t + step;
+  NOMORE(new_t, 1.0);
+  float new_pos0 = eval_bezier(start[X_AXIS], first0, second0, end[X_AXIS], new_t),
+        new_pos1 = eval_bezier(start[Y_AXIS], first1, second1, end[Y_AXIS], new_t);
+  for (;;) {
+    if (new_t - t < (MIN_STEP)) break;
+    const float candidate_t = 0.5 * (t + new_t),
+                candidate_pos0 = eval_bezier(start[X_AXIS], first0, second0, end[X_AXIS], candidate_t),
+                candidate_pos1 = eval_bezier(start[Y_AXIS], first1, second1, end[Y_AXIS], candidate_t),
+                interp_pos0 = 0.5 * (bez_target[X_AXIS] + new_pos0),
+                interp_pos1 = 0.5 * (bez_target[Y_AXIS] + new_pos1);
+    if (dist1(candidate_pos0, candidate_pos1, interp_pos0, interp_pos1) <= (SIGMA)) break;
+    new_t = candidate_t;
+    new_pos0 = candidate_pos0;
+    new_pos1 = candidate_pos1;
+    did_reduce = true;
+  }
 
-    // First try to reduce the step in order to make it sufficiently
-    // close to a linear interpolation.
-    bool did_reduce = false;
-    float new_t = t + step;
-    NOMORE(new_t, 1.0);
-    float new_pos0 = eval_bezier(position[X_AXIS], first0, second0, target[X_AXIS], new_t),
-          new_pos1 = eval_bezier(position[Y_AXIS], first1, second1, target[Y_AXIS], new_t);
-    for (;;) {
-      if (new_t - t < (MIN_STEP)) break;
-      const float candidate_t = 0.5 * (t + new_t),
-                  candidate_pos0 = eval_bezier(position[X_AXIS], first0, second0, target[X_AXIS], candidate_t),
-                  candidate_pos1 = eval_bezier(position[Y_AXIS], first1, second1, target[Y_AXIS], candidate_t),
-                  interp_pos0 = 0.5 * (bez_target[X_AXIS] + new_pos0),
-                  interp_pos1 = 0.5 * (bez_target[Y_AXIS] + new_pos1);
-      if (dist1(candidate_pos0, candidate_pos1, interp_pos0, interp_pos1) <= (SIGMA)) break;
-      new_t = candidate_t;
-      new_pos0 = candidate_pos0;
-      new_pos1 = candidate_pos1;
-      did_reduce = true;
-    }
+  // If we did not reduce the step, maybe we should enlarge it.
+  if (!did_reduce) for (;;) {
+    if (new_t - t > MAX_STEP) break;
+    const float candidate_t = t + 2.0 * (new_t - t);
+    if (candidate_t >= 1.0) break;
+    const float candidate_pos0 = eval_bezier(start[X_AXIS], first0, second0, end[X_AXIS], candidate_t),
+                candidate_pos1 = eval_bezier(start[Y_AXIS], first1, second1, end[Y_AXIS], candidate_t),
+                interp_pos0 = 0.5 * (bez_target[X_AXIS] + candidate_pos0),
+                interp_pos1 = 0.5 * (bez_target[Y_AXIS] + candidate_pos1);
+    if (dist1(new_pos0, new_pos1, interp_pos0, interp_pos1) > (SIGMA)) break;
+    new_t = candidate_t;
+    new_pos0 = candidate_pos0;
+    new_pos1 = candidate_pos1;
+  }
 
-    // If we did not reduce the step, maybe we should enlarge it.
-    if (!did_reduce) for (;;) {
-      if (new_t - t > MAX_STEP) break;
-      const float candidate_t = t + 2.0 * (new_t - t);
-      if (candidate_t >= 1.0) break;
-      const float candidate_pos0 = eval_bezier(position[X_AXIS], first0, second0, target[X_AXIS], candidate_t),
-                  candidate_pos1 = eval_bezier(position[Y_AXIS], first1, second1, target[Y_AXIS], candidate_t),
-                  interp_pos0 = 0.5 * (bez_target[X_AXIS] + candidate_pos0),
-                  interp_pos1 = 0.5 * (bez_target[Y_AXIS] + candidate_pos1);
-      if (dist1(new_pos0, new_pos1, interp_pos0, interp_pos1) > (SIGMA)) break;
-      new_t = candidate_t;
-      new_pos0 = candidate_pos0;
-      new_pos1 = candidate_pos1;
+  // Check some postcondition; they are disabled in the actual
+  // Marlin build, but if you test the same code on a computer you
+  // may want to check they are respect.
+  /*
+    assert(new_t <= 1.0);
+    if (new_t < 1.0) {
+      assert(new_t - t >= (MIN_STEP) / 2.0);
+      assert(new_t - t <= (MAX_STEP) * 2.0);
     }
+  */
+
+  step = new_t - t;
+  t = new_t;
+
+  // Compute and send new position
+  bez_target[X_AXIS] = new_pos0;
+  bez_target[Y_AXIS] = new_pos1;
+  // FIXME. The following two are wrong, since the parameter t is
+  // not linear in the distance.
+  bez_target[Z_AXIS] = interp(start[Z_AXIS], end[Z_AXIS], t);
+  bez_target[E_AXIS] = interp(start[E_AXIS], end[E_AXIS], t);
+  clamp_to_software_endstops(bez_target);
+  planner.buffer_line_kinematic(bez_target, fr_mm_s, extruder);
+
+  return t < 1.0;
+}
 
-    // Check some postcondition; they are disabled in the actual
-    // Marlin build, but if you test the same code on a computer you
-    // may want to check they are respect.
-    /*
-      assert(new_t <= 1.0);
-      if (new_t < 1.0) {
-        assert(new_t - t >= (MIN_STEP) / 2.0);
-        assert(new_t - t <= (MAX_STEP) * 2.0);
-      }
-    */
-
-    step = new_t - t;
-    t = new_t;
-
-    // Compute and send new position
-    bez_target[X_AXIS] = new_pos0;
-    bez_target[Y_AXIS] = new_pos1;
-    // FIXME. The following two are wrong, since the parameter t is
-    // not linear in the distance.
-    bez_target[Z_AXIS] = interp(position[Z_AXIS], target[Z_AXIS], t);
-    bez_target[E_AXIS] = interp(position[E_AXIS], target[E_AXIS], t);
-    clamp_to_software_endstops(bez_target);
-    planner.buffer_line_kinematic(bez_target, fr_mm_s, extruder);
+static CubicProducer cubic;
+
+/**
+ * Set up a spline and hand it to the segment feed
+ */
+void cubic_b_spline(const float position[NUM_AXIS], const float target[NUM_AXIS], const float offset[4], float fr_mm_s, uint8_t extruder) {
+  // Only one spline is cut at a time
+  segment_feed.finish();
+
+  // Absolute first and second control points are recovered.
+  cubic.first0 = position[X_AXIS] + offset[0];
+  cubic.first1 = position[Y_AXIS] + offset[1];
+  cubic.second0 = target[X_AXIS] + offset[2];
+  cubic.second1 = target[Y_AXIS] + offset[3];
+  cubic.t = 0.0;
+
+  LOOP_XYZE(i) {
+    cubic.start[i] = position[i];
+    cubic.end[i] = target[i];
   }
+  cubic.bez_target[X_AXIS] = position[X_AXIS];
+  cubic.bez_target[Y_AXIS] = position[Y_AXIS];
+  cubic.step = MAX_STEP;
+  cubic.fr_mm_s = fr_mm_s;
+  cubic.extruder = extruder;
+
+  segment_feed.start(cubic);
 }
 
 #endif // BEZIER_CURVE_SUPPORT
@@ -0,0 +1,57 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * segment_producer.cpp - Moves buffered a segment at a time
+ */
+
+#include "segment_producer.h"
+#include "planner.h"
+
+#include "../Marlin.h"
+
+SegmentFeed segment_feed;
+
+SegmentProducer *SegmentFeed::producer; // = NULL
+bool SegmentFeed::feeding; // = false
+
+void SegmentFeed::start(SegmentProducer &p) {
+  finish();
+  producer = &p;
+}
+
+void SegmentFeed::run() {
+  // A producer can wait for the planner in idle(), which must not re-enter it
+  if (feeding) return;
+  feeding = true;
+  while (producer && !planner.is_full())
+    if (!producer->next()) producer = NULL;
+  feeding = false;
+}
+
+void SegmentFeed::finish() {
+  if (feeding) return;
+  while (producer) {
+    run();
+    if (producer) idle();
+  }
+}
@@ -0,0 +1,78 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * segment_producer.h - Moves buffered a segment at a time
+ */
+
+#ifndef _SEGMENT_PRODUCER_H_
+#define _SEGMENT_PRODUCER_H_
+
+#include "../inc/MarlinConfig.h"
+
+/**
+ * A move that goes to the planner as many segments: an arc, a spline,
+ * or a kinematic or mesh-leveled line. It keeps the state of the cut
+ * between segments, so it can be buffered one segment at a time.
+ */
+class SegmentProducer {
+  public:
+    // Buffer the next segment. Return false after the last one.
+    virtual bool next() = 0;
+};
+
+/**
+ * Feed the segments of a started move to the planner.
+ *
+ * G0-G3 and G5 start the move and return. loop() then calls run() to
+ * buffer segments whenever the planner has free slots, and holds back
+ * the next command until the move is done, while serial and SD input,
+ * the LCD and the heaters carry on.
+ *
+ * Any other code that needs the whole move buffered before going on
+ * calls finish(), which waits for the planner like a blocking loop.
+ */
+class SegmentFeed {
+  public:
+    static SegmentProducer *producer;
+
+    FORCE_INLINE static bool busy() { return producer != NULL; }
+
+    // Start a move. Any move still being fed is finished first.
+    static void start(SegmentProducer &p);
+
+    // Buffer segments while the planner has room
+    static void run();
+
+    // Buffer all the remaining segments
+    static void finish();
+
+    // Drop the remaining segments (e.g., on a quick stop)
+    FORCE_INLINE static void abort() { producer = NULL; }
+
+  private:
+    static bool feeding;
+};
+
+extern SegmentFeed segment_feed;
+
+#endif // _SEGMENT_PRODUCER_H_
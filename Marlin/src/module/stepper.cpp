@@ -60,6 +60,7 @@
 #include "endstops.h"
 #include "planner.h"
 #include "motion.h"
+#include "segment_producer.h"
 
 #include "../module/temperature.h"
 #include "../lcd/ultralcd.h"
@@ -72,6 +73,14 @@
   #include "../feature/dac/dac_dac084s085.h"
 #endif
 
+#if ENABLED(STEP_TIMELINE)
+  #include "../feature/step_timeline.h"
+#endif
+
+#if ENABLED(CODE_PROFILER)
+  #include "../feature/profiler.h"
+#endif
+
 #if HAS_DIGIPOTSS
   #include <SPI.h>
 #endif
@@ -164,6 +173,11 @@ volatile signed char Stepper::count_direction[NUM_AXIS] = { 1, 1, 1, 1 };
 
 uint8_t Stepper::step_loops, Stepper::step_loops_nominal;
 
+#ifdef STEP_PATTERN_BUFFER
+  Stepper::step_pattern_t Stepper::step_pattern[STEP_PATTERN_BUFFER];
+  uint8_t Stepper::step_pattern_head = 0, Stepper::step_pattern_tail = 0;
+#endif
+
 hal_timer_t Stepper::OCR1A_nominal;
 #if DISABLED(BEZIER_JERK_CONTROL)
   hal_timer_t Stepper::acc_step_rate; // needed for deceleration start point
@@ -304,6 +318,9 @@ void Stepper::set_directions() {
   #endif
 
   #if DISABLED(LIN_ADVANCE)
+    #if EXTRUDERS > 1
+      if (!current_block) return; // Called by init(): the E driver to set is the block's extruder
+    #endif
     if (motor_direction(E_AXIS)) {
       REV_E_DIR();
       count_direction[E_AXIS] = -1;
@@ -1125,6 +1142,82 @@ void Stepper::set_directions() {
   #endif
 #endif // BEZIER_JERK_CONTROL
 
+/**
+ * Advance the speed profile of the current block after the
+ * step events of an ISR and get the timer interval to the next.
+ * Also sets step_loops, the number of step events in that ISR.
+ */
+FORCE_INLINE hal_timer_t Stepper::calc_step_interval() {
+
+  if (step_events_completed <= (uint32_t)current_block->accelerate_until) {
+
+    #if ENABLED(BEZIER_JERK_CONTROL)
+      // Get the next speed to use (Jerk limited!)
+      hal_timer_t acc_step_rate =
+        acceleration_time < current_block->acceleration_time
+          ? _eval_bezier_curve(acceleration_time)
+          : current_block->cruise_rate;
+    #else
+      #ifdef CPU_32_BIT
+        MultiU32X24toH32(acc_step_rate, acceleration_time, current_block->acceleration_rate);
+      #else
+        MultiU24X32toH16(acc_step_rate, acceleration_time, current_block->acceleration_rate);
+      #endif
+      acc_step_rate += current_block->initial_rate;
+
+      // upper limit
+      NOMORE(acc_step_rate, current_block->nominal_rate);
+    #endif
+
+    // step_rate to timer interval
+    const hal_timer_t interval = calc_timer_interval(acc_step_rate);
+    acceleration_time += interval;
+    return interval;
+  }
+  else if (step_events_completed > (uint32_t)current_block->decelerate_after) {
+    hal_timer_t step_rate;
+
+    #if ENABLED(BEZIER_JERK_CONTROL)
+      // If this is the 1st time we process the 2nd half of the trapezoid...
+      if (!bezier_2nd_half) {
+
+        // Initialize the Bzier speed curve
+        _calc_bezier_curve_coeffs(current_block->cruise_rate, current_block->final_rate, current_block->deceleration_time_inverse);
+        bezier_2nd_half = true;
+      }
+
+      // Calculate the next speed to use
+      step_rate = deceleration_time < current_block->deceleration_time
+        ? _eval_bezier_curve(deceleration_time)
+        : current_block->final_rate;
+    #else
+
+      // Using the old trapezoidal control
+      #ifdef CPU_32_BIT
+        MultiU32X24toH32(step_rate, deceleration_time, current_block->acceleration_rate);
+      #else
+        MultiU24X32toH16(step_rate, deceleration_time, current_block->acceleration_rate);
+      #endif
+
+      if (step_rate < acc_step_rate) { // Still decelerating?
+        step_rate = acc_step_rate - step_rate;
+        NOLESS(step_rate, current_block->final_rate);
+      }
+      else
+        step_rate = current_block->final_rate;
+    #endif
+
+    // step_rate to timer interval
+    const hal_timer_t interval = calc_timer_interval(step_rate);
+    deceleration_time += interval;
+    return interval;
+  }
+
+  // ensure we're running at the correct step rate, even if we just came off an acceleration
+  step_loops = step_loops_nominal;
+  return OCR1A_nominal;
+}
+
 /**
  * Stepper Driver Interrupt
  *
@@ -1145,6 +1238,14 @@ void Stepper::set_directions() {
 HAL_STEP_TIMER_ISR {
   HAL_timer_isr_prologue(STEP_TIMER_NUM);
 
+  #if ENABLED(CODE_PROFILER)
+    PROFILE_ZONE(PROFILE_STEPPER_ISR);
+  #endif
+
+  #if ENABLED(STEP_TIMELINE)
+    step_timeline.elapse(HAL_timer_get_compare(STEP_TIMER_NUM)); // The timer restarts at each compare match
+  #endif
+
   #if ENABLED(LIN_ADVANCE)
     Stepper::advance_isr_scheduler();
   #else
@@ -1207,6 +1308,9 @@ void Stepper::isr() {
       #endif
     }
     current_block = NULL;                       // Prep to get a new block after cleaning
+    #ifdef STEP_PATTERN_BUFFER
+      step_pattern_tail = step_pattern_head;    // Drop the steps computed for it
+    #endif
     _NEXT_ISR(HAL_STEPPER_TIMER_RATE / 10000);  // Run at max speed - 10 KHz
     return;
   }
@@ -1217,6 +1321,10 @@ void Stepper::isr() {
     // Anything in the buffer?
     if ((current_block = planner.get_current_block())) {
 
+      #if ENABLED(STEP_TIMELINE)
+        step_timeline.mark(TIMELINE_BLOCK);
+      #endif
+
       // Initialize the trapezoid generator from the current block.
       static int8_t last_extruder = -1;
 
@@ -1267,10 +1375,10 @@ void Stepper::isr() {
       #endif
 
       // Initialize Bresenham counters to 1/2 the ceiling
-      counter_X = counter_Y = counter_Z = counter_E = -(current_block->step_event_count >> 1);
+      counter_X = counter_Y = counter_Z = counter_E = -(long)(current_block->step_event_count >> 1);
       #if ENABLED(MIXING_EXTRUDER)
         MIXING_STEPPERS_LOOP(i)
-          counter_m[i] = -(current_block->mix_event_count[i] >> 1);
+          counter_m[i] = -(long)(current_block->mix_event_count[i] >> 1);
       #endif
 
       #if ENABLED(ENDSTOP_INTERRUPTS_FEATURE)
@@ -1304,85 +1412,179 @@ void Stepper::isr() {
     if (ENDSTOPS_ENABLED) endstops.update();
   #endif
 
-  // Take multiple steps per interrupt (For high speed moves)
-  bool all_steps_done = false;
-  for (uint8_t i = step_loops; i--;) {
+  #define _COUNTER(AXIS) counter_## AXIS
+  #define _APPLY_STEP(AXIS) AXIS ##_APPLY_STEP
+  #define _INVERT_STEP_PIN(AXIS) INVERT_## AXIS ##_STEP_PIN
 
-    #define _COUNTER(AXIS) counter_## AXIS
-    #define _APPLY_STEP(AXIS) AXIS ##_APPLY_STEP
-    #define _INVERT_STEP_PIN(AXIS) INVERT_## AXIS ##_STEP_PIN
+  // Advance the Bresenham counter; start a pulse if the axis needs a step
+  #define PULSE_START(AXIS) do{ \
+    _COUNTER(AXIS) += current_block->steps[_AXIS(AXIS)]; \
+    if (_COUNTER(AXIS) > 0) { _APPLY_STEP(AXIS)(!_INVERT_STEP_PIN(AXIS), 0); } \
+  }while(0)
 
-    // Advance the Bresenham counter; start a pulse if the axis needs a step
-    #define PULSE_START(AXIS) do{ \
-      _COUNTER(AXIS) += current_block->steps[_AXIS(AXIS)]; \
-      if (_COUNTER(AXIS) > 0) { _APPLY_STEP(AXIS)(!_INVERT_STEP_PIN(AXIS), 0); } \
-    }while(0)
+  #if ENABLED(STEP_TIMELINE)
+    #define TIMELINE_STEP(AXIS) SBI(timeline_bits, _AXIS(AXIS))
+  #else
+    #define TIMELINE_STEP(AXIS) NOOP
+  #endif
 
-    // Advance the Bresenham counter; start a pulse if the axis needs a step
-    #define STEP_TICK(AXIS) do { \
-      if (_COUNTER(AXIS) > 0) { \
-        _COUNTER(AXIS) -= current_block->step_event_count; \
+  // Advance the Bresenham counter; start a pulse if the axis needs a step
+  #define STEP_TICK(AXIS) do { \
+    if (_COUNTER(AXIS) > 0) { \
+      TIMELINE_STEP(AXIS); \
+      _COUNTER(AXIS) -= current_block->step_event_count; \
+      count_position[_AXIS(AXIS)] += count_direction[_AXIS(AXIS)]; \
+    } \
+  }while(0)
+
+  // Stop an active pulse, if any
+  #define PULSE_STOP(AXIS) _APPLY_STEP(AXIS)(_INVERT_STEP_PIN(AXIS), 0)
+
+  /**
+   * Estimate the number of cycles that the stepper logic already takes
+   * up between the start and stop of the X stepper pulse.
+   *
+   * Currently this uses very modest estimates of around 5 cycles.
+   * True values may be derived by careful testing.
+   *
+   * Once any delay is added, the cost of the delay code itself
+   * may be subtracted from this value to get a more accurate delay.
+   * Delays under 20 cycles (1.25µs) will be very accurate, using NOPs.
+   * Longer delays use a loop. The resolution is 8 cycles.
+   */
+  #if HAS_X_STEP
+    #define _CYCLE_APPROX_1 5
+  #else
+    #define _CYCLE_APPROX_1 0
+  #endif
+  #if ENABLED(X_DUAL_STEPPER_DRIVERS)
+    #define _CYCLE_APPROX_2 _CYCLE_APPROX_1 + 4
+  #else
+    #define _CYCLE_APPROX_2 _CYCLE_APPROX_1
+  #endif
+  #if HAS_Y_STEP
+    #define _CYCLE_APPROX_3 _CYCLE_APPROX_2 + 5
+  #else
+    #define _CYCLE_APPROX_3 _CYCLE_APPROX_2
+  #endif
+  #if ENABLED(Y_DUAL_STEPPER_DRIVERS)
+    #define _CYCLE_APPROX_4 _CYCLE_APPROX_3 + 4
+  #else
+    #define _CYCLE_APPROX_4 _CYCLE_APPROX_3
+  #endif
+  #if HAS_Z_STEP
+    #define _CYCLE_APPROX_5 _CYCLE_APPROX_4 + 5
+  #else
+    #define _CYCLE_APPROX_5 _CYCLE_APPROX_4
+  #endif
+  #if ENABLED(Z_DUAL_STEPPER_DRIVERS)
+    #define _CYCLE_APPROX_6 _CYCLE_APPROX_5 + 4
+  #else
+    #define _CYCLE_APPROX_6 _CYCLE_APPROX_5
+  #endif
+  #if DISABLED(LIN_ADVANCE)
+    #if ENABLED(MIXING_EXTRUDER)
+      #define _CYCLE_APPROX_7 _CYCLE_APPROX_6 + (MIXING_STEPPERS) * 6
+    #else
+      #define _CYCLE_APPROX_7 _CYCLE_APPROX_6 + 5
+    #endif
+  #else
+    #define _CYCLE_APPROX_7 _CYCLE_APPROX_6
+  #endif
+
+  #define CYCLES_EATEN_XYZE _CYCLE_APPROX_7
+  #define EXTRA_CYCLES_XYZE (STEP_PULSE_CYCLES - (CYCLES_EATEN_XYZE))
+
+  #ifdef STEP_PATTERN_BUFFER
+
+    // Start a pulse if the axis steps in this event
+    #define PATTERN_PULSE_START(AXIS) do{ \
+      if (TEST(step_bits, _AXIS(AXIS))) { \
+        _APPLY_STEP(AXIS)(!_INVERT_STEP_PIN(AXIS), 0); \
         count_position[_AXIS(AXIS)] += count_direction[_AXIS(AXIS)]; \
       } \
     }while(0)
 
-    // Stop an active pulse, if any
-    #define PULSE_STOP(AXIS) _APPLY_STEP(AXIS)(_INVERT_STEP_PIN(AXIS), 0)
+    // The first ISR of a block computes the step events to come
+    if (step_pattern_head == step_pattern_tail) fill_step_pattern();
 
-    /**
-     * Estimate the number of cycles that the stepper logic already takes
-     * up between the start and stop of the X stepper pulse.
-     *
-     * Currently this uses very modest estimates of around 5 cycles.
-     * True values may be derived by careful testing.
-     *
-     * Once any delay is added, the cost of the delay code itself
-     * may be subtracted from this value to get a more accurate delay.
-     * Delays under 20 cycles (1.25µs) will be very accurate, using NOPs.
-     * Longer delays use a loop. The resolution is 8 cycles.
-     */
-    #if HAS_X_STEP
-      #define _CYCLE_APPROX_1 5
-    #else
-      #define _CYCLE_APPROX_1 0
-    #endif
-    #if ENABLED(X_DUAL_STEPPER_DRIVERS)
-      #define _CYCLE_APPROX_2 _CYCLE_APPROX_1 + 4
-    #else
-      #define _CYCLE_APPROX_2 _CYCLE_APPROX_1
-    #endif
-    #if HAS_Y_STEP
-      #define _CYCLE_APPROX_3 _CYCLE_APPROX_2 + 5
-    #else
-      #define _CYCLE_APPROX_3 _CYCLE_APPROX_2
-    #endif
-    #if ENABLED(Y_DUAL_STEPPER_DRIVERS)
-      #define _CYCLE_APPROX_4 _CYCLE_APPROX_3 + 4
-    #else
-      #define _CYCLE_APPROX_4 _CYCLE_APPROX_3
-    #endif
-    #if HAS_Z_STEP
-      #define _CYCLE_APPROX_5 _CYCLE_APPROX_4 + 5
-    #else
-      #define _CYCLE_APPROX_5 _CYCLE_APPROX_4
-    #endif
-    #if ENABLED(Z_DUAL_STEPPER_DRIVERS)
-      #define _CYCLE_APPROX_6 _CYCLE_APPROX_5 + 4
-    #else
-      #define _CYCLE_APPROX_6 _CYCLE_APPROX_5
-    #endif
-    #if DISABLED(LIN_ADVANCE)
-      #if ENABLED(MIXING_EXTRUDER)
-        #define _CYCLE_APPROX_7 _CYCLE_APPROX_6 + (MIXING_STEPPERS) * 6
-      #else
-        #define _CYCLE_APPROX_7 _CYCLE_APPROX_6 + 5
+    // Emit the step events of this ISR, up to the one followed by a delay
+    hal_timer_t pattern_interval = HAL_STEPPER_TIMER_RATE / 10000; // Nothing to emit if the block was killed
+    while (step_pattern_head != step_pattern_tail) {
+      const uint8_t step_bits = step_pattern[step_pattern_tail].step_bits;
+      pattern_interval = step_pattern[step_pattern_tail].interval;
+      step_pattern_tail = STEP_PATTERN_MOD(step_pattern_tail + 1);
+
+      #if EXTRA_CYCLES_XYZE > 20
+        hal_timer_t pulse_start = HAL_timer_get_count(PULSE_TIMER_NUM);
       #endif
-    #else
-      #define _CYCLE_APPROX_7 _CYCLE_APPROX_6
-    #endif
 
-    #define CYCLES_EATEN_XYZE _CYCLE_APPROX_7
-    #define EXTRA_CYCLES_XYZE (STEP_PULSE_CYCLES - (CYCLES_EATEN_XYZE))
+      #if HAS_X_STEP
+        PATTERN_PULSE_START(X);
+      #endif
+      #if HAS_Y_STEP
+        PATTERN_PULSE_START(Y);
+      #endif
+      #if HAS_Z_STEP
+        PATTERN_PULSE_START(Z);
+      #endif
+      PATTERN_PULSE_START(E);
+
+      #if ENABLED(STEP_TIMELINE)
+        step_timeline.record(step_bits, last_direction_bits);
+      #endif
+
+      // For minimum pulse time wait before stopping pulses
+      #if EXTRA_CYCLES_XYZE > 20
+        while (EXTRA_CYCLES_XYZE > (uint32_t)(HAL_timer_get_count(PULSE_TIMER_NUM) - pulse_start) * (PULSE_TIMER_PRESCALE)) { /* nada */ }
+        pulse_start = HAL_timer_get_count(PULSE_TIMER_NUM);
+      #elif EXTRA_CYCLES_XYZE > 0
+        DELAY_NOPS(EXTRA_CYCLES_XYZE);
+      #endif
+
+      #if HAS_X_STEP
+        PULSE_STOP(X);
+      #endif
+      #if HAS_Y_STEP
+        PULSE_STOP(Y);
+      #endif
+      #if HAS_Z_STEP
+        PULSE_STOP(Z);
+      #endif
+      PULSE_STOP(E);
+
+      if (pattern_interval) break;
+
+      // For minimum pulse time wait after stopping pulses also
+      #if EXTRA_CYCLES_XYZE > 20
+        while (EXTRA_CYCLES_XYZE > (uint32_t)(HAL_timer_get_count(PULSE_TIMER_NUM) - pulse_start) * (PULSE_TIMER_PRESCALE)) { /* nada */ }
+      #elif EXTRA_CYCLES_XYZE > 0
+        DELAY_NOPS(EXTRA_CYCLES_XYZE);
+      #endif
+    }
+
+    SPLIT(pattern_interval);  // split step into multiple ISRs if larger than ENDSTOP_NOMINAL_OCR_VAL
+    _NEXT_ISR(ocr_val);
+
+    // Make sure stepper ISR doesn't monopolize the CPU
+    HAL_timer_restrain(STEP_TIMER_NUM, STEP_TIMER_MIN_INTERVAL * HAL_TICKS_PER_US);
+
+    if (step_pattern_head == step_pattern_tail) {
+      // Compute the next step events while waiting for the timer
+      if (step_events_completed < current_block->step_event_count)
+        fill_step_pattern();
+      else {
+        current_block = NULL;
+        planner.discard_current_block();
+      }
+    }
+    return;
+
+  #endif // STEP_PATTERN_BUFFER
+
+  // Take multiple steps per interrupt (For high speed moves)
+  bool all_steps_done = false;
+  for (uint8_t i = step_loops; i--;) {
 
     /**
      * If a minimum pulse time was specified get the timer 0 value.
@@ -1396,6 +1598,10 @@ void Stepper::isr() {
       hal_timer_t pulse_start = HAL_timer_get_count(PULSE_TIMER_NUM);
     #endif
 
+    #if ENABLED(STEP_TIMELINE)
+      uint8_t timeline_bits = 0;
+    #endif
+
     #if HAS_X_STEP
       PULSE_START(X);
     #endif
@@ -1456,6 +1662,13 @@ void Stepper::isr() {
 
     STEP_TICK(E); // Always tick the single E axis
 
+    #if ENABLED(STEP_TIMELINE)
+      #if ENABLED(LIN_ADVANCE)
+        CBI(timeline_bits, E_AXIS); // E is stepped by advance_isr
+      #endif
+      step_timeline.record(timeline_bits, last_direction_bits);
+    #endif
+
     // For minimum pulse time wait before stopping pulses
     #if EXTRA_CYCLES_XYZE > 20
       while (EXTRA_CYCLES_XYZE > (uint32_t)(HAL_timer_get_count(PULSE_TIMER_NUM) - pulse_start) * (PULSE_TIMER_PRESCALE)) { /* nada */ }
@@ -1502,35 +1715,13 @@ void Stepper::isr() {
   } // steps_loop
 
   // Calculate new timer value
-  if (step_events_completed <= (uint32_t)current_block->accelerate_until) {
+  const hal_timer_t interval = calc_step_interval();
 
-    #if ENABLED(BEZIER_JERK_CONTROL)
-      // Get the next speed to use (Jerk limited!)
-      hal_timer_t acc_step_rate =
-        acceleration_time < current_block->acceleration_time
-          ? _eval_bezier_curve(acceleration_time)
-          : current_block->cruise_rate;
-    #else
-      #ifdef CPU_32_BIT
-        MultiU32X24toH32(acc_step_rate, acceleration_time, current_block->acceleration_rate);
-      #else
-        MultiU24X32toH16(acc_step_rate, acceleration_time, current_block->acceleration_rate);
-      #endif
-      acc_step_rate += current_block->initial_rate;
+  SPLIT(interval);  // split step into multiple ISRs if larger than ENDSTOP_NOMINAL_OCR_VAL
+  _NEXT_ISR(ocr_val);
 
-      // upper limit
-      NOMORE(acc_step_rate, current_block->nominal_rate);
-    #endif
-
-    // step_rate to timer interval
-    const hal_timer_t interval = calc_timer_interval(acc_step_rate);
-
-    SPLIT(interval);  // split step into multiple ISRs if larger than ENDSTOP_NOMINAL_OCR_VAL
-    _NEXT_ISR(ocr_val);
-
-    acceleration_time += interval;
-
-    #if ENABLED(LIN_ADVANCE)
+  #if ENABLED(LIN_ADVANCE)
+    if (step_events_completed <= (uint32_t)current_block->accelerate_until) {
       if (current_block->use_advance_lead) {
         if (step_events_completed == step_loops || (e_steps && eISR_Rate != current_block->advance_speed)) {
           nextAdvanceISR = 0; // Wake up eISR on first acceleration loop and fire ISR if final adv_rate is reached
@@ -1541,50 +1732,8 @@ void Stepper::isr() {
         eISR_Rate = ADV_NEVER;
         if (e_steps) nextAdvanceISR = 0;
       }
-    #endif // LIN_ADVANCE
-  }
-  else if (step_events_completed > (uint32_t)current_block->decelerate_after) {
-    hal_timer_t step_rate;
-
-    #if ENABLED(BEZIER_JERK_CONTROL)
-      // If this is the 1st time we process the 2nd half of the trapezoid...
-      if (!bezier_2nd_half) {
-
-        // Initialize the Bézier speed curve
-        _calc_bezier_curve_coeffs(current_block->cruise_rate, current_block->final_rate, current_block->deceleration_time_inverse);
-        bezier_2nd_half = true;
-      }
-
-      // Calculate the next speed to use
-      step_rate = deceleration_time < current_block->deceleration_time
-        ? _eval_bezier_curve(deceleration_time)
-        : current_block->final_rate;
-    #else
-
-      // Using the old trapezoidal control
-      #ifdef CPU_32_BIT
-        MultiU32X24toH32(step_rate, deceleration_time, current_block->acceleration_rate);
-      #else
-        MultiU24X32toH16(step_rate, deceleration_time, current_block->acceleration_rate);
-      #endif
-
-      if (step_rate < acc_step_rate) { // Still decelerating?
-        step_rate = acc_step_rate - step_rate;
-        NOLESS(step_rate, current_block->final_rate);
-      }
-      else
-        step_rate = current_block->final_rate;
-    #endif
-
-    // step_rate to timer interval
-    const hal_timer_t interval = calc_timer_interval(step_rate);
-
-    SPLIT(interval);  // split step into multiple ISRs if larger than ENDSTOP_NOMINAL_OCR_VAL
-    _NEXT_ISR(ocr_val);
-
-    deceleration_time += interval;
-
-    #if ENABLED(LIN_ADVANCE)
+    }
+    else if (step_events_completed > (uint32_t)current_block->decelerate_after) {
       if (current_block->use_advance_lead) {
         if (step_events_completed <= (uint32_t)current_block->decelerate_after + step_loops || (e_steps && eISR_Rate != current_block->advance_speed)) {
           nextAdvanceISR = 0; // Wake up eISR on first deceleration loop
@@ -1595,21 +1744,12 @@ void Stepper::isr() {
         eISR_Rate = ADV_NEVER;
         if (e_steps) nextAdvanceISR = 0;
       }
-    #endif // LIN_ADVANCE
-  }
-  else {
-
-    #if ENABLED(LIN_ADVANCE)
+    }
+    else {
       // If we have esteps to execute, fire the next advance_isr "now"
       if (e_steps && eISR_Rate != current_block->advance_speed) nextAdvanceISR = 0;
-    #endif
-
-    SPLIT(OCR1A_nominal);  // split step into multiple ISRs if larger than ENDSTOP_NOMINAL_OCR_VAL
-    _NEXT_ISR(ocr_val);
-
-    // ensure we're running at the correct step rate, even if we just came off an acceleration
-    step_loops = step_loops_nominal;
-  }
+    }
+  #endif // LIN_ADVANCE
 
   #if DISABLED(LIN_ADVANCE)
     // Make sure stepper ISR doesn't monopolize the CPU
@@ -1623,6 +1763,69 @@ void Stepper::isr() {
   }
 }
 
+#ifdef STEP_PATTERN_BUFFER
+
+  /**
+   * Compute the step events of the current block for the next ISRs:
+   * the axes to step in each event and, after the last event of an
+   * ISR, the timer interval to the next one. The Bresenham counters
+   * and the speed profile advance just as with the step loop above,
+   * but in one pass over as many events as the buffer can hold, so
+   * the ISRs in between only have to emit them.
+   */
+  void Stepper::fill_step_pattern() {
+    uint8_t head = step_pattern_head, count = 0;
+
+    // Size the first burst of a block for its initial rate, not the nominal rate
+    if (!step_events_completed) calc_timer_interval(current_block->initial_rate);
+
+    // Advance the Bresenham counter; flag the axis if it needs a step
+    #define PATTERN_TICK(AXIS) do{ \
+      _COUNTER(AXIS) += current_block->steps[_AXIS(AXIS)]; \
+      if (_COUNTER(AXIS) > 0) { \
+        _COUNTER(AXIS) -= current_block->step_event_count; \
+        SBI(step_bits, _AXIS(AXIS)); \
+      } \
+    }while(0)
+
+    while (step_events_completed < current_block->step_event_count && count + step_loops < STEP_PATTERN_BUFFER) {
+      for (uint8_t i = step_loops; i--;) {
+        uint8_t step_bits = 0;
+        #if HAS_X_STEP
+          PATTERN_TICK(X);
+        #endif
+        #if HAS_Y_STEP
+          PATTERN_TICK(Y);
+        #endif
+        #if HAS_Z_STEP
+          PATTERN_TICK(Z);
+        #endif
+        PATTERN_TICK(E);
+
+        step_pattern[head].step_bits = step_bits;
+        step_pattern[head].interval = 0;
+        head = STEP_PATTERN_MOD(head + 1);
+        count++;
+
+        if (++step_events_completed >= current_block->step_event_count) break;
+      }
+
+      // The last event of the ISR sets the timer, as the step loop does, for
+      // the next burst, or for the events left if the block ends before it
+      hal_timer_t interval = calc_step_interval();
+      const uint32_t left = current_block->step_event_count - step_events_completed;
+      if (left && left < step_loops) {
+        interval = uint32_t(interval) * left / step_loops;
+        step_loops = left;
+      }
+      step_pattern[STEP_PATTERN_MOD(head - 1)].interval = interval;
+    }
+
+    step_pattern_head = head;
+  }
+
+#endif // STEP_PATTERN_BUFFER
+
 #if ENABLED(LIN_ADVANCE)
 
   #define CYCLES_EATEN_E (E_STEPPERS * 5)
@@ -1715,6 +1918,10 @@ void Stepper::isr() {
         DELAY_NOPS(EXTRA_CYCLES_E);
       #endif
 
+      #if ENABLED(STEP_TIMELINE)
+        step_timeline.record(_BV(E_AXIS), e_steps < 0 ? _BV(E_AXIS) : 0);
+      #endif
+
       switch (LA_active_extruder) {
         case 0: STOP_E_PULSE(0); break;
         #if EXTRUDERS > 1
@@ -1965,7 +2172,10 @@ void Stepper::init() {
 /**
  * Block until all buffered steps are executed / cleaned
  */
-void Stepper::synchronize() { while (planner.has_blocks_queued() || cleaning_buffer_counter) idle(); }
+void Stepper::synchronize() {
+  segment_feed.finish();
+  while (planner.has_blocks_queued() || cleaning_buffer_counter) idle();
+}
 
 /**
  * Set the stepper positions directly in steps
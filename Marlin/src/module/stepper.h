@@ -132,6 +132,17 @@ class Stepper {
     static int32_t acceleration_time, deceleration_time;
     static uint8_t step_loops, step_loops_nominal;
 
+    #ifdef STEP_PATTERN_BUFFER
+      // Step events computed ahead by fill_step_pattern for isr() to emit
+      typedef struct {
+        uint8_t step_bits;    // The axes to step in this event
+        hal_timer_t interval; // Timer interval to the next ISR, or 0 for the next event in the same ISR
+      } step_pattern_t;
+      static step_pattern_t step_pattern[STEP_PATTERN_BUFFER];
+      static uint8_t step_pattern_head, step_pattern_tail;
+      #define STEP_PATTERN_MOD(n) ((n)&(STEP_PATTERN_BUFFER-1))
+    #endif
+
     static hal_timer_t OCR1A_nominal;
     #if DISABLED(BEZIER_JERK_CONTROL)
       static hal_timer_t acc_step_rate; // needed for deceleration start point
@@ -276,6 +287,9 @@ class Stepper {
 
     static inline void kill_current_block() {
       step_events_completed = current_block->step_event_count;
+      #ifdef STEP_PATTERN_BUFFER
+        step_pattern_tail = step_pattern_head;
+      #endif
     }
 
     //
@@ -305,6 +319,15 @@ class Stepper {
       #ifdef CPU_32_BIT
         #if ENABLED(DISABLE_MULTI_STEPPING)
           step_loops = 1;
+        #elif defined(STEP_PATTERN_BUFFER)
+          // The pattern buffer holds whole bursts of any size. Above STEP_DOUBLER_FREQUENCY
+          // a burst spans at least two of its periods, so the ISR runs at half that rate or less.
+          if (step_rate > STEP_DOUBLER_FREQUENCY) {
+            step_loops = (uint32_t(step_rate) * 2 + STEP_DOUBLER_FREQUENCY - 1) / (STEP_DOUBLER_FREQUENCY);
+            NOMORE(step_loops, (STEP_PATTERN_BUFFER) / 2);
+            return uint32_t(HAL_STEPPER_TIMER_RATE) * step_loops / step_rate;
+          }
+          step_loops = 1;
         #else
           if (step_rate > STEP_DOUBLER_FREQUENCY * 2) { // If steprate > (STEP_DOUBLER_FREQUENCY * 2) kHz >> step 4 times
             step_rate >>= 2;
@@ -363,6 +386,12 @@ class Stepper {
       return timer;
     }
 
+    static hal_timer_t calc_step_interval();
+
+    #ifdef STEP_PATTERN_BUFFER
+      static void fill_step_pattern();
+    #endif
+
     #if ENABLED(BEZIER_JERK_CONTROL)
       static void _calc_bezier_curve_coeffs(const int32_t v0, const int32_t v1, const uint32_t av);
       static int32_t _eval_bezier_curve(const uint32_t curr_step);
@@ -45,16 +45,20 @@
 
 #include "printcounter.h"
 
+#if ENABLED(CODE_PROFILER)
+  #include "../feature/profiler.h"
+#endif
+
 #if ENABLED(FILAMENT_WIDTH_SENSOR)
   #include "../feature/filwidth.h"
 #endif
 
 #if ENABLED(TEMP_SENSOR_1_AS_REDUNDANT)
-  static void* heater_ttbl_map[2] = { (void*)HEATER_0_TEMPTABLE, (void*)HEATER_1_TEMPTABLE };
-  static uint8_t heater_ttbllen_map[2] = { HEATER_0_TEMPTABLE_LEN, HEATER_1_TEMPTABLE_LEN };
+  static constexpr const temp_entry_t* heater_ttbl_map[2] = { HEATER_0_TEMPTABLE_LOOKUP, HEATER_1_TEMPTABLE_LOOKUP };
+  static constexpr uint8_t heater_ttbllen_map[2] = { HEATER_0_TEMPTABLE_LEN, HEATER_1_TEMPTABLE_LEN };
 #else
-  static void* heater_ttbl_map[HOTENDS] = ARRAY_BY_HOTENDS((void*)HEATER_0_TEMPTABLE, (void*)HEATER_1_TEMPTABLE, (void*)HEATER_2_TEMPTABLE, (void*)HEATER_3_TEMPTABLE, (void*)HEATER_4_TEMPTABLE);
-  static uint8_t heater_ttbllen_map[HOTENDS] = ARRAY_BY_HOTENDS(HEATER_0_TEMPTABLE_LEN, HEATER_1_TEMPTABLE_LEN, HEATER_2_TEMPTABLE_LEN, HEATER_3_TEMPTABLE_LEN, HEATER_4_TEMPTABLE_LEN);
+  static constexpr const temp_entry_t* heater_ttbl_map[HOTENDS] = ARRAY_BY_HOTENDS(HEATER_0_TEMPTABLE_LOOKUP, HEATER_1_TEMPTABLE_LOOKUP, HEATER_2_TEMPTABLE_LOOKUP, HEATER_3_TEMPTABLE_LOOKUP, HEATER_4_TEMPTABLE_LOOKUP);
+  static constexpr uint8_t heater_ttbllen_map[HOTENDS] = ARRAY_BY_HOTENDS(HEATER_0_TEMPTABLE_LEN, HEATER_1_TEMPTABLE_LEN, HEATER_2_TEMPTABLE_LEN, HEATER_3_TEMPTABLE_LEN, HEATER_4_TEMPTABLE_LEN);
 #endif
 
 Temperature thermalManager;
@@ -142,6 +146,9 @@ int16_t Temperature::current_temperature_raw[HOTENDS] = { 0 },
       float Temperature::Kc;
     #endif
   #endif
+  #if ENABLED(MPCTEMP)
+    mpc_t Temperature::mpc[HOTENDS];
+  #endif
 #endif
 
 #if ENABLED(BABYSTEPPING)
@@ -187,6 +194,15 @@ volatile bool Temperature::temp_meas_ready = false;
 
   float Temperature::pid_error[HOTENDS];
   bool Temperature::pid_reset[HOTENDS];
+
+  #if ENABLED(MPCTEMP)
+    float Temperature::mpc_block_temp[HOTENDS],
+          Temperature::mpc_sensor_temp[HOTENDS],
+          Temperature::mpc_ambient_temp[HOTENDS] = ARRAY_BY_HOTENDS1(25.0), // Room temperature until corrected
+          Temperature::mpc_power[HOTENDS],
+          Temperature::mpc_filament_rate[HOTENDS];
+    bool Temperature::mpc_reset[HOTENDS] = ARRAY_BY_HOTENDS1(true);
+  #endif
 #endif
 
 uint16_t Temperature::raw_temp_value[MAX_EXTRUDERS] = { 0 };
@@ -245,8 +261,24 @@ uint8_t Temperature::soft_pwm_amount[HOTENDS];
    *
    * Alternately heat and cool the nozzle, observing its behavior to
    * determine the best PID values to achieve a stable temperature.
+   *
+   * With 'fit' (M303 F) heat once at full power instead and fit a first
+   * order plus dead time model to the rise, from the times it crosses a
+   * quarter, half, three quarters and all of the way to the target:
+   *
+   *   dT/dt = (G - (T - T0)) / tau, delayed by L
+   *
+   * The slopes over the lower and the upper half give G and tau, and the
+   * crossing times the dead time L. With 'ncycles' (M303 F R) one relay
+   * cycle around the target follows, and its period corrects L. The gains
+   * follow from the classic Ziegler-Nichols rules for this model, which
+   * give about what the relay cycles would.
    */
-  void Temperature::PID_autotune(const float &target, const int8_t hotend, const int8_t ncycles, const bool set_result/*=false*/) {
+  void Temperature::PID_autotune(const float &target, const int8_t hotend, const int8_t ncycles, const bool set_result/*=false*/
+    #if ENABLED(PID_AUTOTUNE_FIT)
+      , const bool fit/*=false*/
+    #endif
+  ) {
     float current = 0.0;
     int cycles = 0;
     bool heating = true;
@@ -301,15 +333,33 @@ uint8_t Temperature::soft_pwm_amount[HOTENDS];
 
     disable_all_heaters(); // switch off all heaters.
 
+    const long max_pow =
+      #if HAS_PID_FOR_BOTH
+        hotend < 0 ? MAX_BED_POWER : PID_MAX
+      #elif ENABLED(PIDTEMP)
+        PID_MAX
+      #else
+        MAX_BED_POWER
+      #endif
+    ;
+
     #if HAS_PID_FOR_BOTH
-      if (hotend < 0)
-        soft_pwm_amount_bed = bias = d = (MAX_BED_POWER) >> 1;
-      else
-        soft_pwm_amount[hotend] = bias = d = (PID_MAX) >> 1;
+      #define _SET_HEATER_POWER(P) do{ if (hotend < 0) soft_pwm_amount_bed = (P); else soft_pwm_amount[hotend] = (P); }while(0)
     #elif ENABLED(PIDTEMP)
-      soft_pwm_amount[hotend] = bias = d = (PID_MAX) >> 1;
+      #define _SET_HEATER_POWER(P) (soft_pwm_amount[hotend] = (P))
     #else
-      soft_pwm_amount_bed = bias = d = (MAX_BED_POWER) >> 1;
+      #define _SET_HEATER_POWER(P) (soft_pwm_amount_bed = (P))
+    #endif
+
+    bias = d = max_pow >> 1;
+    _SET_HEATER_POWER(bias);
+
+    #if ENABLED(PID_AUTOTUNE_FIT)
+      // Step response: the start temperature, then the times and temperatures
+      // of the crossings. Relay refinement: the phase of the single cycle.
+      float fit_start = -1, fit_time[4], fit_temp[4], gain = 0, tau = 0, dead = 0;
+      uint8_t fit_crossings = 0, relay_phase = 0;
+      const millis_t fit_ms = next_temp_ms;
     #endif
 
     wait_for_heatup = true; // Can be interrupted with M108
@@ -342,19 +392,96 @@ uint8_t Temperature::soft_pwm_amount[HOTENDS];
           }
         #endif
 
+        #if ENABLED(PID_AUTOTUNE_FIT)
+          if (fit) {
+            const float t = (ms - fit_ms) * 0.001f;
+            if (fit_start < 0) {
+              fit_start = current;
+              if (target - fit_start < 20) {
+                SERIAL_PROTOCOLLNPGM(MSG_PID_FIT_TOO_CLOSE);
+                break;
+              }
+            }
+
+            if (fit_crossings < 4) {
+              if (current >= fit_start + (target - fit_start) * (fit_crossings + 1) * 0.25f) {
+                fit_time[fit_crossings] = t;
+                fit_temp[fit_crossings] = current;
+                if (++fit_crossings == 4) {
+                  // Slopes at the middle of the lower and the upper half
+                  const float lower = (fit_temp[0] + fit_temp[1]) * 0.5f,
+                              slope_lower = (fit_temp[1] - fit_temp[0]) / (fit_time[1] - fit_time[0]),
+                              slope_upper = (fit_temp[3] - fit_temp[2]) / (fit_time[3] - fit_time[2]),
+                              rate = (slope_lower - slope_upper) / ((fit_temp[2] + fit_temp[3]) * 0.5f - lower);
+                  if (!(rate > 0 && slope_upper > 0)) {
+                    SERIAL_PROTOCOLLNPGM(MSG_PID_FIT_FAILED);
+                    break;
+                  }
+                  tau = 1.0f / rate;
+                  const float rise = slope_lower * tau + lower - fit_start; // At full power, in the end
+                  gain = rise / max_pow;
+                  uint8_t n = 0;
+                  for (uint8_t i = 0; i < 4; i++) {
+                    const float fraction = 1.0f - (fit_temp[i] - fit_start) / rise;
+                    if (fraction > 0) { dead += fit_time[i] + tau * log(fraction); n++; }
+                  }
+                  dead = max(n ? dead / n : 0.0f, float(PID_dT));
+
+                  if (ncycles > 0) {
+                    // Relay around the output that holds the target
+                    bias = constrain(long((target - fit_start) / gain), 20, max_pow - 20);
+                    d = (bias > max_pow >> 1) ? max_pow - 1 - bias : bias;
+                    _SET_HEATER_POWER((bias - d) >> 1);
+                    heating = false;
+                    t1 = ms;
+                  }
+                  else
+                    cycles = ncycles + 1;
+                }
+              }
+            }
+            else if (ELAPSED(ms, t1 + 1000UL)) { // Ignore the noise right after a switch
+              // Low until below the target, then one cycle: high, low, below again
+              if (heating ? current > target : current < target) {
+                heating = !heating;
+                _SET_HEATER_POWER((heating ? bias + d : bias - d) >> 1);
+                if (relay_phase == 0) { t2 = ms; max = min = target; }
+                t1 = ms;
+                if (++relay_phase == 3) {
+                  const float Tu = (ms - t2) * 0.001f, w = 2 * M_PI / Tu;
+                  SERIAL_PROTOCOLPAIR(MSG_BIAS, bias);
+                  SERIAL_PROTOCOLPAIR(MSG_D, d);
+                  SERIAL_PROTOCOLPAIR(MSG_T_MIN, min);
+                  SERIAL_PROTOCOLPAIR(MSG_T_MAX, max);
+                  SERIAL_PROTOCOLLNPAIR(MSG_TU, Tu);
+                  // The plant lags the relay by half a period at w, so w * L + atan(w * tau) = pi.
+                  // The period is a steadier measure of the dead time than the crossing times.
+                  dead = max(float((M_PI - atan(w * tau)) / w), float(PID_dT));
+                  cycles = ncycles + 1;
+                }
+              }
+            }
+
+            if (cycles > ncycles) {
+              SERIAL_PROTOCOLPAIR(MSG_PID_GAIN, gain);
+              SERIAL_PROTOCOLPAIR(MSG_PID_TIME_CONSTANT, tau);
+              SERIAL_PROTOCOLLNPAIR(MSG_PID_DEAD_TIME, dead);
+              workKp = 1.2f * tau / (gain * dead);
+              workKi = workKp / (2 * dead);
+              workKd = workKp * 0.5f * dead;
+              SERIAL_PROTOCOLLNPGM(MSG_CLASSIC_PID);
+              SERIAL_PROTOCOLPAIR(MSG_KP, workKp);
+              SERIAL_PROTOCOLPAIR(MSG_KI, workKi);
+              SERIAL_PROTOCOLLNPAIR(MSG_KD, workKd);
+            }
+          }
+          else
+        #endif // PID_AUTOTUNE_FIT
+
         if (heating && current > target) {
           if (ELAPSED(ms, t2 + 5000UL)) {
             heating = false;
-            #if HAS_PID_FOR_BOTH
-              if (hotend < 0)
-                soft_pwm_amount_bed = (bias - d) >> 1;
-              else
-                soft_pwm_amount[hotend] = (bias - d) >> 1;
-            #elif ENABLED(PIDTEMP)
-              soft_pwm_amount[hotend] = (bias - d) >> 1;
-            #elif ENABLED(PIDTEMPBED)
-              soft_pwm_amount_bed = (bias - d) >> 1;
-            #endif
+            _SET_HEATER_POWER((bias - d) >> 1);
             t1 = ms;
             t_high = t1 - t2;
             max = target;
@@ -367,15 +494,6 @@ uint8_t Temperature::soft_pwm_amount[HOTENDS];
             t2 = ms;
             t_low = t2 - t1;
             if (cycles > 0) {
-              long max_pow =
-                #if HAS_PID_FOR_BOTH
-                  hotend < 0 ? MAX_BED_POWER : PID_MAX
-                #elif ENABLED(PIDTEMP)
-                  PID_MAX
-                #else
-                  MAX_BED_POWER
-                #endif
-              ;
               bias += (d * (t_high - t_low)) / (t_low + t_high);
               bias = constrain(bias, 20, max_pow - 20);
               d = (bias > max_pow >> 1) ? max_pow - 1 - bias : bias;
@@ -414,16 +532,7 @@ uint8_t Temperature::soft_pwm_amount[HOTENDS];
                 */
               }
             }
-            #if HAS_PID_FOR_BOTH
-              if (hotend < 0)
-                soft_pwm_amount_bed = (bias + d) >> 1;
-              else
-                soft_pwm_amount[hotend] = (bias + d) >> 1;
-            #elif ENABLED(PIDTEMP)
-              soft_pwm_amount[hotend] = (bias + d) >> 1;
-            #else
-              soft_pwm_amount_bed = (bias + d) >> 1;
-            #endif
+            _SET_HEATER_POWER((bias + d) >> 1);
             cycles++;
             min = target;
           }
@@ -532,6 +641,143 @@ uint8_t Temperature::soft_pwm_amount[HOTENDS];
     disable_all_heaters();
   }
 
+  #if ENABLED(MPCTEMP)
+
+    /**
+     * MPC Autotuning (M306 T)
+     *
+     * Heat the hotend at full power from room temperature to MPC_TUNING_TEMP,
+     * then let it cool for a while. With the configured heater power, the
+     * heating rate on the way up and the cooling rate afterwards give the heat
+     * capacity of the block and its loss to the surroundings. How far the
+     * sensor trails the block that model predicts gives its responsiveness.
+     */
+    void Temperature::MPC_autotune(const uint8_t e) {
+      SERIAL_ECHOLNPGM(MSG_MPC_AUTOTUNE_START);
+
+      disable_all_heaters();
+
+      const float ambient = current_temperature[e], rise = (MPC_TUNING_TEMP) - ambient;
+      if (ambient > 50) {
+        SERIAL_PROTOCOLLNPGM(MSG_MPC_TOO_HOT);
+        return;
+      }
+
+      // Temperatures that time the heating rate, and the drop that times the cooling rate
+      const float heat_lo = ambient + rise * 0.4f, heat_hi = ambient + rise * 0.8f, cool_drop = 10;
+      float t_lo = 0, t_hi = 0, temp_lo = 0, temp_hi = 0,
+            t_cool = 0, temp_cool = 0, peak = 0, current = ambient;
+      bool heating = true, done = false;
+
+      #if HAS_AUTO_FAN
+        next_auto_fan_check_ms = millis() + 2500UL;
+      #endif
+
+      soft_pwm_amount[e] = (PID_MAX) >> 1;
+      const millis_t start_ms = millis();
+      millis_t next_temp_ms = start_ms, cool_ms = 0;
+
+      wait_for_heatup = true; // Can be interrupted with M108
+      while (wait_for_heatup) {
+        const millis_t ms = millis();
+        const float t = (ms - start_ms) * 0.001f;
+
+        if (temp_meas_ready) {
+          updateTemperaturesFromRawValues();
+          current = current_temperature[e];
+
+          #if HAS_AUTO_FAN
+            if (ELAPSED(ms, next_auto_fan_check_ms)) {
+              checkExtruderAutoFans();
+              next_auto_fan_check_ms = ms + 2500UL;
+            }
+          #endif
+
+          if (heating) {
+            if (!t_lo && current >= heat_lo) { t_lo = t; temp_lo = current; }
+            if (!t_hi && current >= heat_hi) { t_hi = t; temp_hi = current; }
+            if (current >= MPC_TUNING_TEMP) {
+              soft_pwm_amount[e] = 0;
+              heating = false;
+              peak = current;
+            }
+          }
+          else if (!cool_ms) {
+            // Time the cooling from just after the peak, once the sensor has caught up
+            if (current > peak) peak = current;
+            else if (current < peak - 1) { cool_ms = ms; temp_cool = current; }
+          }
+          else if (current <= temp_cool - cool_drop || ELAPSED(ms, cool_ms + 60000UL)) {
+            t_cool = (ms - cool_ms) * 0.001f;
+            temp_cool -= current;
+            done = true;
+            break;
+          }
+        }
+
+        #ifndef MAX_OVERSHOOT_PID_AUTOTUNE
+          #define MAX_OVERSHOOT_PID_AUTOTUNE 20
+        #endif
+        if (current > (MPC_TUNING_TEMP) + (MAX_OVERSHOOT_PID_AUTOTUNE)) {
+          SERIAL_PROTOCOLLNPGM(MSG_MPC_TEMP_TOO_HIGH);
+          break;
+        }
+
+        // No hotend needs more than 10 minutes at full power
+        if (heating && ELAPSED(ms, start_ms + 600000UL)) {
+          SERIAL_PROTOCOLLNPGM(MSG_MPC_TIMEOUT);
+          break;
+        }
+
+        // Report heater states every 2 seconds
+        if (ELAPSED(ms, next_temp_ms)) {
+          print_heaterstates();
+          SERIAL_EOL();
+          next_temp_ms = ms + 2000UL;
+        }
+
+        lcd_update();
+      }
+
+      disable_all_heaters();
+      if (!done) return;
+
+      // Rates halfway up and on the way down, in K/s
+      const float full_power = mpc[e].heater_power * (PID_MAX) / 255.0f,
+                  heat_rate = (temp_hi - temp_lo) / (t_hi - t_lo), heat_temp = (temp_lo + temp_hi) * 0.5f, heat_t = (t_lo + t_hi) * 0.5f,
+                  cool_rate = temp_cool / t_cool, cool_temp = current + temp_cool * 0.5f;
+      if (!(t_hi > t_lo && heat_rate > 0 && t_cool > 0 && cool_rate > 0)) {
+        SERIAL_PROTOCOLLNPGM(MSG_MPC_BAD_MEASUREMENT);
+        return;
+      }
+
+      // Cooling: C * cool_rate = A * (T - ambient), so A / C is known. Heating
+      // at the block temperature, which leads the sensor by lag * heat_rate:
+      // C * heat_rate = P - A * (T - ambient). Each estimate of the lag gives
+      // a better block temperature, so iterate.
+      const float loss_rate = cool_rate / (cool_temp - ambient);  // A / C
+      float capacity = 0, lag = 0;
+      for (uint8_t i = 4; i--;) {
+        capacity = full_power / (heat_rate + loss_rate * (heat_temp + lag * heat_rate - ambient));
+        // The time the modeled block takes to reach heat_temp at full power
+        const float fraction = 1.0f - loss_rate * capacity * (heat_temp - ambient) / full_power;
+        if (fraction <= 0) break;
+        lag = max(heat_t + log(fraction) / loss_rate, 0.0f);
+      }
+
+      mpc[e].block_heat_capacity = capacity;
+      mpc[e].ambient_xfer_coeff = loss_rate * capacity;
+      mpc[e].sensor_responsiveness = 1.0f / max(lag, float(PID_dT));
+      updatePID();
+
+      SERIAL_PROTOCOLLNPGM(MSG_MPC_AUTOTUNE_FINISHED);
+      SERIAL_PROTOCOLPAIR("#define MPC_BLOCK_HEAT_CAPACITY ", mpc[e].block_heat_capacity); SERIAL_EOL();
+      SERIAL_PROTOCOLPGM("#define MPC_SENSOR_RESPONSIVENESS "); SERIAL_PROTOCOL_F(mpc[e].sensor_responsiveness, 4); SERIAL_EOL();
+      SERIAL_PROTOCOLPGM("#define MPC_AMBIENT_XFER_COEFF "); SERIAL_PROTOCOL_F(mpc[e].ambient_xfer_coeff, 4); SERIAL_EOL();
+    }
+
+  #endif // MPCTEMP
+
 #endif // HAS_PID_HEATING
 
 /**
@@ -634,7 +880,9 @@ float Temperature::get_pid_output(const int8_t e) {
   #endif
   float pid_output;
   #if ENABLED(PIDTEMP)
-    #if DISABLED(PID_OPENLOOP)
+    #if ENABLED(MPCTEMP)
+      pid_output = get_mpc_output(HOTEND_INDEX);
+    #elif DISABLED(PID_OPENLOOP)
       pid_error[HOTEND_INDEX] = target_temperature[HOTEND_INDEX] - current_temperature[HOTEND_INDEX];
       dTerm[HOTEND_INDEX] = PID_K2 * PID_PARAM(Kd, HOTEND_INDEX) * (current_temperature[HOTEND_INDEX] - temp_dState[HOTEND_INDEX]) + PID_K1 * dTerm[HOTEND_INDEX];
       temp_dState[HOTEND_INDEX] = current_temperature[HOTEND_INDEX];
@@ -698,7 +946,7 @@ float Temperature::get_pid_output(const int8_t e) {
       pid_output = constrain(target_temperature[HOTEND_INDEX], 0, PID_MAX);
     #endif // PID_OPENLOOP
 
-    #if ENABLED(PID_DEBUG)
+    #if ENABLED(PID_DEBUG) && DISABLED(MPCTEMP)
       SERIAL_ECHO_START();
       SERIAL_ECHOPAIR(MSG_PID_DEBUG, HOTEND_INDEX);
       SERIAL_ECHOPAIR(MSG_PID_DEBUG_INPUT, current_temperature[HOTEND_INDEX]);
@@ -724,6 +972,78 @@ float Temperature::get_pid_output(const int8_t e) {
   return pid_output;
 }
 
+#if ENABLED(MPCTEMP)
+
+  /**
+   * Model predictive control of a hotend
+   *
+   * The block and sensor temperatures are modeled from the heater power and
+   * the heat lost to the surroundings and the filament, and pulled toward
+   * each new reading. The heater gets the power that brings the modeled
+   * block to the target over the next cycle and holds it there, including
+   * the heat the filament in the queued moves is about to take.
+   */
+  float Temperature::get_mpc_output(const uint8_t e) {
+    const mpc_t &model = mpc[e];
+    const float current = current_temperature[e], target = target_temperature[e],
+                max_power = model.heater_power * (PID_MAX) / 255.0f;
+
+    if (mpc_reset[e]) {
+      mpc_block_temp[e] = mpc_sensor_temp[e] = current;
+      mpc_power[e] = mpc_filament_rate[e] = 0.0;
+      mpc_reset[e] = false;
+    }
+
+    // Advance the model over the last cycle
+    const float loss_coeff = model.ambient_xfer_coeff + model.filament_heat_capacity * mpc_filament_rate[e];
+    mpc_block_temp[e] += (mpc_power[e] - loss_coeff * (mpc_block_temp[e] - mpc_ambient_temp[e])) * (PID_dT) / model.block_heat_capacity;
+    mpc_sensor_temp[e] += (mpc_block_temp[e] - mpc_sensor_temp[e]) * min(model.sensor_responsiveness * (PID_dT), 1.0f);
+
+    // Correct it from the reading. A lasting difference while holding the
+    // target is a loss the model lacks, like a part fan, and is taken up by
+    // the ambient temperature, at no less than MPC_MIN_AMBIENT_CHANGE.
+    const float correction = (current - mpc_sensor_temp[e]) * (MPC_SMOOTHING_FACTOR);
+    mpc_block_temp[e] += correction;
+    mpc_sensor_temp[e] += correction;
+    if (target && FABS(target - current) < (PID_FUNCTIONAL_RANGE) && WITHIN(mpc_power[e], 0.01f, max_power - 0.01f)) {
+      const float least = (MPC_MIN_AMBIENT_CHANGE) * (PID_dT);
+      mpc_ambient_temp[e] += correction > 0 ? max(correction, least) : min(correction, -least);
+    }
+
+    const bool heating = target
+      #if HEATER_IDLE_HANDLER
+        && !heater_idle_timeout_exceeded[e]
+      #endif
+    ;
+
+    mpc_filament_rate[e] = heating ? planner.get_extrusion_rate(HOTENDS > 1 ? e : active_extruder, MPC_LOOKAHEAD_TIME) : 0.0;
+
+    float power = 0.0;
+    if (heating) {
+      power = (target - mpc_block_temp[e]) * model.block_heat_capacity / (PID_dT)
+            + (model.ambient_xfer_coeff + model.filament_heat_capacity * mpc_filament_rate[e]) * (target - mpc_ambient_temp[e]);
+      power = constrain(power, 0, max_power);
+    }
+    mpc_power[e] = power;
+
+    const float output = power * 255.0f / model.heater_power;
+
+    #if ENABLED(PID_DEBUG)
+      SERIAL_ECHO_START();
+      SERIAL_ECHOPAIR(MSG_MPC_DEBUG, e);
+      SERIAL_ECHOPAIR(MSG_PID_DEBUG_INPUT, current);
+      SERIAL_ECHOPAIR(MSG_PID_DEBUG_OUTPUT, output);
+      SERIAL_ECHOPAIR(MSG_MPC_DEBUG_BLOCK, mpc_block_temp[e]);
+      SERIAL_ECHOPAIR(MSG_MPC_DEBUG_AMBIENT, mpc_ambient_temp[e]);
+      SERIAL_ECHOPAIR(MSG_MPC_DEBUG_E_RATE, mpc_filament_rate[e]);
+      SERIAL_EOL();
+    #endif
+
+    return output;
+  }
+
+#endif // MPCTEMP
+
 #if ENABLED(PIDTEMPBED)
   float Temperature::get_pid_output_bed() {
     float pid_output;
@@ -778,6 +1098,9 @@ float Temperature::get_pid_output(const int8_t e) {
  *  - Update the heated bed PID output value
  */
 void Temperature::manage_heater() {
+  #if ENABLED(CODE_PROFILER)
+    PROFILE_ZONE(PROFILE_MANAGE_HEATER);
+  #endif
 
   #if EARLY_WATCHDOG
     // If thermal manager is still not running, make sure to at least reset the watchdog!
@@ -927,6 +1250,27 @@ void Temperature::manage_heater() {
 }
 
 #define PGM_RD_W(x)   (short)pgm_read_word(&x)
+#define PGM_RD_DW(x)  (int32_t)pgm_read_dword(&x)
+
+/**
+ * Convert a raw value with a lookup table (see thermistors.h). Binary
+ * search for the first entry above the raw value and interpolate from
+ * the entry before it, which also extends the first entry's slope below
+ * the table. Above the table use the last temperature.
+ */
+static float lookup_celsius(const temp_entry_t * const tt, const uint8_t len, const int raw) {
+  uint8_t l = 1, r = len;
+  while (l < r) {
+    const uint8_t m = (l + r) >> 1;
+    if (PGM_RD_W(tt[m].raw) > raw) r = m; else l = m + 1;
+  }
+
+  // Overflow: Set to last value in the table
+  if (l == len) return PGM_RD_W(tt[len - 1].celsius);
+
+  const temp_entry_t &e = tt[l - 1];
+  return PGM_RD_W(e.celsius) + int32_t(raw - PGM_RD_W(e.raw)) * PGM_RD_DW(e.slope) * (1.0f / 65536);
+}
 
 // Derived from RepRap FiveD extruder::getTemperature()
 // For hot end temperature measurement.
@@ -948,26 +1292,8 @@ float Temperature::analog2temp(const int raw, const uint8_t e) {
     if (e == 0) return 0.25 * raw;
   #endif
 
-  if (heater_ttbl_map[e] != NULL) {
-    float celsius = 0;
-    uint8_t i;
-    short(*tt)[][2] = (short(*)[][2])(heater_ttbl_map[e]);
-
-    for (i = 1; i < heater_ttbllen_map[e]; i++) {
-      if (PGM_RD_W((*tt)[i][0]) > raw) {
-        celsius = PGM_RD_W((*tt)[i - 1][1]) +
-                  (raw - PGM_RD_W((*tt)[i - 1][0])) *
-                  (float)(PGM_RD_W((*tt)[i][1]) - PGM_RD_W((*tt)[i - 1][1])) /
-                  (float)(PGM_RD_W((*tt)[i][0]) - PGM_RD_W((*tt)[i - 1][0]));
-        break;
-      }
-    }
-
-    // Overflow: Set to last value in the table
-    if (i == heater_ttbllen_map[e]) celsius = PGM_RD_W((*tt)[i - 1][1]);
+  if (heater_ttbl_map[e] != NULL) return lookup_celsius(heater_ttbl_map[e], heater_ttbllen_map[e], raw);
 
-    return celsius;
-  }
   return ((raw * ((5.0 * 100.0) / 1024.0) / OVERSAMPLENR) * (TEMP_SENSOR_AD595_GAIN)) + TEMP_SENSOR_AD595_OFFSET;
 }
 
@@ -976,23 +1302,7 @@ float Temperature::analog2temp(const int raw, const uint8_t e) {
   // For bed temperature measurement.
   float Temperature::analog2tempBed(const int raw) {
     #if ENABLED(BED_USES_THERMISTOR)
-      float celsius = 0;
-      byte i;
-
-      for (i = 1; i < BEDTEMPTABLE_LEN; i++) {
-        if (PGM_RD_W(BEDTEMPTABLE[i][0]) > raw) {
-          celsius  = PGM_RD_W(BEDTEMPTABLE[i - 1][1]) +
-                     (raw - PGM_RD_W(BEDTEMPTABLE[i - 1][0])) *
-                     (float)(PGM_RD_W(BEDTEMPTABLE[i][1]) - PGM_RD_W(BEDTEMPTABLE[i - 1][1])) /
-                     (float)(PGM_RD_W(BEDTEMPTABLE[i][0]) - PGM_RD_W(BEDTEMPTABLE[i - 1][0]));
-          break;
-        }
-      }
-
-      // Overflow: Set to last value in the table
-      if (i == BEDTEMPTABLE_LEN) celsius = PGM_RD_W(BEDTEMPTABLE[i - 1][1]);
-
-      return celsius;
+      return lookup_celsius(BEDTEMPTABLE_LOOKUP, BEDTEMPTABLE_LEN, raw);
 
     #elif defined(BED_USES_AD595)
 
@@ -1012,23 +1322,7 @@ float Temperature::analog2temp(const int raw, const uint8_t e) {
   // For chamber temperature measurement.
   float Temperature::analog2tempChamber(const int raw) {
     #if ENABLED(CHAMBER_USES_THERMISTOR)
-      float celsius = 0;
-      byte i;
-
-      for (i = 1; i < CHAMBERTEMPTABLE_LEN; i++) {
-        if (PGM_RD_W(CHAMBERTEMPTABLE[i][0]) > raw) {
-          celsius  = PGM_RD_W(CHAMBERTEMPTABLE[i - 1][1]) +
-                     (raw - PGM_RD_W(CHAMBERTEMPTABLE[i - 1][0])) *
-                     (float)(PGM_RD_W(CHAMBERTEMPTABLE[i][1]) - PGM_RD_W(CHAMBERTEMPTABLE[i - 1][1])) /
-                     (float)(PGM_RD_W(CHAMBERTEMPTABLE[i][0]) - PGM_RD_W(CHAMBERTEMPTABLE[i - 1][0]));
-          break;
-        }
-      }
-
-      // Overflow: Set to last value in the table
-      if (i == CHAMBERTEMPTABLE_LEN) celsius = PGM_RD_W(CHAMBERTEMPTABLE[i - 1][1]);
-
-      return celsius;
+      return lookup_celsius(CHAMBERTEMPTABLE_LOOKUP, CHAMBERTEMPTABLE_LEN, raw);
 
     #elif defined(CHAMBER_USES_AD595)
 
@@ -1719,6 +2013,10 @@ void Temperature::set_current_temp_raw() {
 HAL_TEMP_TIMER_ISR {
   HAL_timer_isr_prologue(TEMP_TIMER_NUM);
 
+  #if ENABLED(CODE_PROFILER)
+    PROFILE_ZONE(PROFILE_TEMPERATURE_ISR);
+  #endif
+
   Temperature::isr();
 
   HAL_timer_isr_epilogue(TEMP_TIMER_NUM);
@@ -2283,7 +2581,7 @@ void Temperature::isr() {
       if (e >= 0) SERIAL_PROTOCOLCHAR_P(port, '0' + e);
     #endif
     SERIAL_PROTOCOLCHAR_P(port, ':');
-    SERIAL_PROTOCOL_P(port, c);
+    SERIAL_PROTOCOL_F_P(port, c, 2);
     SERIAL_PROTOCOLPAIR_P(port, " /" , t);
     #if ENABLED(SHOW_TEMP_ADC_VALUES)
       SERIAL_PROTOCOLPAIR_P(port, " (", r / OVERSAMPLENR);
@@ -2357,8 +2655,24 @@ void Temperature::isr() {
     uint8_t Temperature::auto_report_temp_interval;
     millis_t Temperature::next_temp_report_ms;
 
+    #if ENABLED(AUTO_REPORT_COALESCE)
+      // Room for the longest report: " T0:-999.99 /-999.99" and " @0:127" for the
+      // active hotend, the bed, the chamber, and each hotend when there are several
+      #if ENABLED(SHOW_TEMP_ADC_VALUES)
+        #define TEMP_REPORT_SENSOR_BYTES 30
+      #else
+        #define TEMP_REPORT_SENSOR_BYTES 20
+      #endif
+      #define TEMP_REPORT_BYTES ((HOTENDS + 3) * (TEMP_REPORT_SENSOR_BYTES + 7))
+    #endif
+
     void Temperature::auto_report_temperatures() {
       if (auto_report_temp_interval && ELAPSED(millis(), next_temp_report_ms)) {
+        #if ENABLED(AUTO_REPORT_COALESCE)
+          // Don't wait on the host. Try again from the next idle(), so reports that
+          // fall due in the meantime go out as one, with the latest temperatures.
+          if (!SERIAL_TX_ROOM(TEMP_REPORT_BYTES)) return;
+        #endif
         next_temp_report_ms = millis() + 1000UL * auto_report_temp_interval;
         print_heaterstates();
         SERIAL_EOL();
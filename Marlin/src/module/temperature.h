@@ -108,6 +108,19 @@ enum ADCSensorState : char {
   #define unscalePID_d(d) ( (d) * PID_dT )
 #endif
 
+#if ENABLED(MPCTEMP)
+  /**
+   * Thermal model of a hotend for model predictive control (M306)
+   */
+  typedef struct {
+    float heater_power,             // (W) Heater power at full duty
+          block_heat_capacity,      // (J/K) Heat capacity of the heater block
+          sensor_responsiveness,    // (1/s) Rate the sensor follows the block temperature at
+          ambient_xfer_coeff,       // (W/K) Heat lost to the surroundings per degree above ambient
+          filament_heat_capacity;   // (J/K/mm) Heat taken per mm of extruded filament per degree
+  } mpc_t;
+#endif
+
 class Temperature {
 
   public:
@@ -148,6 +161,10 @@ class Temperature {
 
       #endif // PID_PARAMS_PER_HOTEND
 
+      #if ENABLED(MPCTEMP)
+        static mpc_t mpc[HOTENDS];
+      #endif
+
     #endif
 
     #if HAS_HEATED_BED
@@ -222,6 +239,15 @@ class Temperature {
 
       static float pid_error[HOTENDS];
       static bool pid_reset[HOTENDS];
+
+      #if ENABLED(MPCTEMP)
+        static float mpc_block_temp[HOTENDS],     // Modeled temperatures of the block and its sensor
+                     mpc_sensor_temp[HOTENDS],
+                     mpc_ambient_temp[HOTENDS],   // Ambient temperature, adjusted for unmodeled losses
+                     mpc_power[HOTENDS],          // (W) Heater power over the last cycle
+                     mpc_filament_rate[HOTENDS];  // (mm/s) Extrusion rate over the last cycle
+        static bool mpc_reset[HOTENDS];
+      #endif
     #endif
 
     // Init min and max temp with extreme values to prevent false errors during startup
@@ -476,11 +502,25 @@ class Temperature {
      */
     static void disable_all_heaters();
 
+    /**
+     * The heater output (0 to PID_MAX) for a hotend, from its current and
+     * target temperatures. Called once per PID_dT by manage_heater().
+     */
+    static float get_pid_output(const int8_t e);
+
     /**
      * Perform auto-tuning for hotend or bed in response to M303
      */
     #if HAS_PID_HEATING
-      static void PID_autotune(const float &target, const int8_t hotend, const int8_t ncycles, const bool set_result=false);
+      static void PID_autotune(const float &target, const int8_t hotend, const int8_t ncycles, const bool set_result=false
+        #if ENABLED(PID_AUTOTUNE_FIT)
+          , const bool fit=false
+        #endif
+      );
+
+      #if ENABLED(MPCTEMP)
+        static void MPC_autotune(const uint8_t e);
+      #endif
 
       /**
        * Update the temp manager when PID values change
@@ -490,6 +530,9 @@ class Temperature {
           #if ENABLED(PID_EXTRUSION_SCALING)
             last_e_position = 0;
           #endif
+          #if ENABLED(MPCTEMP)
+            HOTEND_LOOP() mpc_reset[e] = true;
+          #endif
         }
       #endif
 
@@ -615,7 +658,9 @@ class Temperature {
 
     static void checkExtruderAutoFans();
 
-    static float get_pid_output(const int8_t e);
+    #if ENABLED(MPCTEMP)
+      static float get_mpc_output(const uint8_t e);
+    #endif
 
     #if ENABLED(PIDTEMPBED)
       static float get_pid_output_bed();
@@ -40,150 +40,225 @@
 #define PtAdVal(T,R0,Rup) (short)(1024/(Rup/PtRt(T,R0)+1))
 #define PtLine(T,R0,Rup) { OV(PtAdVal(T,R0,Rup)), T },
 
+#define _TT_NAME(_N) temptable_ ## _N
+#define TT_NAME(_N) _TT_NAME(_N)
+#define _TT_LOOKUP_NAME(_N) temptable_lookup_ ## _N
+#define TT_LOOKUP_NAME(_N) _TT_LOOKUP_NAME(_N)
+
+/**
+ * Lookup tables
+ *
+ * Each table in use is compiled into a lookup table holding, for every
+ * entry, the slope (celsius per raw unit, 16.16 fixed-point) to the next
+ * entry. Temperature::analog2temp() finds the entry by binary search and
+ * interpolates with a multiply instead of a division.
+ *
+ * The tables below stay in the simple { raw, celsius } form, as written
+ * by createTemperatureLookupMarlin.py. Their entries must be in order of
+ * increasing raw value.
+ */
+typedef struct { int16_t raw, celsius; int32_t slope; } temp_entry_t;
+
+template<uint8_t N> struct temp_lookup_t { temp_entry_t entry[N]; };
+
+template<uint8_t... I> struct temp_indexes {};
+template<uint8_t N, uint8_t... I> struct make_temp_indexes : make_temp_indexes<N - 1, N - 1, I...> {};
+template<uint8_t... I> struct make_temp_indexes<0, I...> { typedef temp_indexes<I...> type; };
+
+constexpr int32_t temp_slope(const int16_t dr, const int16_t dt) {
+  return dr ? int32_t(dt * 65536.0 / dr + ((dt < 0) != (dr < 0) ? -0.5 : 0.5)) : 0;
+}
+
+template<uint8_t N, uint8_t... I>
+constexpr temp_lookup_t<N> temp_lookup(const short (*tt)[2], temp_indexes<I...>) {
+  return {{ { tt[I][0], tt[I][1], I < N - 1 ? temp_slope(tt[I + 1][0] - tt[I][0], tt[I + 1][1] - tt[I][1]) : 0 }... }};
+}
+
+#define TEMPTABLE_LOOKUP(_N) \
+  constexpr temp_lookup_t<COUNT(TT_NAME(_N))> TT_LOOKUP_NAME(_N) PROGMEM = \
+    temp_lookup<COUNT(TT_NAME(_N))>(TT_NAME(_N), make_temp_indexes<COUNT(TT_NAME(_N))>::type())
+
 #if ANY_THERMISTOR_IS(1) // beta25 = 4092 K, R25 = 100 kOhm, Pull-up = 4.7 kOhm, "EPCOS"
   #include "thermistor_1.h"
+  TEMPTABLE_LOOKUP(1);
 #endif
 #if ANY_THERMISTOR_IS(2) // 4338 K, R25 = 200 kOhm, Pull-up = 4.7 kOhm, "ATC Semitec 204GT-2"
   #include "thermistor_2.h"
+  TEMPTABLE_LOOKUP(2);
 #endif
 #if ANY_THERMISTOR_IS(3) // beta25 = 4120 K, R25 = 100 kOhm, Pull-up = 4.7 kOhm, "Mendel-parts"
   #include "thermistor_3.h"
+  TEMPTABLE_LOOKUP(3);
 #endif
 #if ANY_THERMISTOR_IS(4) // beta25 = 3950 K, R25 = 10 kOhm, Pull-up = 4.7 kOhm, "Generic"
   #include "thermistor_4.h"
+  TEMPTABLE_LOOKUP(4);
 #endif
 #if ANY_THERMISTOR_IS(5) // beta25 = 4267 K, R25 = 100 kOhm, Pull-up = 4.7 kOhm, "ParCan, ATC 104GT-2"
   #include "thermistor_5.h"
+  TEMPTABLE_LOOKUP(5);
 #endif
 #if ANY_THERMISTOR_IS(6) // beta25 = 4092 K, R25 = 100 kOhm, Pull-up = 8.2 kOhm, "EPCOS ?"
   #include "thermistor_6.h"
+  TEMPTABLE_LOOKUP(6);
 #endif
 #if ANY_THERMISTOR_IS(7) // beta25 = 3974 K, R25 = 100 kOhm, Pull-up = 4.7 kOhm, "Honeywell 135-104LAG-J01"
   #include "thermistor_7.h"
+  TEMPTABLE_LOOKUP(7);
 #endif
 #if ANY_THERMISTOR_IS(71) // beta25 = 3974 K, R25 = 100 kOhm, Pull-up = 4.7 kOhm, "Honeywell 135-104LAF-J01"
   #include "thermistor_71.h"
+  TEMPTABLE_LOOKUP(71);
 #endif
 #if ANY_THERMISTOR_IS(8) // beta25 = 3950 K, R25 = 100 kOhm, Pull-up = 10 kOhm, "Vishay E3104FHT"
   #include "thermistor_8.h"
+  TEMPTABLE_LOOKUP(8);
 #endif
 #if ANY_THERMISTOR_IS(9) // beta25 = 3960 K, R25 = 100 kOhm, Pull-up = 4.7 kOhm, "GE Sensing AL03006-58.2K-97-G1"
   #include "thermistor_9.h"
+  TEMPTABLE_LOOKUP(9);
 #endif
 #if ANY_THERMISTOR_IS(10) // beta25 = 3960 K, R25 = 100 kOhm, Pull-up = 4.7 kOhm, "RS 198-961"
   #include "thermistor_10.h"
+  TEMPTABLE_LOOKUP(10);
 #endif
 #if ANY_THERMISTOR_IS(11) // beta25 = 3950 K, R25 = 100 kOhm, Pull-up = 4.7 kOhm, "QU-BD silicone bed, QWG-104F-3950"
   #include "thermistor_11.h"
+  TEMPTABLE_LOOKUP(11);
 #endif
 #if ANY_THERMISTOR_IS(13) // beta25 = 4100 K, R25 = 100 kOhm, Pull-up = 4.7 kOhm, "Hisens"
   #include "thermistor_13.h"
+  TEMPTABLE_LOOKUP(13);
 #endif
 #if ANY_THERMISTOR_IS(15) // JGAurora A5 thermistor calibration
   #include "thermistor_15.h"
+  TEMPTABLE_LOOKUP(15);
 #endif
 #if ANY_THERMISTOR_IS(20) // PT100 with INA826 amp on Ultimaker v2.0 electronics
   #include "thermistor_20.h"
+  TEMPTABLE_LOOKUP(20);
 #endif
 #if ANY_THERMISTOR_IS(51) // beta25 = 4092 K, R25 = 100 kOhm, Pull-up = 1 kOhm, "EPCOS"
   #include "thermistor_51.h"
+  TEMPTABLE_LOOKUP(51);
 #endif
 #if ANY_THERMISTOR_IS(52) // beta25 = 4338 K, R25 = 200 kOhm, Pull-up = 1 kOhm, "ATC Semitec 204GT-2"
   #include "thermistor_52.h"
+  TEMPTABLE_LOOKUP(52);
 #endif
 #if ANY_THERMISTOR_IS(55) // beta25 = 4267 K, R25 = 100 kOhm, Pull-up = 1 kOhm, "ATC Semitec 104GT-2 (Used on ParCan)"
   #include "thermistor_55.h"
+  TEMPTABLE_LOOKUP(55);
 #endif
 #if ANY_THERMISTOR_IS(60) // beta25 = 3950 K, R25 = 100 kOhm, Pull-up = 4.7 kOhm, "Maker's Tool Works Kapton Bed"
   #include "thermistor_60.h"
+  TEMPTABLE_LOOKUP(60);
 #endif
 #if ANY_THERMISTOR_IS(66) // beta25 = 4500 K, R25 = 2.5 MOhm, Pull-up = 4.7 kOhm, "DyzeDesign 500 C Thermistor"
   #include "thermistor_66.h"
+  TEMPTABLE_LOOKUP(66);
 #endif
 #if ANY_THERMISTOR_IS(12) // beta25 = 4700 K, R25 = 100 kOhm, Pull-up = 4.7 kOhm, "Personal calibration for Makibox hot bed"
   #include "thermistor_12.h"
+  TEMPTABLE_LOOKUP(12);
 #endif
 #if ANY_THERMISTOR_IS(70) // beta25 = 4100 K, R25 = 100 kOhm, Pull-up = 4.7 kOhm, "Hephestos 2, bqh2 stock thermistor"
   #include "thermistor_70.h"
+  TEMPTABLE_LOOKUP(70);
 #endif
 #if ANY_THERMISTOR_IS(75) // beta25 = 4100 K, R25 = 100 kOhm, Pull-up = 4.7 kOhm, "MGB18-104F39050L32 thermistor"
   #include "thermistor_75.h"
+  TEMPTABLE_LOOKUP(75);
 #endif
 #if ANY_THERMISTOR_IS(110) // Pt100 with 1k0 pullup
   #include "thermistor_110.h"
+  TEMPTABLE_LOOKUP(110);
 #endif
 #if ANY_THERMISTOR_IS(147) // Pt100 with 4k7 pullup
   #include "thermistor_147.h"
+  TEMPTABLE_LOOKUP(147);
 #endif
 #if ANY_THERMISTOR_IS(1010) // Pt1000 with 1k0 pullup
   #include "thermistor_1010.h"
+  TEMPTABLE_LOOKUP(1010);
 #endif
 #if ANY_THERMISTOR_IS(1047) // Pt1000 with 4k7 pullup
   #include "thermistor_1047.h"
+  TEMPTABLE_LOOKUP(1047);
 #endif
 #if ANY_THERMISTOR_IS(998) // User-defined table 1
   #include "thermistor_998.h"
+  TEMPTABLE_LOOKUP(998);
 #endif
 #if ANY_THERMISTOR_IS(999) // User-defined table 2
   #include "thermistor_999.h"
+  TEMPTABLE_LOOKUP(999);
 #endif
 
-#define _TT_NAME(_N) temptable_ ## _N
-#define TT_NAME(_N) _TT_NAME(_N)
-
 #ifdef THERMISTORHEATER_0
   #define HEATER_0_TEMPTABLE TT_NAME(THERMISTORHEATER_0)
   #define HEATER_0_TEMPTABLE_LEN COUNT(HEATER_0_TEMPTABLE)
+  #define HEATER_0_TEMPTABLE_LOOKUP TT_LOOKUP_NAME(THERMISTORHEATER_0).entry
 #elif defined(HEATER_0_USES_THERMISTOR)
   #error "No heater 0 thermistor table specified"
 #else
   #define HEATER_0_TEMPTABLE NULL
   #define HEATER_0_TEMPTABLE_LEN 0
+  #define HEATER_0_TEMPTABLE_LOOKUP NULL
 #endif
 
 #ifdef THERMISTORHEATER_1
   #define HEATER_1_TEMPTABLE TT_NAME(THERMISTORHEATER_1)
   #define HEATER_1_TEMPTABLE_LEN COUNT(HEATER_1_TEMPTABLE)
+  #define HEATER_1_TEMPTABLE_LOOKUP TT_LOOKUP_NAME(THERMISTORHEATER_1).entry
 #elif defined(HEATER_1_USES_THERMISTOR)
   #error "No heater 1 thermistor table specified"
 #else
   #define HEATER_1_TEMPTABLE NULL
   #define HEATER_1_TEMPTABLE_LEN 0
+  #define HEATER_1_TEMPTABLE_LOOKUP NULL
 #endif
 
 #ifdef THERMISTORHEATER_2
   #define HEATER_2_TEMPTABLE TT_NAME(THERMISTORHEATER_2)
   #define HEATER_2_TEMPTABLE_LEN COUNT(HEATER_2_TEMPTABLE)
+  #define HEATER_2_TEMPTABLE_LOOKUP TT_LOOKUP_NAME(THERMISTORHEATER_2).entry
 #elif defined(HEATER_2_USES_THERMISTOR)
   #error "No heater 2 thermistor table specified"
 #else
   #define HEATER_2_TEMPTABLE NULL
   #define HEATER_2_TEMPTABLE_LEN 0
+  #define HEATER_2_TEMPTABLE_LOOKUP NULL
 #endif
 
 #ifdef THERMISTORHEATER_3
   #define HEATER_3_TEMPTABLE TT_NAME(THERMISTORHEATER_3)
   #define HEATER_3_TEMPTABLE_LEN COUNT(HEATER_3_TEMPTABLE)
+  #define HEATER_3_TEMPTABLE_LOOKUP TT_LOOKUP_NAME(THERMISTORHEATER_3).entry
 #elif defined(HEATER_3_USES_THERMISTOR)
   #error "No heater 3 thermistor table specified"
 #else
   #define HEATER_3_TEMPTABLE NULL
   #define HEATER_3_TEMPTABLE_LEN 0
+  #define HEATER_3_TEMPTABLE_LOOKUP NULL
 #endif
 
 #ifdef THERMISTORHEATER_4
   #define HEATER_4_TEMPTABLE TT_NAME(THERMISTORHEATER_4)
   #define HEATER_4_TEMPTABLE_LEN COUNT(HEATER_4_TEMPTABLE)
+  #define HEATER_4_TEMPTABLE_LOOKUP TT_LOOKUP_NAME(THERMISTORHEATER_4).entry
 #elif defined(HEATER_4_USES_THERMISTOR)
   #error "No heater 4 thermistor table specified"
 #else
   #define HEATER_4_TEMPTABLE NULL
   #define HEATER_4_TEMPTABLE_LEN 0
+  #define HEATER_4_TEMPTABLE_LOOKUP NULL
 #endif
 
 #ifdef THERMISTORBED
   #define BEDTEMPTABLE TT_NAME(THERMISTORBED)
   #define BEDTEMPTABLE_LEN COUNT(BEDTEMPTABLE)
+  #define BEDTEMPTABLE_LOOKUP TT_LOOKUP_NAME(THERMISTORBED).entry
 #else
   #ifdef BED_USES_THERMISTOR
     #error "No bed thermistor table specified"
@@ -193,6 +268,7 @@
 #ifdef THERMISTORCHAMBER
   #define CHAMBERTEMPTABLE TT_NAME(THERMISTORCHAMBER)
   #define CHAMBERTEMPTABLE_LEN COUNT(CHAMBERTEMPTABLE)
+  #define CHAMBERTEMPTABLE_LOOKUP TT_LOOKUP_NAME(THERMISTORCHAMBER).entry
 #else
   #ifdef CHAMBER_USES_THERMISTOR
     #error "No chamber thermistor table specified"
@@ -283,6 +283,13 @@
 #elif MB(RAMPS_14_RE_ARM_SF)
   #include "pins_RAMPS_RE_ARM.h"
 
+//
+// Linux Native Debug board
+//
+
+#elif MB(LINUX_RAMPS)
+  #include "pins_RAMPS_LINUX.h"
+
 //
 // Other 32-bit Boards
 //
@@ -0,0 +1,39 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ * Copyright (C) 2017 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Linux native build with a simulated RAMPS v1.4
+ *
+ * Uses the stock RAMPS (Mega2560) pin numbers. The Linux HAL attaches its
+ * heater, thermistor, axis and SD card models to these pins.
+ */
+
+#ifndef __PLAT_LINUX__
+  #error "Oops!  Make sure you have the Linux Native environment selected."
+#endif
+
+#ifndef BOARD_NAME
+  #define BOARD_NAME "Linux RAMPS 1.4"
+#endif
+
+#include "pins_RAMPS.h"
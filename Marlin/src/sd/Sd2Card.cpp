@@ -89,6 +89,9 @@
 
 // send command and return error code.  Return zero for OK
 uint8_t Sd2Card::cardCommand(uint8_t cmd, uint32_t arg) {
+  // any other command ends a multiple block read
+  if (readMultiple_ && cmd != CMD12) readStop();
+
   // select card
   chipSelect();
 
@@ -238,6 +241,7 @@ bool Sd2Card::eraseSingleBlockEnable() {
  */
 bool Sd2Card::init(uint8_t sckRateID, pin_t chipSelectPin) {
   errorCode_ = type_ = 0;
+  readMultiple_ = false;
   chipSelectPin_ = chipSelectPin;
   // 16-bit init start time allows over a minute
   uint16_t t0 = (uint16_t)millis();
@@ -344,6 +348,9 @@ bool Sd2Card::init(uint8_t sckRateID, pin_t chipSelectPin) {
  * \return true for success, false for failure.
  */
 bool Sd2Card::readBlock(uint32_t blockNumber, uint8_t* dst) {
+  // continue a multiple block read already positioned here
+  if (readMultiple_ && blockNumber == readMultipleBlock_) return readBlocks(blockNumber, dst, 1);
+
   // use address if not SDHC card
   if (type() != SD_CARD_TYPE_SDHC) blockNumber <<= 9;
 
@@ -373,6 +380,38 @@ bool Sd2Card::readBlock(uint32_t blockNumber, uint8_t* dst) {
   #endif
 }
 
+/**
+ * Read consecutive 512 byte blocks from an SD card.
+ *
+ * A multiple block read (CMD18) is left open afterwards, so sequential
+ * calls cost no further commands. It is ended by readStop(), which
+ * cardCommand() calls before any other command is sent.
+ *
+ * \param[in] blockNumber Logical block of the first block to be read.
+ * \param[out] dst Pointer to the location that will receive the data.
+ * \param[in] count Number of blocks to read.
+ * \return true for success, false for failure.
+ */
+bool Sd2Card::readBlocks(uint32_t blockNumber, uint8_t* dst, uint16_t count) {
+  if (!readMultiple_ || blockNumber != readMultipleBlock_)
+    if (!readStart(blockNumber)) return false;
+
+  for (; count; count--, blockNumber++, dst += 512) {
+    if (!readData(dst)) {
+      readStop();
+      #if ENABLED(SD_CHECK_AND_RETRY)
+        // Fall back to single block reads, which are retried
+        for (; count; count--, blockNumber++, dst += 512)
+          if (!readBlock(blockNumber, dst)) return false;
+        return true;
+      #else
+        return false;
+      #endif
+    }
+  }
+  return true;
+}
+
 /**
  * Read one data block in a multiple block read sequence
  *
@@ -382,6 +421,7 @@ bool Sd2Card::readBlock(uint32_t blockNumber, uint8_t* dst) {
  */
 bool Sd2Card::readData(uint8_t* dst) {
   chipSelect();
+  readMultipleBlock_++;
   return readData(dst, 512);
 }
 
@@ -505,12 +545,14 @@ bool Sd2Card::readRegister(uint8_t cmd, void* buf) {
  * \return true for success, false for failure.
  */
 bool Sd2Card::readStart(uint32_t blockNumber) {
+  readMultipleBlock_ = blockNumber;
   if (type() != SD_CARD_TYPE_SDHC) blockNumber <<= 9;
   if (cardCommand(CMD18, blockNumber)) {
     error(SD_CARD_ERROR_CMD18);
     chipDeselect();
     return false;
   }
+  readMultiple_ = true;
   chipDeselect();
   return true;
 }
@@ -521,6 +563,7 @@ bool Sd2Card::readStart(uint32_t blockNumber) {
  * \return true for success, false for failure.
  */
 bool Sd2Card::readStop() {
+  readMultiple_ = false;
   chipSelect();
   if (cardCommand(CMD12, 0)) {
     error(SD_CARD_ERROR_CMD12);
@@ -116,7 +116,7 @@ uint8_t const SD_CARD_TYPE_SD1  = 1,                    // Standard capacity V1
 class Sd2Card {
   public:
 
-  Sd2Card() : errorCode_(SD_CARD_ERROR_INIT_NOT_CALLED), type_(0) {}
+  Sd2Card() : errorCode_(SD_CARD_ERROR_INIT_NOT_CALLED), type_(0), readMultiple_(false) {}
 
   uint32_t cardSize();
   bool erase(uint32_t firstBlock, uint32_t lastBlock);
@@ -145,6 +145,7 @@ class Sd2Card {
   bool init(uint8_t sckRateID = SPI_FULL_SPEED,
             pin_t chipSelectPin = SD_CHIP_SELECT_PIN);
   bool readBlock(uint32_t block, uint8_t* dst);
+  bool readBlocks(uint32_t block, uint8_t* dst, uint16_t count);
 
   /**
    * Read a card's CID register. The CID contains card identification
@@ -187,6 +188,8 @@ class Sd2Card {
           spiRate_,
           status_,
           type_;
+  bool readMultiple_;           // A multiple block read is open
+  uint32_t readMultipleBlock_;  // Next block it will return
 
   // private functions
   uint8_t cardAcmd(uint8_t cmd, uint32_t arg) {
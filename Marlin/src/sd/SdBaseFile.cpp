@@ -41,6 +41,7 @@ void (*SdBaseFile::dateTime_)(uint16_t* date, uint16_t* time) = 0;
 
 // add a cluster to a file
 bool SdBaseFile::addCluster() {
+  contiguousEnd_ = 0;
   if (!vol_->allocContiguous(1, &curCluster_)) return false;
 
   // if first cluster of file link to directory entry
@@ -741,7 +742,7 @@ bool SdBaseFile::openCachedEntry(uint8_t dirIndex, uint8_t oflag) {
   flags_ = oflag & F_OFLAG;
 
   // set to start of file
-  curCluster_ = 0;
+  curCluster_ = contiguousEnd_ = 0;
   curPosition_ = 0;
   if ((oflag & O_TRUNC) && !truncate(0)) return false;
   return oflag & O_AT_END ? seekEnd(0) : true;
@@ -882,7 +883,7 @@ bool SdBaseFile::openRoot(SdVolume* vol) {
   flags_ = O_READ;
 
   // set to start of file
-  curCluster_ = curPosition_ = 0;
+  curCluster_ = contiguousEnd_ = curPosition_ = 0;
 
   // root has no directory entry
   dirBlock_ = dirIndex_ = 0;
@@ -990,6 +991,7 @@ int16_t SdBaseFile::read() {
 int16_t SdBaseFile::read(void* buf, uint16_t nbyte) {
   uint8_t* dst = reinterpret_cast<uint8_t*>(buf);
   uint16_t offset, toRead;
+  uint8_t blockOfCluster = 0;
   uint32_t block;  // raw device block number
 
   // error if not open or write only
@@ -1006,14 +1008,9 @@ int16_t SdBaseFile::read(void* buf, uint16_t nbyte) {
       block = vol_->rootDirStart() + (curPosition_ >> 9);
     }
     else {
-      uint8_t blockOfCluster = vol_->blockOfCluster(curPosition_);
-      if (offset == 0 && blockOfCluster == 0) {
-        // start of new cluster
-        if (curPosition_ == 0)
-          curCluster_ = firstCluster_;                      // use first cluster in file
-        else if (!vol_->fatGet(curCluster_, &curCluster_))  // get next cluster from FAT
-          return -1;
-      }
+      blockOfCluster = vol_->blockOfCluster(curPosition_);
+      if (offset == 0 && blockOfCluster == 0 && !nextReadCluster()) // start of new cluster
+        return -1;
       block = vol_->clusterStartBlock(curCluster_) + blockOfCluster;
     }
     uint16_t n = toRead;
@@ -1023,7 +1020,20 @@ int16_t SdBaseFile::read(void* buf, uint16_t nbyte) {
 
     // no buffering needed if n == 512
     if (n == 512 && block != vol_->cacheBlockNumber()) {
-      if (!vol_->readBlock(block, dst)) return -1;
+      // read all whole blocks that follow on the card in one go
+      uint16_t count = toRead >> 9;
+      if (type_ != FAT_FILE_TYPE_ROOT_FIXED) {
+        const uint32_t clusters = curCluster_ < contiguousEnd_ ? contiguousEnd_ - curCluster_ + 1 : 1;
+        NOMORE(count, (clusters << vol_->clusterSizeShift_) - blockOfCluster);
+      }
+      // stop short of the cached block, which may hold newer data
+      const uint32_t cached = vol_->cacheBlockNumber();
+      if (cached > block && cached - block < count) count = cached - block;
+
+      if (!vol_->readBlocks(block, dst, count)) return -1;
+      n = count << 9;
+      if (type_ != FAT_FILE_TYPE_ROOT_FIXED)
+        curCluster_ += (blockOfCluster + count - 1) >> vol_->clusterSizeShift_;
     }
     else {
       // read block to cache and copy data to caller
@@ -1038,6 +1048,33 @@ int16_t SdBaseFile::read(void* buf, uint16_t nbyte) {
   return nbyte;
 }
 
+/**
+ * Advance curCluster_ to the cluster for a read at the start of a new
+ * cluster. The run of consecutive clusters that begins there is looked up
+ * once, so reads can go on through it without FAT lookups or breaking up
+ * a multiple block read. The lookup stops after one FAT block or so.
+ *
+ * \return true for success, false for failure.
+ */
+bool SdBaseFile::nextReadCluster() {
+  if (curPosition_ == 0)
+    curCluster_ = firstCluster_;                      // use first cluster in file
+  else if (curCluster_ < contiguousEnd_) {
+    curCluster_++;                                    // next cluster in the run
+    return true;
+  }
+  else if (!vol_->fatGet(curCluster_, &curCluster_))  // get next cluster from FAT
+    return false;
+
+  contiguousEnd_ = curCluster_;
+  for (uint8_t i = 128; i--;) {
+    uint32_t next;
+    if (!vol_->fatGet(contiguousEnd_, &next) || next != contiguousEnd_ + 1) break;
+    contiguousEnd_ = next;
+  }
+  return true;
+}
+
 /**
  * Read the next entry in a directory.
  *
@@ -1382,6 +1419,7 @@ bool SdBaseFile::seekSet(const uint32_t pos) {
     curPosition_ = pos;
     return true;
   }
+  contiguousEnd_ = 0;
   if (pos == 0) {
     curCluster_ = curPosition_ = 0;   // set position to start of file
     return true;
@@ -1406,6 +1444,7 @@ bool SdBaseFile::seekSet(const uint32_t pos) {
 void SdBaseFile::setpos(filepos_t* pos) {
   curPosition_ = pos->position;
   curCluster_ = pos->cluster;
+  contiguousEnd_ = 0;
 }
 
 /**
@@ -1656,6 +1695,7 @@ int16_t SdBaseFile::write(const void* buf, uint16_t nbyte) {
         }
         else {
           curCluster_ = firstCluster_;
+          contiguousEnd_ = 0;
         }
       }
       else {
@@ -1667,6 +1707,7 @@ int16_t SdBaseFile::write(const void* buf, uint16_t nbyte) {
         }
         else {
           curCluster_ = next;
+          contiguousEnd_ = 0;
         }
       }
     }
@@ -364,6 +364,7 @@ class SdBaseFile {
   uint8_t   fstate_;        // error and eof indicator
   uint8_t   type_;          // type of file see above for values
   uint32_t  curCluster_;    // cluster for current file position
+  uint32_t  contiguousEnd_;  // last cluster of the consecutive run holding curCluster_, if known
   uint32_t  curPosition_;   // current file position in bytes from beginning
   uint32_t  dirBlock_;      // block for this files directory entry
   uint8_t   dirIndex_;      // index of directory entry in dirBlock
@@ -379,6 +380,7 @@ class SdBaseFile {
   // private functions
   bool addCluster();
   bool addDirCluster();
+  bool nextReadCluster();
   dir_t* cacheDirEntry(uint8_t action);
   int8_t lsPrintNext(uint8_t flags, uint8_t indent);
   static bool make83Name(const char* str, uint8_t* name, const char** ptr);
@@ -189,6 +189,7 @@ class SdVolume {
     return  cluster >= FAT32EOC_MIN;
   }
   bool readBlock(uint32_t block, uint8_t* dst) { return sdCard_->readBlock(block, dst); }
+  bool readBlocks(uint32_t block, uint8_t* dst, uint16_t count) { return sdCard_->readBlocks(block, dst, count); }
   bool writeBlock(uint32_t block, const uint8_t* dst) { return sdCard_->writeBlock(block, dst); }
 
   // Deprecated functions
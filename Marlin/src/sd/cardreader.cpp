@@ -56,11 +56,11 @@ CardReader::CardReader() {
   #endif
   sdprinting = cardOK = saving = logging = false;
   filesize = 0;
-  sdpos = 0;
+  sdpos = read_buffer_start = 0;
+  read_buffer_pos = read_buffer_len = 0;
   file_subcall_ctr = 0;
 
   workDirDepth = 0;
-  ZERO(workDirParents);
 
   autostart_stilltocheck = true; //the SD start is delayed, because otherwise the serial cannot answer fast enough to make contact with the host software.
   autostart_index = 0;
@@ -295,6 +295,9 @@ void CardReader::printFilename(
 void CardReader::initsd() {
   cardOK = false;
   if (root.isOpen()) root.close();
+  #if ENABLED(POWER_LOSS_RECOVERY)
+    jobRecoveryBlock = 0;
+  #endif
 
   #ifndef SPI_SPEED
     #define SPI_SPEED SPI_FULL_SPEED
@@ -486,7 +489,7 @@ void CardReader::openFile(char* name, const bool read, const bool subcall/*=fals
   if (read) {
     if (file.open(curDir, fname, O_READ)) {
       filesize = file.fileSize();
-      sdpos = 0;
+      setIndex(0);
       SERIAL_PROTOCOLPAIR(MSG_SD_FILE_OPENED, fname);
       SERIAL_PROTOCOLLNPAIR(MSG_SD_SIZE, filesize);
       SERIAL_PROTOCOLLNPGM(MSG_SD_FILE_SELECTED);
@@ -526,7 +529,7 @@ void CardReader::removeFile(const char * const name) {
   curDir = &root;
   const char *fname = name;
 
-  char *dirname_start, *dirname_end;
+  const char *dirname_start, *dirname_end;
   if (name[0] == '/') {
     dirname_start = strchr(name, '/') + 1;
     while (dirname_start != NULL) {
@@ -572,6 +575,60 @@ void CardReader::removeFile(const char * const name) {
   }
 }
 
+/**
+ * Refill the read-ahead buffer with the data following it.
+ * Return the number of bytes read, 0 at the end of the file, or -1 on error.
+ */
+int16_t CardReader::fillReadBuffer() {
+  read_buffer_start += read_buffer_len;
+  read_buffer_pos = read_buffer_len = 0;
+  if (read_buffer_start >= filesize) return 0;
+  // Stop at a buffer-size boundary, so later reads are aligned whole blocks
+  uint16_t n = SD_READ_BUFFER_SIZE - (read_buffer_start % (SD_READ_BUFFER_SIZE));
+  NOMORE(n, filesize - read_buffer_start);
+  const int16_t got = file.read(read_buffer, n);
+  if (got > 0) read_buffer_len = got;
+  return got;
+}
+
+/**
+ * Get the next command from the file being printed into dst, scanning
+ * it straight out of the read-ahead buffer. Comments are dropped and
+ * characters beyond MAX_CMD_SIZE are ignored. sdpos is only updated
+ * here, so it always points to the start of the next command.
+ *
+ * Return the terminator ('\n', '\r', '#' or ':'), -1 at the end of the
+ * file, or -2 on a read error. A command may precede the end of the file.
+ */
+int16_t CardReader::getCommand(char * const dst, uint8_t &len) {
+  bool comment_mode = false;
+  len = 0;
+  for (;;) {
+    if (read_buffer_pos >= read_buffer_len) {
+      const int16_t got = fillReadBuffer();
+      if (got < 0) {
+        setIndex(sdpos);  // Retry from the start of the command
+        return -2;
+      }
+      if (got == 0) {
+        sdpos = filesize;
+        dst[len] = '\0';
+        return -1;
+      }
+    }
+    while (read_buffer_pos < read_buffer_len) {
+      const char c = read_buffer[read_buffer_pos++];
+      if (c == '\n' || c == '\r' || ((c == '#' || c == ':') && !comment_mode)) {
+        sdpos = read_buffer_start + read_buffer_pos;
+        dst[len] = '\0';
+        return c;
+      }
+      if (c == ';') comment_mode = true;
+      if (!comment_mode && len < MAX_CMD_SIZE - 1) dst[len++] = c;
+    }
+  }
+}
+
 void CardReader::getStatus(
   #if NUM_SERIAL > 1
     const int8_t port/*= -1*/
@@ -974,11 +1031,7 @@ void CardReader::printingHasFinished() {
     sdprinting = false;
 
     #if ENABLED(POWER_LOSS_RECOVERY)
-      openJobRecoveryFile(false);
-      job_recovery_info.valid_head = job_recovery_info.valid_foot = 0;
-      (void)saveJobRecoveryInfo();
-      closeJobRecoveryFile();
-      job_recovery_commands_count = 0;
+      cancel_job_recovery();
     #endif
 
     #if ENABLED(SD_FINISHED_STEPPERRELEASE) && defined(SD_FINISHED_RELEASECOMMAND)
@@ -1009,6 +1062,9 @@ void CardReader::printingHasFinished() {
   void CardReader::auto_report_sd_status() {
     millis_t current_ms = millis();
     if (auto_report_sd_interval && ELAPSED(current_ms, next_sd_report_ms)) {
+      #if ENABLED(AUTO_REPORT_COALESCE)
+        if (!SERIAL_TX_ROOM(40)) return;  // "SD printing byte 4294967295/4294967295\n"
+      #endif
       next_sd_report_ms = current_ms + 1000UL * auto_report_sd_interval;
       getStatus(
         #if NUM_SERIAL > 1
@@ -1023,40 +1079,56 @@ void CardReader::printingHasFinished() {
 
   char job_recovery_file_name[4] = "bin";
 
-  void CardReader::openJobRecoveryFile(const bool read) {
-    if (!cardOK) return;
-    if (jobRecoveryFile.isOpen()) return;
-    if (!jobRecoveryFile.open(&root, job_recovery_file_name, read ? O_READ : O_CREAT | O_WRITE | O_TRUNC | O_SYNC)) {
+  /**
+   * Open the power-loss journal, a file of at least 'blocks' consecutive
+   * blocks that are read and written straight from the card, bypassing the
+   * FAT. Return false if the file is missing, too short or fragmented.
+   */
+  bool CardReader::openJobRecoveryFile(const uint16_t blocks) {
+    jobRecoveryBlock = 0;
+    if (!cardOK) return false;
+    SdFile journal;
+    if (!journal.open(&root, job_recovery_file_name, O_READ)) return false;
+    uint32_t bgn, end;
+    const bool usable = journal.fileSize() >= blocks * 512UL && journal.contiguousRange(&bgn, &end);
+    journal.close();
+    if (usable) jobRecoveryBlock = bgn;
+    return usable;
+  }
+
+  /**
+   * Make the power-loss journal, replacing an unusable one. Its blocks hold
+   * whatever the clusters held before, for the caller to clear.
+   */
+  bool CardReader::createJobRecoveryFile(const uint16_t blocks) {
+    jobRecoveryBlock = 0;
+    if (!cardOK) return false;
+    SdFile journal;
+    if (journal.open(&root, job_recovery_file_name, O_READ)) {
+      journal.close();
+      if (!SdFile::remove(&root, job_recovery_file_name)) return false;
+    }
+    uint32_t bgn, end;
+    if (!journal.createContiguous(&root, job_recovery_file_name, blocks * 512UL) || !journal.contiguousRange(&bgn, &end)) {
       SERIAL_PROTOCOLPAIR(MSG_SD_OPEN_FILE_FAIL, job_recovery_file_name);
       SERIAL_PROTOCOLCHAR('.');
       SERIAL_EOL();
+      journal.close();
+      return false;
     }
-    else
-      SERIAL_PROTOCOLLNPAIR(MSG_SD_WRITE_TO_FILE, job_recovery_file_name);
-  }
-
-  void CardReader::closeJobRecoveryFile() { jobRecoveryFile.close(); }
-
-  bool CardReader::jobRecoverFileExists() {
-    return jobRecoveryFile.open(&root, job_recovery_file_name, O_READ);
-  }
-
-  int16_t CardReader::saveJobRecoveryInfo() {
-    jobRecoveryFile.seekSet(0);
-    const int16_t ret = jobRecoveryFile.write(&job_recovery_info, sizeof(job_recovery_info));
-    if (ret == -1) SERIAL_PROTOCOLLNPGM("Power-loss file write failed.");
-    return ret;
+    journal.close();
+    jobRecoveryBlock = bgn;
+    SERIAL_PROTOCOLLNPAIR(MSG_SD_WRITE_TO_FILE, job_recovery_file_name);
+    return true;
   }
 
-  int16_t CardReader::loadJobRecoveryInfo() {
-    return jobRecoveryFile.read(&job_recovery_info, sizeof(job_recovery_info));
+  // Block reads and writes end a multiple block read of the print file, which the next read starts again
+  bool CardReader::readJobRecoveryBlock(const uint16_t index, uint8_t *dst) {
+    return cardOK && jobRecoveryBlock && card.readBlock(jobRecoveryBlock + index, dst);
   }
 
-  void CardReader::removeJobRecoveryFile() {
-    if (jobRecoveryFile.remove(&root, job_recovery_file_name))
-      SERIAL_PROTOCOLLNPGM("Power-loss file deleted.");
-    else
-      SERIAL_PROTOCOLLNPGM("Power-loss file delete failed.");
+  bool CardReader::writeJobRecoveryBlock(const uint16_t index, const uint8_t *src) {
+    return cardOK && jobRecoveryBlock && card.writeBlock(jobRecoveryBlock + index, src);
   }
 
 #endif // POWER_LOSS_RECOVERY
@@ -31,6 +31,14 @@
 
 #define MAX_DIR_DEPTH 10          // Maximum folder depth
 
+// Read-ahead for printing. Reads are aligned to the buffer size, so on
+// 32-bit boards two whole blocks are read straight from the card each time.
+#ifdef __AVR__
+  #define SD_READ_BUFFER_SIZE 64    // RAM is tight. Reads come from the volume block cache.
+#else
+  #define SD_READ_BUFFER_SIZE 1024
+#endif
+
 #include "SdFile.h"
 
 class CardReader {
@@ -104,19 +112,22 @@ public:
   #endif
 
   #if ENABLED(POWER_LOSS_RECOVERY)
-    void openJobRecoveryFile(const bool read);
-    void closeJobRecoveryFile();
-    bool jobRecoverFileExists();
-    int16_t saveJobRecoveryInfo();
-    int16_t loadJobRecoveryInfo();
-    void removeJobRecoveryFile();
+    bool openJobRecoveryFile(const uint16_t blocks);
+    bool createJobRecoveryFile(const uint16_t blocks);
+    bool readJobRecoveryBlock(const uint16_t index, uint8_t *dst);
+    bool writeJobRecoveryBlock(const uint16_t index, const uint8_t *src);
+    FORCE_INLINE uint8_t getSubcallDepth() { return file_subcall_ctr; }
   #endif
 
   FORCE_INLINE void pauseSDPrint() { sdprinting = false; }
   FORCE_INLINE bool isFileOpen() { return file.isOpen(); }
   FORCE_INLINE bool eof() { return sdpos >= filesize; }
-  FORCE_INLINE int16_t get() { sdpos = file.curPosition(); return (int16_t)file.read(); }
-  FORCE_INLINE void setIndex(const uint32_t index) { sdpos = index; file.seekSet(index); }
+  int16_t getCommand(char * const dst, uint8_t &len);
+  FORCE_INLINE void setIndex(const uint32_t index) {
+    sdpos = read_buffer_start = index;
+    read_buffer_pos = read_buffer_len = 0;
+    file.seekSet(index);
+  }
   FORCE_INLINE uint32_t getIndex() { return sdpos; }
   FORCE_INLINE uint8_t percentDone() { return (isFileOpen() && filesize) ? sdpos / ((filesize + 99) / 100) : 0; }
   FORCE_INLINE char* getWorkDirName() { workDir.getFilename(filename); return filename; }
@@ -202,7 +213,7 @@ private:
   SdFile file;
 
   #if ENABLED(POWER_LOSS_RECOVERY)
-    SdFile jobRecoveryFile;
+    uint32_t jobRecoveryBlock;        // First block of the power-loss journal, 0 when not open
   #endif
 
   #define SD_PROCEDURE_DEPTH 1
@@ -210,7 +221,13 @@ private:
   uint8_t file_subcall_ctr;
   uint32_t filespos[SD_PROCEDURE_DEPTH];
   char proc_filenames[SD_PROCEDURE_DEPTH][MAXPATHNAMELENGTH];
-  uint32_t filesize, sdpos;
+  uint32_t filesize, sdpos;           // sdpos is the start of the next command
+
+  uint8_t read_buffer[SD_READ_BUFFER_SIZE];
+  uint32_t read_buffer_start;         // File position of read_buffer[0]
+  uint16_t read_buffer_pos,           // Next unread byte
+           read_buffer_len;           // Valid bytes
+  int16_t fillReadBuffer();
 
   millis_t next_autostart_ms;
   bool autostart_stilltocheck; //the sd start is delayed, because otherwise the serial cannot answer fast enought to make contact with the hostsoftware.
@@ -0,0 +1,259 @@
+#!/usr/bin/env python
+
+""" Encode G-code into the binary frames accepted with BINARY_GCODE_TRANSPORT,
+    decode them back to text, and compare both transports.
+
+    encode IN OUT    Write IN the way a host would send it, with line numbers:
+                     binary frames, and text lines with a checksum for
+                     commands a frame can't carry (string arguments, M28..M29).
+                     With --text, text lines only.
+    decode IN        Print the commands in a stream of frames and text lines.
+    benchmark IN     Check that every command in IN survives encoding and
+                     decoding, then time the firmware's serial queue and parser
+                     on the text and binary streams with the Linux native build
+                     (--benchmark-gcode).
+
+    The frame and record formats are described in Marlin/src/gcode/queue.h
+    and GCodeParser::parse_binary.
+"""
+
+from __future__ import print_function
+import argparse
+import os
+import re
+import struct
+import subprocess
+import sys
+import tempfile
+import time
+
+FRAME_START = 0xA5
+FRAME_OVERHEAD = 5
+LETTERS = 'GMT'
+
+# BinaryFormat: (struct code, scale)
+NONE, INT8, INT16, INT32, INT16_MILLI, INT32_MILLI, INT32_FINE, INT16_FINE = range(8)
+FORMATS = {
+  INT8: ('<b', 1), INT16: ('<h', 1), INT32: ('<i', 1),
+  INT16_MILLI: ('<h', 1000), INT32_MILLI: ('<i', 1000),
+  INT16_FINE: ('<h', 100000), INT32_FINE: ('<i', 100000)
+}
+
+# Commands that take a string argument, which frames can't carry
+STRING_CODES = (23, 28, 30, 32, 33, 117, 118, 928)
+
+COMMAND = re.compile(r'^([GMT])\s*(\d+)(?:\.(\d+))?\s*(.*)$')
+PARAM = re.compile(r'([A-Z])\s*([-+]?(?:\d+\.?\d*|\.\d+))?\s*')
+
+def crc16(data):
+  """ CRC-16/CCITT, as crc16() in Marlin/src/core/utility.cpp """
+  crc = 0
+  for b in bytearray(data):
+    crc ^= b << 8
+    for _ in range(8):
+      crc = ((crc << 1) ^ 0x1021 if crc & 0x8000 else crc << 1) & 0xFFFF
+  return crc
+
+def strip(line):
+  """ The command in a line, without comment, line number or checksum """
+  line = line.split(';', 1)[0].strip()
+  line = re.sub(r'^N\d+\s*', '', line)
+  return re.sub(r'\s*\*\d*$', '', line)
+
+def value_format(text):
+  """ The smallest BinaryFormat and integer that represent a decimal value """
+  if '.' not in text:
+    v = int(text)
+    for fmt, lo, hi in ((INT8, -128, 127), (INT16, -32768, 32767), (INT32, -2**31, 2**31 - 1)):
+      if lo <= v <= hi:
+        return fmt, v
+  decimals = len(text.split('.')[1].rstrip('0'))
+  x = float(text)
+  scales = [(INT16, INT32, 1), (INT16_MILLI, INT32_MILLI, 1000), (INT16_FINE, INT32_FINE, 100000)]
+  exact = [s for s in scales if s[2] >= 10 ** decimals]
+  # Exact at the coarsest scale that fits, otherwise rounded at the finest one that fits
+  for short, long_, scale in exact + [s for s in reversed(scales) if s not in exact]:
+    v = int(round(x * scale))
+    if -32768 <= v <= 32767:
+      return short, v
+    if -2**31 <= v < 2**31:
+      return long_, v
+  raise ValueError("value out of range: " + text)
+
+def encode_record(command):
+  """ The binary record for a command, or None if it must be sent as text """
+  match = COMMAND.match(command)
+  if not match:
+    return None
+  letter, code, subcode, args = match.groups()
+  code = int(code)
+  if letter == 'M' and code in STRING_CODES or code > 0xFFFF:
+    return None
+  params = []
+  pos = 0
+  while pos < len(args):
+    param = PARAM.match(args, pos)
+    if not param:
+      return None
+    name, value = param.groups()
+    if value is None:
+      params.append(struct.pack('<B', ord(name) - ord('A')))
+    else:
+      try:
+        fmt, v = value_format(value)
+      except ValueError:
+        return None
+      params.append(struct.pack('<B', (ord(name) - ord('A')) | fmt << 5) + struct.pack(FORMATS[fmt][0], v))
+    pos = param.end()
+  header = LETTERS.index(letter) | (0x04 if subcode else 0)
+  record = struct.pack('<BH', header, code)
+  if subcode:
+    record += struct.pack('<B', int(subcode))
+  return record + b''.join(params)
+
+def frame(record, line):
+  body = struct.pack('<BB', len(record), line & 0xFF) + record
+  return struct.pack('<B', FRAME_START) + body + struct.pack('<H', crc16(body))
+
+def text_line(command, line):
+  text = 'N%d %s' % (line, command)
+  checksum = 0
+  for c in bytearray(text.encode()):
+    checksum ^= c
+  return ('%s*%d\n' % (text, checksum)).encode()
+
+def encode(lines, binary=True, max_record=91):
+  """ The byte stream a host would send for lines of G-code """
+  out = []
+  saving = False
+  line = 0
+  for command in map(strip, lines):
+    if not command:
+      continue
+    line += 1
+    record = None
+    if binary and not saving:
+      record = encode_record(command)
+      if record is not None and len(record) > max_record:
+        record = None
+    out.append(text_line(command, line) if record is None else frame(record, line))
+    if re.match(r'^M2[89]\b', command):
+      saving = command.startswith('M28')
+  return b''.join(out)
+
+def decode_record(record):
+  header, code = struct.unpack_from('<BH', record)
+  text = LETTERS[header & 0x03] + str(code)
+  pos = 3
+  if header & 0x04:
+    text += '.%d' % bytearray(record)[pos]
+    pos += 1
+  while pos < len(record):
+    spec = bytearray(record)[pos]
+    pos += 1
+    name, fmt = chr(ord('A') + (spec & 0x1F)), spec >> 5
+    text += ' ' + name
+    if fmt != NONE:
+      code, scale = FORMATS[fmt]
+      v = struct.unpack_from(code, record, pos)[0]
+      pos += struct.calcsize(code)
+      if scale == 1:
+        text += str(v)
+      else:
+        digits = len(str(scale)) - 1
+        text += ('%.*f' % (digits, float(v) / scale)).rstrip('0').rstrip('.')
+  return text
+
+def decode(data):
+  """ Yield (line number, command) for each frame or text line in a stream """
+  data = bytearray(data)
+  pos = 0
+  while pos < len(data):
+    if data[pos] == FRAME_START:
+      length, line = data[pos + 1], data[pos + 2]
+      body = data[pos + 1:pos + 3 + length]
+      crc = struct.unpack_from('<H', data, pos + 3 + length)[0]
+      if crc != crc16(body):
+        raise ValueError("CRC mismatch at byte %d" % pos)
+      yield line, decode_record(bytes(body[2:]))
+      pos += length + FRAME_OVERHEAD
+    else:
+      end = data.index(b'\n', pos) if b'\n' in data[pos:] else len(data)
+      text = data[pos:end].decode()
+      match = re.match(r'^N(\d+)\s*', text)
+      command = strip(text)
+      if command:
+        yield int(match.group(1)) if match else None, command
+      pos = end + 1
+
+def canonical(command):
+  """ A command's letter, code and parameter values, for comparison """
+  match = COMMAND.match(command)
+  if not match:
+    return command
+  letter, code, subcode, args = match.groups()
+  params = [(name, round(float(value), 5) if value else None) for name, value in PARAM.findall(args)]
+  return (letter, int(code), int(subcode or 0), params)
+
+def run_firmware(program, stream):
+  fd, path = tempfile.mkstemp(suffix='.gcode')
+  with os.fdopen(fd, 'wb') as f:
+    f.write(stream)
+  try:
+    with open(os.devnull, 'r+b') as null:
+      run = subprocess.Popen([program, '--stdio', '--benchmark-gcode', path], stdin=null, stdout=null, stderr=subprocess.PIPE)
+      err = run.communicate()[1].decode()
+  finally:
+    os.remove(path)
+  match = re.search(r'(\d+) commands, (\d+) bytes in ([\d.]+)s, ([\d.]+) commands/s, last line (-?\d+)', err)
+  if not match:
+    sys.exit("No benchmark result:\n" + err)
+  return int(match.group(1)), int(match.group(2)), float(match.group(4)), int(match.group(5))
+
+def benchmark(args):
+  with open(args.input) as f:
+    lines = f.readlines()
+  commands = [c for c in map(strip, lines) if c]
+
+  start = time.time()
+  binary = encode(lines, max_record=args.max_record)
+  encoded = time.time() - start
+  text = encode(lines, binary=False)
+
+  decoded = [c for _, c in decode(binary)]
+  if len(decoded) != len(commands):
+    sys.exit("Decoded %d commands, expected %d" % (len(decoded), len(commands)))
+  for original, back in zip(commands, decoded):
+    if canonical(original) != canonical(back):
+      sys.exit("Round trip changed '%s' into '%s'" % (original, back))
+  print("Round trip: %d commands OK, host encoder %.0f commands/s" % (len(commands), len(commands) / encoded))
+
+  print("Stream   Bytes      Bytes/command  Firmware commands/s")
+  for name, stream in (('text', text), ('binary', binary)):
+    count, size, rate, last = run_firmware(args.program, stream)
+    if count != len(commands) or last != len(commands):
+      sys.exit("Firmware took %d commands up to line %d, expected %d" % (count, last, len(commands)))
+    print("%-8s %-10d %-14.1f %.0f" % (name, size, float(size) / count, rate))
+
+parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+parser.add_argument('mode', choices=('encode', 'decode', 'benchmark'))
+parser.add_argument('input', help='G-code file, or a stream to decode')
+parser.add_argument('output', nargs='?', help='Stream to write when encoding')
+parser.add_argument('--text', action='store_true', help='Encode text lines only')
+parser.add_argument('--max-record', type=int, default=91, help='Largest record, MAX_CMD_SIZE - 5 (default=91)')
+parser.add_argument('-p', '--program', default='.pioenvs/linux_native/program', help='Linux native executable')
+args = parser.parse_args()
+
+if args.mode == 'encode':
+  if not args.output:
+    sys.exit("encode needs an output file")
+  with open(args.input) as f:
+    stream = encode(f.readlines(), binary=not args.text, max_record=args.max_record)
+  with open(args.output, 'wb') as f:
+    f.write(stream)
+elif args.mode == 'decode':
+  with open(args.input, 'rb') as f:
+    for line, command in decode(f.read()):
+      print(command if line is None else 'N%d %s' % (line, command))
+else:
+  benchmark(args)
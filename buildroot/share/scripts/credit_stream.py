@@ -0,0 +1,181 @@
+#!/usr/bin/env python
+
+""" Stream a G-code file to Marlin with numbered, checksummed lines, waiting
+    for an "ok" per line or with SERIAL_CREDIT_FLOW (M575 S1), and report
+    lines per second and how long the host waited on acknowledgments.
+
+    run GCODE        Stream to the Linux native build (--stdio).
+    stream PORT      Stream GCODE (-g) to a printer over a serial port.
+                     Needs pyserial.
+
+    With credit flow the host keeps the bytes sent after the last
+    acknowledged line N within the credit R of "ok N<line> R<bytes> B<slots>",
+    and goes back to line n on "Resend: n". --latency delays everything the
+    host receives, to see the effect of a slow link on each mode.
+"""
+
+from __future__ import print_function
+import argparse
+import collections
+import re
+import subprocess
+import sys
+import threading
+import time
+
+CREDIT = re.compile(r'^ok N(-?\d+) R(\d+) B(\d+)')
+RESEND = re.compile(r'^Resend: ?(\d+)')
+
+def checksum(line):
+  c = 0
+  for b in bytearray(line.encode('ascii')): c ^= b
+  return c
+
+def numbered(n, command):
+  line = 'N%d %s' % (n, command)
+  return ('%s*%d\n' % (line, checksum(line))).encode('ascii')
+
+def load(filename):
+  commands = []
+  with open(filename) as f:
+    for line in f:
+      line = line.split(';', 1)[0].strip()
+      if line: commands.append(line)
+  return commands
+
+class Link(object):
+  """ Lines from the firmware, each available --latency seconds after it arrived """
+  def __init__(self, write, read, latency):
+    self.write, self.read, self.latency = write, read, latency
+    self.lines = collections.deque()
+    self.cond = threading.Condition()
+    reader = threading.Thread(target=self.reader)
+    reader.daemon = True
+    reader.start()
+
+  def reader(self):
+    data = b''
+    while True:
+      chunk = self.read()
+      if not chunk: continue
+      data += chunk
+      while b'\n' in data:
+        line, data = data.split(b'\n', 1)
+        with self.cond:
+          self.lines.append((time.time() + self.latency, line.decode('ascii', 'replace').strip()))
+          self.cond.notify()
+
+  def get(self, timeout):
+    """ The next line, or None after timeout seconds """
+    end = time.time() + timeout
+    with self.cond:
+      while True:
+        now = time.time()
+        if self.lines and self.lines[0][0] <= now: return self.lines.popleft()[1]
+        if now >= end: return None
+        self.cond.wait(min(end, self.lines[0][0]) - now if self.lines else end - now)
+
+def stream(link, commands, credit, timeout):
+  """ Send all commands and wait for the last acknowledgment. Return the seconds waited on acks. """
+  lines = [numbered(1, 'M575 S%d' % int(credit))] + [numbered(n + 2, c) for n, c in enumerate(commands)]
+  last = len(lines)
+  waited = 0.0
+  acked = 0           # Last line acknowledged
+  window = 0          # Credit: bytes allowed after line 'acked'
+  sent = 0            # Lines sent
+  in_flight = collections.deque() # Sizes of lines sent after 'acked'
+  started_credit = False
+  while acked < last:
+    # Send while allowed: one line in flight, or within the credit
+    while sent < last:
+      size = len(lines[sent])
+      if started_credit:
+        if sum(in_flight) + size > window: break
+      elif sent > acked: break
+      link.write(lines[sent])
+      in_flight.append(size)
+      sent += 1
+    begin = time.time()
+    line = link.get(timeout)
+    waited += time.time() - begin
+    if line is None: sys.exit("No answer after line %d" % acked)
+    match = CREDIT.match(line)
+    if match and started_credit:
+      n, window = int(match.group(1)), int(match.group(2))
+      while acked < n:
+        in_flight.popleft()
+        acked += 1
+      continue
+    match = RESEND.match(line)
+    if match:
+      # Everything from line n on is gone
+      n = int(match.group(1))
+      while sent >= n:
+        in_flight.pop()
+        sent -= 1
+      continue
+    if line.startswith('ok') and not started_credit:
+      in_flight.popleft()
+      acked += 1
+      # The "ok" of M575 S1 carries the first credit
+      if acked == 1 and credit:
+        match = CREDIT.match(line)
+        if not match: sys.exit("No credit in the answer to M575 S1: %s" % line)
+        window = int(match.group(2))
+        started_credit = True
+  return waited
+
+def run(args, link):
+  # Reset the line number once the firmware is up
+  deadline = time.time() + 30
+  while True:
+    link.write(b'M110 N0\n')
+    line = link.get(1)
+    while line is not None and not line.startswith('ok'): line = link.get(0.1)
+    if line is not None: break
+    if time.time() > deadline: sys.exit("No answer to M110")
+  while link.get(0.5) is not None: pass
+
+  commands = load(args.gcode)
+  for credit in args.modes:
+    begin = time.time()
+    waited = stream(link, commands, credit, args.timeout)
+    seconds = time.time() - begin
+    print("%-6s  %d lines in %.2fs, %.0f lines/s, %.2fs waiting on acknowledgments"
+          % ('credit' if credit else 'ok', len(commands), seconds, len(commands) / seconds, waited))
+    link.write(numbered(len(commands) + 2, 'M110 N0'))
+    while link.get(0.5) is not None: pass
+
+parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+sub = parser.add_subparsers(dest='mode')
+r = sub.add_parser('run', help='Stream to the Linux native build')
+r.add_argument('gcode')
+r.add_argument('-p', '--program', default='.pioenvs/linux_native/program', help='Linux native executable')
+s = sub.add_parser('stream', help='Stream to a serial port')
+s.add_argument('port')
+s.add_argument('-g', '--gcode', required=True, help='G-code to stream')
+s.add_argument('-b', '--baud', type=int, default=250000)
+for p in (r, s):
+  p.add_argument('-l', '--latency', type=float, default=0, help='Extra delay (ms) on everything received')
+  p.add_argument('-m', '--modes', choices=('ok', 'credit'), nargs='+', default=['ok', 'credit'])
+  p.add_argument('-t', '--timeout', type=float, default=60, help='Seconds to wait for an answer')
+args = parser.parse_args()
+args.modes = [m == 'credit' for m in args.modes]
+
+if args.mode == 'run':
+  proc = subprocess.Popen([args.program, '--stdio'], stdin=subprocess.PIPE, stdout=subprocess.PIPE, bufsize=0)
+  def write(data):
+    proc.stdin.write(data)
+    proc.stdin.flush()
+  link = Link(write, lambda: proc.stdout.read1(256) if hasattr(proc.stdout, 'read1') else proc.stdout.readline(), args.latency * 0.001)
+  try:
+    run(args, link)
+  finally:
+    proc.kill()
+elif args.mode == 'stream':
+  import serial
+  port = serial.Serial(args.port, args.baud, timeout=0.1)
+  link = Link(port.write, lambda: port.read(256), args.latency * 0.001)
+  run(args, link)
+else:
+  parser.print_help()
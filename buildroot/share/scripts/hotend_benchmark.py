@@ -0,0 +1,65 @@
+#!/usr/bin/env python
+
+""" Hold the simulated hotend of the Linux native build at temperature through
+    stretches of printing (--benchmark-hotend), once with PID and once with
+    MPCTEMP, and compare heat-up, overshoot, sag while printing and RMS error.
+
+    Before each benchmark the controller is tuned on the simulated printer,
+    with M303 for PID and M306 T for MPCTEMP, and saved with M500 to a
+    scratch EEPROM file that the benchmark then loads.
+
+    Run from the top of the Marlin tree. Configuration_adv.h is restored
+    afterwards.
+"""
+
+from __future__ import print_function
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+import native_benchmark
+
+parser = native_benchmark.arguments(__doc__, 'Marlin/Configuration_adv.h', 'MPCTEMP')
+parser.add_argument('-n', '--stretches', type=int, default=40, help='Stretches of printing and travel per run (default=40)')
+parser.add_argument('--no-tune', action='store_true', help='Benchmark the configured constants')
+args = parser.parse_args()
+
+RESULT = re.compile(r'hotend: (.*?): \d+ stretches, [\d.]+s printing, sag ([\d.-]+)C, rise ([\d.-]+)C, '
+                    r'rms ([\d.]+)C, heat-up ([\d.]+)s, overshoot ([\d.-]+)C')
+
+def tune(eeprom, command, done):
+  """ Run command on the simulated printer until a line starts with done, then save with M500 """
+  run = subprocess.Popen([args.program, '--stdio', '--eeprom', eeprom], stdin=subprocess.PIPE, stdout=subprocess.PIPE)
+  try:
+    time.sleep(2)
+    run.stdin.write((command + '\n').encode())
+    run.stdin.flush()
+    for line in iter(run.stdout.readline, b''):
+      line = line.decode('ascii', 'replace')
+      if 'failed' in line.lower(): sys.exit("%s: %s" % (command, line.strip()))
+      if done in line: break
+    else:
+      sys.exit("%s did not finish" % command)
+    run.stdin.write(b'M500\n')
+    run.stdin.flush()
+    time.sleep(1)
+  finally:
+    run.kill()
+
+eeprom = os.path.join(tempfile.mkdtemp(), 'eeprom.dat')
+
+def benchmark(enable):
+  if os.path.exists(eeprom): os.remove(eeprom)
+  if not args.no_tune:
+    if enable: tune(eeprom, 'M306 T', 'MPC Autotune finished')
+    else: tune(eeprom, 'M303 E0 S210 C8 U1', 'PID Autotune finished')
+  report = native_benchmark.run(args, 'hotend', args.stretches, '--eeprom', eeprom)[0]
+  return native_benchmark.results(RESULT, report, 'MPCTEMP', enable)
+
+results = sum(native_benchmark.sweep(args, 'MPCTEMP', (False, True), benchmark), [])
+
+print("%-26s  %9s  %9s  %8s  %11s  %9s" % ('Controller', 'Sag (C)', 'Rise (C)', 'RMS (C)', 'Heat-up (s)', 'Overshoot'))
+for name, sag, rise, rms, heatup, overshoot in results:
+  print("%-26s  %9s  %9s  %8s  %11s  %9s" % (name, sag, rise, rms, heatup, overshoot))
@@ -0,0 +1,31 @@
+#!/usr/bin/env python
+
+""" Plan random toolpaths with the Linux native build (--benchmark-junction),
+    once with the jerk cornering model and once with JUNCTION_DEVIATION, and
+    compare print time and the largest speed change of an axis at a junction.
+
+    Run from the top of the Marlin tree. Configuration.h is restored
+    afterwards.
+"""
+
+from __future__ import print_function
+import re
+import native_benchmark
+
+parser = native_benchmark.arguments(__doc__, 'Marlin/Configuration.h', 'JUNCTION_DEVIATION')
+parser.add_argument('-n', '--paths', type=int, default=200, help='Toolpaths to plan per build (default=200)')
+args = parser.parse_args()
+
+RESULT = re.compile(r'junction: (.*?): \d+ paths, (\d+) blocks, .*? print time ([\d.]+)s, mean ([\d.]+)mm/s, '
+                    r'max junction jump X([\d.]+) Y([\d.]+) mm/s, mean ([\d.]+)mm/s')
+
+def benchmark(enable):
+  report = native_benchmark.run(args, 'junction', args.paths)[0]
+  return native_benchmark.results(RESULT, report, 'JUNCTION_DEVIATION', enable)
+
+results = sum(native_benchmark.sweep(args, 'JUNCTION_DEVIATION', (False, True), benchmark), [])
+
+base = float(results[0][2])
+print("%-34s  %6s  %9s  %7s  %s" % ('Model', 'Blocks', 'Time (s)', 'vs jerk', 'Max jump X/Y, mean (mm/s)'))
+for model, blocks, seconds, speed, jump_x, jump_y, jump_mean in results:
+  print("%-34s  %6s  %9s  %+6.1f%%  %s/%s, %s" % (model, blocks, seconds, (float(seconds) / base - 1) * 100, jump_x, jump_y, jump_mean))
@@ -0,0 +1,75 @@
+""" Shared steps of the *_benchmark.py scripts, which build the Linux native
+    program with a configuration option set to each of several values, run
+    one of its --benchmark-* options on every build and compare the reports.
+
+    The configuration file is restored afterwards, even on failure.
+"""
+
+import argparse
+import re
+import shlex
+import subprocess
+import sys
+
+def arguments(description, config, option):
+  """ An argument parser with the -c/-b/-p options every benchmark takes """
+  parser = argparse.ArgumentParser(description=description)
+  parser.add_argument('-c', '--config', default=config, help='Configuration file holding %s' % option)
+  parser.add_argument('-b', '--build', default='platformio run -e linux_native --silent', help='Build command')
+  parser.add_argument('-p', '--program', default='.pioenvs/linux_native/program', help='Resulting executable')
+  return parser
+
+def _define(option):
+  return re.compile(r'^([ \t]*)(?://[ \t]*)?#define[ \t]+%s\b([^\n]*)$' % option, re.M)
+
+def define(text, option, value):
+  """ Set every #define of option in text: True enables it, False or None
+      comments it out, and anything else becomes its value """
+  def setting(match):
+    indent, rest = match.groups()
+    if value is True: return '%s#define %s%s' % (indent, option, rest)
+    if value is False or value is None: return '%s//#define %s%s' % (indent, option, rest)
+    comment = re.search(r'\s*//.*$', rest)
+    return '%s#define %s %s%s' % (indent, option, value, comment.group(0) if comment else '')
+  return _define(option).sub(setting, text)
+
+def setting(option, value):
+  """ The build for value, in messages """
+  if value is True: return 'with %s' % option
+  if value is False or value is None: return 'without %s' % option
+  return 'with %s %s' % (option, value)
+
+def sweep(args, option, values, benchmark):
+  """ Build with option set to each of values in turn and call benchmark(value)
+      on each build. Returns what the calls returned. """
+  with open(args.config) as f:
+    original = f.read()
+  if not _define(option).search(original):
+    sys.exit("No %s in %s" % (option, args.config))
+
+  results = []
+  try:
+    for value in values:
+      with open(args.config, 'w') as f:
+        f.write(define(original, option, value))
+      subprocess.check_call(shlex.split(args.build))
+      results.append(benchmark(value))
+  finally:
+    with open(args.config, 'w') as f:
+      f.write(original)
+  return results
+
+def run(args, name, count, *options):
+  """ Run --benchmark-NAME COUNT, after any other options. Returns the report
+      written to stderr and the exit status. """
+  run = subprocess.Popen([args.program, '--stdio'] + list(options) + ['--benchmark-' + name, str(count)],
+                         stdin=subprocess.PIPE, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+  report = run.communicate()[1].decode()
+  return report, run.returncode
+
+def results(pattern, report, option, value):
+  """ Every match of pattern in report, exiting if there are none """
+  found = pattern.findall(report)
+  if not found:
+    sys.exit("No benchmark result %s:\n%s" % (setting(option, value), report))
+  return found
@@ -0,0 +1,110 @@
+#!/usr/bin/env python
+
+""" Regression test for PID autotuning (M303) against the simulated hotend of
+    the Linux native build, run faster than real time with --speedup.
+
+    Each method tunes a fresh printer and saves the result with M500, then
+    --benchmark-hotend holds the tuned hotend at temperature through
+    stretches of printing. Reported are the simulated time each method took
+    to tune, the constants it found and how well they hold the temperature.
+
+      relay       M303 C<cycles>, the classic relay autotune
+      fit         M303 F, a model fitted to one heat-up (PID_AUTOTUNE_FIT)
+      fit-relay   M303 F R, the model refined with one relay cycle
+
+    Build with PID_AUTOTUNE_FIT and without MPCTEMP. Exits with an error if a
+    method fails or its RMS error while printing exceeds --max-rms.
+"""
+
+from __future__ import print_function
+import argparse
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+
+parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+parser.add_argument('-p', '--program', default='.pioenvs/linux_native/program', help='Linux native executable')
+parser.add_argument('-m', '--methods', choices=('relay', 'fit', 'fit-relay'), nargs='+', default=['relay', 'fit', 'fit-relay'])
+parser.add_argument('-s', '--temp', type=int, default=210, help='Autotune temperature (default=210)')
+parser.add_argument('-c', '--cycles', type=int, default=5, help='Relay cycles (default=5)')
+parser.add_argument('-x', '--speedup', type=int, default=20, help='Simulated time per host time (default=20)')
+parser.add_argument('-n', '--stretches', type=int, default=20, help='Stretches of printing to benchmark (default=20)')
+parser.add_argument('--max-rms', type=float, default=1.5, help='Largest RMS error (C) allowed while printing')
+args = parser.parse_args()
+
+COMMANDS = {
+  'relay': 'M303 E0 S%d C%d U1' % (args.temp, args.cycles),
+  'fit': 'M303 E0 S%d F U1' % args.temp,
+  'fit-relay': 'M303 E0 S%d F R U1' % args.temp
+}
+CONSTANT = re.compile(r'^#define DEFAULT_K([pid]) ([\d.]+)')
+RESULT = re.compile(r'hotend: .*?: \d+ stretches, [\d.]+s printing, sag ([\d.-]+)C, rise ([\d.-]+)C, '
+                    r'rms ([\d.]+)C, heat-up ([\d.]+)s, overshoot ([\d.-]+)C')
+
+def expect(lines, done, timeout):
+  """ Lines up to one containing done. Exits on a failure or after timeout host seconds. """
+  seen = []
+  end = time.time() + timeout
+  while time.time() < end:
+    line = lines.pop(0) if lines else None
+    if line is None:
+      time.sleep(0.05)
+      continue
+    seen.append(line)
+    if 'failed' in line.lower(): sys.exit('%s' % line)
+    if done in line: return seen
+  sys.exit("No '%s' after %ds" % (done, timeout))
+
+def tune(command, eeprom):
+  """ Run command on a fresh simulated printer, save with M500. Return simulated seconds and constants. """
+  run = subprocess.Popen([args.program, '--stdio', '--speedup', str(args.speedup), '--eeprom', eeprom],
+                         stdin=subprocess.PIPE, stdout=subprocess.PIPE)
+  lines = []
+  def reader():
+    for line in iter(run.stdout.readline, b''): lines.append(line.decode('ascii', 'replace').strip())
+  thread = threading.Thread(target=reader)
+  thread.daemon = True
+  thread.start()
+  try:
+    def send(text):
+      run.stdin.write((text + '\n').encode())
+      run.stdin.flush()
+    expect(lines, 'Settings Loaded', 30)
+    begin = time.time()
+    send(command)
+    seen = expect(lines, 'PID Autotune finished', 3600.0 / args.speedup + 30)
+    seen += expect(lines, 'DEFAULT_Kd', 5)
+    seconds = (time.time() - begin) * args.speedup
+    send('M500')
+    expect(lines, 'Settings Stored', 10)
+  finally:
+    run.kill()
+  constants = dict(m.groups() for m in (CONSTANT.match(l) for l in seen) if m)
+  return seconds, constants
+
+workdir = tempfile.mkdtemp()
+failed = False
+try:
+  print("%-10s  %8s  %7s  %6s  %7s  %7s  %7s  %8s  %9s" % ('Method', 'Tune (s)', 'Kp', 'Ki', 'Kd', 'Sag (C)', 'RMS (C)', 'Heat-up', 'Overshoot'))
+  for method in args.methods:
+    eeprom = os.path.join(workdir, method + '.dat')
+    seconds, k = tune(COMMANDS[method], eeprom)
+    run = subprocess.Popen([args.program, '--stdio', '--eeprom', eeprom, '--benchmark-hotend', str(args.stretches)],
+                           stdin=subprocess.PIPE, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    err = run.communicate()[1].decode()
+    result = RESULT.search(err)
+    if not result: sys.exit("No benchmark result for %s:\n%s" % (method, err))
+    sag, rise, rms, heatup, overshoot = result.groups()
+    print("%-10s  %8.0f  %7s  %6s  %7s  %7s  %7s  %7ss  %9s" % (method, seconds, k.get('p'), k.get('i'), k.get('d'), sag, rms, heatup, overshoot))
+    if float(rms) > args.max_rms:
+      print("%s: RMS error %sC is over %.2fC" % (method, rms, args.max_rms))
+      failed = True
+finally:
+  shutil.rmtree(workdir)
+
+sys.exit(1 if failed else 0)
@@ -0,0 +1,34 @@
+#!/usr/bin/env python
+
+""" Measure planner throughput (blocks planned per second) for several
+    BLOCK_BUFFER_SIZE values, using the Linux native build.
+
+    Run from the top of the Marlin tree. Configuration_adv.h is restored
+    afterwards.
+"""
+
+from __future__ import print_function
+import re
+import sys
+import native_benchmark
+
+parser = native_benchmark.arguments(__doc__, 'Marlin/Configuration_adv.h', 'BLOCK_BUFFER_SIZE')
+parser.add_argument('-s', '--sizes', type=int, nargs='+', default=[8, 16, 32, 64, 128], help='BLOCK_BUFFER_SIZE values to test (powers of 2, max 128)')
+parser.add_argument('-n', '--blocks', type=int, default=100000, help='Blocks to plan per run (default=100000)')
+args = parser.parse_args()
+
+for size in args.sizes:
+  if size < 2 or size > 128 or size & (size - 1):
+    sys.exit("BLOCK_BUFFER_SIZE %d is not a power of 2 between 2 and 128" % size)
+
+RESULT = re.compile(r'([\d.]+) blocks/s')
+
+def benchmark(size):
+  report = native_benchmark.run(args, 'planner', args.blocks)[0]
+  return size, float(native_benchmark.results(RESULT, report, 'BLOCK_BUFFER_SIZE', size)[0])
+
+results = native_benchmark.sweep(args, 'BLOCK_BUFFER_SIZE', args.sizes, benchmark)
+
+print("BLOCK_BUFFER_SIZE  blocks/s")
+for size, rate in results:
+  print("%17d  %8.0f" % (size, rate))
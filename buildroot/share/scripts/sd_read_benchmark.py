@@ -0,0 +1,116 @@
+#!/usr/bin/env python
+
+""" Count the SD card commands needed to read a G-code file for printing,
+    using the Linux native build.
+
+    The file is written to a FAT16 card image twice: once in consecutive
+    clusters and once split into fragments interleaved with another file.
+    Each copy is read with --benchmark-sd, which reports the block read
+    commands (CMD17, CMD18, CMD12) the simulated card received.
+"""
+
+from __future__ import print_function
+import argparse
+import os
+import re
+import struct
+import subprocess
+import sys
+import tempfile
+
+parser = argparse.ArgumentParser(description=__doc__)
+parser.add_argument('gcode', help='G-code file to read')
+parser.add_argument('-f', '--fragment', type=int, default=4, help='Clusters per fragment in the fragmented copy (default=4)')
+parser.add_argument('-c', '--cluster', type=int, default=8, help='Blocks per cluster (default=8)')
+parser.add_argument('-p', '--program', default='.pioenvs/linux_native/program', help='Linux native executable')
+args = parser.parse_args()
+
+BLOCK = 512
+
+def fat16_image(path, files, cluster):
+  """ Write a FAT16 image holding files, a list of (8.3 name, data, fragment
+      size in clusters or 0). Fragmented files alternate with a filler file
+      so their clusters are not consecutive. """
+  total = 131072  # 64MB
+  clusters = total // cluster
+  fat_blocks = (clusters * 2 + BLOCK - 1) // BLOCK
+  root_entries = 512
+  data_start = 1 + 2 * fat_blocks + root_entries * 32 // BLOCK
+  image = bytearray(data_start * BLOCK)
+  boot = bytearray(BLOCK)
+  boot[0:11] = b'\xEB\x3C\x90MARLIN  '
+  struct.pack_into('<HBHBHHBHHHII', boot, 11, BLOCK, cluster, 1, 2, root_entries, 0, 0xF8, fat_blocks, 32, 64, 0, total)
+  struct.pack_into('<BBBI11s8s', boot, 36, 0x80, 0, 0x29, 0x1234, b'NO NAME    ', b'FAT16   ')
+  boot[510:512] = b'\x55\xAA'
+  image[0:BLOCK] = boot
+
+  fat = [0xFFF8, 0xFFFF]
+  data = {}
+  root = bytearray()
+  free = [2]
+
+  def allocate(count):
+    first = free[0]
+    free[0] += count
+    fat.extend([0] * (free[0] - len(fat)))
+    return list(range(first, first + count))
+
+  filler = None
+  for name, content, fragment in files:
+    size = BLOCK * cluster
+    count = max(1, (len(content) + size - 1) // size)
+    chain = []
+    while len(chain) < count:
+      chain += allocate(min(fragment or count, count - len(chain)))
+      if fragment and len(chain) < count:
+        filler = (filler or []) + allocate(1)
+    for i, c in enumerate(chain):
+      fat[c] = chain[i + 1] if i + 1 < len(chain) else 0xFFFF
+      data[c] = content[i * size:(i + 1) * size]
+    base, ext = name.split('.')
+    root += struct.pack('<8s3sB10sHHHI', base.ljust(8).encode(), ext.ljust(3).encode(), 0x20, b'\0' * 10, 0, 0x21, chain[0], len(content))
+
+  if filler:
+    for i, c in enumerate(filler):
+      fat[c] = filler[i + 1] if i + 1 < len(filler) else 0xFFFF
+    root += struct.pack('<8s3sB10sHHHI', b'FILLER  ', b'BIN', 0x20, b'\0' * 10, 0, 0x21, filler[0], len(filler) * BLOCK * cluster)
+
+  fat_data = b''.join(struct.pack('<H', x) for x in fat)
+  for k in range(2):
+    offset = (1 + k * fat_blocks) * BLOCK
+    image[offset:offset + len(fat_data)] = fat_data
+  offset = (1 + 2 * fat_blocks) * BLOCK
+  image[offset:offset + len(root)] = root
+
+  with open(path, 'wb') as f:
+    f.write(image)
+    for c in sorted(data):
+      f.seek((data_start + (c - 2) * cluster) * BLOCK)
+      f.write(data[c])
+    f.truncate(total * BLOCK)
+
+with open(args.gcode, 'rb') as f:
+  gcode = f.read()
+
+fd, image = tempfile.mkstemp(suffix='.img')
+os.close(fd)
+try:
+  fat16_image(image, [('CONTIG.GCO', gcode, 0), ('FRAGMENT.GCO', gcode, args.fragment)], args.cluster)
+  results = []
+  for name in ('CONTIG.GCO', 'FRAGMENT.GCO'):
+    run = subprocess.Popen([args.program, '--stdio', '--sdcard', image, '--benchmark-sd', name],
+                           stdin=subprocess.PIPE, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    err = run.communicate()[1].decode()
+    speed = re.search(r'([\d.]+) KB/s, checksum (\w+)', err)
+    counts = re.search(r'(\d+) blocks read with (\d+) commands .*?([\d.]+) commands/MB', err)
+    if not speed or not counts:
+      sys.exit("No benchmark result for %s:\n%s" % (name, err))
+    results.append((name, float(speed.group(1)), speed.group(2), int(counts.group(1)), int(counts.group(2)), float(counts.group(3))))
+finally:
+  os.remove(image)
+
+print("File          KB/s  Checksum   Blocks  Commands  Commands/MB")
+for r in results:
+  print("%-12s %5.0f  %s %7d  %8d  %11.1f" % r)
+if results[0][2] != results[1][2]:
+  sys.exit("Checksums differ")
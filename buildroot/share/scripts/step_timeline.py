@@ -0,0 +1,312 @@
+#!/usr/bin/env python
+
+""" Rebuild the motion of each axis from a step timeline recorded with
+    STEP_TIMELINE (M576) and check it against the planner settings.
+
+    analyze FILE     Analyze the raw serial output of a recording, saved from
+                     before M576 S1 to after M576 S0.
+    run GCODE        Record GCODE on the Linux native build (--stdio) and
+                     analyze it.
+    capture PORT     Record GCODE (-g) on a printer over a serial port and
+                     analyze it. Needs pyserial.
+
+    Position, velocity, acceleration and jerk of every axis are sampled on
+    a uniform grid (--window) from the step times, and the report flags:
+
+     - velocity above the axis' max feedrate (M203)
+     - acceleration above the axis' max acceleration (M201), allowing for
+       a jerk (M205) speed change within one window
+     - step pulses closer than the driver can see (twice MINIMUM_STEPPER_PULSE)
+     - the path coming to a stop at a block junction, which with the moves
+       still to come means the planner ran dry (BLOCK_BUFFER_SIZE) or
+       planned a full stop (MINIMUM_PLANNER_SPEED, jerk)
+     - records dropped by the firmware (STEP_TIMELINE_SIZE)
+
+    The frame and record formats are described in
+    Marlin/src/feature/step_timeline.h.
+"""
+
+from __future__ import print_function
+import argparse
+import math
+import re
+import struct
+import subprocess
+import sys
+import threading
+import time
+
+FRAME_START = 0xA6
+FRAME_RECORDS = 32
+AXES = 'XYZE'
+MARKER_ELAPSED, MARKER_BLOCK, MARKER_DROPPED = range(3)
+
+HEADER = re.compile(r'Step timeline: rate (\d+) pulse (\d+)((?: [XYZE] [-\d.]+/[-\d.]+/\d+/[-\d.]+)+)')
+AXIS_SETTINGS = re.compile(r'([XYZE]) ([-\d.]+)/([-\d.]+)/(\d+)/([-\d.]+)')
+FOOTER = re.compile(r'Step timeline: off, records (\d+) dropped (\d+)')
+
+def crc16(data):
+  """ CRC-16/CCITT, as crc16() in Marlin/src/core/utility.cpp """
+  crc = 0
+  for b in bytearray(data):
+    crc ^= b << 8
+    for _ in range(8):
+      crc = ((crc << 1) ^ 0x1021 if crc & 0x8000 else crc << 1) & 0xFFFF
+  return crc
+
+class Splitter(object):
+  """ Split serial output into text lines and timeline frames """
+  def __init__(self):
+    self.data = bytearray()
+    self.line = bytearray()
+    self.lines = []
+    self.records = []
+    self.bad_frames = 0
+
+  def feed(self, data):
+    self.data += data
+    pos, size = 0, len(self.data)
+    while pos < size:
+      b = self.data[pos]
+      if b == FRAME_START:
+        if pos + 2 > size: break
+        count = self.data[pos + 1]
+        length = 2 + 4 * count + 2
+        if 0 < count <= FRAME_RECORDS:
+          if pos + length > size: break
+          body = bytes(self.data[pos + 1:pos + length - 2])
+          if struct.unpack_from('<H', self.data, pos + length - 2)[0] == crc16(body):
+            self.records.extend(struct.unpack_from('<%dI' % count, body, 1))
+            pos += length
+            continue
+          self.bad_frames += 1
+      pos += 1
+      if b == 10:
+        self.lines.append(self.line.decode('ascii', 'replace').rstrip('\r'))
+        self.line = bytearray()
+      else:
+        self.line.append(b)
+    del self.data[:pos]
+
+class Settings(object):
+  def __init__(self, lines):
+    for line in lines:
+      match = HEADER.search(line)
+      if match: break
+    else:
+      sys.exit("No 'Step timeline' header in the capture. Was it started with M576 S1?")
+    self.rate = int(match.group(1))
+    self.pulse_us = int(match.group(2))
+    self.axes = {}
+    for axis, steps_mm, feedrate, accel, jerk in AXIS_SETTINGS.findall(match.group(3)):
+      self.axes[axis] = (float(steps_mm), float(feedrate), float(accel), float(jerk))
+    self.footer = None
+    for line in lines:
+      match = FOOTER.search(line)
+      if match: self.footer = (int(match.group(1)), int(match.group(2)))
+
+def decode(records, settings):
+  """ Step times and positions per axis, block start times, and drop points """
+  steps = dict((axis, [(0.0, 0)]) for axis in AXES)
+  position = dict((axis, 0) for axis in AXES)
+  last_tick = dict((axis, None) for axis in AXES)
+  blocks, drops, close = [], [], dict((axis, 0) for axis in AXES)
+  min_ticks = 2 * settings.pulse_us * settings.rate // 1000000
+  ticks = 0
+  for record in records:
+    ticks += record & 0xFFFFFF
+    step_bits, dir_bits = (record >> 24) & 0x0F, record >> 28
+    t = float(ticks) / settings.rate
+    if not step_bits:
+      if dir_bits == MARKER_BLOCK: blocks.append(t)
+      elif dir_bits == MARKER_DROPPED: drops.append(t)
+      continue
+    for i, axis in enumerate(AXES):
+      if step_bits & (1 << i):
+        position[axis] += -1 if dir_bits & (1 << i) else 1
+        steps[axis].append((t, position[axis]))
+        if last_tick[axis] is not None and ticks - last_tick[axis] < min_ticks: close[axis] += 1
+        last_tick[axis] = ticks
+  return steps, blocks, drops, close, float(ticks) / settings.rate
+
+def sample(points, grid):
+  """ Position at each grid time, linear between steps """
+  out, i = [], 0
+  for t in grid:
+    while i + 1 < len(points) and points[i + 1][0] <= t: i += 1
+    if i + 1 < len(points):
+      (t0, p0), (t1, p1) = points[i], points[i + 1]
+      out.append(p0 + (p1 - p0) * (t - t0) / (t1 - t0) if t1 > t0 else p1)
+    else:
+      out.append(points[i][1])
+  return out
+
+def derive(values, dt):
+  return [(b - a) / dt for a, b in zip(values, values[1:])]
+
+def analyze(splitter, args):
+  settings = Settings(splitter.lines)
+  steps, blocks, drops, close, duration = decode(splitter.records, settings)
+  window = args.window / 1000.0
+  count = int(duration / window) + 1
+  grid = [i * window for i in range(count + 1)]
+
+  print("%d records, %d blocks, %.3f s, timer %d Hz" % (len(splitter.records), len(blocks), duration, settings.rate))
+  if splitter.bad_frames: print("%d frames with a bad CRC" % splitter.bad_frames)
+  if settings.footer and settings.footer[0] != len(splitter.records) - len(drops):
+    print("The firmware recorded %d records, %d were received" % (settings.footer[0], len(splitter.records) - len(drops)))
+
+  violations = 0
+  if drops:
+    lost = settings.footer[1] if settings.footer else 0
+    print("VIOLATION: %d records dropped in %d places, from %.3f s. Timing after that is shifted. Increase STEP_TIMELINE_SIZE." % (lost, len(drops), drops[0]))
+    violations += 1
+
+  path_v = [0.0] * count
+  columns = [('t', grid[:count])]
+  print("axis    steps  max mm/s  limit  max mm/s2  limit  max mm/s3  close pulses")
+  for axis in AXES:
+    if axis not in settings.axes: continue
+    steps_mm, feedrate, accel, jerk = settings.axes[axis]
+    mm = [p / steps_mm for p in sample(steps[axis], grid)]
+    v = derive(mm, window)
+    a = derive(v, window)
+    j = derive(a, window)
+    if axis != 'E':
+      path_v = [pv + x * x for pv, x in zip(path_v, v)]
+    max_v = max([abs(x) for x in v] or [0])
+    max_a = max([abs(x) for x in a] or [0])
+    max_j = max([abs(x) for x in j] or [0])
+    limit_a = accel + jerk / window
+    print("%4s %8d %9.1f %6.0f %10.0f %6.0f %10.0f %13d" % (axis, len(steps[axis]) - 1, max_v, feedrate, max_a, limit_a, max_j, close[axis]))
+
+    over_v = [grid[i] for i, x in enumerate(v) if abs(x) > feedrate * (1 + args.tolerance)]
+    over_a = [grid[i] for i, x in enumerate(a) if abs(x) > limit_a * (1 + args.tolerance)]
+    if over_v:
+      print("VIOLATION: %s over %.1f mm/s in %d windows, first at %.3f s" % (axis, feedrate, len(over_v), over_v[0]))
+      violations += 1
+    if over_a:
+      print("VIOLATION: %s over %.0f mm/s2 in %d windows, first at %.3f s" % (axis, limit_a, len(over_a), over_a[0]))
+      violations += 1
+    if close[axis]:
+      print("VIOLATION: %d %s steps less than %d us apart" % (close[axis], axis, 2 * settings.pulse_us))
+      violations += 1
+    columns += [(axis, mm[:count]), (axis + '_v', v + [0]), (axis + '_a', a + [0] * 2), (axis + '_j', j + [0] * 3)]
+
+  path_v = [math.sqrt(x) for x in path_v]
+  columns.append(('path_v', path_v))
+
+  # Speed at each block junction, ignoring the first block and anything after the moves
+  end = max(points[-1][0] for points in steps.values())
+  junctions = [(t, path_v[min(int(t / window), count - 1)]) for t in blocks[1:] if t < end]
+  stops = [t for t, speed in junctions if speed < args.stop_speed]
+  if junctions:
+    speeds = sorted(speed for t, speed in junctions)
+    print("Junction speed: min %.1f, median %.1f, max %.1f mm/s" % (speeds[0], speeds[len(speeds) // 2], speeds[-1]))
+  if stops:
+    print("VIOLATION: the path stopped at %d of %d block junctions, first at %.3f s (planner starved or a planned stop)" % (len(stops), len(junctions), stops[0]))
+    violations += 1
+
+  if args.csv:
+    with open(args.csv, 'w') as f:
+      f.write(','.join(name for name, values in columns) + '\n')
+      for i in range(count):
+        f.write(','.join('%.6g' % values[i] for name, values in columns) + '\n')
+    print("Wrote %d samples to %s" % (count, args.csv))
+
+  print("%d violations" % violations if violations else "No violations")
+  return 1 if violations else 0
+
+def oks_in(splitter):
+  return sum(1 for l in splitter.lines if l.startswith('ok'))
+
+def record(write, read, gcode, timeout):
+  """ Send M576 S1, the G-code and M576 S0 one line at a time, waiting for
+      each 'ok', and collect the output until the timeline is off. """
+  splitter = Splitter()
+  lines = ['M576 S1'] + [l.split(';', 1)[0].strip() for l in gcode] + ['M576 S0']
+  deadline = time.time() + timeout
+  for line in lines:
+    if not line: continue
+    oks = oks_in(splitter)
+    write((line + '\n').encode())
+    while oks_in(splitter) == oks:
+      if time.time() > deadline: sys.exit("Timed out waiting for 'ok' after %s" % line)
+      splitter.feed(read())
+  while not any(FOOTER.search(l) for l in splitter.lines):
+    if time.time() > deadline: sys.exit("Timed out waiting for the end of the timeline")
+    splitter.feed(read())
+  return splitter
+
+def run_native(args):
+  proc = subprocess.Popen([args.program, '--stdio'], stdin=subprocess.PIPE, stdout=subprocess.PIPE)
+  chunks, lock = [], threading.Lock()
+  def reader():
+    while True:
+      data = proc.stdout.read1(4096) if hasattr(proc.stdout, 'read1') else proc.stdout.read(1)
+      if not data: break
+      with lock: chunks.append(data)
+  thread = threading.Thread(target=reader)
+  thread.daemon = True
+  thread.start()
+  def read():
+    time.sleep(0.01)
+    with lock:
+      data = b''.join(chunks)
+      del chunks[:]
+    return data
+  def write(data):
+    proc.stdin.write(data)
+    proc.stdin.flush()
+  try:
+    with open(args.gcode) as f:
+      return record(write, read, f.readlines(), args.timeout)
+  finally:
+    proc.kill()
+
+def capture(args):
+  import serial
+  port = serial.Serial(args.port, args.baud, timeout=0.05)
+  time.sleep(2)  # Most boards reset on connect
+  port.reset_input_buffer()
+  with open(args.gcode) as f:
+    splitter = record(port.write, lambda: port.read(4096), f.readlines(), args.timeout)
+  port.close()
+  return splitter
+
+parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+parser.add_argument('mode', choices=['analyze', 'run', 'capture'])
+parser.add_argument('input', help='Capture file (analyze), G-code file (run) or serial port (capture)')
+parser.add_argument('-p', '--program', default='.pioenvs/linux_native/program', help='Linux native executable (run)')
+parser.add_argument('-g', '--gcode', help='G-code file to record (capture)')
+parser.add_argument('-b', '--baud', type=int, default=250000, help='Baud rate (capture)')
+parser.add_argument('-o', '--output', help='Save the raw recording to this file (run, capture)')
+parser.add_argument('-w', '--window', type=float, default=2.0, help='Sampling window in ms (default=2)')
+parser.add_argument('-t', '--tolerance', type=float, default=0.05, help='Allowed excess over the limits (default=0.05)')
+parser.add_argument('-s', '--stop-speed', type=float, default=1.0, help='Path speed in mm/s counted as a stop at a junction (default=1)')
+parser.add_argument('--timeout', type=float, default=600, help='Seconds to wait for a recording (default=600)')
+parser.add_argument('--csv', help='Write the sampled positions and derivatives to this CSV file')
+args = parser.parse_args()
+
+if args.mode == 'analyze':
+  splitter = Splitter()
+  with open(args.input, 'rb') as f:
+    splitter.feed(f.read())
+else:
+  if args.mode == 'run':
+    args.gcode = args.input
+    splitter = run_native(args)
+  else:
+    if not args.gcode: sys.exit("capture needs the G-code to record (-g)")
+    args.port = args.input
+    splitter = capture(args)
+  if args.output:
+    # Saved as text lines and re-encoded frames, which analyze reads the same way
+    with open(args.output, 'wb') as f:
+      for line in splitter.lines:
+        f.write((line + '\n').encode())
+      for i in range(0, len(splitter.records), FRAME_RECORDS):
+        body = struct.pack('<B', len(splitter.records[i:i + FRAME_RECORDS])) + struct.pack('<%dI' % len(splitter.records[i:i + FRAME_RECORDS]), *splitter.records[i:i + FRAME_RECORDS])
+        f.write(struct.pack('<B', FRAME_START) + body + struct.pack('<H', crc16(body)))
+
+sys.exit(analyze(splitter, args))
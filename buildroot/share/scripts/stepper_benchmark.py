@@ -0,0 +1,47 @@
+#!/usr/bin/env python
+
+""" Run the stepper ISR on random moves with the Linux native build
+    (--benchmark-stepper), without STEP_PATTERN_BUFFER and with several
+    buffer sizes, and compare ISRs and host time per step event. Every
+    build must emit all the steps of every block, at the rates of its
+    trapezoid.
+
+    Run from the top of the Marlin tree. Configuration_adv.h is restored
+    afterwards.
+"""
+
+from __future__ import print_function
+import re
+import sys
+import native_benchmark
+
+parser = native_benchmark.arguments(__doc__, 'Marlin/Configuration_adv.h', 'STEP_PATTERN_BUFFER')
+parser.add_argument('-s', '--sizes', type=int, nargs='+', default=[0, 16, 32, 64], help='STEP_PATTERN_BUFFER values to test, 0 for none (powers of 2, 8 to 128)')
+parser.add_argument('-n', '--moves', type=int, default=40, help='Moves to run per build (default=40)')
+args = parser.parse_args()
+
+for size in args.sizes:
+  if size and (size < 8 or size > 128 or size & (size - 1)):
+    sys.exit("STEP_PATTERN_BUFFER %d is not a power of 2 between 8 and 128" % size)
+
+RESULT = re.compile(r'stepper: .*?, X (\d+) steps/mm, .*? ([\d.]+) ISRs/event, (\d+) ns/ISR, (\d+) ns/event\n'
+                    r'stepper: (\d+) blocks with missing steps, max rate (\d+) steps/s, .*? (\d+) of \d+ ISRs off by over 5%')
+
+def benchmark(size):
+  report, status = native_benchmark.run(args, 'stepper', args.moves)
+  passes = []
+  for steps_mm, isrs, ns_isr, ns_event, missing, rate, off_rate in native_benchmark.results(RESULT, report, 'STEP_PATTERN_BUFFER', size):
+    if int(missing):
+      sys.exit("STEP_PATTERN_BUFFER %s: %s blocks with missing steps at %s steps/mm" % (size, missing, steps_mm))
+    if int(off_rate):
+      sys.exit("STEP_PATTERN_BUFFER %s: %s ISRs off the trapezoid at %s steps/mm" % (size, off_rate, steps_mm))
+    passes.append((size, int(steps_mm), float(isrs), int(ns_isr), int(ns_event), int(rate)))
+  if status:
+    sys.exit("STEP_PATTERN_BUFFER %s: the benchmark failed:\n%s" % (size, report))
+  return passes
+
+results = native_benchmark.sweep(args, 'STEP_PATTERN_BUFFER', [size or None for size in args.sizes], benchmark)
+
+print("STEP_PATTERN_BUFFER  X steps/mm  ISRs/event  ns/ISR  ns/event  max steps/s")
+for size, steps_mm, isrs, ns_isr, ns_event, rate in sum(results, []):
+  print("%19s  %10d  %10.2f  %6d  %8d  %11d" % (size or 'none', steps_mm, isrs, ns_isr, ns_event, rate))